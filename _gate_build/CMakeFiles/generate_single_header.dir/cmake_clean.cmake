@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/generate_single_header"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/generate_single_header.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,31 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/include/internal/csv_cache.cpp" "include/internal/CMakeFiles/csv.dir/csv_cache.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_cache.cpp.o.d"
+  "/root/repo/include/internal/csv_format.cpp" "include/internal/CMakeFiles/csv.dir/csv_format.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_format.cpp.o.d"
+  "/root/repo/include/internal/csv_index.cpp" "include/internal/CMakeFiles/csv.dir/csv_index.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_index.cpp.o.d"
+  "/root/repo/include/internal/csv_instantiations.cpp" "include/internal/CMakeFiles/csv.dir/csv_instantiations.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_instantiations.cpp.o.d"
+  "/root/repo/include/internal/csv_multi_reader.cpp" "include/internal/CMakeFiles/csv.dir/csv_multi_reader.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_multi_reader.cpp.o.d"
+  "/root/repo/include/internal/csv_reader.cpp" "include/internal/CMakeFiles/csv.dir/csv_reader.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_reader.cpp.o.d"
+  "/root/repo/include/internal/csv_reader_internals.cpp" "include/internal/CMakeFiles/csv.dir/csv_reader_internals.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_reader_internals.cpp.o.d"
+  "/root/repo/include/internal/csv_reader_iterator.cpp" "include/internal/CMakeFiles/csv.dir/csv_reader_iterator.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_reader_iterator.cpp.o.d"
+  "/root/repo/include/internal/csv_row.cpp" "include/internal/CMakeFiles/csv.dir/csv_row.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_row.cpp.o.d"
+  "/root/repo/include/internal/csv_row_json.cpp" "include/internal/CMakeFiles/csv.dir/csv_row_json.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_row_json.cpp.o.d"
+  "/root/repo/include/internal/csv_stat.cpp" "include/internal/CMakeFiles/csv.dir/csv_stat.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_stat.cpp.o.d"
+  "/root/repo/include/internal/csv_utility.cpp" "include/internal/CMakeFiles/csv.dir/csv_utility.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/csv_utility.cpp.o.d"
+  "/root/repo/include/internal/row_buffer.cpp" "include/internal/CMakeFiles/csv.dir/row_buffer.cpp.o" "gcc" "include/internal/CMakeFiles/csv.dir/row_buffer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
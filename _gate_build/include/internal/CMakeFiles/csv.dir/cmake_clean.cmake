@@ -0,0 +1,35 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv.dir/csv_cache.cpp.o"
+  "CMakeFiles/csv.dir/csv_cache.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_format.cpp.o"
+  "CMakeFiles/csv.dir/csv_format.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_index.cpp.o"
+  "CMakeFiles/csv.dir/csv_index.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_instantiations.cpp.o"
+  "CMakeFiles/csv.dir/csv_instantiations.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_multi_reader.cpp.o"
+  "CMakeFiles/csv.dir/csv_multi_reader.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_reader.cpp.o"
+  "CMakeFiles/csv.dir/csv_reader.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_reader_internals.cpp.o"
+  "CMakeFiles/csv.dir/csv_reader_internals.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_reader_iterator.cpp.o"
+  "CMakeFiles/csv.dir/csv_reader_iterator.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_row.cpp.o"
+  "CMakeFiles/csv.dir/csv_row.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_row_json.cpp.o"
+  "CMakeFiles/csv.dir/csv_row_json.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_stat.cpp.o"
+  "CMakeFiles/csv.dir/csv_stat.cpp.o.d"
+  "CMakeFiles/csv.dir/csv_utility.cpp.o"
+  "CMakeFiles/csv.dir/csv_utility.cpp.o.d"
+  "CMakeFiles/csv.dir/row_buffer.cpp.o"
+  "CMakeFiles/csv.dir/row_buffer.cpp.o.d"
+  "libcsv.a"
+  "libcsv.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_bench.dir/csv_bench.cpp.o"
+  "CMakeFiles/csv_bench.dir/csv_bench.cpp.o.d"
+  "csv_bench"
+  "csv_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
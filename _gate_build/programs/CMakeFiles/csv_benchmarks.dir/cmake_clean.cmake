@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_benchmarks.dir/csv_benchmarks.cpp.o"
+  "CMakeFiles/csv_benchmarks.dir/csv_benchmarks.cpp.o.d"
+  "csv_benchmarks"
+  "csv_benchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_benchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_generator.dir/csv_generator.cpp.o"
+  "CMakeFiles/csv_generator.dir/csv_generator.cpp.o.d"
+  "csv_generator"
+  "csv_generator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_generator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
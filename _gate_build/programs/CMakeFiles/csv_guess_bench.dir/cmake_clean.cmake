@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_guess_bench.dir/csv_guess_bench.cpp.o"
+  "CMakeFiles/csv_guess_bench.dir/csv_guess_bench.cpp.o.d"
+  "csv_guess_bench"
+  "csv_guess_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_guess_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_info.dir/csv_info.cpp.o"
+  "CMakeFiles/csv_info.dir/csv_info.cpp.o.d"
+  "csv_info"
+  "csv_info.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_info.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
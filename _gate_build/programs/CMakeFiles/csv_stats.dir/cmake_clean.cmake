@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_stats.dir/csv_stats.cpp.o"
+  "CMakeFiles/csv_stats.dir/csv_stats.cpp.o.d"
+  "csv_stats"
+  "csv_stats.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
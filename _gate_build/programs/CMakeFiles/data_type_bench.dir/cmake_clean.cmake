@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/data_type_bench.dir/data_type_bench.cpp.o"
+  "CMakeFiles/data_type_bench.dir/data_type_bench.cpp.o.d"
+  "data_type_bench"
+  "data_type_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/data_type_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
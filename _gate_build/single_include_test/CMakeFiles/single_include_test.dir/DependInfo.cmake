@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/single_include_test/file1.cpp" "single_include_test/CMakeFiles/single_include_test.dir/file1.cpp.o" "gcc" "single_include_test/CMakeFiles/single_include_test.dir/file1.cpp.o.d"
+  "/root/repo/single_include_test/file2.cpp" "single_include_test/CMakeFiles/single_include_test.dir/file2.cpp.o" "gcc" "single_include_test/CMakeFiles/single_include_test.dir/file2.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/single_include_test.dir/file1.cpp.o"
+  "CMakeFiles/single_include_test.dir/file1.cpp.o.d"
+  "CMakeFiles/single_include_test.dir/file2.cpp.o"
+  "CMakeFiles/single_include_test.dir/file2.cpp.o.d"
+  "single_include_test"
+  "single_include_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/single_include_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/main.cpp" "tests/CMakeFiles/csv_test.dir/main.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/main.cpp.o.d"
+  "/root/repo/tests/test_async_reader.cpp" "tests/CMakeFiles/csv_test.dir/test_async_reader.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_async_reader.cpp.o.d"
+  "/root/repo/tests/test_csv_buffer.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_buffer.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_buffer.cpp.o.d"
+  "/root/repo/tests/test_csv_cache.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_cache.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_cache.cpp.o.d"
+  "/root/repo/tests/test_csv_field.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_field.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_field.cpp.o.d"
+  "/root/repo/tests/test_csv_format.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_format.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_format.cpp.o.d"
+  "/root/repo/tests/test_csv_index.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_index.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_index.cpp.o.d"
+  "/root/repo/tests/test_csv_iterator.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_iterator.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_iterator.cpp.o.d"
+  "/root/repo/tests/test_csv_row.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_row.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_row.cpp.o.d"
+  "/root/repo/tests/test_csv_row_json.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_row_json.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_row_json.cpp.o.d"
+  "/root/repo/tests/test_csv_stat.cpp" "tests/CMakeFiles/csv_test.dir/test_csv_stat.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_csv_stat.cpp.o.d"
+  "/root/repo/tests/test_data_type.cpp" "tests/CMakeFiles/csv_test.dir/test_data_type.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_data_type.cpp.o.d"
+  "/root/repo/tests/test_guess_csv.cpp" "tests/CMakeFiles/csv_test.dir/test_guess_csv.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_guess_csv.cpp.o.d"
+  "/root/repo/tests/test_multi_reader.cpp" "tests/CMakeFiles/csv_test.dir/test_multi_reader.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_multi_reader.cpp.o.d"
+  "/root/repo/tests/test_read_csv.cpp" "tests/CMakeFiles/csv_test.dir/test_read_csv.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_read_csv.cpp.o.d"
+  "/root/repo/tests/test_read_csv_file.cpp" "tests/CMakeFiles/csv_test.dir/test_read_csv_file.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_read_csv_file.cpp.o.d"
+  "/root/repo/tests/test_write_csv.cpp" "tests/CMakeFiles/csv_test.dir/test_write_csv.cpp.o" "gcc" "tests/CMakeFiles/csv_test.dir/test_write_csv.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/include/internal/CMakeFiles/csv.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
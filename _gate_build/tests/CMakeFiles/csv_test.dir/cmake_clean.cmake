@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/csv_test.dir/main.cpp.o"
+  "CMakeFiles/csv_test.dir/main.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_async_reader.cpp.o"
+  "CMakeFiles/csv_test.dir/test_async_reader.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_buffer.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_buffer.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_cache.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_cache.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_field.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_field.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_format.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_format.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_index.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_index.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_iterator.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_iterator.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_row.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_row.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_row_json.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_row_json.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_csv_stat.cpp.o"
+  "CMakeFiles/csv_test.dir/test_csv_stat.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_data_type.cpp.o"
+  "CMakeFiles/csv_test.dir/test_data_type.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_guess_csv.cpp.o"
+  "CMakeFiles/csv_test.dir/test_guess_csv.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_multi_reader.cpp.o"
+  "CMakeFiles/csv_test.dir/test_multi_reader.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_read_csv.cpp.o"
+  "CMakeFiles/csv_test.dir/test_read_csv.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_read_csv_file.cpp.o"
+  "CMakeFiles/csv_test.dir/test_read_csv_file.cpp.o.d"
+  "CMakeFiles/csv_test.dir/test_write_csv.cpp.o"
+  "CMakeFiles/csv_test.dir/test_write_csv.cpp.o.d"
+  "csv_test"
+  "csv_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/csv_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
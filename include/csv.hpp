@@ -29,6 +29,11 @@ SOFTWARE.
 #ifndef CSV_HPP
 #define CSV_HPP
 
+#include "internal/csv_async.hpp"
+#include "internal/csv_cache.hpp"
+#include "internal/csv_compressed_output.hpp"
+#include "internal/csv_index.hpp"
+#include "internal/csv_multi_reader.hpp"
 #include "internal/csv_reader.hpp"
 #include "internal/csv_stat.hpp"
 #include "internal/csv_utility.hpp"
@@ -37,6 +37,16 @@ namespace csv {
          *  many bytes are read at a time
          */
         constexpr size_t ITERATION_CHUNK_SIZE = 50000000; // 50MB
+
+        /** Minimum amount of input each parallel parse worker should receive.
+         *  Below this, thread start-up costs outweigh any parsing speedup.
+         */
+        constexpr size_t PARALLEL_SLICE_MIN = 65536; // 64KB
+
+        /** How many raw compressed bytes are staged per read when
+         *  stream-decompressing gzip or zstd input
+         */
+        constexpr size_t COMPRESSED_CHUNK_SIZE = 1048576; // 1MB
     }
 
     /** Integer indicating a requested column wasn't found. */
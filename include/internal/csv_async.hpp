@@ -0,0 +1,198 @@
+/** @file
+ *  Defines an awaitable row stream for C++20 coroutine consumers
+ *
+ *  Everything here is guarded by CSV_HAS_COROUTINES and compiles away
+ *  entirely on C++14/17 builds. Unlike the rest of the library, this file
+ *  is header-only: its symbols cannot live in the precompiled library,
+ *  which may have been built under an older standard.
+ */
+
+#pragma once
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define CSV_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef CSV_HAS_COROUTINES
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "csv_reader.hpp"
+
+namespace csv {
+    /** @class AsyncReader
+     *  @brief Reads rows for coroutine-based consumers without blocking them
+     *
+     *  A dedicated reader thread parses the file chunk by chunk into a
+     *  bounded row buffer. `co_await reader.next(row)` completes immediately
+     *  while buffered rows remain; when the buffer runs dry, the awaiting
+     *  coroutine suspends — freeing its thread for other work — and is
+     *  resumed by the reader thread once the next chunk has been parsed.
+     *  This lets many concurrent streams share a small thread pool instead
+     *  of each pinning a thread inside read_row().
+     *
+     *  At most one coroutine may be awaiting a given AsyncReader at a time,
+     *  and the AsyncReader must outlive any coroutine suspended on it.
+     */
+    class AsyncReader {
+    public:
+        /** Awaitable returned by next(); resolves to true if a row was read */
+        class RowAwaiter {
+        public:
+            RowAwaiter(AsyncReader& reader, CSVRow& out) :
+                owner(reader), row(out) {};
+
+            bool await_ready() {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+                return this->try_pop();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+
+                // A chunk may have been parsed between await_ready() and
+                // here; resume immediately rather than suspend
+                if (!this->owner.ready.empty() || this->owner.done)
+                    return false;
+
+                this->owner.waiter = handle;
+                return true;
+            }
+
+            bool await_resume() {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+                if (this->got_row) return true;
+                if (this->try_pop()) return true;
+
+                // Stream exhausted: surface any reader thread failure
+                if (this->owner.reader_error)
+                    std::rethrow_exception(this->owner.reader_error);
+
+                return false;
+            }
+
+        private:
+            /** Move the next buffered row into the caller's slot.
+             *  @pre owner.lock is held
+             */
+            bool try_pop() {
+                if (this->owner.ready.empty()) return false;
+
+                this->row = std::move(this->owner.ready.front());
+                this->owner.ready.pop_front();
+                this->got_row = true;
+                this->owner.space_available.notify_one();
+                return true;
+            }
+
+            AsyncReader& owner;
+            CSVRow& row;
+            bool got_row = false;
+        };
+
+        AsyncReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv()) :
+            reader(filename, format) {
+            this->reader_thread = std::thread(&AsyncReader::reader_main, this);
+        }
+
+        ~AsyncReader() {
+            {
+                std::unique_lock<std::mutex> lock(this->lock);
+                this->shutting_down = true;
+            }
+
+            this->space_available.notify_all();
+            if (this->reader_thread.joinable())
+                this->reader_thread.join();
+        }
+
+        AsyncReader(const AsyncReader&) = delete;
+        AsyncReader& operator=(const AsyncReader&) = delete;
+
+        /** Await the next row, suspending the caller if none is buffered
+         *
+         *  @param[out] row The variable where the parsed row will be stored
+         *  @return An awaitable resolving to true if a row was read,
+         *          or false once the stream is exhausted
+         */
+        RowAwaiter next(CSVRow& row) { return RowAwaiter(*this, row); }
+
+        std::vector<std::string> get_col_names() const {
+            return this->reader.get_col_names();
+        }
+
+    private:
+        /** Rows buffered ahead of the consumer before the reader thread
+         *  pauses and waits for the stream to drain
+         */
+        static constexpr size_t HIGH_WATER = 10000;
+
+        /** Rows pulled from the CSVReader per wakeup */
+        static constexpr size_t READ_BATCH = 1000;
+
+        void reader_main() {
+            std::vector<CSVRow> batch;
+
+            while (true) {
+                batch.clear();
+
+                size_t n_read = 0;
+                try {
+                    n_read = this->reader.read_rows(batch, READ_BATCH);
+                }
+                catch (...) {
+                    std::unique_lock<std::mutex> lock(this->lock);
+                    this->reader_error = std::current_exception();
+                }
+
+                std::coroutine_handle<> handle = nullptr;
+
+                {
+                    std::unique_lock<std::mutex> lock(this->lock);
+                    for (auto& row : batch)
+                        this->ready.push_back(std::move(row));
+
+                    if (n_read == 0 || this->reader_error)
+                        this->done = true;
+
+                    // The consumer suspends only when the buffer is empty,
+                    // so new rows (or EOF) always warrant a resume
+                    if (this->waiter) {
+                        handle = this->waiter;
+                        this->waiter = nullptr;
+                    }
+                }
+
+                // Resumed outside the lock: the consumer immediately
+                // re-enters next(), which locks to pop its row
+                if (handle) handle.resume();
+                if (this->done) break;
+
+                std::unique_lock<std::mutex> lock(this->lock);
+                this->space_available.wait(lock, [this] {
+                    return this->ready.size() < HIGH_WATER || this->shutting_down;
+                });
+
+                if (this->shutting_down) break;
+            }
+        }
+
+        CSVReader reader;
+        std::thread reader_thread;
+
+        std::mutex lock;
+        std::condition_variable space_available;
+        std::deque<CSVRow> ready;
+        std::coroutine_handle<> waiter = nullptr;
+        std::exception_ptr reader_error = nullptr;
+        bool done = false;
+        bool shutting_down = false;
+    };
+}
+#endif
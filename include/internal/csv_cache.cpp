@@ -0,0 +1,195 @@
+/** @file
+ *  Defines a binary columnar cache that eliminates parsing cost on
+ *  repeat reads of the same CSV file
+ */
+
+#include <cstring> // For std::memcmp()
+#include <fstream>
+#include <limits>
+
+#include <sys/stat.h> // For is_fresh()
+
+#include "csv_cache.hpp"
+
+namespace csv {
+    namespace internals {
+        /** Magic bytes identifying a columnar cache sidecar file */
+        static const char CACHE_MAGIC[8] = { 'C', 'S', 'V', 'C', 'C', 'H', '0', '2' };
+
+        /** Retrieve a source file's size and mtime for freshness checks */
+        static bool stat_source(csv::string_view filename,
+            unsigned long long& size, unsigned long long& mtime) {
+            struct stat st;
+            if (stat(std::string(filename).c_str(), &st) != 0) {
+                return false;
+            }
+
+            size = (unsigned long long)st.st_size;
+            mtime = (unsigned long long)st.st_mtime;
+            return true;
+        }
+    }
+
+    CSV_INLINE CSVCache CSVCache::build(csv::string_view filename, CSVFormat format) {
+        CSVCache cache;
+        if (!internals::stat_source(filename, cache.source_size, cache.source_mtime)) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        CSVReader reader(filename, format);
+        // Caches hold retained reference data, where interning repeated
+        // values pays off both in memory and in sidecar size
+        reader.set_dictionary_encoding(true);
+        reader.read_batch(cache.batch, std::numeric_limits<size_t>::max());
+        return cache;
+    }
+
+    CSV_INLINE void CSVCache::save(csv::string_view cache_path) const {
+        std::ofstream out(cache_path.data(), std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(cache_path));
+        }
+
+        auto write_u64 = [&out](unsigned long long value) {
+            out.write((const char*)&value, sizeof(value));
+        };
+
+        out.write(internals::CACHE_MAGIC, sizeof(internals::CACHE_MAGIC));
+        write_u64(this->source_size);
+        write_u64(this->source_mtime);
+        write_u64((unsigned long long)this->batch.n_rows);
+
+        write_u64((unsigned long long)this->batch.col_names.size());
+        for (auto& name : this->batch.col_names) {
+            write_u64((unsigned long long)name.size());
+            out.write(name.data(), name.size());
+        }
+
+        for (auto& col : this->batch.columns) {
+            out.put((char)col.type);
+
+            switch (col.type) {
+            case CSV_INT64:
+                out.write((const char*)col.ints.data(),
+                    col.ints.size() * sizeof(long long));
+                break;
+            case CSV_DOUBLE:
+                out.write((const char*)col.doubles.data(),
+                    col.doubles.size() * sizeof(double));
+                break;
+            default:
+                write_u64((unsigned long long)col.chars.size());
+                out.write(col.chars.data(), col.chars.size());
+                write_u64((unsigned long long)col.offsets.size());
+                out.write((const char*)col.offsets.data(),
+                    col.offsets.size() * sizeof(size_t));
+                write_u64((unsigned long long)col.codes.size());
+                out.write((const char*)col.codes.data(),
+                    col.codes.size() * sizeof(int));
+                break;
+            }
+        }
+    }
+
+    CSV_INLINE CSVCache CSVCache::load(csv::string_view cache_path) {
+        std::ifstream in(cache_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(cache_path));
+        }
+
+        auto read_u64 = [&in]() {
+            unsigned long long value = 0;
+            in.read((char*)&value, sizeof(value));
+            return value;
+        };
+
+        char magic[sizeof(internals::CACHE_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::CACHE_MAGIC, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a CSV cache file " + std::string(cache_path));
+        }
+
+        CSVCache cache;
+        cache.source_size = read_u64();
+        cache.source_mtime = read_u64();
+        cache.batch.n_rows = (size_t)read_u64();
+
+        const size_t n_names = (size_t)read_u64();
+        for (size_t i = 0; i < n_names; i++) {
+            std::string name((size_t)read_u64(), '\0');
+            in.read(&name[0], name.size());
+            cache.batch.col_names.push_back(std::move(name));
+        }
+
+        // Each column is at most three bulk reads straight into its arrays
+        cache.batch.columns.resize(n_names);
+        for (auto& col : cache.batch.columns) {
+            col.type = (DataType)in.get();
+
+            switch (col.type) {
+            case CSV_INT64:
+                col.ints.resize(cache.batch.n_rows);
+                in.read((char*)col.ints.data(),
+                    col.ints.size() * sizeof(long long));
+                break;
+            case CSV_DOUBLE:
+                col.doubles.resize(cache.batch.n_rows);
+                in.read((char*)col.doubles.data(),
+                    col.doubles.size() * sizeof(double));
+                break;
+            default:
+                col.chars.resize((size_t)read_u64());
+                in.read(&col.chars[0], col.chars.size());
+                col.offsets.resize((size_t)read_u64());
+                in.read((char*)col.offsets.data(),
+                    col.offsets.size() * sizeof(size_t));
+                col.codes.resize((size_t)read_u64());
+                in.read((char*)col.codes.data(),
+                    col.codes.size() * sizeof(int));
+                break;
+            }
+        }
+
+        if (!in) {
+            throw std::runtime_error("Truncated CSV cache file " + std::string(cache_path));
+        }
+
+        return cache;
+    }
+
+    CSV_INLINE bool CSVCache::is_fresh(csv::string_view filename, csv::string_view cache_path) {
+        unsigned long long size = 0, mtime = 0;
+        if (!internals::stat_source(filename, size, mtime)) {
+            return false;
+        }
+
+        std::ifstream in(cache_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+
+        char magic[sizeof(internals::CACHE_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::CACHE_MAGIC, sizeof(magic)) != 0) {
+            return false;
+        }
+
+        unsigned long long stored_size = 0, stored_mtime = 0;
+        in.read((char*)&stored_size, sizeof(stored_size));
+        in.read((char*)&stored_mtime, sizeof(stored_mtime));
+
+        return in && stored_size == size && stored_mtime == mtime;
+    }
+
+    CSV_INLINE CSVCache CSVCache::open(csv::string_view filename, CSVFormat format) {
+        const auto cache_path = default_cache_path(filename);
+
+        if (is_fresh(filename, cache_path)) {
+            return load(cache_path);
+        }
+
+        auto cache = build(filename, format);
+        cache.save(cache_path);
+        return cache;
+    }
+}
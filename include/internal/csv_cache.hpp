@@ -0,0 +1,76 @@
+/** @file
+ *  Defines a binary columnar cache that eliminates parsing cost on
+ *  repeat reads of the same CSV file
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "compatibility.hpp"
+#include "constants.hpp"
+#include "csv_format.hpp"
+#include "csv_reader.hpp"
+
+namespace csv {
+    /** A parsed, column-oriented snapshot of a CSV file that can be saved
+     *  to a versioned binary sidecar and reloaded without re-parsing.
+     *
+     *  The cache stores the file's ColumnBatch representation: column
+     *  names, per-column types from data_type(), contiguous numeric value
+     *  arrays, and string arenas with offset tables. Loading a sidecar is
+     *  a handful of bulk reads straight into those arrays — no tokenizing,
+     *  quoting, or type inference — so repeat reads cost I/O only.
+     *
+     *  Sidecars record the source file's size and modification time;
+     *  open() transparently rebuilds the cache when the source changes.
+     */
+    class CSVCache {
+    public:
+        CSVCache() = default;
+
+        /** The sidecar path used by open() for a given CSV file */
+        static std::string default_cache_path(csv::string_view filename) {
+            return std::string(filename) + ".csvcache";
+        }
+
+        /** Parse filename in full and build its columnar snapshot
+         *
+         *  @param[in] filename Path to CSV file
+         *  @param[in] format   Format of the CSV file
+         */
+        static CSVCache build(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv());
+
+        /** Load a previously saved cache from a sidecar file */
+        static CSVCache load(csv::string_view cache_path);
+
+        /** Save this cache to a binary sidecar file */
+        void save(csv::string_view cache_path) const;
+
+        /** Returns true if cache_path exists and was built from the
+         *  current size and modification time of filename
+         */
+        static bool is_fresh(csv::string_view filename, csv::string_view cache_path);
+
+        /** Retrieve the columnar snapshot of filename, loading its sidecar
+         *  when fresh and rebuilding (and re-saving) it otherwise
+         */
+        static CSVCache open(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv());
+
+        /** The cached columnar data */
+        const ColumnBatch& data() const { return this->batch; }
+
+        /** Number of data rows in the cached file */
+        RowCount num_rows() const { return (RowCount)this->batch.n_rows; }
+
+        /** Column names of the cached file */
+        std::vector<std::string> get_col_names() const { return this->batch.col_names; }
+
+    private:
+        ColumnBatch batch;                    /**< The cached columns */
+        unsigned long long source_size = 0;   /**< Source file size at build time */
+        unsigned long long source_mtime = 0;  /**< Source mtime at build time */
+    };
+}
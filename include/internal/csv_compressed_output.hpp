@@ -0,0 +1,232 @@
+/** @file
+ *  A compressing file sink for DelimWriter
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstring> // For strlen()
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "csv_reader.hpp"
+
+#ifdef CSV_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef CSV_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace csv {
+    /** A file sink which compresses CSV output as it is written,
+     *  for use as the output stream of a DelimWriter
+     *
+     *  Each chunk handed over by the writer — a whole number of rows, since
+     *  DelimWriter's buffer always ends on a row boundary — is compressed
+     *  into one independent gzip member or zstd frame on a background
+     *  thread, pipelining row formatting with compression. Because every
+     *  frame is self-contained, flush() establishes a point at which the
+     *  file so far decompresses to complete rows, so tailing consumers
+     *  never see a torn record.
+     *
+     *  @par Example
+     *  @code
+     *  csv::CompressedOutput out("rows.csv.gz");
+     *  auto writer = csv::make_csv_writer(out);
+     *  @endcode
+     *
+     *  @note Requires building with zlib (gzip) or zstd support,
+     *        like CSVReader's transparent decompression.
+     */
+    class CompressedOutput {
+    public:
+        /** Open a compressed file sink, deducing the codec from the
+         *  filename: `.gz` selects gzip and `.zst` selects zstd
+         */
+        CompressedOutput(const std::string& filename)
+            : CompressedOutput(filename, deduce_codec(filename)) {};
+
+        /** Open a compressed file sink with an explicit codec */
+        CompressedOutput(const std::string& filename, Compression _codec)
+            : codec(_codec) {
+#ifndef CSV_HAS_ZLIB
+            if (this->codec == Compression::GZIP)
+                throw std::runtime_error(
+                    "This library was built without zlib support.");
+#endif
+#ifndef CSV_HAS_ZSTD
+            if (this->codec == Compression::ZSTD)
+                throw std::runtime_error(
+                    "This library was built without zstd support.");
+#endif
+            if (this->codec == Compression::NONE)
+                throw std::runtime_error(
+                    "CompressedOutput requires a compression codec");
+
+            this->out.open(filename, std::ios::binary);
+            if (!this->out.is_open())
+                throw std::runtime_error("Cannot open file " + filename);
+
+            this->worker = std::thread(&CompressedOutput::worker_main, this);
+        }
+
+        /** Drain pending frames and close the file */
+        ~CompressedOutput() {
+            {
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->shutting_down = true;
+            }
+
+            this->frame_ready.notify_all();
+            this->worker.join();
+        }
+
+        /** Enqueue one chunk of formatted rows as a compression frame.
+         *  Called by DelimWriter whenever its buffer fills; blocks only
+         *  when compression has fallen MAX_PENDING_FRAMES behind.
+         */
+        void write(const char* data, std::streamsize n) {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->frame_done.wait(guard, [this] {
+                return this->frames.size() < MAX_PENDING_FRAMES || this->worker_error;
+            });
+
+            if (this->worker_error)
+                std::rethrow_exception(this->worker_error);
+
+            this->frames.push_back(std::string(data, (size_t)n));
+            this->frame_ready.notify_all();
+        }
+
+        /** Wait for every pending frame to be compressed and written,
+         *  then flush the underlying file. The output up to this point
+         *  decompresses to complete rows.
+         */
+        void flush() {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->frame_done.wait(guard, [this] {
+                return (this->frames.empty() && !this->busy) || this->worker_error;
+            });
+
+            if (this->worker_error)
+                std::rethrow_exception(this->worker_error);
+
+            this->out.flush();
+        }
+
+    private:
+        /** Upper bound on frames formatted but not yet compressed */
+        static const size_t MAX_PENDING_FRAMES = 8;
+
+        static Compression deduce_codec(const std::string& filename) {
+            auto ends_with = [&filename](const char* suffix) {
+                const size_t len = std::strlen(suffix);
+                return filename.size() >= len
+                    && filename.compare(filename.size() - len, len, suffix) == 0;
+            };
+
+            if (ends_with(".gz")) return Compression::GZIP;
+            if (ends_with(".zst")) return Compression::ZSTD;
+
+            throw std::runtime_error(
+                "Cannot deduce compression codec from filename " + filename);
+        }
+
+        /** Compress one chunk into a self-contained gzip member or
+         *  zstd frame
+         */
+        std::string compress_frame(const std::string& raw) {
+            std::string frame;
+
+            if (this->codec == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+                z_stream stream = {};
+
+                // windowBits of 15 + 16 selects the gzip wrapper
+                if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                    15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                    throw std::runtime_error("Could not initialize gzip compressor");
+
+                frame.resize((size_t)deflateBound(&stream, (uLong)raw.size()));
+                stream.next_in = (Bytef*)raw.data();
+                stream.avail_in = (uInt)raw.size();
+                stream.next_out = (Bytef*)&frame[0];
+                stream.avail_out = (uInt)frame.size();
+
+                int ret = deflate(&stream, Z_FINISH);
+                frame.resize(frame.size() - (size_t)stream.avail_out);
+                deflateEnd(&stream);
+
+                if (ret != Z_STREAM_END)
+                    throw std::runtime_error("gzip compression failed");
+#endif
+            }
+            else {
+#ifdef CSV_HAS_ZSTD
+                frame.resize(ZSTD_compressBound(raw.size()));
+                size_t n = ZSTD_compress(&frame[0], frame.size(),
+                    raw.data(), raw.size(), ZSTD_CLEVEL_DEFAULT);
+
+                if (ZSTD_isError(n))
+                    throw std::runtime_error("zstd compression failed");
+
+                frame.resize(n);
+#endif
+            }
+
+            return frame;
+        }
+
+        void worker_main() {
+            std::unique_lock<std::mutex> guard(this->lock);
+
+            while (true) {
+                this->frame_ready.wait(guard, [this] {
+                    return !this->frames.empty() || this->shutting_down;
+                });
+
+                if (this->frames.empty()) return;
+
+                std::string raw = std::move(this->frames.front());
+                this->frames.pop_front();
+                this->busy = true;
+
+                // Compress and write without holding the lock; flush()
+                // never touches the file while a frame is in flight
+                guard.unlock();
+
+                try {
+                    std::string frame = this->compress_frame(raw);
+                    this->out.write(frame.data(), (std::streamsize)frame.size());
+
+                    guard.lock();
+                }
+                catch (...) {
+                    guard.lock();
+                    this->worker_error = std::current_exception();
+                    this->frames.clear();
+                }
+
+                this->busy = false;
+                this->frame_done.notify_all();
+            }
+        }
+
+        Compression codec;
+        std::ofstream out;
+        std::thread worker;
+
+        std::mutex lock;
+        std::condition_variable frame_ready; /**< Signals a queued frame */
+        std::condition_variable frame_done;  /**< Signals compression progress */
+        std::deque<std::string> frames;      /**< Chunks awaiting compression */
+        bool busy = false;                   /**< A frame is being compressed */
+        bool shutting_down = false;
+        std::exception_ptr worker_error;
+    };
+}
@@ -23,6 +23,11 @@ namespace csv {
     struct CSVGuessResult {
         char delim;
         int header_row;
+
+        /** True if the sampled data contains no quote characters at all,
+         *  making it eligible for the quote-free parsing fast lane
+         */
+        bool no_quote = false;
     };
 
     /** Stores information about how to parse a CSV file.
@@ -95,6 +100,31 @@ namespace csv {
             return *this;
         }
 
+        /** Sets how many worker threads the parser may split chunks of
+         *  input across (default 1, i.e. single-threaded parsing)
+         */
+        CONSTEXPR CSVFormat& threads(int n) {
+            this->n_threads = n > 0 ? n : 1;
+            return *this;
+        }
+
+        /** Parse only the named columns, skipping over all others at parse
+         *  time: unselected fields are never copied into the row buffer and
+         *  never receive split entries, so memory traffic shrinks with the
+         *  projection ratio.
+         *
+         *  @note Columns are returned in file order, not selection order
+         *  @note Parsing in-memory sources requires column_names() to also
+         *        be set, since the selection cannot be resolved otherwise
+         *
+         *  @throws `std::runtime_error` thrown by CSVReader if a selected
+         *          column does not exist
+         */
+        CSVFormat& select(const std::vector<std::string>& cols) {
+            this->selected_cols = cols;
+            return *this;
+        }
+
         #ifndef DOXYGEN_SHOULD_SKIP_THIS
         char get_delim() const {
             // This error should never be received by end users.
@@ -110,7 +140,9 @@ namespace csv {
         CONSTEXPR int get_header() const { return this->header; }
         std::vector<char> get_possible_delims() const { return this->possible_delimiters; }
         std::vector<char> get_trim_chars() const { return this->trim_chars; }
+        std::vector<std::string> get_selected_cols() const { return this->selected_cols; }
         CONSTEXPR VariableColumnPolicy get_variable_column_policy() const { return this->variable_column_policy; }
+        CONSTEXPR int get_n_threads() const { return this->n_threads; }
         #endif
         
         /** CSVFormat for guessing the delimiter */
@@ -152,9 +184,15 @@ namespace csv {
         /**< Should be left empty unless file doesn't include header */
         std::vector<std::string> col_names = {};
 
+        /**< Columns to materialize when parsing (empty = all of them) */
+        std::vector<std::string> selected_cols = {};
+
         /**< Allow variable length columns? */
         VariableColumnPolicy variable_column_policy = VariableColumnPolicy::IGNORE_ROW;
 
+        /**< Maximum number of parse worker threads */
+        int n_threads = 1;
+
         /**< Detect and strip out Unicode byte order marks */
         bool unicode_detect = true;
     };
@@ -0,0 +1,311 @@
+/** @file
+ *  Defines a persistent row-offset index enabling fast random access
+ *  into large CSV files
+ */
+
+#include <cstring> // For std::memcmp()
+#include <deque>
+#include <fstream>
+
+#include "csv_index.hpp"
+#include "csv_reader.hpp"
+
+namespace csv {
+    namespace internals {
+        /** Magic bytes identifying an index sidecar file */
+        static const char INDEX_MAGIC[8] = { 'C', 'S', 'V', 'I', 'D', 'X', '0', '1' };
+    }
+
+    CSV_INLINE CSVIndex CSVIndex::build(csv::string_view filename, CSVFormat format, size_t stride) {
+        using internals::ParseFlags;
+
+        CSVIndex index;
+        index.stride = stride > 0 ? stride : DEFAULT_STRIDE;
+
+        /** Guess delimiter and header row */
+        if (format.guess_delim()) {
+            auto guess_result = guess_format(filename, format.get_possible_delims());
+            format.delimiter(guess_result.delim).header_row(guess_result.header_row);
+        }
+
+        index.delim = format.get_delim();
+        index.quote = format.get_quote_char();
+        index.no_quote = !format.is_quoting_enabled();
+        index.col_names = csv::get_col_names(filename, format);
+
+        auto parse_flags = index.no_quote
+            ? internals::make_parse_flags(index.delim)
+            : internals::make_parse_flags(index.delim, index.quote);
+
+        std::ifstream infile(filename.data(), std::ios::binary);
+        if (!infile.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        constexpr size_t BLOCK = 65536;
+        std::unique_ptr<char[]> block(new char[BLOCK]);
+
+        // Rows before (and including) the header are not data rows
+        const RowCount skip = (RowCount)format.get_header() + 1;
+
+        bool quote_escape = false;
+        bool at_row_start = true;     /*< Next byte begins a new row */
+        bool row_has_content = false; /*< Current row contains at least one byte */
+        RowCount rows_started = 0;    /*< Physical rows begun so far */
+        unsigned long long offset = 0;
+        unsigned long long row_start_offset = 0;
+        ParseFlags prev_flag = ParseFlags::NEWLINE;
+
+        // Checkpoints and n_rows must count rows identically, or get_row()'s
+        // numbering drifts: a checkpoint is recorded only once a row turns
+        // out to be a data row — past the header and non-blank — so blank
+        // physical lines never shift the mapping
+        auto count_data_row = [&]() {
+            if (rows_started - 1 - skip >= 0 && row_has_content) {
+                if (index.n_rows % (RowCount)index.stride == 0) {
+                    index.offsets.push_back(row_start_offset);
+                }
+
+                index.n_rows++;
+            }
+        };
+
+        size_t leftover = 0;
+        while (true) {
+            infile.read(block.get() + leftover, BLOCK - leftover);
+            const size_t len = leftover + (size_t)infile.gcount();
+            if (len == 0) break;
+
+            // Unless this is the final block, hold one byte back so the
+            // quote state machine always has its lookahead character
+            const bool last_block = infile.eof();
+            const size_t limit = last_block ? len : len - 1;
+
+            size_t i = 0;
+            for (; i < limit; i++) {
+                const char ch = block[i];
+
+                if (at_row_start) {
+                    row_start_offset = offset;
+                    rows_started++;
+                    at_row_start = false;
+                    row_has_content = false;
+                }
+
+                switch (parse_flags[ch + 128]) {
+                case ParseFlags::QUOTE:
+                    if (!quote_escape) {
+                        // Mirrors parse(): only a quote following a delimiter
+                        // or newline opens a quoted field
+                        if (prev_flag >= ParseFlags::DELIMITER) {
+                            quote_escape = true;
+                        }
+                    }
+                    else if (i + 1 < len) {
+                        auto next_ch = parse_flags[block[i + 1] + 128];
+                        if (next_ch >= ParseFlags::DELIMITER) {
+                            quote_escape = false;
+                        }
+                        else if (next_ch == ParseFlags::QUOTE) {
+                            i++; // Case: Two consecutive quotes
+                            offset++;
+                        }
+                    }
+                    else {
+                        // End of file closes the field
+                        quote_escape = false;
+                    }
+
+                    row_has_content = true;
+                    break;
+                case ParseFlags::NEWLINE:
+                    if (!quote_escape) {
+                        // End of record; catches CRLF (or LFLF) like parse()
+                        if (i + 1 < len && block[i + 1] == '\n') {
+                            i++;
+                            offset++;
+                        }
+
+                        // The current row's index is rows_started - 1
+                        count_data_row();
+
+                        at_row_start = true;
+                    }
+                    else {
+                        row_has_content = true;
+                    }
+
+                    break;
+                default:
+                    row_has_content = true;
+                    break;
+                }
+
+                prev_flag = parse_flags[block[i] + 128];
+                offset++;
+            }
+
+            // Carry the lookahead byte into the next block
+            leftover = len - i;
+            if (leftover > 0) block[0] = block[i];
+            if (last_block) break;
+        }
+
+        // A final row without a trailing newline still counts
+        if (!at_row_start) {
+            count_data_row();
+        }
+
+        return index;
+    }
+
+    CSV_INLINE void CSVIndex::save(csv::string_view index_path) const {
+        std::ofstream out(index_path.data(), std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(index_path));
+        }
+
+        auto write_u64 = [&out](unsigned long long value) {
+            out.write((const char*)&value, sizeof(value));
+        };
+
+        out.write(internals::INDEX_MAGIC, sizeof(internals::INDEX_MAGIC));
+        write_u64((unsigned long long)this->stride);
+        write_u64((unsigned long long)this->n_rows);
+        out.put(this->delim);
+        out.put(this->quote);
+        out.put(this->no_quote ? 1 : 0);
+
+        write_u64((unsigned long long)this->col_names.size());
+        for (auto& name : this->col_names) {
+            write_u64((unsigned long long)name.size());
+            out.write(name.data(), name.size());
+        }
+
+        write_u64((unsigned long long)this->offsets.size());
+        for (auto checkpoint : this->offsets) {
+            write_u64(checkpoint);
+        }
+    }
+
+    CSV_INLINE CSVIndex CSVIndex::load(csv::string_view index_path) {
+        std::ifstream in(index_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(index_path));
+        }
+
+        auto read_u64 = [&in]() {
+            unsigned long long value = 0;
+            in.read((char*)&value, sizeof(value));
+            return value;
+        };
+
+        char magic[sizeof(internals::INDEX_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::INDEX_MAGIC, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a CSV index file " + std::string(index_path));
+        }
+
+        CSVIndex index;
+        index.stride = (size_t)read_u64();
+        index.n_rows = (RowCount)read_u64();
+        index.delim = (char)in.get();
+        index.quote = (char)in.get();
+        index.no_quote = in.get() != 0;
+
+        const size_t n_names = (size_t)read_u64();
+        for (size_t i = 0; i < n_names; i++) {
+            std::string name((size_t)read_u64(), '\0');
+            in.read(&name[0], name.size());
+            index.col_names.push_back(std::move(name));
+        }
+
+        const size_t n_checkpoints = (size_t)read_u64();
+        for (size_t i = 0; i < n_checkpoints; i++) {
+            index.offsets.push_back(read_u64());
+        }
+
+        if (!in) {
+            throw std::runtime_error("Truncated CSV index file " + std::string(index_path));
+        }
+
+        return index;
+    }
+
+    CSV_INLINE CSVRow CSVIndex::get_row(csv::string_view filename, RowCount n) const {
+        if (n < 0 || n >= this->n_rows) {
+            throw std::runtime_error("Row index out of bounds.");
+        }
+
+        const size_t checkpoint = (size_t)(n / (RowCount)this->stride);
+        const size_t to_skip = (size_t)(n % (RowCount)this->stride);
+
+        std::ifstream infile(filename.data(), std::ios::binary);
+        if (!infile.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        infile.seekg((std::streamoff)this->offsets[checkpoint]);
+
+        // Resume parsing from the checkpoint: by construction, checkpoints
+        // are row boundaries outside of any quoted field
+        auto parse_flags = this->no_quote
+            ? internals::make_parse_flags(this->delim)
+            : internals::make_parse_flags(this->delim, this->quote);
+        auto ws_flags = internals::make_ws_flags({}, 0);
+
+        auto col_names_ptr = std::make_shared<internals::ColNames>(this->col_names);
+        auto buffer = internals::BufferPtr(new internals::RawRowBuffer(col_names_ptr));
+
+        bool quote_escape = false;
+        internals::RecordRing rows;
+
+        constexpr size_t BLOCK = 65536;
+        std::unique_ptr<char[]> block(new char[BLOCK]);
+
+        // Blank physical lines parse into zero-field records, but build()
+        // excludes them from the index's numbering; skip them here the
+        // same way so row n means the same row in both
+        auto is_blank = [](const CSVRow& row) {
+            return row.size() == 0;
+        };
+
+        auto content_rows = [&rows, &is_blank]() {
+            size_t n = 0;
+            for (size_t i = 0; i < rows.size(); i++) {
+                if (!is_blank(rows[i])) n++;
+            }
+
+            return n;
+        };
+
+        while (content_rows() <= to_skip && infile) {
+            infile.read(block.get(), BLOCK);
+            const size_t len = (size_t)infile.gcount();
+            if (len == 0) break;
+
+            buffer = internals::parse({
+                csv::string_view(block.get(), len),
+                parse_flags,
+                ws_flags,
+                buffer,
+                quote_escape,
+                rows
+            });
+        }
+
+        // Handle a final row without a trailing newline
+        if (content_rows() <= to_skip && buffer->size() > 0) {
+            rows.push_back(CSVRow(buffer));
+        }
+
+        size_t seen = 0;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (is_blank(rows[i])) continue;
+            if (seen == to_skip) return rows[i];
+            seen++;
+        }
+
+        throw std::runtime_error("Row index out of bounds.");
+    }
+}
@@ -0,0 +1,84 @@
+/** @file
+ *  Defines a persistent row-offset index enabling fast random access
+ *  into large CSV files
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "compatibility.hpp"
+#include "constants.hpp"
+#include "csv_format.hpp"
+#include "csv_row.hpp"
+
+namespace csv {
+    /** An index of the byte offsets where every k-th CSV row begins,
+     *  allowing row N of a large file to be retrieved without parsing
+     *  the N - 1 rows before it.
+     *
+     *  Indexes are built with one quote-aware pass over the file, can be
+     *  saved to a compact binary sidecar file, and loaded back in later
+     *  runs. Retrieval seeks to the nearest recorded checkpoint and
+     *  resumes parsing from there, so lookup cost is O(stride) rows
+     *  instead of O(N).
+     *
+     *  @note Rows are numbered over the physical rows following the header,
+     *        before any variable-column policy is applied. For files where
+     *        CSVReader drops short or long rows, numbering will differ from
+     *        CSVReader::num_rows.
+     */
+    class CSVIndex {
+    public:
+        /** Default number of rows between recorded checkpoints */
+        static constexpr size_t DEFAULT_STRIDE = 64;
+
+        CSVIndex() = default;
+
+        /** Build an index by scanning filename once with a quote-aware
+         *  state machine
+         *
+         *  @param[in] filename Path to CSV file
+         *  @param[in] format   Format of the CSV file
+         *  @param[in] stride   Record a checkpoint every stride rows
+         */
+        static CSVIndex build(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv(),
+            size_t stride = DEFAULT_STRIDE);
+
+        /** Load a previously saved index from a sidecar file */
+        static CSVIndex load(csv::string_view index_path);
+
+        /** Save this index to a binary sidecar file */
+        void save(csv::string_view index_path) const;
+
+        /** Retrieve the n-th row (zero-based, header excluded) of the
+         *  indexed file
+         *
+         *  @throws std::runtime_error If n is out of bounds
+         */
+        CSVRow get_row(csv::string_view filename, RowCount n) const;
+
+        /** Number of data rows in the indexed file */
+        RowCount num_rows() const { return this->n_rows; }
+
+        /** Number of checkpoints recorded */
+        size_t num_checkpoints() const { return this->offsets.size(); }
+
+        /** Column names of the indexed file */
+        std::vector<std::string> get_col_names() const { return this->col_names; }
+
+    private:
+        size_t stride = DEFAULT_STRIDE; /**< Rows between checkpoints */
+        RowCount n_rows = 0;            /**< Number of data rows */
+        char delim = ',';               /**< Delimiting character */
+        char quote = '"';               /**< Quote character */
+        bool no_quote = false;          /**< Whether quoting is disabled */
+
+        /** Column names, stored so retrieved rows support name lookup */
+        std::vector<std::string> col_names = {};
+
+        /** Byte offset of the first byte of every (stride * k)-th data row */
+        std::vector<unsigned long long> offsets = {};
+    };
+}
@@ -0,0 +1,43 @@
+/** @file
+ *  Explicit instantiations of the library's most commonly used templates
+ *
+ *  When built as a static library, the csv CMake target defines
+ *  CSV_EXTERN_TEMPLATES for itself and its consumers: clients then link
+ *  the definitions emitted here instead of re-instantiating these
+ *  templates in every translation unit, which noticeably shortens their
+ *  compiles. Single-header users never define the macro, so this file
+ *  contributes nothing to single_include/csv.hpp.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "csv_row.hpp"
+#include "csv_writer.hpp"
+
+#ifdef CSV_EXTERN_TEMPLATES
+namespace csv {
+    template short CSVField::get<short>();
+    template unsigned short CSVField::get<unsigned short>();
+    template int CSVField::get<int>();
+    template unsigned int CSVField::get<unsigned int>();
+    template long CSVField::get<long>();
+    template unsigned long CSVField::get<unsigned long>();
+    template unsigned long long CSVField::get<unsigned long long>();
+    template float CSVField::get<float>();
+
+    template DelimWriter<std::ofstream, ',', '"'>::DelimWriter(std::ofstream&);
+    template void DelimWriter<std::ofstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::ofstream, ',', '"'>::flush();
+
+    template DelimWriter<std::ofstream, '\t', '"'>::DelimWriter(std::ofstream&);
+    template void DelimWriter<std::ofstream, '\t', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::ofstream, '\t', '"'>::flush();
+
+    template DelimWriter<std::stringstream, ',', '"'>::DelimWriter(std::stringstream&);
+    template void DelimWriter<std::stringstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::stringstream, ',', '"'>::flush();
+}
+#endif
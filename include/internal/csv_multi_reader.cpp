@@ -0,0 +1,132 @@
+/** @file
+ *  Defines a multi-threaded reader which parses many CSV files at once
+ */
+
+#include <algorithm>
+
+#include "csv_multi_reader.hpp"
+
+namespace csv {
+    CSV_INLINE MultiReader::MultiReader(std::vector<std::string> _filenames,
+        CSVFormat _format, size_t _n_threads) :
+        filenames(std::move(_filenames)), format(std::move(_format)) {
+        size_t n_threads = _n_threads > 0
+            ? _n_threads
+            : (std::max)((size_t)1, (size_t)std::thread::hardware_concurrency());
+
+        // No point in more workers than files
+        n_threads = (std::min)(n_threads, this->filenames.size());
+        this->pool.reserve(n_threads);
+        this->active_workers = n_threads;
+    }
+
+    CSV_INLINE MultiReader::~MultiReader() {
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->shutting_down = true;
+        }
+
+        // Unblock workers waiting for queue space, then let them drain
+        this->space_available.notify_all();
+        for (auto& worker : this->pool) {
+            worker.join();
+        }
+    }
+
+    CSV_INLINE void MultiReader::start() {
+        if (this->started) return;
+        this->started = true;
+
+        for (size_t i = 0; i < this->pool.capacity(); i++) {
+            this->pool.push_back(std::thread(&MultiReader::worker_main, this));
+        }
+    }
+
+    CSV_INLINE void MultiReader::worker_main() {
+        while (true) {
+            // Claim the next unclaimed file; finished workers pull more
+            // work instead of idling, balancing skewed shard sizes
+            const size_t idx = this->next_file.fetch_add(1);
+            if (idx >= this->filenames.size()) break;
+
+            try {
+                CSVReader reader(this->filenames[idx], this->format);
+                std::vector<CSVRow> batch;
+                RowCount file_rows = 0;
+
+                while (true) {
+                    batch.clear();
+                    if (reader.read_rows(batch, WORKER_BATCH) == 0) break;
+                    file_rows += (RowCount)batch.size();
+
+                    std::unique_lock<std::mutex> guard(this->lock);
+                    this->space_available.wait(guard, [this] {
+                        return this->merged.size() < QUEUE_CAPACITY || this->shutting_down;
+                    });
+
+                    if (this->shutting_down) {
+                        guard.unlock();
+                        this->finish_worker();
+                        return;
+                    }
+
+                    for (auto& row : batch) {
+                        this->merged.push_back(std::move(row));
+                    }
+
+                    guard.unlock();
+                    this->rows_available.notify_one();
+                }
+
+                if (this->file_callback) {
+                    this->file_callback(this->filenames[idx], file_rows);
+                }
+
+                this->n_complete++;
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(this->lock);
+                if (!this->worker_error) {
+                    this->worker_error = std::current_exception();
+                }
+
+                break;
+            }
+        }
+
+        this->finish_worker();
+    }
+
+    CSV_INLINE void MultiReader::finish_worker() {
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->active_workers--;
+        }
+
+        this->rows_available.notify_all();
+    }
+
+    CSV_INLINE bool MultiReader::read_row(CSVRow& row) {
+        this->start();
+
+        std::unique_lock<std::mutex> guard(this->lock);
+        this->rows_available.wait(guard, [this] {
+            return !this->merged.empty() || this->active_workers == 0;
+        });
+
+        if (this->merged.empty()) {
+            if (this->worker_error) {
+                std::rethrow_exception(this->worker_error);
+            }
+
+            return false;
+        }
+
+        row = std::move(this->merged.front());
+        this->merged.pop_front();
+        guard.unlock();
+
+        this->space_available.notify_one();
+        return true;
+    }
+}
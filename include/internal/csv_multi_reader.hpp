@@ -0,0 +1,109 @@
+/** @file
+ *  Defines a multi-threaded reader which parses many CSV files at once
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "compatibility.hpp"
+#include "csv_format.hpp"
+#include "csv_reader.hpp"
+
+namespace csv {
+    /** Parses a set of shard files on a pool of worker threads, exposing
+     *  one merged row stream.
+     *
+     *  Workers claim whole files from a shared queue as they finish their
+     *  previous one, so skewed shard sizes balance automatically: a worker
+     *  that draws a small file simply claims the next, instead of idling
+     *  while a sibling grinds through a large one. Each worker runs the
+     *  ordinary CSVReader pipeline with its own buffers.
+     *
+     *  Rows from different files are interleaved in no particular order,
+     *  but rows from any single file arrive in file order. Per-file
+     *  completion can be observed with on_file_complete().
+     *
+     *  @par Example
+     *  @code
+     *  csv::MultiReader shards(filenames);
+     *  csv::CSVRow row;
+     *  while (shards.read_row(row)) process(row);
+     *  @endcode
+     */
+    class MultiReader {
+    public:
+        /** Prepare to read filenames on a pool of worker threads
+         *
+         *  @param[in] _filenames Paths of the CSV files to parse
+         *  @param[in] _format    Format shared by all files
+         *  @param[in] _n_threads Worker count; 0 uses the hardware concurrency
+         *
+         *  @note Workers start on the first read_row() call, so callbacks
+         *        may be registered after construction.
+         */
+        MultiReader(std::vector<std::string> _filenames,
+            CSVFormat _format = CSVFormat::guess_csv(),
+            size_t _n_threads = 0);
+
+        MultiReader(const MultiReader&) = delete;
+        MultiReader& operator=(const MultiReader&) = delete;
+        ~MultiReader();
+
+        /** Register a callback invoked (from a worker thread) after each
+         *  file has been fully parsed, with the filename and its row count
+         */
+        void on_file_complete(std::function<void(const std::string&, RowCount)> callback) {
+            this->file_callback = std::move(callback);
+        }
+
+        /** Retrieve the next row from the merged stream, blocking until one
+         *  is available or every file has been consumed
+         *
+         *  @return True if a row was retrieved, false upon end of input
+         *  @throws Any exception raised inside a worker's CSVReader
+         */
+        bool read_row(CSVRow& row);
+
+        /** Number of files fully parsed so far */
+        size_t files_completed() const { return this->n_complete.load(); }
+
+    private:
+        /** Rows a worker hands over per queue access */
+        static constexpr size_t WORKER_BATCH = 1024;
+
+        /** Merged rows held before workers are made to wait for the consumer */
+        static constexpr size_t QUEUE_CAPACITY = 65536;
+
+        void start();
+        void worker_main();
+        void finish_worker();
+
+        std::vector<std::string> filenames; /**< Work queue of shard files */
+        CSVFormat format;                   /**< Format shared by all files */
+
+        /** Per-file completion callback, if any */
+        std::function<void(const std::string&, RowCount)> file_callback;
+
+        std::atomic<size_t> next_file = { 0 };  /**< Next unclaimed file */
+        std::atomic<size_t> n_complete = { 0 }; /**< Files fully parsed */
+
+        std::deque<CSVRow> merged;     /**< Rows awaiting the consumer */
+        std::mutex lock;               /**< Guards merged and the fields below */
+        size_t active_workers = 0;     /**< Workers still producing rows */
+        bool shutting_down = false;    /**< Set by the destructor */
+        std::exception_ptr worker_error = nullptr; /**< First worker failure */
+
+        std::condition_variable rows_available;  /**< Signals the consumer */
+        std::condition_variable space_available; /**< Signals the workers */
+
+        std::vector<std::thread> pool; /**< The worker threads */
+        bool started = false;          /**< Whether the pool is running */
+    };
+}
@@ -3,14 +3,196 @@
  */
 
 #include <algorithm>
+#include <chrono>   // For worker wait metrics
 #include <cstdio>   // For read_csv()
-#include <cstring>  // For read_csv()
+#include <cstring>  // For validate_chunk()
 #include <fstream>
+#include <limits>        // For read_batch()
+#include <unordered_map> // For dictionary encoding
+#include <unordered_set>
 #include <sstream>
 
 #include "constants.hpp"
 #include "csv_reader.hpp"
 
+/** Latency tracing hooks (see CSVReaderTrace): each site expands to a
+ *  steady_clock read and a histogram record when CSV_TRACE is defined,
+ *  and to nothing at all otherwise, keeping the release hot path clean
+ */
+#ifdef CSV_TRACE
+#define CSV_TRACE_START(name) const auto name = std::chrono::steady_clock::now()
+#define CSV_TRACE_STOP(hist, name) (hist).record( \
+    (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>( \
+        std::chrono::steady_clock::now() - (name)).count())
+#else
+#define CSV_TRACE_START(name)
+#define CSV_TRACE_STOP(hist, name)
+#endif
+
+#if !defined(_WIN32) && (defined(__linux__) || defined(__APPLE__))
+#include <fcntl.h>    // For open_mmap()
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef CSV_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef CSV_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef CSV_HAS_IO_URING
+#include <cstring>    // For strerror()
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+
+namespace csv {
+    namespace internals {
+        /** Streams a file as a sequence of WorkItem-sized chunks while keeping
+         *  a fixed window of read requests in flight via io_uring, so the next
+         *  chunks are already being fetched while the current one is parsed.
+         *
+         *  Each of the QUEUE_DEPTH slots owns one chunk buffer and always has
+         *  a read outstanding against the next unclaimed file offset; chunks
+         *  are consumed strictly in file order, and completed buffers are
+         *  moved out whole so read_csv() can feed them to the parser without
+         *  an extra copy.
+         */
+        class UringReader {
+        public:
+            /** Structurally identical to CSVReader::WorkItem */
+            using WorkItem = std::pair<std::unique_ptr<char[]>, size_t>;
+
+            UringReader(csv::string_view filename) {
+                this->fd = ::open(filename.data(), O_RDONLY);
+                if (this->fd < 0)
+                    throw std::runtime_error("Cannot open file " + std::string(filename));
+
+                if (io_uring_queue_init(QUEUE_DEPTH, &this->ring, 0) < 0) {
+                    ::close(this->fd);
+                    throw std::runtime_error("Cannot initialize io_uring for file "
+                        + std::string(filename));
+                }
+
+                // Prime the window: one read per slot
+                for (size_t i = 0; i < QUEUE_DEPTH; i++)
+                    this->submit(i);
+            }
+
+            ~UringReader() {
+                // Reap any still-outstanding completions before tearing down
+                while (this->in_flight > 0) {
+                    struct io_uring_cqe* cqe;
+                    if (io_uring_wait_cqe(&this->ring, &cqe) < 0) break;
+
+                    io_uring_cqe_seen(&this->ring, cqe);
+                    this->in_flight--;
+                }
+
+                io_uring_queue_exit(&this->ring);
+                ::close(this->fd);
+            }
+
+            /** Block until the next chunk in file order has completed
+             *
+             *  @return The chunk's buffer and byte count, or a (nullptr, 0)
+             *          WorkItem once the end of the file is reached
+             */
+            WorkItem next_chunk() {
+                if (this->hit_eof)
+                    return std::make_pair<>(nullptr, 0);
+
+                // Drain completions until the in-order slot is ready; other
+                // slots finishing early are simply marked for later
+                const size_t slot = this->consume_index % QUEUE_DEPTH;
+                while (!this->slots[slot].ready) {
+                    struct io_uring_cqe* cqe;
+                    if (io_uring_wait_cqe(&this->ring, &cqe) < 0)
+                        throw std::runtime_error("io_uring wait failed");
+
+                    const size_t done = (size_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+                    this->slots[done].result = cqe->res;
+                    this->slots[done].ready = true;
+
+                    io_uring_cqe_seen(&this->ring, cqe);
+                    this->in_flight--;
+                }
+
+                auto& current = this->slots[slot];
+                current.ready = false;
+
+                if (current.result < 0)
+                    throw std::runtime_error("Asynchronous read failed: "
+                        + std::string(std::strerror(-current.result)));
+
+                const size_t n_read = (size_t)current.result;
+                if (n_read == 0) {
+                    this->hit_eof = true;
+                    return std::make_pair<>(nullptr, 0);
+                }
+
+                WorkItem chunk = std::make_pair<>(std::move(current.buffer), n_read);
+                this->consume_index++;
+
+                if (n_read < CHUNK_SIZE) {
+                    // Short read => the file ends inside this chunk; reads
+                    // already queued past it complete with 0 bytes and are
+                    // reaped by the destructor
+                    this->hit_eof = true;
+                }
+                else {
+                    this->submit(slot);
+                }
+
+                return chunk;
+            }
+
+            bool done() const { return this->hit_eof; }
+
+        private:
+            /** Reads kept in flight at once */
+            static constexpr size_t QUEUE_DEPTH = 4;
+
+            /** Matches the 1 MB WorkItem buffers used by read_csv() */
+            static constexpr size_t CHUNK_SIZE = 1000000;
+
+            struct Slot {
+                std::unique_ptr<char[]> buffer;
+                int result = 0;
+                bool ready = false;
+            };
+
+            /** Queue a read of the next unclaimed file offset into a slot */
+            void submit(size_t slot) {
+                if (!this->slots[slot].buffer)
+                    this->slots[slot].buffer = std::unique_ptr<char[]>(new char[CHUNK_SIZE]);
+
+                struct io_uring_sqe* sqe = io_uring_get_sqe(&this->ring);
+                io_uring_prep_read(sqe, this->fd, this->slots[slot].buffer.get(),
+                    (unsigned)CHUNK_SIZE, this->next_offset);
+                io_uring_sqe_set_data(sqe, (void*)(uintptr_t)slot);
+                io_uring_submit(&this->ring);
+
+                this->next_offset += CHUNK_SIZE;
+                this->in_flight++;
+            }
+
+            struct io_uring ring;
+            int fd = -1;
+            Slot slots[QUEUE_DEPTH];
+            size_t consume_index = 0;
+            size_t in_flight = 0;
+            unsigned long long next_offset = 0;
+            bool hit_eof = false;
+        };
+    }
+}
+#endif
+
 namespace csv {
     namespace internals {
         CSV_INLINE std::string format_row(const std::vector<std::string>& row, csv::string_view delim) {
@@ -41,7 +223,7 @@ namespace csv {
             auto buffer_ptr = internals::BufferPtr(new internals::RawRowBuffer());
             auto trim_chars = format.get_trim_chars();
 
-            std::deque<CSVRow> rows;
+            internals::RecordRing rows;
             bool quote_escape = false;
 
             internals::parse({
@@ -55,6 +237,67 @@ namespace csv {
 
             return rows[format.get_header()];
         }
+
+        CSV_INLINE Compression detect_compression(csv::string_view filename) {
+            std::ifstream file(filename.data(), std::ios::binary);
+            unsigned char magic[4] = { 0, 0, 0, 0 };
+            file.read((char*)magic, sizeof(magic));
+
+            if (magic[0] == 0x1F && magic[1] == 0x8B)
+                return Compression::GZIP;
+
+            if (magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+                return Compression::ZSTD;
+
+            return Compression::NONE;
+        }
+
+        CSV_INLINE std::string get_compressed_head(csv::string_view filename, Compression compression) {
+            const size_t bytes = 500000;
+            std::string head(bytes, '\0');
+            size_t total = 0;
+
+            if (compression == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+                gzFile file = gzopen(filename.data(), "rb");
+                if (!file)
+                    throw std::runtime_error("Cannot open file " + std::string(filename));
+
+                int n_read = gzread(file, &head[0], (unsigned)bytes);
+                gzclose(file);
+
+                if (n_read > 0) total = (size_t)n_read;
+#else
+                throw std::runtime_error("File " + std::string(filename) +
+                    " is gzip-compressed, but this library was built without zlib support.");
+#endif
+            }
+            else if (compression == Compression::ZSTD) {
+#ifdef CSV_HAS_ZSTD
+                std::ifstream file(filename.data(), std::ios::binary);
+                std::string raw((std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+
+                ZSTD_DStream* stream = ZSTD_createDStream();
+                ZSTD_inBuffer in_buf = { raw.data(), raw.size(), 0 };
+                ZSTD_outBuffer out_buf = { &head[0], bytes, 0 };
+
+                while (out_buf.pos < out_buf.size && in_buf.pos < in_buf.size) {
+                    size_t ret = ZSTD_decompressStream(stream, &out_buf, &in_buf);
+                    if (ZSTD_isError(ret) || ret == 0) break;
+                }
+
+                ZSTD_freeDStream(stream);
+                total = out_buf.pos;
+#else
+                throw std::runtime_error("File " + std::string(filename) +
+                    " is zstd-compressed, but this library was built without zstd support.");
+#endif
+            }
+
+            head.resize(total);
+            return head;
+        }
     }
 
     /** Return a CSV's column names
@@ -63,12 +306,39 @@ namespace csv {
      *  @param[in] format    Format of the CSV file
      *
      */
+    /** Render all four pipeline histograms as one JSON object keyed by
+     *  stage name, each with summary statistics and the raw bucket counts
+     */
+    CSV_INLINE std::string CSVReaderTrace::to_json() const {
+        auto histogram = [](const LatencyHistogram& hist) {
+            std::string ret = "{\"count\":" + std::to_string(hist.count)
+                + ",\"total_ns\":" + std::to_string(hist.total_ns)
+                + ",\"min_ns\":" + std::to_string(hist.min_ns)
+                + ",\"max_ns\":" + std::to_string(hist.max_ns)
+                + ",\"p50_ns\":" + std::to_string(hist.percentile_ns(0.5))
+                + ",\"p99_ns\":" + std::to_string(hist.percentile_ns(0.99))
+                + ",\"buckets\":[";
+
+            for (size_t i = 0; i < LatencyHistogram::N_BUCKETS; i++) {
+                if (i > 0) ret += ',';
+                ret += std::to_string(hist.buckets[i]);
+            }
+
+            return ret + "]}";
+        };
+
+        return "{\"read\":" + histogram(this->read)
+            + ",\"parse\":" + histogram(this->parse)
+            + ",\"queue_full\":" + histogram(this->queue_full)
+            + ",\"queue_empty\":" + histogram(this->queue_empty) + "}";
+    }
+
     CSV_INLINE std::vector<std::string> get_col_names(csv::string_view filename, CSVFormat format) {
         auto head = internals::get_csv_head(filename);
 
-        /** Guess delimiter and header row */
+        /** Guess delimiter and header row using the head we already read */
         if (format.guess_delim()) {
-            auto guess_result = guess_format(filename, format.get_possible_delims());
+            auto guess_result = internals::_guess_format(head, format.get_possible_delims());
             format.delimiter(guess_result.delim).header_row(guess_result.header_row);
         }
 
@@ -82,12 +352,21 @@ namespace csv {
     }
 
     /** Allows parsing in-memory sources (by calling feed() and end_feed()). */
-    CSV_INLINE CSVReader::CSVReader(CSVFormat format) : 
+    CSV_INLINE CSVReader::CSVReader(CSVFormat format) :
         unicode_bom_scan(!format.unicode_detect), feed_state(new ThreadedReadingState)  {
         if (!format.col_names.empty()) {
-            this->set_col_names(format.col_names);
+            if (!format.selected_cols.empty()) {
+                this->set_col_names(this->apply_projection(format.col_names, format.selected_cols));
+            }
+            else {
+                this->set_col_names(format.col_names);
+            }
         }
-        
+        else if (!format.selected_cols.empty()) {
+            throw std::runtime_error("Cannot select columns when parsing in-memory"
+                " sources without explicit column names.");
+        }
+
         this->set_parse_flags(format);
     }
 
@@ -105,25 +384,120 @@ namespace csv {
      *  \snippet tests/test_read_csv.cpp CSVField Example
      *
      */
-    CSV_INLINE CSVReader::CSVReader(csv::string_view filename, CSVFormat format) : feed_state(new ThreadedReadingState) {
-        auto head = internals::get_csv_head(filename);
+    CSV_INLINE CSVReader::CSVReader(csv::string_view filename, CSVFormat format, IOMode io_mode) :
+        feed_state(new ThreadedReadingState), io_mode(io_mode) {
+        this->compression = internals::detect_compression(filename);
+
+        auto head = this->compression == Compression::NONE
+            ? internals::get_csv_head(filename)
+            : internals::get_compressed_head(filename, this->compression);
 
         /** Guess delimiter and header row */
         if (format.guess_delim()) {
             auto guess_result = internals::_guess_format(head, format.possible_delimiters);
             format.delimiter(guess_result.delim);
             format.header = guess_result.header_row;
+
+            // Only trust quote-free detection when the sample covered the
+            // whole file (the head is capped at 500 KB by get_csv_head());
+            // a quoted field past the sampled head would otherwise mis-parse
+            if (guess_result.no_quote && head.size() < 500000)
+                format.quote(false);
         }
 
-        if (format.col_names.empty()) {
-            this->set_col_names(internals::_get_col_names(head, format));
+        auto full_names = format.col_names.empty()
+            ? internals::_get_col_names(head, format)
+            : format.col_names;
+
+        if (!format.selected_cols.empty()) {
+            this->set_col_names(this->apply_projection(full_names, format.selected_cols));
         }
         else {
-            this->set_col_names(format.col_names);
+            this->set_col_names(full_names);
         }
 
         this->set_parse_flags(format);
-        this->fopen(filename);
+
+        if (this->io_mode == IOMode::MMAP) {
+            this->open_mmap(filename);
+        }
+        else {
+            this->fopen(filename);
+        }
+    }
+
+    /** Point this reader at another file, resetting per-file state while
+     *  keeping every reusable structure warm
+     *
+     *  @see CSVReader::open() in csv_reader.hpp for usage notes
+     */
+    CSV_INLINE void CSVReader::open(csv::string_view filename, IOMode io_mode) {
+        // Note: an unresolved guessing format cannot reach this point; the
+        // in-memory constructor already rejects it, and the file constructor
+        // locks in its guess. this->format is always concrete here.
+        if (!this->format.selected_cols.empty() && this->format.col_names.empty())
+            throw std::runtime_error("Cannot reuse a reader that projects columns"
+                " resolved against one file's header; provide explicit column names.");
+
+        if (this->prefetch_thread.joinable())
+            this->prefetch_thread.join();
+
+        this->close();
+
+        // Per-file parser state. The parse and whitespace flag tables, the
+        // buffer pool, and the threading state all carry over untouched.
+        this->records.clear();
+        this->staging_records.clear();
+        this->use_staging = false;
+        this->quote_escape = false;
+        this->header_trimmed = false;
+        this->unicode_bom_scan = !this->format.unicode_detect;
+        this->utf8_bom = false;
+        this->num_rows = 0;
+        this->metrics_data = CSVReaderMetrics();
+        this->trace_data = CSVReaderTrace();
+        this->unicode_state = internals::UnicodeValidator();
+        this->feed_state->queued_bytes = 0;
+        this->feed_state->parsed_rows = 0;
+
+        this->compression = internals::detect_compression(filename);
+
+        // Column names fixed by the format survive across files; otherwise
+        // the new file's header row supplies them. Rows from previous files
+        // keep their own ColNames, so a fresh one is allocated rather than
+        // mutated underneath them.
+        if (this->format.col_names.empty()) {
+            this->col_names = std::make_shared<internals::ColNames>();
+
+            auto head = this->compression == Compression::NONE
+                ? internals::get_csv_head(filename)
+                : internals::get_compressed_head(filename, this->compression);
+
+            this->set_col_names(internals::_get_col_names(head, this->format));
+        }
+
+        this->record_buffer = this->buffer_pool.lease(this->col_names);
+
+        // A row filter's header bypass re-arms for the new file's header
+        if (this->row_filter.predicate)
+            this->row_filter.bypass_rows = (RowCount)this->format.header + 1;
+
+        // Per-file I/O state
+        this->mmap_pos = 0;
+        this->mmap_len = 0;
+        this->async_done = false;
+        this->decompress_done = false;
+        this->compressed_len = 0;
+        this->compressed_pos = 0;
+
+        this->io_mode = io_mode;
+
+        if (this->io_mode == IOMode::MMAP) {
+            this->open_mmap(filename);
+        }
+        else {
+            this->fopen(filename);
+        }
     }
 
     /** Return the format of the original raw CSV */
@@ -159,6 +533,24 @@ namespace csv {
         return CSV_NOT_FOUND;
     }
 
+    /** Resolve a column name to a reusable handle.
+     *
+     *  The hash lookup happens once, here; every subsequent
+     *  `row[handle]` access is a bounds-checked integer index. Use this
+     *  for loops that retrieve the same columns by name on every row.
+     *
+     *  @throws std::runtime_error If no such column exists
+     *  @see CSVRow::operator[](const ColumnHandle&)
+     */
+    CSV_INLINE ColumnHandle CSVReader::column(const std::string& col_name) const {
+        const int idx = this->col_names ? this->col_names->index_of(col_name) : CSV_NOT_FOUND;
+        if (idx == CSV_NOT_FOUND) {
+            throw std::runtime_error("Can't find a column named " + col_name);
+        }
+
+        return ColumnHandle((size_t)idx, col_name, this->col_names);
+    }
+
     CSV_INLINE void CSVReader::feed(WorkItem&& buff) {
         this->feed( csv::string_view(buff.first.get(), buff.second) );
     }
@@ -172,6 +564,9 @@ namespace csv {
      *  `end_feed()` should be called after the last string.
      */
     CSV_INLINE void CSVReader::feed(csv::string_view in) {
+        this->metrics_data.chunks_fed++;
+        this->metrics_data.bytes_parsed += in.size();
+
         /** Handle possible Unicode byte order mark */
         if (!this->unicode_bom_scan) {
             if (in[0] == '\xEF' && in[1] == '\xBB' && in[2] == '\xBF') {
@@ -182,26 +577,165 @@ namespace csv {
             this->unicode_bom_scan = true;
         }
 
+        /** Input may only be split across threads where the quote state at each
+         *  candidate boundary is known. Rather than guess, only engage the parallel
+         *  path when the chunk provably contains no quoted fields; everything else
+         *  takes the serial path below.
+         */
+        const size_t n_threads = (size_t)this->format.get_n_threads();
+        const bool parallelizable = n_threads > 1
+            && !this->quote_escape
+            && !this->row_filter.predicate // Filters are evaluated serially
+            && in.size() >= 2 * internals::PARALLEL_SLICE_MIN
+            && (!this->format.is_quoting_enabled()
+                || in.find(this->format.get_quote_char()) == csv::string_view::npos);
+
+        if (parallelizable) {
+            this->feed_parallel(in, n_threads);
+        }
+        else {
+            this->parse_chunk(in);
+        }
+
+        if (!this->header_trimmed) {
+            auto& sink = this->use_staging ? this->staging_records : this->records;
+            for (int i = 0; i <= this->format.header && !sink.empty(); i++) {
+                if (i == this->format.header && this->col_names->empty()) {
+                    this->set_col_names(sink.front());
+                }
+
+                sink.pop_front();
+            }
+
+            this->header_trimmed = true;
+        }
+    }
+
+    /** Parse one chunk of input into records using the runtime-dispatched parser */
+    CSV_INLINE void CSVReader::parse_chunk(csv::string_view in) {
+        // Quote-free formats without trimming, projection, or filtering take
+        // the two-symbol fast lane, which skips quote tracking entirely
+        if (this->format.no_quote && this->format.trim_chars.empty()
+            && this->projection.mask.empty() && !this->row_filter.predicate) {
+            this->record_buffer = internals::parse_no_quote({
+                in,
+                this->parse_flags,
+                this->ws_flags,
+                this->record_buffer,
+                this->quote_escape,
+                this->use_staging ? this->staging_records : this->records
+            }, &this->buffer_pool, &this->metrics_data.peak_buffer_bytes);
+
+            return;
+        }
+
         this->record_buffer = internals::parse({
             in,
             this->parse_flags,
             this->ws_flags,
             this->record_buffer,
             this->quote_escape,
-            this->records
-        });
+            this->use_staging ? this->staging_records : this->records
+        }, &this->buffer_pool,
+            this->projection.mask.empty() ? nullptr : &this->projection,
+            this->row_filter.predicate ? &this->row_filter : nullptr,
+            &this->metrics_data.peak_buffer_bytes);
+    }
 
-        if (!this->header_trimmed) {
-            for (int i = 0; i <= this->format.header && !this->records.empty(); i++) {
-                if (i == this->format.header && this->col_names->empty()) {
-                    this->set_col_names(this->records.front());
-                }
+    /** Keep only rows matching the given predicate
+     *
+     *  @see CSVReader::set_row_filter
+     */
+    CSV_INLINE void CSVReader::set_row_filter(
+        std::function<bool(const std::vector<csv::string_view>&)> predicate) {
+        this->row_filter.predicate = std::move(predicate);
 
-                this->records.pop_front();
-            }
+        // The header row (and anything before it) is never filtered
+        this->row_filter.bypass_rows = this->header_trimmed
+            ? 0 : (RowCount)this->format.header + 1;
+    }
 
-            this->header_trimmed = true;
+    /** Parse one chunk of input on multiple threads
+     *
+     *  Slices are aligned on newline boundaries, so every row except possibly
+     *  the last one of the final slice is wholly contained in one slice. Each
+     *  worker parses into a private RawRowBuffer and row queue; results are
+     *  merged into CSVReader::records in their original order.
+     *
+     *  @pre The chunk contains no quoted fields and the parser is not
+     *       currently inside one (see CSVReader::feed())
+     */
+    CSV_INLINE void CSVReader::feed_parallel(csv::string_view in, size_t n_threads) {
+        // Don't create more slices than can pull their own weight
+        n_threads = std::min(n_threads, in.size() / internals::PARALLEL_SLICE_MIN);
+
+        // Find newline-aligned slice boundaries
+        std::vector<size_t> bounds = { 0 };
+        for (size_t k = 1; k < n_threads; k++) {
+            size_t target = (in.size() * k) / n_threads;
+            if (target < bounds.back()) continue;
+
+            size_t newline_pos = in.find('\n', target);
+            if (newline_pos == csv::string_view::npos) break;
+
+            // Slices begin just after a newline
+            if (newline_pos + 1 < in.size() && newline_pos + 1 > bounds.back())
+                bounds.push_back(newline_pos + 1);
+        }
+
+        bounds.push_back(in.size());
+        const size_t n_slices = bounds.size() - 1;
+
+        // Per-slice parser state: the first slice continues the row left
+        // unfinished by the previous chunk
+        std::vector<internals::BufferPtr> buffers = { this->record_buffer };
+        for (size_t k = 1; k < n_slices; k++)
+            buffers.push_back(internals::BufferPtr(new internals::RawRowBuffer(this->col_names)));
+
+        std::vector<internals::RecordRing> slice_records(n_slices);
+        std::vector<internals::BufferPtr> leftovers(n_slices);
+        std::unique_ptr<bool[]> slice_escapes(new bool[n_slices]());
+
+        // Later slices start on fresh rows; the first continues the row (and
+        // projection position) left unfinished by the previous chunk
+        const bool project = !this->projection.mask.empty();
+        std::vector<internals::ProjectionState> slice_projections;
+        if (project) {
+            slice_projections.resize(n_slices);
+            for (auto& state : slice_projections)
+                state.mask = this->projection.mask;
+
+            slice_projections.front() = this->projection;
         }
+
+        std::vector<std::thread> pool;
+        for (size_t k = 0; k < n_slices; k++) {
+            pool.push_back(std::thread([&, k] {
+                leftovers[k] = internals::parse({
+                    in.substr(bounds[k], bounds[k + 1] - bounds[k]),
+                    this->parse_flags,
+                    this->ws_flags,
+                    buffers[k],
+                    slice_escapes[k],
+                    slice_records[k]
+                }, nullptr, project ? &slice_projections[k] : nullptr);
+            }));
+        }
+
+        for (auto& worker : pool)
+            worker.join();
+
+        // Merge rows in order; only the final slice may leave a row in progress
+        auto& sink = this->use_staging ? this->staging_records : this->records;
+        for (auto& slice : slice_records)
+            for (auto& row : slice)
+                sink.push_back(std::move(row));
+
+        this->record_buffer = leftovers.back();
+        this->quote_escape = slice_escapes[n_slices - 1];
+
+        if (project)
+            this->projection = slice_projections.back();
     }
 
     CSV_INLINE void CSVReader::end_feed() {
@@ -209,7 +743,21 @@ namespace csv {
          *  and handle the last row
          */
         if (this->record_buffer->size() > 0) {
-            this->records.push_back(CSVRow(this->record_buffer));
+            bool keep = true;
+            if (this->row_filter.predicate) {
+                if (this->row_filter.bypass_rows > 0) {
+                    this->row_filter.bypass_rows--;
+                }
+                else {
+                    this->record_buffer->get_current_row(this->row_filter.scratch);
+                    keep = this->row_filter.predicate(this->row_filter.scratch);
+                }
+            }
+
+            if (keep) {
+                auto& sink = this->use_staging ? this->staging_records : this->records;
+                sink.push_back(CSVRow(this->record_buffer));
+            }
         }
     }
 
@@ -218,19 +766,32 @@ namespace csv {
      */
     CSV_INLINE void CSVReader::read_csv_worker() {
         while (true) {
-            std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock }; // Get lock
-            this->feed_state->feed_cond.wait(lock,                            // Wait
-                [this] { return !(this->feed_state->feed_buffer.empty()); });
+            WorkItem in;
+            if (!this->feed_state->feed_buffer.try_pop(in)) { // Queue empty
+                const auto wait_start = std::chrono::steady_clock::now();
+                while (!this->feed_state->feed_buffer.try_pop(in))
+                    std::this_thread::yield();
 
-            // Wake-up
-            auto in = std::move(this->feed_state->feed_buffer.front());
-            this->feed_state->feed_buffer.pop_front();
+                std::chrono::duration<double> waited =
+                    std::chrono::steady_clock::now() - wait_start;
+                this->metrics_data.worker_wait_sec += waited.count();
+
+                CSV_TRACE_STOP(this->trace_data.queue_empty, wait_start);
+            }
 
             // Nullptr --> Die
             if (!in.first) break;
 
-            lock.unlock();      // Release lock
-            this->feed(std::move(in));
+            CSV_TRACE_START(parse_start);
+            this->feed(csv::string_view(in.first.get(), in.second));
+            CSV_TRACE_STOP(this->trace_data.parse, parse_start);
+
+            this->feed_state->queued_bytes -= in.second;
+            this->feed_state->parsed_rows.store((this->use_staging ? this->staging_records : this->records).size());
+
+            // Hand the consumed chunk buffer back to the reader thread for
+            // reuse; if the return lane is full, the buffer is simply freed
+            this->feed_state->recycle_buffer.try_push(std::move(in));
         }
     }
 
@@ -248,6 +809,25 @@ namespace csv {
     }
 
     CSV_INLINE void CSVReader::fopen(csv::string_view filename) {
+        // Decompression is pull-based, so compressed input always takes the
+        // portable stdio path, as do builds without liburing
+        if (this->io_mode == IOMode::ASYNC) {
+#ifdef CSV_HAS_IO_URING
+            if (this->compression == Compression::NONE) {
+                this->async_ctx = (void*)new internals::UringReader(filename);
+                return;
+            }
+#endif
+            this->io_mode = IOMode::STDIO;
+        }
+
+        // Compressed files are decompressed on the fly by read_chunk();
+        // gzip streams are handled entirely by zlib's gzFile interface
+        if (this->compression == Compression::GZIP) {
+            this->init_decompression(filename);
+            return;
+        }
+
         if (!this->infile) {
 #ifdef _MSC_BUILD
             // Silence compiler warnings in Microsoft Visual C++
@@ -260,6 +840,159 @@ namespace csv {
                 throw std::runtime_error("Cannot open file " + std::string(filename));
 #endif
         }
+
+        if (this->compression == Compression::ZSTD)
+            this->init_decompression(filename);
+    }
+
+    /** Open the decompression stream matching this->compression
+     *
+     *  @throws std::runtime_error if the required codec was not compiled in
+     */
+    CSV_INLINE void CSVReader::init_decompression(csv::string_view filename) {
+        if (this->compression == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+            gzFile file = gzopen(filename.data(), "rb");
+            if (!file)
+                throw std::runtime_error("Cannot open file " + std::string(filename));
+
+            // Larger internal buffer than zlib's 8 KB default
+            gzbuffer(file, 131072);
+            this->decompress_ctx = (void*)file;
+#else
+            throw std::runtime_error("File " + std::string(filename) +
+                " is gzip-compressed, but this library was built without zlib support.");
+#endif
+        }
+        else if (this->compression == Compression::ZSTD) {
+#ifdef CSV_HAS_ZSTD
+            this->decompress_ctx = (void*)ZSTD_createDStream();
+            this->compressed_buffer = std::unique_ptr<char[]>(
+                new char[internals::COMPRESSED_CHUNK_SIZE]);
+#else
+            throw std::runtime_error("File " + std::string(filename) +
+                " is zstd-compressed, but this library was built without zstd support.");
+#endif
+        }
+    }
+
+    /** Read up to n bytes of plaintext into `out`, stream-decompressing
+     *  compressed input as necessary
+     */
+    CSV_INLINE size_t CSVReader::read_chunk(char* out, size_t n) {
+        switch (this->compression) {
+#ifdef CSV_HAS_ZLIB
+        case Compression::GZIP: {
+            int n_read = gzread((gzFile)this->decompress_ctx, out, (unsigned)n);
+            if (n_read <= 0 || gzeof((gzFile)this->decompress_ctx))
+                this->decompress_done = true;
+
+            return n_read > 0 ? (size_t)n_read : 0;
+        }
+#endif
+#ifdef CSV_HAS_ZSTD
+        case Compression::ZSTD: {
+            auto* stream = (ZSTD_DStream*)this->decompress_ctx;
+            ZSTD_outBuffer out_buf = { out, n, 0 };
+
+            while (out_buf.pos < out_buf.size) {
+                if (this->compressed_pos >= this->compressed_len) {
+                    this->compressed_len = std::fread(this->compressed_buffer.get(), 1,
+                        internals::COMPRESSED_CHUNK_SIZE, this->infile);
+                    this->compressed_pos = 0;
+
+                    if (this->compressed_len == 0) break; // Raw input exhausted
+                }
+
+                ZSTD_inBuffer in_buf = {
+                    this->compressed_buffer.get() + this->compressed_pos,
+                    this->compressed_len - this->compressed_pos, 0
+                };
+
+                size_t ret = ZSTD_decompressStream(stream, &out_buf, &in_buf);
+                this->compressed_pos += in_buf.pos;
+
+                if (ZSTD_isError(ret))
+                    throw std::runtime_error("Corrupt zstd stream: " +
+                        std::string(ZSTD_getErrorName(ret)));
+            }
+
+            if (out_buf.pos == 0)
+                this->decompress_done = true;
+
+            return out_buf.pos;
+        }
+#endif
+        default:
+            return std::fread(out, 1, n, this->infile);
+        }
+    }
+
+    /** Map a file into memory so parse() can run directly over its contents,
+     *  avoiding the WorkItem copies made by read_csv().
+     *
+     *  On platforms without memory mapping this quietly falls back to fopen().
+     */
+    CSV_INLINE void CSVReader::open_mmap(csv::string_view filename) {
+        // A mapping of compressed bytes is useless to the parser
+        if (this->compression != Compression::NONE) {
+            this->io_mode = IOMode::STDIO;
+            this->fopen(filename);
+            return;
+        }
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filename.data(), GENERIC_READ, FILE_SHARE_READ,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        this->mmap_len = (size_t)file_size.QuadPart;
+
+        if (this->mmap_len > 0) {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping) {
+                this->mmap_base = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping); // View keeps the mapping alive
+            }
+
+            if (!this->mmap_base) {
+                CloseHandle(file);
+                throw std::runtime_error("Cannot memory map file " + std::string(filename));
+            }
+        }
+
+        CloseHandle(file);
+#elif defined(__linux__) || defined(__APPLE__)
+        // Qualified so the POSIX open(2) wins over CSVReader::open()
+        int fd = ::open(filename.data(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+
+        struct stat file_stat = {};
+        fstat(fd, &file_stat);
+        this->mmap_len = (size_t)file_stat.st_size;
+
+        if (this->mmap_len > 0) {
+            void* map = mmap(nullptr, this->mmap_len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot memory map file " + std::string(filename));
+            }
+
+            // The parser only ever moves forward
+            madvise(map, this->mmap_len, MADV_SEQUENTIAL);
+            this->mmap_base = (const char*)map;
+        }
+
+        ::close(fd);
+#else
+        // No memory mapping facilities: use buffered reads instead
+        this->io_mode = IOMode::STDIO;
+        this->fopen(filename);
+#endif
     }
 
     /**
@@ -271,6 +1004,33 @@ namespace csv {
         this->n_cols = names.size();
     }
 
+    /** Resolve a column selection against the full column set
+     *
+     *  @return The selected column names in file order
+     *  @throws std::runtime_error if a selected column does not exist
+     */
+    CSV_INLINE std::vector<std::string> CSVReader::apply_projection(
+        const std::vector<std::string>& full_names,
+        const std::vector<std::string>& selected)
+    {
+        for (auto& name : selected) {
+            if (std::find(full_names.begin(), full_names.end(), name) == full_names.end())
+                throw std::runtime_error("Selected column \"" + name + "\" not found.");
+        }
+
+        this->projection.mask.assign(full_names.size(), false);
+
+        std::vector<std::string> projected;
+        for (size_t i = 0; i < full_names.size(); i++) {
+            if (std::find(selected.begin(), selected.end(), full_names[i]) != selected.end()) {
+                this->projection.mask[i] = true;
+                projected.push_back(full_names[i]);
+            }
+        }
+
+        return projected;
+    }
+
     /**
      * Parse a CSV file using multiple threads
      *
@@ -280,45 +1040,230 @@ namespace csv {
      * @see CSVReader::read_row()
      */
     CSV_INLINE void CSVReader::read_csv(const size_t& bytes) {
+        if (this->io_mode == IOMode::MMAP) {
+            this->read_csv_mmap(bytes);
+            return;
+        }
+
         const size_t BUFFER_UPPER_LIMIT = std::min(bytes, (size_t)1000000);
-        std::unique_ptr<char[]> buffer(new char[BUFFER_UPPER_LIMIT]);
-        auto * HEDLEY_RESTRICT line_buffer = buffer.get();
-        line_buffer[0] = '\0';
 
+        // Chunk buffers are only recycled at the fixed 1 MB size, so a buffer
+        // allocated by an earlier call can never be smaller than expected
+        const bool reuse_chunks = BUFFER_UPPER_LIMIT == (size_t)1000000;
+        auto acquire_buffer = [&]() -> std::unique_ptr<char[]> {
+            WorkItem recycled;
+            if (reuse_chunks && this->feed_state->recycle_buffer.try_pop(recycled)) {
+                return std::move(recycled.first);
+            }
+
+            return std::unique_ptr<char[]>(new char[BUFFER_UPPER_LIMIT]);
+        };
+
+        this->feed_state->parsed_rows.store((this->use_staging ? this->staging_records : this->records).size());
+
+        std::string unicode_error;
         std::thread worker(&CSVReader::read_csv_worker, this);
 
+        // Each chunk is read straight into a WorkItem buffer in one fread()
+        // call; parse() handles chunks that end mid-row (or mid-quote) by
+        // carrying quote_escape state and the partial row between feeds
         for (size_t processed = 0; processed < bytes; ) {
-            char * HEDLEY_RESTRICT result = std::fgets(line_buffer, internals::PAGE_SIZE, this->infile);
-            if (result == NULL) break;
-            line_buffer += std::strlen(line_buffer);
-            size_t current_strlen = line_buffer - buffer.get();
+            // Backpressure: once the row cap is hit, stop reading and let
+            // the caller drain records before the next parsing round
+            if (this->max_buffered_rows > 0
+                && this->feed_state->parsed_rows.load() >= this->max_buffered_rows)
+                break;
+
+            std::unique_ptr<char[]> buffer;
+            size_t n_read = 0;
+
+            CSV_TRACE_START(read_start);
 
-            if (current_strlen >= 0.9 * BUFFER_UPPER_LIMIT) {
-                processed += (line_buffer - buffer.get());
-                std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock };
+#ifdef CSV_HAS_IO_URING
+            if (this->async_ctx) {
+                // The next chunk was already in flight while the previous
+                // ones were being parsed; its buffer is fed to the worker
+                // directly instead of being copied into a fresh WorkItem
+                WorkItem chunk = static_cast<internals::UringReader*>(this->async_ctx)->next_chunk();
+                buffer = std::move(chunk.first);
+                n_read = chunk.second;
+                this->async_done = static_cast<internals::UringReader*>(this->async_ctx)->done();
+            }
+            else
+#endif
+            {
+                buffer = acquire_buffer();
+                const size_t target = std::min(BUFFER_UPPER_LIMIT, bytes - processed);
+                n_read = this->read_chunk(buffer.get(), target);
+            }
 
-                this->feed_state->feed_buffer.push_back(std::make_pair<>(std::move(buffer), current_strlen));
+            CSV_TRACE_STOP(this->trace_data.read, read_start);
 
-                buffer = std::unique_ptr<char[]>(new char[BUFFER_UPPER_LIMIT]); // New pointer
-                line_buffer = buffer.get();
-                line_buffer[0] = '\0';
+            if (n_read == 0) break;
 
-                this->feed_state->feed_cond.notify_one();
+            processed += n_read;
+            this->metrics_data.bytes_read += n_read;
+
+            if (this->unicode_policy != UnicodePolicy::NONE
+                && !this->validate_chunk(buffer, n_read, BUFFER_UPPER_LIMIT, unicode_error))
+                break; // Shut the worker down cleanly before throwing
+
+            // A chunk can validate to zero bytes, e.g. it held only a byte
+            // order mark, or UTF-16 output was queued by validate_chunk()
+            if (n_read == 0) continue;
+
+            this->feed_state->queued_bytes += n_read;
+
+            WorkItem item = std::make_pair<>(std::move(buffer), n_read);
+            if (!this->feed_state->feed_buffer.try_push(std::move(item))) { // Queue full
+                CSV_TRACE_START(stall_start);
+
+                while (!this->feed_state->feed_buffer.try_push(std::move(item)))
+                    std::this_thread::yield();
+
+                CSV_TRACE_STOP(this->trace_data.queue_full, stall_start);
             }
         }
 
-        // Feed remaining bits
-        std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock };
-        this->feed_state->feed_buffer.push_back(std::make_pair<>(std::move(buffer), line_buffer - buffer.get()));
-        this->feed_state->feed_buffer.push_back(std::make_pair<>(nullptr, 0)); // Termination signal
-        this->feed_state->feed_cond.notify_one();
-        lock.unlock();
+        WorkItem poison = std::make_pair<>(nullptr, 0); // Termination signal
+        while (!this->feed_state->feed_buffer.try_push(std::move(poison)))
+            std::this_thread::yield();
+
         worker.join();
 
-        if (std::feof(this->infile)) {
+        if (!unicode_error.empty()) {
+            this->close();
+            throw std::runtime_error(unicode_error);
+        }
+
+        const bool exhausted = this->async_ctx
+            ? this->async_done
+            : (this->compression == Compression::NONE
+                ? std::feof(this->infile) != 0
+                : this->decompress_done);
+
+        if (exhausted) {
+            // In follow mode, EOF on a plain file only means the producer
+            // has not appended yet: clear the EOF latch so the next round's
+            // fread() sees new bytes, and keep the parser's partial state
+            // (quote_escape and any incomplete trailing line) untouched
+            if (this->follow_mode && this->infile && !this->async_ctx
+                && this->compression == Compression::NONE) {
+                std::clearerr(this->infile);
+                return;
+            }
+
             this->end_feed();
             this->close();
+
+            if (this->unicode_policy == UnicodePolicy::THROW
+                && (this->unicode_state.partial_len > 0
+                    || this->unicode_state.has_odd_byte
+                    || this->unicode_state.pending_high > 0))
+                throw std::runtime_error("Input ended in the middle of a Unicode sequence.");
+        }
+    }
+
+    /**
+     * Parse the next chunk of a memory-mapped file in place, i.e. without
+     * copying bytes into intermediate WorkItem buffers
+     *
+     * @pre CSVReader::mmap_base points to a valid mapping, i.e. CSVReader::open_mmap was called
+     *
+     * @param[in] bytes Number of bytes to parse.
+     * @see CSVReader::read_csv()
+     */
+    CSV_INLINE void CSVReader::read_csv_mmap(const size_t& bytes) {
+        const size_t remaining = this->mmap_len - this->mmap_pos;
+        const size_t to_parse = std::min(bytes, remaining);
+
+        this->feed(csv::string_view(this->mmap_base + this->mmap_pos, to_parse));
+        this->mmap_pos += to_parse;
+
+        if (this->mmap_pos >= this->mmap_len) {
+            this->end_feed();
+            this->close();
+        }
+    }
+
+    /**
+     * Validate or transcode one freshly read chunk before it is queued
+     * for parsing
+     *
+     * The first chunk is sniffed for a UTF-16 byte order mark; UTF-16
+     * input is transcoded into UTF-8 and queued here (possibly as several
+     * WorkItems, since transcoding can grow the byte count past one chunk),
+     * in which case n_read is set to zero and the caller queues nothing.
+     * UTF-8 input is validated in place and queued by the caller as usual.
+     *
+     * @return false when the policy is UnicodePolicy::THROW and the chunk
+     *         is malformed, with `error` describing the problem
+     */
+    CSV_INLINE bool CSVReader::validate_chunk(std::unique_ptr<char[]>& buffer,
+        size_t& n_read, size_t buffer_size, std::string& error)
+    {
+        using Encoding = internals::UnicodeValidator::Encoding;
+        const bool replace = this->unicode_policy == UnicodePolicy::REPLACE;
+        auto& state = this->unicode_state;
+        size_t offset = 0;
+
+        if (state.encoding == Encoding::UNKNOWN) {
+            auto* bytes = (unsigned char*)buffer.get();
+
+            if (n_read >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+                state.encoding = Encoding::UTF16_LE;
+                offset = 2;
+            }
+            else if (n_read >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF) {
+                state.encoding = Encoding::UTF16_BE;
+                offset = 2;
+            }
+            else {
+                // A UTF-8 byte order mark, if any, is stripped by feed()
+                state.encoding = Encoding::UTF8;
+            }
+        }
+
+        if (state.encoding == Encoding::UTF8) {
+            const size_t bad = internals::validate_utf8_chunk(
+                state, buffer.get(), n_read, replace);
+
+            if (bad != csv::string_view::npos) {
+                error = "Malformed UTF-8 at byte offset "
+                    + std::to_string(this->metrics_data.bytes_read - n_read + bad);
+                return false;
+            }
+
+            return true;
+        }
+
+        std::string transcoded;
+        if (!internals::transcode_utf16_chunk(state,
+            buffer.get() + offset, n_read - offset, transcoded, replace)) {
+            error = "Malformed UTF-16 input (unpaired surrogate).";
+            return false;
+        }
+
+        // Transcoding can outgrow the original chunk, so its output is
+        // re-cut into buffer-sized pieces: every queued buffer must be the
+        // standard chunk size for recycling to stay safe
+        for (size_t pos = 0; pos < transcoded.size(); ) {
+            const size_t piece = std::min(buffer_size, transcoded.size() - pos);
+            auto piece_buf = buffer
+                ? std::move(buffer)
+                : std::unique_ptr<char[]>(new char[buffer_size]);
+
+            std::memcpy(piece_buf.get(), transcoded.data() + pos, piece);
+            pos += piece;
+
+            this->feed_state->queued_bytes += piece;
+            WorkItem item = std::make_pair<>(std::move(piece_buf), piece);
+            while (!this->feed_state->feed_buffer.try_push(std::move(item)))
+                std::this_thread::yield();
         }
+
+        n_read = 0;
+        return true;
     }
 
     /** Close the open file handle.
@@ -330,6 +1275,36 @@ namespace csv {
             std::fclose(this->infile);
             this->infile = nullptr;
         }
+
+        if (this->decompress_ctx) {
+#if defined(CSV_HAS_ZLIB)
+            if (this->compression == Compression::GZIP)
+                gzclose((gzFile)this->decompress_ctx);
+#endif
+#if defined(CSV_HAS_ZSTD)
+            if (this->compression == Compression::ZSTD)
+                ZSTD_freeDStream((ZSTD_DStream*)this->decompress_ctx);
+#endif
+            this->decompress_ctx = nullptr;
+            this->decompress_done = true;
+        }
+
+        if (this->mmap_base) {
+#if defined(_WIN32)
+            UnmapViewOfFile((LPCVOID)this->mmap_base);
+#elif defined(__linux__) || defined(__APPLE__)
+            munmap((void*)this->mmap_base, this->mmap_len);
+#endif
+            this->mmap_base = nullptr;
+        }
+
+#ifdef CSV_HAS_IO_URING
+        if (this->async_ctx) {
+            delete static_cast<internals::UringReader*>(this->async_ctx);
+            this->async_ctx = nullptr;
+            this->async_done = true;
+        }
+#endif
     }
 
     /**
@@ -346,19 +1321,51 @@ namespace csv {
      * \snippet tests/test_read_csv.cpp CSVField Example
      *
      */
-    CSV_INLINE bool CSVReader::read_row(CSVRow &row) {
-        if (this->records.empty()) {
-            if (!this->eof()) {
-                // TODO/Suggestion: Make this call non-blocking, 
-                // i.e. move to it another thread
-                this->read_csv(internals::ITERATION_CHUNK_SIZE);
+    CSV_INLINE void CSVReader::fill_records() {
+        if (!this->prefetch_enabled) {
+            if (this->records.empty() && !this->eof()) {
+                this->read_csv(this->iteration_chunk_size);
             }
-            else return false; // Stop reading
+
+            return;
+        }
+
+        // Ran dry: wait for the in-flight chunk and take its rows
+        if (this->records.empty() && this->prefetch_thread.joinable()) {
+            this->prefetch_thread.join();
+            this->use_staging = false;
+            std::swap(this->records, this->staging_records);
+            this->staging_records.clear();
+        }
+
+        // Cold start: nothing has been prefetched yet
+        if (this->records.empty() && !this->eof()) {
+            this->read_csv(this->iteration_chunk_size);
         }
 
+        /** Start refilling in the background before rows run out. While the
+         *  prefetch is in flight it owns staging_records and all file state
+         *  exclusively; this thread only drains records, and eof() is never
+         *  consulted until the prefetch has been joined.
+         */
+        if (!this->prefetch_thread.joinable()
+            && this->records.size() <= this->prefetch_low_water
+            && !this->records.empty()
+            && !this->eof()) {
+            this->use_staging = true;
+            this->prefetch_thread = std::thread([this] {
+                this->read_csv(this->iteration_chunk_size);
+            });
+        }
+    }
+
+    CSV_INLINE bool CSVReader::read_row(CSVRow &row) {
+        this->fill_records();
+        if (this->records.empty())
+            return false; // Stop reading
+
         while (!this->records.empty()) {
-            if (this->records.front().size() != this->n_cols &&
-                this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
+            if (this->records.front().size() != this->n_cols) {
                 if (this->format.variable_column_policy == VariableColumnPolicy::THROW) {
                     if (this->records.front().size() < this->n_cols) {
                         throw std::runtime_error("Line too short " + internals::format_row(this->records.front()));
@@ -367,17 +1374,305 @@ namespace csv {
                     throw std::runtime_error("Line too long " + internals::format_row(this->records.front()));
                 }
 
-                // Silently drop row (default)
-                this->records.pop_front();
+                if (this->bad_row_handler)
+                    this->bad_row_handler(this->records.front());
+
+                if (this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
+                    // Silently drop row (default)
+                    this->metrics_data.rows_dropped++;
+                    this->records.pop_front();
+                    continue;
+                }
             }
-            else {
-                row = std::move(this->records.front());
-                this->num_rows++;
+
+            row = std::move(this->records.front());
+            this->num_rows++;
+            this->records.pop_front();
+            return true;
+        }
+
+        return false;
+    }
+
+    /** Attempt one parsing round over newly appended bytes
+     *
+     *  @see CSVReader::set_follow
+     *  @return Whether at least one complete row is buffered
+     */
+    CSV_INLINE bool CSVReader::poll() {
+        this->fill_records();
+        return !this->records.empty();
+    }
+
+    /**
+     * Sample buffered rows and record a per-column expected DataType.
+     *
+     * After sampling, fields from columns whose type was consistent across
+     * the sample can skip full type inference, making typed extraction
+     * of homogeneous columns considerably faster. The hint is only an
+     * expectation: fields that do not match it still infer their actual
+     * type, so results never change, only speed.
+     *
+     * Null fields are ignored during sampling, and columns mixing numeric
+     * widths receive the widest observed numeric type. Columns mixing
+     * strings and numbers receive no hint.
+     *
+     * @param[in] sample_size Maximum number of rows to examine
+     */
+    CSV_INLINE void CSVReader::sample_types(size_t sample_size) {
+        if (this->records.empty() && !this->eof()) {
+            this->read_csv(this->iteration_chunk_size);
+        }
+
+        const size_t _n_cols = this->col_names->size();
+        std::vector<DataType> hints(_n_cols, UNKNOWN);
+        std::vector<bool> conflicted(_n_cols, false);
+
+        size_t sampled = 0;
+        for (auto& row : this->records) {
+            if (sampled++ >= sample_size) break;
+            if (row.size() != _n_cols) continue;
+
+            for (size_t i = 0; i < _n_cols; i++) {
+                auto type = internals::data_type(row.get_string_view(i));
+                if (type == CSV_NULL) continue;
+
+                if (hints[i] == UNKNOWN) {
+                    hints[i] = type;
+                }
+                else if (hints[i] != type) {
+                    // Differing numeric widths widen; anything else conflicts
+                    if (hints[i] >= CSV_INT8 && type >= CSV_INT8)
+                        hints[i] = std::max(hints[i], type);
+                    else
+                        conflicted[i] = true;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < _n_cols; i++) {
+            if (conflicted[i]) hints[i] = UNKNOWN;
+        }
+
+        this->col_names->set_type_hints(hints);
+    }
+
+    /**
+     * Retrieve up to n rows at once, appending them to out.
+     *
+     * Batching amortizes the per-call bookkeeping of read_row() over many rows,
+     * which helps tight ETL loops that process rows in cache-friendly blocks.
+     * Rows are subject to the same variable column policy as read_row().
+     *
+     * @param[out] out Vector the parsed rows are appended to
+     * @param[in]  n   Maximum number of rows to transfer
+     *
+     * @return Number of rows appended; 0 indicates end of file
+     * @see CSVReader::read_row()
+     */
+    CSV_INLINE size_t CSVReader::read_rows(std::vector<CSVRow>& out, size_t n) {
+        size_t transferred = 0;
+
+        // Callers may pass a huge n meaning "until EOF"; growth past the
+        // initial guess is handled by push_back as usual
+        out.reserve(out.size() + (std::min)(n, (size_t)65536));
+
+        while (transferred < n) {
+            if (this->records.empty()) {
+                this->fill_records();
+
+                // Nothing left to parse
+                if (this->records.empty()) break;
+            }
+
+            // Drain the queue in one go
+            while (transferred < n && !this->records.empty()) {
+                bool keep = true;
+
+                if (this->records.front().size() != this->n_cols) {
+                    if (this->format.variable_column_policy == VariableColumnPolicy::THROW) {
+                        if (this->records.front().size() < this->n_cols) {
+                            throw std::runtime_error("Line too short " + internals::format_row(this->records.front()));
+                        }
+
+                        throw std::runtime_error("Line too long " + internals::format_row(this->records.front()));
+                    }
+
+                    if (this->bad_row_handler)
+                        this->bad_row_handler(this->records.front());
+
+                    if (this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
+                        // Silently drop row (default)
+                        this->metrics_data.rows_dropped++;
+                        keep = false;
+                    }
+                }
+
+                if (keep) {
+                    out.push_back(std::move(this->records.front()));
+                    this->num_rows++;
+                    transferred++;
+                }
+
                 this->records.pop_front();
-                return true;
             }
         }
-    
-        return false;
+
+        return transferred;
+    }
+
+    namespace internals {
+        /** Retrieve one field for batching, treating columns missing from
+         *  a short row (VariableColumnPolicy::KEEP) as empty/null
+         */
+        static csv::string_view batch_field(const CSVRow& row, size_t col) {
+            return col < row.size() ? row.get_string_view(col) : csv::string_view("");
+        }
+
+        /** Cheap cardinality heuristic deciding whether a string column is
+         *  worth dictionary encoding: sample up to 1024 values and encode
+         *  if at most 256 distinct values cover no more than a quarter of
+         *  the sample
+         */
+        static bool dict_worthwhile(const std::vector<CSVRow>& rows, size_t col) {
+            constexpr size_t SAMPLE = 1024;
+            constexpr size_t MAX_DISTINCT = 256;
+
+            const size_t n = (std::min)(rows.size(), SAMPLE);
+            std::unordered_set<std::string> distinct;
+
+            for (size_t i = 0; i < n; i++) {
+                distinct.insert(std::string(batch_field(rows[i], col)));
+                if (distinct.size() > MAX_DISTINCT) return false;
+            }
+
+            return distinct.size() * 4 <= n;
+        }
+    }
+
+    /**
+     * Retrieve up to n rows transposed into per-column contiguous arrays.
+     *
+     * Analytics consumers that aggregate column-wise would otherwise
+     * transpose CSVRows themselves, chasing the shared row buffer once per
+     * field. This converts each field exactly once and lays the results out
+     * cache-linearly; see ColumnBatch for the storage and type promotion
+     * rules. The batch is cleared and rebuilt on every call, so its vectors'
+     * capacity is recycled across calls.
+     *
+     * Rows are subject to the same variable column policy as read_row().
+     *
+     * @param[out] batch Receives the columnar data
+     * @param[in]  n     Maximum number of rows to transfer
+     *
+     * @return Number of rows batched; 0 indicates end of file
+     * @see CSVReader::read_rows()
+     */
+    CSV_INLINE size_t CSVReader::read_batch(ColumnBatch& batch, size_t n) {
+        std::vector<CSVRow> rows;
+        this->read_rows(rows, n);
+
+        batch.col_names = this->get_col_names();
+        batch.n_rows = rows.size();
+        batch.columns.resize(batch.col_names.size());
+
+        for (size_t i = 0; i < batch.columns.size(); i++) {
+            auto& col = batch.columns[i];
+            col.ints.clear();
+            col.doubles.clear();
+            col.chars.clear();
+            col.offsets.clear();
+            col.codes.clear();
+
+            // First pass: find the widest type this column needs
+            DataType widest = UNKNOWN;
+            for (auto& row : rows) {
+                switch (internals::data_type(internals::batch_field(row, i))) {
+                case CSV_STRING:
+                    widest = CSV_STRING;
+                    break;
+                case CSV_NULL:       // Empty fields become NaN
+                case CSV_DOUBLE:
+                    if (widest != CSV_STRING) widest = CSV_DOUBLE;
+                    break;
+                default:             // Some integer width
+                    if (widest == UNKNOWN) widest = CSV_INT64;
+                    break;
+                }
+            }
+
+            col.type = (widest == UNKNOWN) ? CSV_STRING : widest;
+
+            // Second pass: convert each field exactly once
+            switch (col.type) {
+            case CSV_INT64:
+                col.ints.reserve(rows.size());
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+
+                    // The fast parser rejects some inputs data_type()
+                    // accepts, e.g. whitespace padding, so a miss falls
+                    // back to the slow path's value rather than zero
+                    long long value = 0;
+                    if (!internals::fast_parse_int64(field, value)) {
+                        long double number = 0;
+                        internals::data_type(field, &number);
+                        value = (long long)number;
+                    }
+
+                    col.ints.push_back(value);
+                }
+                break;
+            case CSV_DOUBLE:
+                col.doubles.reserve(rows.size());
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+
+                    // Same fallback as above; empty fields keep their NaN
+                    double value = std::numeric_limits<double>::quiet_NaN();
+                    if (!internals::fast_parse_double(field, value)) {
+                        long double number = 0;
+                        if (internals::data_type(field, &number) != CSV_NULL)
+                            value = (double)number;
+                    }
+
+                    col.doubles.push_back(value);
+                }
+                break;
+            default:
+                if (this->dict_encoding && internals::dict_worthwhile(rows, i)) {
+                    // Store each distinct value once, plus a code per row
+                    std::unordered_map<std::string, int> dictionary;
+                    col.codes.reserve(rows.size());
+                    col.offsets.push_back(0);
+
+                    for (auto& row : rows) {
+                        auto field = internals::batch_field(row, i);
+                        auto entry = dictionary.emplace(
+                            std::string(field), (int)dictionary.size());
+
+                        if (entry.second) {
+                            col.chars.append(field.data(), field.size());
+                            col.offsets.push_back(col.chars.size());
+                        }
+
+                        col.codes.push_back(entry.first->second);
+                    }
+
+                    break;
+                }
+
+                col.offsets.reserve(rows.size() + 1);
+                col.offsets.push_back(0);
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+                    col.chars.append(field.data(), field.size());
+                    col.offsets.push_back(col.chars.size());
+                }
+                break;
+            }
+        }
+
+        return batch.n_rows;
     }
 }
\ No newline at end of file
@@ -4,12 +4,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <deque>
 #include <iterator>
 #include <memory>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <string>
 #include <vector>
 
@@ -23,11 +24,73 @@
 
 /** The all encompassing namespace */
 namespace csv {
+    /** Compression formats CSVReader can detect and stream-decompress */
+    enum class Compression {
+        NONE, /**< Plain uncompressed text */
+        GZIP, /**< RFC 1952 gzip (requires building with CSV_HAS_ZLIB) */
+        ZSTD  /**< Zstandard frames (requires building with CSV_HAS_ZSTD) */
+    };
+
     /** Stuff that is generally not of interest to end-users */
     namespace internals {
         std::string format_row(const std::vector<std::string>& row, csv::string_view delim = ", ");
 
+        /** Identify a file's compression format from its magic bytes */
+        Compression detect_compression(csv::string_view filename);
+
+        /** Decompress the first 500 KB of a compressed file, for format
+         *  guessing and column name retrieval (cf. get_csv_head())
+         */
+        std::string get_compressed_head(csv::string_view filename, Compression compression);
+
         std::vector<std::string> _get_col_names( csv::string_view head, const CSVFormat format = CSVFormat::guess_csv());
+
+        /** A fixed-capacity, lock-free single-producer/single-consumer queue
+         *
+         *  Items are handed from the reader thread to the parse worker with plain
+         *  atomic index bumps; neither side ever takes a mutex or waits on a
+         *  condition variable. Callers should retry (e.g. with
+         *  std::this_thread::yield()) when the queue is full or empty.
+         */
+        template<typename T, size_t Capacity = 32>
+        class SPSCQueue {
+        public:
+            static_assert((Capacity & (Capacity - 1)) == 0,
+                "Capacity should be a power of two.");
+
+            /** Append an item, returning false if the queue is full.
+             *  May only be called from the producer thread.
+             */
+            bool try_push(T&& item) {
+                const size_t current_tail = this->tail.load(std::memory_order_relaxed);
+                if (current_tail - this->head.load(std::memory_order_acquire) == Capacity) {
+                    return false;
+                }
+
+                this->ring[current_tail & (Capacity - 1)] = std::move(item);
+                this->tail.store(current_tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /** Remove the oldest item, returning false if the queue is empty.
+             *  May only be called from the consumer thread.
+             */
+            bool try_pop(T& item) {
+                const size_t current_head = this->head.load(std::memory_order_relaxed);
+                if (this->tail.load(std::memory_order_acquire) == current_head) {
+                    return false;
+                }
+
+                item = std::move(this->ring[current_head & (Capacity - 1)]);
+                this->head.store(current_head + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            std::array<T, Capacity> ring; /**< Preallocated storage for queued items */
+            std::atomic<size_t> head = { 0 }; /**< Index of the oldest item */
+            std::atomic<size_t> tail = { 0 }; /**< Index one past the newest item */
+        };
     }
 
     std::vector<std::string> get_col_names(
@@ -38,6 +101,166 @@ namespace csv {
     CSVGuessResult guess_format(csv::string_view filename,
         const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
 
+    /** Determines how CSVReader pulls bytes out of a file */
+    enum class IOMode {
+        STDIO, /**< Buffered reads through a std::FILE* (default) */
+        MMAP,  /**< Parse directly over a memory-mapped region */
+        ASYNC  /**< Keep a window of in-flight reads via io_uring (Linux only).
+                *   Falls back to STDIO when built without liburing or when
+                *   the input is compressed.
+                */
+    };
+
+    /** Determines whether, and how strictly, CSVReader validates that its
+     *  input is well-formed Unicode (see CSVReader::set_unicode_policy())
+     */
+    enum class UnicodePolicy {
+        NONE,    /**< Pass bytes through unexamined (default) */
+        THROW,   /**< Raise std::runtime_error on the first malformed sequence */
+        REPLACE  /**< Substitute malformed sequences and keep parsing */
+    };
+
+    /** A column-oriented batch of parsed rows
+     *
+     *  Produced by CSVReader::read_batch(). Each column's values are stored
+     *  contiguously so vectorized aggregation can stream over them without
+     *  per-field pointer chasing:
+     *  - Numeric columns are converted once into `doubles` or `ints`
+     *  - String columns keep their bytes back to back in `chars`, with
+     *    `offsets` (length `n_rows + 1`) delimiting individual values
+     *
+     *  A column's type is the widest type observed in the batch: integer
+     *  columns containing a float or an empty field are promoted to double
+     *  (empty fields become NaN), and columns mixing text with numbers are
+     *  kept as strings.
+     */
+    struct ColumnBatch {
+        struct Column {
+            DataType type = CSV_STRING;   /**< CSV_STRING, CSV_INT64, or CSV_DOUBLE */
+            std::vector<long long> ints;  /**< Values when type == CSV_INT64 */
+            std::vector<double> doubles;  /**< Values when type == CSV_DOUBLE */
+            std::string chars;            /**< Concatenated bytes when type == CSV_STRING */
+            std::vector<size_t> offsets;  /**< Value boundaries within chars */
+
+            /** Per-row dictionary codes. When non-empty, chars/offsets hold
+             *  one entry per distinct value instead of one per row, and
+             *  equality between rows is an integer compare of codes.
+             */
+            std::vector<int> codes;
+
+            /** Whether this column's strings are dictionary encoded */
+            bool is_dictionary() const { return !this->codes.empty(); }
+
+            /** Number of distinct values in a dictionary encoded column */
+            size_t dict_size() const {
+                return this->offsets.empty() ? 0 : this->offsets.size() - 1;
+            }
+
+            /** Retrieve the ith string value of a CSV_STRING column */
+            csv::string_view str(size_t i) const {
+                if (!this->codes.empty()) i = (size_t)this->codes[i];
+                return csv::string_view(this->chars.data() + this->offsets[i],
+                    this->offsets[i + 1] - this->offsets[i]);
+            }
+        };
+
+        std::vector<std::string> col_names; /**< Names of the batched columns */
+        std::vector<Column> columns;        /**< One entry per column, in file order */
+        size_t n_rows = 0;                  /**< Number of rows in this batch */
+    };
+
+    /** Snapshot of a CSVReader's hot-path instrumentation counters,
+     *  retrieved with CSVReader::metrics()
+     *
+     *  Counters answer "where is ingest time going" without a profiler:
+     *  bytes_read far ahead of bytes_parsed means the parser is behind the
+     *  disk (parse-bound); a large worker_wait_sec means the parser is
+     *  starved (I/O-bound); buffered rows piling up between read_row()
+     *  calls means the consumer is behind (consumer-bound).
+     *
+     *  Each counter is written by exactly one thread — no atomics touch
+     *  the hot path — so a snapshot taken while a read is in flight may
+     *  be momentarily inconsistent between fields.
+     */
+    struct CSVReaderMetrics {
+        size_t bytes_read = 0;        /**< Bytes pulled from the source (after decompression) */
+        size_t bytes_parsed = 0;      /**< Bytes fed through the parser */
+        size_t chunks_fed = 0;        /**< Chunks passed to feed() */
+        size_t rows_dropped = 0;      /**< Rows dropped by the variable column policy */
+        size_t peak_buffer_bytes = 0; /**< Largest row text buffer observed */
+        double worker_wait_sec = 0;   /**< Parse worker time spent waiting for chunks */
+    };
+
+    /** Fixed-size latency histogram with power-of-two nanosecond buckets
+     *
+     *  Bucket `i` counts durations in `[2^i, 2^(i+1))` nanoseconds, so 40
+     *  buckets cover roughly 1 ns through 18 minutes with the HDR-style
+     *  trade of at most 2x relative error per sample — enough to tell a
+     *  microsecond parse from a millisecond storage stall. Recording is a
+     *  bucket increment and a few compares; no allocation, ever.
+     */
+    struct LatencyHistogram {
+        static constexpr size_t N_BUCKETS = 40;
+
+        std::array<size_t, N_BUCKETS> buckets = {}; /**< buckets[i] counts samples in [2^i, 2^(i+1)) ns */
+        size_t count = 0;                           /**< Total samples recorded */
+        unsigned long long total_ns = 0;            /**< Sum of all samples */
+        unsigned long long min_ns = 0;              /**< Smallest sample (0 when empty) */
+        unsigned long long max_ns = 0;              /**< Largest sample */
+
+        /** Record one duration in nanoseconds */
+        void record(unsigned long long ns) {
+            size_t bucket = 0;
+            while ((ns >> (bucket + 1)) != 0 && bucket < N_BUCKETS - 1)
+                bucket++;
+
+            this->buckets[bucket]++;
+            this->total_ns += ns;
+            this->max_ns = std::max(this->max_ns, ns);
+            if (this->count == 0 || ns < this->min_ns) this->min_ns = ns;
+            this->count++;
+        }
+
+        /** Upper bound of the bucket holding the pth percentile sample,
+         *  e.g. percentile_ns(0.99) for p99 latency
+         */
+        unsigned long long percentile_ns(double p) const {
+            if (this->count == 0) return 0;
+
+            const size_t target = (size_t)((double)this->count * p);
+            size_t seen = 0;
+
+            for (size_t i = 0; i < N_BUCKETS; i++) {
+                seen += this->buckets[i];
+                if (seen > target)
+                    return ((unsigned long long)2 << i) - 1;
+            }
+
+            return this->max_ns;
+        }
+    };
+
+    /** Per-stage latency histograms for the reader pipeline, retrieved
+     *  with CSVReader::trace()
+     *
+     *  Populated only when the library is built with `CSV_TRACE` defined;
+     *  otherwise every histogram stays empty and no clock is read on the
+     *  hot path. Together the four stages separate storage stalls (`read`
+     *  slow), parse stalls (`parse` slow, `queue_full` filling up), and
+     *  consumer backpressure (`queue_empty` near zero while rows pile up).
+     */
+    struct CSVReaderTrace {
+        LatencyHistogram read;        /**< One read_chunk() or async next_chunk() call */
+        LatencyHistogram parse;       /**< One feed() of a chunk on the worker thread */
+        LatencyHistogram queue_full;  /**< Reader thread blocked: chunk queue full */
+        LatencyHistogram queue_empty; /**< Worker thread starved: chunk queue empty */
+
+        /** Render all four histograms as a JSON object, suitable for
+         *  shipping to whatever is collecting incident diagnostics
+         */
+        std::string to_json() const;
+    };
+
     /** @class CSVReader
      *  @brief Main class for parsing CSVs from files and in-memory sources
      *
@@ -99,15 +322,35 @@ namespace csv {
          *  Constructors for iterating over large files and parsing in-memory sources.
          */
          ///@{
-        CSVReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv());
+        CSVReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv(),
+            IOMode io_mode = IOMode::STDIO);
         CSVReader(CSVFormat format = CSVFormat());
         ///@}
 
+        /** Point this reader at another file, reusing its parse tables and
+         *  every buffer the previous file warmed up
+         *
+         *  Unlike constructing a fresh CSVReader, open() keeps the parse and
+         *  whitespace flag tables, the row buffer pool, and the threading
+         *  state, so switching files costs little more than the fopen() —
+         *  the difference dominates when churning through many small files
+         *  (see ParserSession). Column names fixed by the format carry over;
+         *  otherwise they are taken from each file's header row. A format
+         *  guessed while constructing over a file is locked in by the
+         *  constructor and applies to every subsequently opened file.
+         */
+        void open(csv::string_view filename, IOMode io_mode = IOMode::STDIO);
+
         CSVReader(const CSVReader&) = delete; // No copy constructor
         CSVReader(CSVReader&&) = default;     // Move constructor
         CSVReader& operator=(const CSVReader&) = delete; // No copy assignment
         CSVReader& operator=(CSVReader&& other) = default;
-        ~CSVReader() { this->close(); }
+        virtual ~CSVReader() {
+            if (this->prefetch_thread.joinable())
+                this->prefetch_thread.join();
+
+            this->close();
+        }
 
         /** @name Reading In-Memory Strings
          *  You can piece together incomplete CSV fragments by calling feed() on them
@@ -124,6 +367,9 @@ namespace csv {
         /** @name Retrieving CSV Rows */
         ///@{
         bool read_row(CSVRow &row);
+        size_t read_rows(std::vector<CSVRow>& out, size_t n);
+        size_t read_batch(ColumnBatch& batch, size_t n);
+        void sample_types(size_t sample_size = 100);
         iterator begin();
         HEDLEY_CONST iterator end() const;
         ///@}
@@ -133,6 +379,142 @@ namespace csv {
         CSVFormat get_format() const;
         std::vector<std::string> get_col_names() const;
         int index_of(csv::string_view col_name) const;
+        ColumnHandle column(const std::string& col_name) const;
+        ///@}
+
+        /** @name Memory Budget
+         *  Bound how much memory this reader holds between read_row() calls
+         */
+        ///@{
+        /** Set how many bytes each parsing round pulls from disk */
+        void set_chunk_size(size_t bytes) {
+            this->iteration_chunk_size = std::max(bytes, (size_t)1);
+        }
+
+        /** How many bytes each parsing round pulls from disk */
+        size_t get_chunk_size() const { return this->iteration_chunk_size; }
+
+        /** Stop a parsing round early once this many rows are buffered
+         *  (0 = only bounded by the chunk size). The cap is checked between
+         *  chunks, so it may be overshot by up to one chunk's worth of rows.
+         */
+        void set_max_buffered_rows(size_t n_rows) { this->max_buffered_rows = n_rows; }
+
+        /** Number of parsed rows awaiting retrieval */
+        size_t get_buffered_rows() const { return this->records.size(); }
+
+        /** Keep only rows for which the predicate returns true
+         *
+         *  The predicate is evaluated over raw field string_views before a
+         *  CSVRow is materialized: rejected rows never allocate and their
+         *  bytes are reclaimed immediately. The header row always bypasses
+         *  the filter, and when columns are projected (CSVFormat::select())
+         *  the predicate sees only the projected fields.
+         *
+         *  @note Views passed to the predicate are invalidated when it returns
+         */
+        void set_row_filter(std::function<bool(const std::vector<csv::string_view>&)> predicate);
+
+        /** Invoke a callback for every row whose field count differs from
+         *  the header — whether the variable column policy then keeps or
+         *  drops it — e.g. to log or divert dirty vendor rows in the same
+         *  pass that parses the clean ones. Rows rejected under
+         *  VariableColumnPolicy::THROW still throw instead.
+         *
+         *  @note The CSVRow passed to the callback may be inspected but
+         *        should not be stored if the policy drops it afterwards
+         */
+        void set_bad_row_handler(std::function<void(const CSVRow&)> handler) {
+            this->bad_row_handler = std::move(handler);
+        }
+
+        /** Bytes read from disk but not yet parsed. Only non-zero while a
+         *  parsing round is in flight.
+         */
+        size_t get_buffered_bytes() const { return this->feed_state->queued_bytes.load(); }
+
+        /** Read and parse the next chunk in the background once buffered rows
+         *  drop to the given low-water mark, so steady-state iteration never
+         *  blocks on I/O (classic double buffering)
+         *
+         *  @warning A reader must not be moved while a prefetch is in flight
+         */
+        void set_prefetch(bool on, size_t low_water_rows = 1000) {
+            this->prefetch_enabled = on;
+            this->prefetch_low_water = low_water_rows;
+        }
+
+        /** Follow a file that is still being written, like `tail -f`
+         *
+         *  In follow mode, reaching end of file no longer finalizes the
+         *  reader: the stream stays open and the parser keeps its partial
+         *  state — quote_escape and any incomplete trailing line — so
+         *  parsing continues exactly where it left off when new bytes land.
+         *  read_row() returning false then means "no complete row yet"
+         *  rather than "done"; call poll() (or simply read_row() again)
+         *  after the producer appends. Each poll costs one read attempt
+         *  plus parsing of whatever bytes arrived — never a re-scan.
+         *
+         *  Turning follow mode off lets the next read finish normally,
+         *  flushing a trailing unterminated row and closing the file.
+         *
+         *  @note Only applies to plain stdio reads; memory-mapped,
+         *        compressed, and async inputs are finalized at EOF as usual
+         */
+        void set_follow(bool on) { this->follow_mode = on; }
+
+        /** Attempt to read newly appended bytes, returning true if at
+         *  least one complete row is now buffered
+         */
+        bool poll();
+
+        /** Validate that the input is well-formed Unicode as it is read
+         *
+         *  Validation runs on the reader thread over each chunk, overlapped
+         *  with parsing on the worker thread. A UTF-16 byte order mark
+         *  (FF FE or FE FF) switches the reader into a streaming transcode
+         *  which feeds the parser UTF-8; otherwise the input is checked as
+         *  UTF-8 in place. Sequences split across chunk boundaries are
+         *  carried between reads.
+         *
+         *  Under UnicodePolicy::THROW, the first malformed sequence raises
+         *  std::runtime_error; under UnicodePolicy::REPLACE, malformed
+         *  UTF-8 bytes become '?' and unpaired UTF-16 surrogates become
+         *  U+FFFD, and parsing continues.
+         *
+         *  @note Only applies to stdio and async reads; memory-mapped
+         *        input is parsed in place over a read-only mapping and
+         *        passes through unexamined
+         *
+         *  @note Format guessing and header parsing examine raw file
+         *        bytes, so UTF-16 input should be paired with an explicit
+         *        CSVFormat (delimiter and column names)
+         */
+        void set_unicode_policy(UnicodePolicy policy) {
+            this->unicode_policy = policy;
+        }
+
+        /** Intern repeated string values when batching with read_batch().
+         *  Each string column is sampled for cardinality; low-cardinality
+         *  columns (country codes, enum states, ...) store each distinct
+         *  value once plus an integer code per row, instead of repeating
+         *  the bytes for every occurrence. See ColumnBatch::Column::codes.
+         */
+        void set_dictionary_encoding(bool on) { this->dict_encoding = on; }
+        ///@}
+
+        /** @name Instrumentation */
+        ///@{
+        /** Snapshot this reader's hot-path counters. See CSVReaderMetrics
+         *  for how to read them.
+         */
+        CSVReaderMetrics metrics() const { return this->metrics_data; }
+
+        /** Snapshot this reader's per-stage latency histograms. Empty
+         *  unless the library was built with `CSV_TRACE` defined; see
+         *  CSVReaderTrace.
+         */
+        CSVReaderTrace trace() const { return this->trace_data; }
         ///@}
         
         /** @name CSV Metadata: Attributes */
@@ -158,19 +540,43 @@ namespace csv {
 
         /** Multi-threaded Reading State, including synchronization objects that cannot be moved. */
         struct ThreadedReadingState {
-            std::deque<WorkItem> feed_buffer;    /**< Message queue for worker */
-            std::mutex feed_lock;                /**< Allow only one worker to write */
-            std::condition_variable feed_cond;   /**< Wake up worker */
+            internals::SPSCQueue<WorkItem> feed_buffer;    /**< Lock-free message queue for worker */
+            internals::SPSCQueue<WorkItem> recycle_buffer; /**< Returns consumed chunk buffers to the reader */
+            std::atomic<size_t> queued_bytes = { 0 };      /**< Bytes read from disk but not yet parsed */
+            std::atomic<size_t> parsed_rows = { 0 };       /**< Rows currently sitting in records */
         };
 
         /** Open a file for reading. Implementation is compiler specific. */
         void fopen(csv::string_view filename);
 
+        /** Map a file into memory for zero-copy reading. Falls back to
+         *  fopen() on platforms without memory mapping.
+         */
+        void open_mmap(csv::string_view filename);
+
         /** Sets this reader's column names and associated data */
         void set_col_names(const std::vector<std::string>&);
 
+        /** Resolve a column selection against the full column set, building
+         *  the projection mask and returning the projected column names
+         */
+        std::vector<std::string> apply_projection(
+            const std::vector<std::string>& full_names,
+            const std::vector<std::string>& selected);
+
         /** Returns true if we have reached end of file */
-        bool eof() { return !(this->infile); };
+        bool eof() {
+            if (this->io_mode == IOMode::MMAP)
+                return !this->mmap_base || this->mmap_pos >= this->mmap_len;
+
+            if (this->compression != Compression::NONE)
+                return this->decompress_done;
+
+            if (this->async_ctx)
+                return this->async_done;
+
+            return !(this->infile);
+        };
 
         /** @name CSV Settings **/
         ///@{
@@ -193,27 +599,103 @@ namespace csv {
         /** Buffer for current row being parsed */
         internals::BufferPtr record_buffer = internals::BufferPtr(new internals::RawRowBuffer(this->col_names));
 
+        /** Recycles RawRowBuffers that no CSVRow references anymore */
+        internals::BufferPool buffer_pool;
+
         /** Queue of parsed CSV rows */
-        std::deque<CSVRow> records;
+        internals::RecordRing records;
+
+        /** Rows parsed by an in-flight prefetch. The background thread owns
+         *  this deque exclusively while use_staging is set; the consumer
+         *  swaps it into records after joining (see fill_records()).
+         */
+        internals::RecordRing staging_records;
+
+        /** Whether newly parsed rows are delivered to staging_records */
+        bool use_staging = false;
+
+        /** Whether prefetching was requested via set_prefetch() */
+        bool prefetch_enabled = false;
+
+        /** Whether EOF is treated as "no new bytes yet" (see set_follow()) */
+        bool follow_mode = false;
+
+        /** Whether read_batch() dictionary encodes low-cardinality columns */
+        bool dict_encoding = false;
+
+        /** Hot-path counters; each field is written by one thread only */
+        CSVReaderMetrics metrics_data;
+
+        /** Pipeline latency histograms; recorded into only under CSV_TRACE */
+        CSVReaderTrace trace_data;
+
+        /** Buffered row count at which the next prefetch is launched */
+        size_t prefetch_low_water = 0;
+
+        /** Background thread running the current prefetch, if any */
+        std::thread prefetch_thread;
+
+        /** Ensure records holds rows if any remain, harvesting or launching
+         *  prefetches as configured
+         */
+        void fill_records();
 
         /** Whether or not we are in a quote-escaped field */
         bool quote_escape = false;
 
+        /** Column projection push-down state; an empty mask parses every column */
+        internals::ProjectionState projection;
+
+        /** Row filter push-down state; rows are kept when no predicate is set */
+        internals::RowFilter row_filter;
+
+        /** Observer for rows whose field count differs from the header */
+        std::function<void(const CSVRow&)> bad_row_handler;
+
         /** Whether or not an attempt to find Unicode BOM has been made */
         bool unicode_bom_scan = false;
 
+        /** How malformed input bytes are handled (see set_unicode_policy()) */
+        UnicodePolicy unicode_policy = UnicodePolicy::NONE;
+
+        /** Detected encoding, plus Unicode sequences split across chunks */
+        internals::UnicodeValidator unicode_state;
+
         /** Whether or not rows before header were trimmed */
         bool header_trimmed = false;
 
         /** The number of columns in this CSV */
         size_t n_cols = 0;
+
+        /** How many bytes read_csv() pulls from disk per round */
+        size_t iteration_chunk_size = internals::ITERATION_CHUNK_SIZE;
+
+        /** Row count at which a parsing round stops early (0 = no cap) */
+        size_t max_buffered_rows = 0;
         ///@}
 
         /** @name Multi-Threaded File Reading Functions */
         ///@{
         void feed(WorkItem&&); /**< @brief Helper for read_csv_worker() */
+
+        /** Split a chunk of input into newline-aligned slices and parse
+         *  them on multiple threads
+         */
+        void feed_parallel(csv::string_view in, size_t n_threads);
+
+        /** Parse one chunk of input into records. Virtual so that readers
+         *  with statically known formats can substitute a specialized kernel.
+         */
+        virtual void parse_chunk(csv::string_view in);
         void read_csv(const size_t& bytes = internals::ITERATION_CHUNK_SIZE);
         void read_csv_worker();
+
+        /** Parse the next chunk of a memory-mapped file in place */
+        void read_csv_mmap(const size_t& bytes);
+
+        /** Validate or transcode one freshly read chunk (see set_unicode_policy()) */
+        bool validate_chunk(std::unique_ptr<char[]>& buffer, size_t& n_read,
+            size_t buffer_size, std::string& error);
         ///@}
 
         /** @name Multi-Threaded File Reading: Flags and State */
@@ -221,7 +703,56 @@ namespace csv {
         /** Current file handle. Destroyed by ~CSVReader(). */
         std::FILE* HEDLEY_RESTRICT infile = nullptr;
         std::unique_ptr<ThreadedReadingState> feed_state;
-        ///@} 
+
+        /** How bytes are pulled from the current file */
+        IOMode io_mode = IOMode::STDIO;
+
+        /** Base address of the current memory mapping. Unmapped by close(). */
+        const char* mmap_base = nullptr;
+
+        /** Length of the current memory mapping in bytes */
+        size_t mmap_len = 0;
+
+        /** How far into the memory mapping the parser has advanced */
+        size_t mmap_pos = 0;
+
+        /** Opaque handle to the io_uring submission state
+         *  (an internals::UringReader*). Released by close().
+         */
+        void* async_ctx = nullptr;
+
+        /** Whether the async read stream has been fully consumed */
+        bool async_done = false;
+        ///@}
+
+        /** @name Compressed Input State */
+        ///@{
+        /** Compression format of the current file, detected from magic bytes */
+        Compression compression = Compression::NONE;
+
+        /** Opaque handle to the active decompression stream
+         *  (a gzFile or ZSTD_DStream*). Released by close().
+         */
+        void* decompress_ctx = nullptr;
+
+        /** Staging buffer for raw compressed bytes awaiting decompression */
+        std::unique_ptr<char[]> compressed_buffer;
+
+        /** Valid bytes in compressed_buffer */
+        size_t compressed_len = 0;
+
+        /** Consumed bytes in compressed_buffer */
+        size_t compressed_pos = 0;
+
+        /** Whether the compressed stream has been fully decompressed */
+        bool decompress_done = false;
+
+        /** Open the decompression stream matching this->compression */
+        void init_decompression(csv::string_view filename);
+
+        /** Read up to n bytes of plaintext, decompressing when necessary */
+        size_t read_chunk(char* out, size_t n);
+        ///@}
 
         /**@}*/ // End of parser internals
 
@@ -229,4 +760,84 @@ namespace csv {
         /** Set parse and whitespace flags */
         void set_parse_flags(const CSVFormat& format);
     };
+
+    /** A CSVReader whose delimiter and quote character are fixed at
+     *  compile time
+     *
+     *  For files whose format is known statically -- e.g. plain RFC 4180
+     *  comma/double-quote data -- this reader parses chunks with
+     *  internals::parse_static(), which replaces the runtime ParseFlagMap
+     *  lookups with immediate compares the compiler can fold.
+     *
+     *  @tparam Delim The delimiter character
+     *  @tparam Quote The quote character
+     */
+    template<char Delim = ',', char Quote = '"'>
+    class BasicCSVReader : public CSVReader {
+    public:
+        /** Parse in-memory sources with a statically known format */
+        BasicCSVReader() : CSVReader(static_format()) {};
+
+        /** Read a file with a statically known format */
+        BasicCSVReader(csv::string_view filename) : CSVReader(filename, static_format()) {};
+
+    protected:
+        void parse_chunk(csv::string_view in) override {
+            this->record_buffer = internals::parse_static<Delim, Quote>({
+                in,
+                this->parse_flags,
+                this->ws_flags,
+                this->record_buffer,
+                this->quote_escape,
+                this->use_staging ? this->staging_records : this->records
+            }, &this->buffer_pool);
+        }
+
+    private:
+        /** Return a CSVFormat matching this reader's template parameters */
+        static CSVFormat static_format() {
+            CSVFormat format;
+            format.delimiter(Delim).quote(Quote);
+            return format;
+        }
+    };
+
+    /** A reusable parsing session for churning through many small files
+     *
+     *  Constructing a CSVReader per file rebuilds the parse flag tables and
+     *  allocates fresh column name, row buffer, and threading state — for
+     *  files of a few KB, that setup dwarfs the parsing itself. A
+     *  ParserSession constructs one CSVReader up front and re-points it at
+     *  each file with CSVReader::open(), so all of those allocations are
+     *  paid once per session rather than once per file.
+     *
+     *  @par Example
+     *  @code
+     *  csv::ParserSession session(format);
+     *  for (auto& path : paths) {
+     *      csv::CSVReader& reader = session.open(path);
+     *      for (auto& row : reader) { ... }
+     *  }
+     *  @endcode
+     *
+     *  @warning Rows from one file should be consumed before the next
+     *           open(): switching files discards any still buffered.
+     */
+    class ParserSession {
+    public:
+        /** Construct a session whose format applies to every opened file */
+        ParserSession(CSVFormat format = CSVFormat()) : reader(format) {};
+
+        /** Begin reading the given file, reusing the session's reader */
+        CSVReader& open(csv::string_view filename, IOMode io_mode = IOMode::STDIO) {
+            this->reader.open(filename, io_mode);
+            return this->reader;
+        }
+
+        /** The reader over the most recently opened file */
+        CSVReader& current() { return this->reader; }
+
+    private:
+        CSVReader reader;
+    };
 }
\ No newline at end of file
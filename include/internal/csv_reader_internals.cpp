@@ -1,5 +1,9 @@
 #include "csv_reader_internals.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <sys/stat.h> // For get_csv_head()'s staleness check
 
 namespace csv {
     namespace internals {
@@ -12,7 +16,7 @@ namespace csv {
 
             // Parse the CSV
             auto buffer_ptr = internals::BufferPtr(new internals::RawRowBuffer());
-            std::deque<CSVRow> rows;
+            internals::RecordRing rows;
             bool quote_escape = false;
 
             internals::parse({
@@ -57,29 +61,119 @@ namespace csv {
              *  The delimiter with the longest mode row length wins.
              *  Then, the line number of the header row is the first row with
              *  the mode row length.
+             *
+             *  All candidates are scored simultaneously in one scan of the
+             *  head: each runs a small state machine mirroring parse()'s
+             *  quote handling, so the head is touched once instead of once
+             *  per candidate.
              */
+            struct Candidate {
+                char delim;
+                size_t n_fields = 0;      /*< Delimiters seen in the current row */
+                size_t n_rows = 0;        /*< Rows terminated so far */
+                bool quote_escape = false;
+                bool skip_char = false;   /*< Consume the next character blindly */
+                bool prev_special = false; /*< Previous character was a delimiter or newline */
+                std::unordered_map<size_t, size_t> row_tally;
+                std::unordered_map<size_t, size_t> row_when;
+            };
+
+            std::vector<Candidate> candidates;
+            for (char cand_delim : delims) {
+                candidates.push_back({});
+                candidates.back().delim = cand_delim;
+            }
+
+            const size_t n = head.size();
+            for (size_t i = 0; i < n; i++) {
+                const char ch = head[i];
+
+                for (auto& cand : candidates) {
+                    if (cand.skip_char) {
+                        cand.skip_char = false;
+                        continue;
+                    }
+
+                    if (cand.quote_escape) {
+                        if (ch == '"' && i + 1 < n) {
+                            const char next_ch = head[i + 1];
+                            if (next_ch == cand.delim || next_ch == '\r' || next_ch == '\n')
+                                cand.quote_escape = false;
+                            else if (next_ch == '"')
+                                cand.skip_char = true; // Two consecutive quotes
+                        }
+
+                        continue;
+                    }
+
+                    if (ch == cand.delim) {
+                        cand.n_fields++;
+                        cand.prev_special = true;
+                    }
+                    else if (ch == '\r' || ch == '\n') {
+                        // End of record; catches CRLF (or LFLF) like parse()
+                        const size_t row_len = cand.n_fields + 1;
+                        if (cand.row_tally.find(row_len) != cand.row_tally.end()) {
+                            cand.row_tally[row_len]++;
+                        }
+                        else {
+                            cand.row_tally[row_len] = 1;
+                            cand.row_when[row_len] = cand.n_rows;
+                        }
+
+                        cand.n_fields = 0;
+                        cand.n_rows++;
+                        cand.prev_special = true;
+
+                        if (i + 1 < n && head[i + 1] == '\n')
+                            cand.skip_char = true;
+                    }
+                    else {
+                        // Mirrors parse(): a quote only opens a field when
+                        // it follows a delimiter or newline
+                        if (ch == '"' && cand.prev_special)
+                            cand.quote_escape = true;
+
+                        cand.prev_special = false;
+                    }
+                }
+            }
 
-            CSVFormat format;
             size_t max_score = 0,
                    header = 0;
             char current_delim = delims[0];
 
-            for (char cand_delim : delims) {
-                auto result = calculate_score(head, format.delimiter(cand_delim));
+            for (auto& cand : candidates) {
+                if (cand.row_tally.empty()) continue;
 
-                if (result.score > max_score) {
-                    max_score = result.score;
-                    current_delim = cand_delim;
-                    header = result.header;
+                // Most common number of columns
+                auto max = std::max_element(cand.row_tally.begin(), cand.row_tally.end(),
+                    [](const std::pair<size_t, size_t>& x,
+                        const std::pair<size_t, size_t>& y) {
+                            return x.second < y.second; });
+
+                const size_t score = max->first * max->second;
+                if (score > max_score) {
+                    max_score = score;
+                    current_delim = cand.delim;
+                    header = cand.row_when[max->first];
                 }
             }
 
-            return { current_delim, (int)header };
+            return {
+                current_delim,
+                (int)header,
+                head.find('"') == csv::string_view::npos
+            };
         }
 
-        CSV_INLINE BufferPtr parse(const ParseData& data) {
+        CSV_INLINE BufferPtr parse(const ParseData& data, BufferPool* pool,
+            ProjectionState* projection, RowFilter* filter,
+            size_t* peak_buffer_bytes) {
             using internals::ParseFlags;
 
+            auto * HEDLEY_RESTRICT proj = projection;
+
             // Optimizations
             auto * HEDLEY_RESTRICT parse_flags = data.parse_flags.data();
             auto * HEDLEY_RESTRICT ws_flags = data.ws_flags.data();
@@ -90,11 +184,41 @@ namespace csv {
             text_buffer.reserve(data.in.size());
             split_buffer.reserve(data.in.size() / 10);
 
+            // Recover the raw special characters for the vectorized scanner
+            char delim = ',', quote = '\0';
+            bool has_quote = false;
+            for (size_t ch = 0; ch < data.parse_flags.size(); ch++) {
+                if (parse_flags[ch] == ParseFlags::DELIMITER) {
+                    delim = (char)((int)ch - 128);
+                }
+                else if (parse_flags[ch] == ParseFlags::QUOTE) {
+                    quote = (char)((int)ch - 128);
+                    has_quote = true;
+                }
+            }
+
+            // With quoting disabled, only three characters are special
+            if (!has_quote) quote = delim;
+
             for (size_t i = 0; i < in.size(); i++) {
                 switch (parse_flags[data.in[i] + 128]) {
                 case ParseFlags::DELIMITER:
                     if (!data.quote_escape) {
-                        split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
+                        if (proj == nullptr) {
+                            split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
+                        }
+                        else {
+                            // A field boundary is only recorded between two
+                            // materialized fields
+                            if (proj->is_selected(proj->field_no))
+                                proj->wrote_field = true;
+
+                            proj->field_no++;
+
+                            if (proj->wrote_field && proj->is_selected(proj->field_no))
+                                split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
+                        }
+
                         break;
                     }
 
@@ -105,12 +229,34 @@ namespace csv {
                         if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
                             ++i;
 
-                        data.records.push_back(CSVRow(data.row_buffer));
+                        bool keep = true;
+                        if (filter != nullptr) {
+                            if (filter->bypass_rows > 0) {
+                                filter->bypass_rows--;
+                            }
+                            else {
+                                row_buffer.get_current_row(filter->scratch);
+                                keep = filter->predicate(filter->scratch);
+                            }
+                        }
+
+                        if (keep)
+                            data.records.push_back(CSVRow(data.row_buffer));
+                        else
+                            row_buffer.discard_row();
+
+                        if (proj != nullptr) {
+                            proj->field_no = 0;
+                            proj->wrote_field = false;
+                        }
+
                         break;
                     }
 
                     // Treat as regular character
-                    text_buffer += in[i];
+                    if (proj == nullptr || proj->is_selected(proj->field_no))
+                        text_buffer += in[i];
+
                     break;
                 case ParseFlags::NOT_SPECIAL: {
                     size_t start, end;
@@ -121,11 +267,17 @@ namespace csv {
                         ws_flags,
                         i,
                         start,
-                        end
+                        end,
+                        delim,
+                        quote
                     )) {
                         break;
                     }
 
+                    // Skipped fields only pay for the boundary scan above
+                    if (proj != nullptr && !proj->is_selected(proj->field_no))
+                        break;
+
                     // Finally append text
 #ifdef CSV_HAS_CXX17
                     text_buffer += in.substr(start, end - start + 1);
@@ -154,7 +306,8 @@ namespace csv {
                         }
 
                         // Case: Escaped quote
-                        text_buffer += in[i];
+                        if (proj == nullptr || proj->is_selected(proj->field_no))
+                            text_buffer += in[i];
 
                         // Note: Unescaped single quotes can be handled by the parser
                         if (next_ch == ParseFlags::QUOTE)
@@ -165,16 +318,335 @@ namespace csv {
                 }
             }
 
-            return row_buffer.reset();
+            // Record the buffer's high-water mark before it is swapped out
+            if (peak_buffer_bytes != nullptr && text_buffer.size() > *peak_buffer_bytes)
+                *peak_buffer_bytes = text_buffer.size();
+
+            return row_buffer.reset(pool);
+        }
+
+        CSV_INLINE BufferPtr parse_no_quote(const ParseData& data, BufferPool* pool,
+            size_t* peak_buffer_bytes) {
+            using internals::ParseFlags;
+
+            auto * HEDLEY_RESTRICT parse_flags = data.parse_flags.data();
+            auto& in = data.in;
+            auto& row_buffer = *(data.row_buffer.get());
+            auto& text_buffer = row_buffer.buffer;
+            auto& split_buffer = row_buffer.split_buffer;
+            text_buffer.reserve(in.size());
+            split_buffer.reserve(in.size() / 10);
+
+            // Recover the raw delimiter for the vectorized scanner
+            char delim = ',';
+            for (size_t ch = 0; ch < data.parse_flags.size(); ch++) {
+                if (parse_flags[ch] == ParseFlags::DELIMITER)
+                    delim = (char)((int)ch - 128);
+            }
+
+            // With no quote state to track, parsing reduces to alternating
+            // between bulk-copying runs of ordinary characters and acting on
+            // the delimiter or newline that terminated each run
+            size_t i = 0;
+            while (i < in.size()) {
+                const size_t start = i;
+                i = find_special(in, parse_flags, i, delim, delim);
+
+                if (i > start) {
+#ifdef CSV_HAS_CXX17
+                    text_buffer += in.substr(start, i - start);
+#else
+                    for (size_t j = start; j < i; j++) {
+                        text_buffer += in[j];
+                    }
+#endif
+                }
+
+                if (i >= in.size()) break;
+
+                if (in[i] == delim) {
+                    split_buffer.push_back((StrBufferPos)row_buffer.size());
+                }
+                else {
+                    // End of record -> Write record
+                    if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
+                        ++i;
+
+                    data.records.push_back(CSVRow(data.row_buffer));
+                }
+
+                i++;
+            }
+
+            if (peak_buffer_bytes != nullptr && text_buffer.size() > *peak_buffer_bytes)
+                *peak_buffer_bytes = text_buffer.size();
+
+            return row_buffer.reset(pool);
+        }
+
+        /** Outcome of examining one UTF-8 sequence */
+        enum class Utf8Result {
+            VALID,
+            INVALID,
+            INCOMPLETE /**< The sequence continues past the available bytes */
+        };
+
+        /** Examine the UTF-8 sequence starting at p, applying the
+         *  second-byte range restrictions that reject overlong encodings
+         *  and surrogate code points
+         *
+         *  @param[in]  p     First byte of the sequence
+         *  @param[in]  avail Bytes available at p
+         *  @param[out] len   Full length of the sequence (1-4), set for
+         *                    VALID and INCOMPLETE results
+         */
+        static Utf8Result check_utf8_sequence(const unsigned char* p, size_t avail, size_t& len) {
+            const unsigned char c = p[0];
+
+            if (c < 0x80) {
+                len = 1;
+                return Utf8Result::VALID;
+            }
+
+            unsigned char lo = 0x80, hi = 0xBF;
+
+            if (c >= 0xC2 && c <= 0xDF) { len = 2; }
+            else if (c == 0xE0) { len = 3; lo = 0xA0; } // Reject overlong
+            else if (c >= 0xE1 && c <= 0xEC) { len = 3; }
+            else if (c == 0xED) { len = 3; hi = 0x9F; } // Reject surrogates
+            else if (c >= 0xEE && c <= 0xEF) { len = 3; }
+            else if (c == 0xF0) { len = 4; lo = 0x90; } // Reject overlong
+            else if (c >= 0xF1 && c <= 0xF3) { len = 4; }
+            else if (c == 0xF4) { len = 4; hi = 0x8F; } // Reject > U+10FFFF
+            else return Utf8Result::INVALID;            // 0x80-0xC1, 0xF5-0xFF
+
+            for (size_t i = 1; i < len; i++) {
+                if (i >= avail) return Utf8Result::INCOMPLETE;
+
+                const unsigned char cc = p[i];
+                if (i == 1 ? (cc < lo || cc > hi) : (cc < 0x80 || cc > 0xBF))
+                    return Utf8Result::INVALID;
+            }
+
+            return Utf8Result::VALID;
+        }
+
+        CSV_INLINE size_t validate_utf8_chunk(UnicodeValidator& state,
+            char* data, size_t n, bool replace) {
+            auto* bytes = (unsigned char*)data;
+            size_t i = 0;
+
+            // Finish a sequence the previous chunk left incomplete
+            if (state.partial_len > 0) {
+                const size_t take = std::min(n, (size_t)4 - state.partial_len);
+                std::memcpy(state.partial + state.partial_len, bytes, take);
+
+                size_t len = 0;
+                switch (check_utf8_sequence(state.partial, state.partial_len + take, len)) {
+                case Utf8Result::VALID:
+                    i = len - state.partial_len;
+                    state.partial_len = 0;
+                    break;
+                case Utf8Result::INCOMPLETE: // Only possible for a tiny chunk
+                    state.partial_len += take;
+                    return csv::string_view::npos;
+                case Utf8Result::INVALID:
+                    // The sequence's lead byte went out with the previous
+                    // chunk and is beyond repair; rescan this chunk's bytes
+                    // from the top so a valid lead byte is not swallowed
+                    if (!replace) return 0;
+                    state.partial_len = 0;
+                    break;
+                }
+            }
+
+            while (i < n) {
+                // Runs of ASCII — the overwhelming share of typical CSV —
+                // are validated a register at a time via the sign bit
+#if defined(CSV_HAS_AVX2)
+                while (i + 32 <= n) {
+                    __m256i chunk = _mm256_loadu_si256((const __m256i*)(bytes + i));
+                    if (_mm256_movemask_epi8(chunk) != 0) break;
+                    i += 32;
+                }
+#elif defined(CSV_HAS_SSE2)
+                while (i + 16 <= n) {
+                    __m128i chunk = _mm_loadu_si128((const __m128i*)(bytes + i));
+                    if (_mm_movemask_epi8(chunk) != 0) break;
+                    i += 16;
+                }
+#endif
+
+                if (i >= n) break;
+
+                if (bytes[i] < 0x80) {
+                    i++;
+                    continue;
+                }
+
+                size_t len = 0;
+                switch (check_utf8_sequence(bytes + i, n - i, len)) {
+                case Utf8Result::VALID:
+                    i += len;
+                    break;
+                case Utf8Result::INCOMPLETE:
+                    std::memcpy(state.partial, bytes + i, n - i);
+                    state.partial_len = n - i;
+                    i = n;
+                    break;
+                case Utf8Result::INVALID:
+                    if (!replace) return i;
+                    bytes[i] = '?';
+                    i++;
+                    break;
+                }
+            }
+
+            return csv::string_view::npos;
+        }
+
+        CSV_INLINE bool transcode_utf16_chunk(UnicodeValidator& state,
+            const char* data, size_t n, std::string& out, bool replace) {
+            const auto* bytes = (const unsigned char*)data;
+            const bool big_endian =
+                state.encoding == UnicodeValidator::Encoding::UTF16_BE;
+            size_t i = 0;
+
+            // Worst case: every 2-byte unit becomes 3 UTF-8 bytes
+            out.clear();
+            out.reserve(n + n / 2);
+
+            // Pull the next 16-bit code unit, absorbing a byte carried over
+            // from the previous chunk and carrying a trailing odd byte
+            auto read_unit = [&](unsigned int& unit) -> bool {
+                unsigned char b0, b1;
+
+                if (state.has_odd_byte) {
+                    if (i >= n) return false;
+
+                    b0 = state.odd_byte;
+                    b1 = bytes[i++];
+                    state.has_odd_byte = false;
+                }
+                else {
+                    if (i + 2 > n) {
+                        if (i < n) {
+                            state.odd_byte = bytes[i++];
+                            state.has_odd_byte = true;
+                        }
+
+                        return false;
+                    }
+
+                    b0 = bytes[i++];
+                    b1 = bytes[i++];
+                }
+
+                unit = big_endian
+                    ? ((unsigned int)b0 << 8) | b1
+                    : ((unsigned int)b1 << 8) | b0;
+                return true;
+            };
+
+            auto emit = [&out](unsigned int cp) {
+                if (cp < 0x80) {
+                    out += (char)cp;
+                }
+                else if (cp < 0x800) {
+                    out += (char)(0xC0 | (cp >> 6));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+                else if (cp < 0x10000) {
+                    out += (char)(0xE0 | (cp >> 12));
+                    out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+                else {
+                    out += (char)(0xF0 | (cp >> 18));
+                    out += (char)(0x80 | ((cp >> 12) & 0x3F));
+                    out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+            };
+
+            unsigned int unit = 0;
+            while (read_unit(unit)) {
+                if (state.pending_high) {
+                    if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                        emit(0x10000
+                            + ((state.pending_high - 0xD800) << 10)
+                            + (unit - 0xDC00));
+                        state.pending_high = 0;
+                        continue;
+                    }
+
+                    // Unpaired high surrogate; reprocess this unit below
+                    if (!replace) return false;
+                    emit(0xFFFD);
+                    state.pending_high = 0;
+                }
+
+                if (unit >= 0xD800 && unit <= 0xDBFF) {
+                    state.pending_high = unit;
+                }
+                else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                    // Low surrogate with no high half
+                    if (!replace) return false;
+                    emit(0xFFFD);
+                }
+                else {
+                    emit(unit);
+                }
+            }
+
+            return true;
         }
 
         CSV_INLINE std::string get_csv_head(csv::string_view filename) {
             const size_t bytes = 500000;
+
+            // Cache the most recently read head: guessing a format and then
+            // retrieving column names hits the same file back to back, and
+            // this avoids reading its first 500 KB from disk twice
+            static std::mutex head_cache_lock;
+            static std::string head_cache_name;
+            static long long head_cache_size = -1;
+            static long long head_cache_mtime = -1;
+            static std::string head_cache;
+
             std::ifstream infile(filename.data());
             if (!infile.is_open()) {
                 throw std::runtime_error("Cannot open file " + std::string(filename));
             }
 
+            // Use the file size and modification time as a cheap staleness
+            // check; size alone misses rewrites with same-length content
+            infile.seekg(0, std::ios::end);
+            const long long file_size = (long long)infile.tellg();
+            infile.seekg(0, std::ios::beg);
+
+            long long file_mtime = -1;
+            struct stat file_info;
+            if (stat(filename.data(), &file_info) == 0) {
+#if defined(__linux__)
+                // Sub-second resolution catches files rewritten in-process
+                file_mtime = (long long)file_info.st_mtim.tv_sec * 1000000000LL
+                    + file_info.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+                file_mtime = (long long)file_info.st_mtimespec.tv_sec * 1000000000LL
+                    + file_info.st_mtimespec.tv_nsec;
+#else
+                file_mtime = (long long)file_info.st_mtime;
+#endif
+            }
+
+            {
+                std::lock_guard<std::mutex> guard(head_cache_lock);
+                if (head_cache_size == file_size && head_cache_mtime == file_mtime
+                    && head_cache_name == filename)
+                    return head_cache;
+            }
+
             std::unique_ptr<char[]> buffer(new char[bytes + 1]);
             char * head_buffer = buffer.get();
 
@@ -183,7 +655,18 @@ namespace csv {
             }
 
             infile.read(head_buffer, bytes);
-            return std::string(head_buffer);
+
+            std::string head(head_buffer);
+
+            {
+                std::lock_guard<std::mutex> guard(head_cache_lock);
+                head_cache_name = std::string(filename);
+                head_cache_size = file_size;
+                head_cache_mtime = file_mtime;
+                head_cache = head;
+            }
+
+            return head;
         }
     }
 }
\ No newline at end of file
@@ -10,6 +10,20 @@
 #include "csv_row.hpp"
 #include "row_buffer.hpp"
 
+// Vectorized scanning kernels used by the CSV parser. SSE2 is part of the
+// x86-64 baseline; AVX2 is used if this library is compiled with it enabled.
+#if defined(__AVX2__)
+#define CSV_HAS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define CSV_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h> // For _BitScanForward()
+#endif
+
 namespace csv {
     namespace internals {
         /**  @typedef ParseFlags
@@ -87,17 +101,88 @@ namespace csv {
 
         CSVGuessResult _guess_format(csv::string_view head, const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
 
+        /** Return the index of the lowest set bit in a non-zero bitmask */
+        HEDLEY_CONST inline size_t first_set_bit(unsigned int mask) {
+#if defined(_MSC_VER)
+            unsigned long pos = 0;
+            _BitScanForward(&pos, mask);
+            return (size_t)pos;
+#else
+            return (size_t)__builtin_ctz(mask);
+#endif
+        }
+
+        /** Find the first special character (as labeled by parse_flags) at or
+         *  after position i, comparing 16-32 bytes at a time where vector
+         *  instructions are available
+         *
+         *  @note delim and quote are the same characters used to build parse_flags.
+         *        If quoting is disabled, pass the delimiter for both.
+         *
+         *  @return Index of the first special character, or in.size() if none remain
+         */
+        inline size_t find_special(
+            csv::string_view in,
+            const ParseFlags* const parse_flags,
+            size_t i,
+            char delim,
+            char quote) {
+#if defined(CSV_HAS_AVX2)
+            const __m256i delim_v = _mm256_set1_epi8(delim),
+                quote_v = _mm256_set1_epi8(quote),
+                cr_v = _mm256_set1_epi8('\r'),
+                lf_v = _mm256_set1_epi8('\n');
+
+            for (; i + 32 <= in.size(); i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(in.data() + i));
+                __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, delim_v), _mm256_cmpeq_epi8(chunk, quote_v)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr_v), _mm256_cmpeq_epi8(chunk, lf_v)));
+
+                unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i delim_v = _mm_set1_epi8(delim),
+                quote_v = _mm_set1_epi8(quote),
+                cr_v = _mm_set1_epi8('\r'),
+                lf_v = _mm_set1_epi8('\n');
+
+            for (; i + 16 <= in.size(); i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(in.data() + i));
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, delim_v), _mm_cmpeq_epi8(chunk, quote_v)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, cr_v), _mm_cmpeq_epi8(chunk, lf_v)));
+
+                unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#else
+            (void)delim;
+            (void)quote;
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            while (i < in.size() && parse_flags[in[i] + 128] == ParseFlags::NOT_SPECIAL) {
+                i++;
+            }
+
+            return i;
+        }
+
         /** Parse a CSV field until a delimiter is hit
          *  @return A value indicating whether or not text to be
          *          saved to the text buffer
          */
-        CONSTEXPR bool parse_not_special(
+        inline bool parse_not_special(
             csv::string_view in,
             const csv::internals::ParseFlags* const parse_flags,
             const bool* const ws_flags,
             size_t& i,
             size_t& start,
-            size_t& end) {
+            size_t& end,
+            char delim,
+            char quote) {
             // Trim off leading whitespace
             while (i < in.size() && ws_flags[in[i] + 128]) {
                 i++;
@@ -114,12 +199,10 @@ namespace csv {
             }
 
             // Optimization: Since NOT_SPECIAL characters tend to occur in contiguous
-            // sequences, use the loop below to avoid having to go through the outer
+            // sequences, scan ahead for the next special character in one shot
+            // (vectorized where possible) to avoid having to go through the outer
             // switch statement as much as possible
-            while (i + 1 < in.size()
-                && parse_flags[in[i + 1] + 128] == ParseFlags::NOT_SPECIAL) {
-                i++;
-            }
+            i = find_special(in, parse_flags, i + 1, delim, quote) - 1;
 
             // Trim off trailing whitespace
             end = i;
@@ -130,18 +213,228 @@ namespace csv {
             return true;
         }
 
+        /** Compile-time ParseFlags lookup for statically known delimiters
+         *  and quote characters
+         */
+        template<char Delim, char Quote>
+        HEDLEY_CONST CONSTEXPR ParseFlags flag_for(char ch) {
+            return ch == Delim ? ParseFlags::DELIMITER
+                : ch == Quote ? ParseFlags::QUOTE
+                : (ch == '\r' || ch == '\n') ? ParseFlags::NEWLINE
+                : ParseFlags::NOT_SPECIAL;
+        }
+
         struct ParseData {
             csv::string_view in;
             ParseFlagMap parse_flags;
             WhitespaceMap ws_flags;
             BufferPtr row_buffer;
             bool& quote_escape; /*< Whether or not we are currently in a quote escaped field */
-            std::deque<CSVRow>& records;
+            RecordRing& records;
+        };
+
+        /** State for column projection push-down (see CSVFormat::select())
+         *
+         *  Fields whose column is not in the mask are skipped by the boundary
+         *  scanner only: no bytes are copied and no split entries recorded.
+         *  field_no and wrote_field persist the parser's position within a
+         *  row across chunk boundaries, like ParseData::quote_escape.
+         */
+        struct ProjectionState {
+            /** mask[i] is true if column i should be materialized */
+            std::vector<bool> mask;
+
+            /** Zero-based index of the field currently being parsed */
+            size_t field_no = 0;
+
+            /** Whether a selected field was already emitted for this row */
+            bool wrote_field = false;
+
+            /** Whether the given column should be materialized. Columns past
+             *  the end of the mask (overlong rows) are dropped.
+             */
+            bool is_selected(size_t col) const {
+                return col < this->mask.size() && this->mask[col];
+            }
+        };
+
+        /** State for predicate push-down row filtering
+         *  (see CSVReader::set_row_filter())
+         *
+         *  The predicate is evaluated over raw field views as soon as a row's
+         *  terminating newline is seen; rejected rows never become CSVRows
+         *  and their bytes are reclaimed on the spot by
+         *  RawRowBuffer::discard_row().
+         */
+        struct RowFilter {
+            /** Returns true if a row should be kept */
+            std::function<bool(const std::vector<csv::string_view>&)> predicate;
+
+            /** Rows delivered unfiltered (the header and anything before it) */
+            RowCount bypass_rows = 0;
+
+            /** Reused per-row scratch space for field views */
+            std::vector<csv::string_view> scratch;
+        };
+
+        /** Streaming state for the opt-in encoding validation stage
+         *  (see CSVReader::set_unicode_policy())
+         *
+         *  Chunk boundaries fall anywhere, so a multi-byte UTF-8 sequence,
+         *  a UTF-16 code unit, or a surrogate pair may straddle two chunks;
+         *  the carry fields below let validation resume mid-sequence.
+         */
+        struct UnicodeValidator {
+            /** Input encoding, detected from the first chunk's BOM */
+            enum class Encoding { UNKNOWN, UTF8, UTF16_LE, UTF16_BE };
+
+            Encoding encoding = Encoding::UNKNOWN;
+
+            /** Bytes of a UTF-8 sequence left unfinished by the last chunk */
+            unsigned char partial[4] = { 0, 0, 0, 0 };
+            size_t partial_len = 0;
+
+            /** A UTF-16 code unit split across chunks leaves its first byte here */
+            unsigned char odd_byte = 0;
+            bool has_odd_byte = false;
+
+            /** A high surrogate awaiting its low half (0 = none) */
+            unsigned int pending_high = 0;
         };
 
-        CSV_INLINE BufferPtr parse(const ParseData& data);
+        /** Validate one chunk of UTF-8 in place, vectorized over ASCII runs
+         *
+         *  @param[in,out] state   Carry state across chunk boundaries
+         *  @param[in,out] data    Chunk bytes; malformed bytes are overwritten
+         *                         with '?' when replace is set
+         *  @param[in]     n       Valid bytes in data
+         *  @param[in]     replace Repair malformed bytes instead of failing
+         *
+         *  @return Offset of the first malformed byte, or npos if the chunk
+         *          is valid (or was repaired)
+         */
+        CSV_INLINE size_t validate_utf8_chunk(UnicodeValidator& state,
+            char* data, size_t n, bool replace);
+
+        /** Transcode one chunk of UTF-16 into UTF-8
+         *
+         *  @param[in,out] state   Carry state across chunk boundaries
+         *  @param[in]     data    Raw UTF-16 bytes (without BOM)
+         *  @param[in]     n       Valid bytes in data
+         *  @param[out]    out     Receives the UTF-8 transcoding
+         *  @param[in]     replace Emit U+FFFD for unpaired surrogates
+         *                         instead of failing
+         *
+         *  @return false if an unpaired surrogate was found and replace
+         *          is not set
+         */
+        CSV_INLINE bool transcode_utf16_chunk(UnicodeValidator& state,
+            const char* data, size_t n, std::string& out, bool replace);
+
+        CSV_INLINE BufferPtr parse(const ParseData& data, BufferPool* pool = nullptr,
+            ProjectionState* projection = nullptr, RowFilter* filter = nullptr,
+            size_t* peak_buffer_bytes = nullptr);
+
+        /** A two-symbol fast lane for formats with quoting disabled
+         *
+         *  With no quote state to track, only the delimiter and newlines are
+         *  special, so each field is one bulk copy between scanner hits.
+         *  Whitespace trimming, projection, and row filters are not
+         *  supported; such readers use the general parse() instead.
+         */
+        CSV_INLINE BufferPtr parse_no_quote(const ParseData& data, BufferPool* pool = nullptr,
+            size_t* peak_buffer_bytes = nullptr);
+
         CSV_INLINE void write_record(const ParseData& data);
 
+        /** A version of parse() whose delimiter and quote character are fixed
+         *  at compile time, allowing the compiler to fold the per-character
+         *  flag lookups into immediate compares and unroll the inner loop
+         *
+         *  @note Whitespace trimming is not supported by this kernel; formats
+         *        with trim characters must use the runtime-dispatched parse().
+         */
+        template<char Delim, char Quote>
+        BufferPtr parse_static(const ParseData& data, BufferPool* pool = nullptr) {
+            // Only used for the scalar tail of find_special()
+            static const ParseFlagMap flag_map = make_parse_flags(Delim, Quote);
+
+            auto& in = data.in;
+            auto& row_buffer = *(data.row_buffer.get());
+            auto& text_buffer = row_buffer.buffer;
+            auto& split_buffer = row_buffer.split_buffer;
+            text_buffer.reserve(in.size());
+            split_buffer.reserve(in.size() / 10);
+
+            for (size_t i = 0; i < in.size(); i++) {
+                switch (flag_for<Delim, Quote>(in[i])) {
+                case ParseFlags::DELIMITER:
+                    if (!data.quote_escape) {
+                        split_buffer.push_back((StrBufferPos)row_buffer.size());
+                        break;
+                    }
+
+                    HEDLEY_FALL_THROUGH;
+                case ParseFlags::NEWLINE:
+                    if (!data.quote_escape) {
+                        // End of record -> Write record
+                        if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
+                            ++i;
+
+                        data.records.push_back(CSVRow(data.row_buffer));
+                        break;
+                    }
+
+                    // Treat as regular character
+                    text_buffer += in[i];
+                    break;
+                case ParseFlags::NOT_SPECIAL: {
+                    const size_t start = i;
+                    i = find_special(in, flag_map.data(), i + 1, Delim, Quote) - 1;
+
+                    // Finally append text
+#ifdef CSV_HAS_CXX17
+                    text_buffer += in.substr(start, i - start + 1);
+#else
+                    for (size_t j = start; j < i + 1; j++) {
+                        text_buffer += in[j];
+                    }
+#endif
+
+                    break;
+                }
+                default: // Quote
+                    if (!data.quote_escape) {
+                        // Don't deref past beginning
+                        if (i && flag_for<Delim, Quote>(in[i - 1]) >= ParseFlags::DELIMITER) {
+                            // Case: Previous character was delimiter or newline
+                            data.quote_escape = true;
+                        }
+                    }
+                    else if (i + 1 < in.size()) {
+                        auto next_ch = flag_for<Delim, Quote>(in[i + 1]);
+                        if (next_ch >= ParseFlags::DELIMITER) {
+                            // Case: Delim or newline => end of field
+                            data.quote_escape = false;
+                            break;
+                        }
+
+                        // Case: Escaped quote
+                        text_buffer += in[i];
+
+                        // Note: Unescaped single quotes can be handled by the parser
+                        if (next_ch == ParseFlags::QUOTE)
+                            ++i;  // Case: Two consecutive quotes
+
+                    }
+
+                    break;
+                }
+            }
+
+            return row_buffer.reset(pool);
+        }
+
         /** Read the first 500KB of a CSV file */
         CSV_INLINE std::string get_csv_head(csv::string_view filename);
     }
@@ -8,7 +8,7 @@ namespace csv {
     /** Return an iterator to the first row in the reader */
     CSV_INLINE CSVReader::iterator CSVReader::begin() {
         if (this->records.empty()) {
-            this->read_csv();
+            this->fill_records();
         }
 
         CSVReader::iterator ret(this, std::move(this->records.front()));
@@ -55,7 +55,8 @@ namespace csv {
      *
      */
     CSV_INLINE CSVField CSVRow::operator[](size_t n) const {
-        return CSVField(this->get_string_view(n));
+        return CSVField(this->get_string_view(n),
+            this->buffer->col_names->get_type_hint(n));
     }
 
     /** Retrieve a value by its associated column name. If the column
@@ -71,12 +72,41 @@ namespace csv {
         auto & col_names = this->buffer->col_names;
         auto col_pos = col_names->index_of(col_name);
         if (col_pos > -1) {
+            // A known column that a ragged row is too short to contain
+            // reads as a null field (see VariableColumnPolicy::KEEP)
+            if ((size_t)col_pos >= this->size())
+                return CSVField(csv::string_view());
+
             return this->operator[](col_pos);
         }
 
         throw std::runtime_error("Can't find a column named " + col_name);
     }
 
+    /** Retrieve a value by a pre-resolved column handle, skipping the
+     *  per-access hash lookup that name-based retrieval performs.
+     *
+     *  @note Bounds checking still applies; a handle created by a
+     *        different reader throws an `std::runtime_error`.
+     *
+     *  @complexity
+     *  Constant, with no string hashing.
+     *
+     *  @param[in] handle Handle obtained from CSVReader::column()
+     */
+    CSV_INLINE CSVField CSVRow::operator[](const ColumnHandle& handle) const {
+        if (!this->buffer || this->buffer->col_names != handle.owner) {
+            throw std::runtime_error("Column handle for " + handle.col_name
+                + " does not belong to this row's reader.");
+        }
+
+        // Matches name-based lookup: missing columns of ragged rows are null
+        if (handle.idx >= this->size())
+            return CSVField(csv::string_view());
+
+        return this->operator[](handle.idx);
+    }
+
     CSV_INLINE CSVRow::operator std::vector<std::string>() const {
 
         std::vector<std::string> ret;
@@ -118,33 +148,22 @@ namespace csv {
     CSVRow::iterator::iterator(const CSVRow* _reader, int _i)
         : daddy(_reader), i(_i) {
         if (_i < (int)this->daddy->size())
-            this->field = std::make_shared<CSVField>(
-                this->daddy->operator[](_i));
-        else
-            this->field = nullptr;
+            this->field = this->daddy->operator[](_i);
     }
 
     CSV_INLINE CSVRow::iterator::reference CSVRow::iterator::operator*() const {
-        return *(this->field.get());
+        return this->field;
     }
 
     CSV_INLINE CSVRow::iterator::pointer CSVRow::iterator::operator->() const {
-        // Using CSVField * as pointer type causes segfaults in MSVC debug builds
-        #ifdef _MSC_BUILD
-        return this->field;
-        #else
-        return this->field.get();
-        #endif
+        return &(this->field);
     }
 
     CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator++() {
         // Pre-increment operator
         this->i++;
         if (this->i < (int)this->daddy->size())
-            this->field = std::make_shared<CSVField>(
-                this->daddy->operator[](i));
-        else // Reached the end of row
-            this->field = nullptr;
+            this->field = this->daddy->operator[](i);
         return *this;
     }
 
@@ -158,8 +177,7 @@ namespace csv {
     CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator--() {
         // Pre-decrement operator
         this->i--;
-        this->field = std::make_shared<CSVField>(
-            this->daddy->operator[](this->i));
+        this->field = this->daddy->operator[](this->i);
         return *this;
     }
 
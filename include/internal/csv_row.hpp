@@ -4,6 +4,7 @@
 
 #pragma once
 #include <math.h>
+#include <tuple> // For CSVRow::unpack()
 #include <vector>
 #include <string>
 #include <iterator>
@@ -23,10 +24,49 @@ namespace csv {
         static const std::string ERROR_FLOAT_TO_INT =
             "Attempted to convert a floating point value to an integral type.";
         static const std::string ERROR_NEG_TO_UNSIGNED = "Negative numbers cannot be converted to unsigned types.";
+        static const std::string ERROR_UNPACK_ROW_SIZE = "Row has fewer fields than unpack() destinations.";
     
         std::string json_escape_string(csv::string_view s) noexcept;
+        void json_append_escaped(std::string& result, csv::string_view s) noexcept;
     }
 
+    class CSVReader;
+
+    /** A column name resolved to its position exactly once, so loops that
+     *  access the same columns by name on every row pay an integer index
+     *  instead of a hash lookup per access.
+     *
+     *  Created by CSVReader::column() and passed to CSVRow::operator[].
+     *  A handle stays valid for every row produced by the reader that
+     *  created it.
+     */
+    class ColumnHandle {
+    public:
+        ColumnHandle() = default;
+
+        /** Position of the column within its rows */
+        size_t index() const { return this->idx; }
+
+        /** Name this handle was resolved from */
+        std::string name() const { return this->col_name; }
+
+    private:
+        friend class CSVReader;
+        friend class CSVRow;
+
+        ColumnHandle(size_t _idx, std::string _name,
+            std::shared_ptr<internals::ColNames> _owner) :
+            idx(_idx), col_name(std::move(_name)), owner(std::move(_owner)) {};
+
+        size_t idx = 0;       /**< Resolved column position */
+        std::string col_name; /**< Original column name */
+
+        /** The column table the handle was resolved against, compared by
+         *  identity to reject handles from a different reader
+         */
+        std::shared_ptr<internals::ColNames> owner = nullptr;
+    };
+
     /**
     * @class CSVField
     * @brief Data type representing individual CSV values.
@@ -34,8 +74,11 @@ namespace csv {
     */
     class CSVField {
     public:
-        /** Constructs a CSVField from a string_view */
-        constexpr explicit CSVField(csv::string_view _sv) : sv(_sv) { };
+        /** Constructs a CSVField from a string_view, optionally with the
+         *  column's expected DataType (see CSVReader::sample_types())
+         */
+        constexpr explicit CSVField(csv::string_view _sv, DataType _type_hint = UNKNOWN)
+            : sv(_sv), type_hint(_type_hint) { };
 
         operator std::string() const {
             return std::string("<CSVField> ") + std::string(this->sv);
@@ -171,12 +214,35 @@ namespace csv {
         long double value = 0;    /**< Cached numeric value */
         csv::string_view sv = ""; /**< A pointer to this field's text */
         DataType _type = UNKNOWN; /**< Cached data type value */
+        DataType type_hint = UNKNOWN; /**< Expected type of this field's column */
+
+        /** Returns true if this field's first character rules out any
+         *  numeric or null interpretation
+         */
+        CONSTEXPR bool is_clearly_string() const {
+            if (this->sv.empty()) return false;
+
+            const char ch = this->sv[0];
+            return !(ch >= '0' && ch <= '9') && ch != '-' && ch != '.' && ch != ' ';
+        }
+
         CONSTEXPR void get_value() {
             /* Check to see if value has been cached previously, if not
              * evaluate it
              */
             if (_type < 0) {
-                this->_type = internals::data_type(this->sv, &this->value);
+                // A column known to hold strings can often skip
+                // inference entirely
+                if (this->type_hint == CSV_STRING && this->is_clearly_string()) {
+                    this->_type = CSV_STRING;
+                    return;
+                }
+
+                // Try the exact integer fast path first; hard cases
+                // fall back to the long double parser
+                this->_type = internals::data_type_fast(this->sv, &this->value);
+                if (this->_type == UNKNOWN)
+                    this->_type = internals::data_type(this->sv, &this->value);
             }
         }
     };
@@ -209,15 +275,66 @@ namespace csv {
         ///@{
         CSVField operator[](size_t n) const;
         CSVField operator[](const std::string&) const;
+        CSVField operator[](const ColumnHandle&) const;
         csv::string_view get_string_view(size_t n) const;
         std::string to_json(const std::vector<std::string>& subset = {}) const;
         std::string to_json_array(const std::vector<std::string>& subset = {}) const;
+        void to_json_into(std::string& out, const std::vector<std::string>& subset = {}) const;
+        void to_json_array_into(std::string& out, const std::vector<std::string>& subset = {}) const;
 
         /** Convert this CSVRow into a vector of strings.
          *  **Note**: This is a less efficient method of
          *  accessing data than using the [] operator.
          */
         operator std::vector<std::string>() const;
+
+        /** Unpack this row's leading fields into typed destinations in one
+         *  linear pass — e.g. straight into the members of a user struct:
+         *
+         *  @code
+         *  struct Reading { std::string station; double temp; int count; };
+         *
+         *  Reading r;
+         *  row.unpack(r.station, r.temp, r.count);
+         *  @endcode
+         *
+         *  Strings are assigned in place (reusing the destination's
+         *  capacity), string_views alias the row's buffer, and numeric
+         *  destinations convert with the same checked machinery as
+         *  CSVField::get<T>() — no intermediate strings are created.
+         *
+         *  @throws std::runtime_error if the row has fewer fields than
+         *          destinations, or a field fails numeric conversion
+         */
+        template<typename... Ts>
+        void unpack(Ts&... dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_into<0>(dests...);
+        }
+
+        /** @copydoc unpack
+         *  Tuple overload, e.g. for a `std::tie` of struct members
+         */
+        template<typename... Ts>
+        void unpack(std::tuple<Ts...>& dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_tuple<0>(dests);
+        }
+
+        /** @copydoc unpack
+         *  Accepts the reference tuples std::tie produces
+         */
+        template<typename... Ts>
+        void unpack(std::tuple<Ts&...>&& dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_tuple<0>(dests);
+        }
         ///@}
 
         /** A random access iterator over the contents of a CSV row.
@@ -228,15 +345,7 @@ namespace csv {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
             using value_type = CSVField;
             using difference_type = int;
-
-            // Using CSVField * as pointer type causes segfaults in MSVC debug builds
-            // but using shared_ptr as pointer type won't compile in g++
-#ifdef _MSC_BUILD
-            using pointer = std::shared_ptr<CSVField>;
-#else
             using pointer = CSVField * ;
-#endif
-
             using reference = CSVField & ;
             using iterator_category = std::random_access_iterator_tag;
 #endif
@@ -264,9 +373,13 @@ namespace csv {
 #endif
 
         private:
-            const CSVRow * daddy = nullptr;            // Pointer to parent
-            std::shared_ptr<CSVField> field = nullptr; // Current field pointed at
-            int i = 0;                                 // Index of current field
+            const CSVRow * daddy = nullptr;        // Pointer to parent
+
+            // Current field pointed at. Held by value so iterating a row
+            // performs no heap allocations.
+            mutable CSVField field = CSVField("");
+
+            int i = 0;                             // Index of current field
         };
 
         /** A reverse iterator over the contents of a CSVRow. */
@@ -283,6 +396,49 @@ namespace csv {
         ///@}
 
     private:
+        /** @name unpack() helpers
+         *  One destination is filled per step, dispatching on its type
+         */
+        ///@{
+        /** Copy a field's bytes into a string, reusing its capacity */
+        void unpack_field(csv::string_view sv, std::string& dest) const {
+            dest.assign(sv.data(), sv.size());
+        }
+
+        /** Alias a field's bytes; only valid while this row is alive */
+        void unpack_field(csv::string_view sv, csv::string_view& dest) const {
+            dest = sv;
+        }
+
+        /** Convert a numeric field with CSVField's checked machinery */
+        template<typename T,
+            typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        void unpack_field(csv::string_view sv, T& dest) const {
+            dest = CSVField(sv).get<T>();
+        }
+
+        template<size_t I>
+        void unpack_into() const {}
+
+        template<size_t I, typename T, typename... Rest>
+        void unpack_into(T& dest, Rest&... rest) const {
+            this->unpack_field(this->get_string_view(I), dest);
+            this->unpack_into<I + 1>(rest...);
+        }
+
+        template<size_t I, typename... Ts>
+        typename std::enable_if<(I < sizeof...(Ts))>::type
+        unpack_tuple(std::tuple<Ts...>& dests) const {
+            this->unpack_field(this->get_string_view(I), std::get<I>(dests));
+            this->unpack_tuple<I + 1>(dests);
+        }
+
+        /** Base case: every destination has been filled */
+        template<size_t I, typename... Ts>
+        typename std::enable_if<I == sizeof...(Ts)>::type
+        unpack_tuple(std::tuple<Ts...>&) const {}
+        ///@}
+
         /** Get the index in CSVRow's text buffer where the n-th field begins */
         size_t split_at(size_t n) const;
 
@@ -290,6 +446,106 @@ namespace csv {
         internals::RowData data;               /**< Contains row string and column positions. */
     };
 
+    namespace internals {
+        /** A FIFO of CSVRow records backed by a preallocated power-of-two
+         *  ring, used for the parser-to-consumer row hand-off.
+         *
+         *  Unlike std::deque, pushing and popping in steady state performs
+         *  no allocation: slots are reused via move assignment, and the
+         *  contiguous backing array keeps draining loops prefetch-friendly.
+         *  When the queue outgrows its ring — bounded in practice by the
+         *  iteration chunk size — capacity doubles and the ring re-lays
+         *  itself out, so pathological inputs spill gracefully.
+         */
+        class RecordRing {
+        public:
+            /** An index-based iterator over the ring's logical order */
+            class iterator {
+            public:
+                #ifndef DOXYGEN_SHOULD_SKIP_THIS
+                using value_type = CSVRow;
+                using difference_type = std::ptrdiff_t;
+                using pointer = CSVRow*;
+                using reference = CSVRow&;
+                using iterator_category = std::forward_iterator_tag;
+                #endif
+
+                iterator(RecordRing* _ring, size_t _i) : ring(_ring), i(_i) {};
+
+                reference operator*() const { return (*this->ring)[this->i]; }
+                pointer operator->() const { return &(*this->ring)[this->i]; }
+                iterator& operator++() { this->i++; return *this; }
+                iterator operator+(difference_type n) const {
+                    return iterator(this->ring, this->i + (size_t)n);
+                }
+
+                bool operator==(const iterator& other) const { return this->i == other.i; }
+                bool operator!=(const iterator& other) const { return !operator==(other); }
+
+            private:
+                RecordRing* ring; /**< The ring being traversed */
+                size_t i;         /**< Logical position within it */
+            };
+
+            /** Initial ring size; must be a power of two */
+            static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+            RecordRing() : slots(DEFAULT_CAPACITY) {};
+
+            bool empty() const { return this->n == 0; }
+            size_t size() const { return this->n; }
+
+            /** Drop all records, keeping the ring's capacity for reuse */
+            void clear() {
+                while (this->n > 0) this->pop_front();
+                this->head = 0;
+            }
+
+            CSVRow& front() { return (*this)[0]; }
+            const CSVRow& front() const {
+                return this->slots[this->head & (this->slots.size() - 1)];
+            }
+
+            /** Retrieve the ith record in queue order */
+            CSVRow& operator[](size_t i) {
+                return this->slots[(this->head + i) & (this->slots.size() - 1)];
+            }
+
+            void push_back(CSVRow&& row) {
+                if (this->n == this->slots.size()) this->grow();
+                (*this)[this->n] = std::move(row);
+                this->n++;
+            }
+
+            void push_back(const CSVRow& row) { this->push_back(CSVRow(row)); }
+
+            void pop_front() {
+                // Release the slot's buffer reference; the slot itself is reused
+                this->front() = CSVRow();
+                this->head++;
+                this->n--;
+            }
+
+            iterator begin() { return iterator(this, 0); }
+            iterator end() { return iterator(this, this->n); }
+
+        private:
+            /** Double the ring, re-laying records out in queue order */
+            void grow() {
+                std::vector<CSVRow> bigger(this->slots.size() * 2);
+                for (size_t i = 0; i < this->n; i++)
+                    bigger[i] = std::move((*this)[i]);
+
+                this->slots.swap(bigger);
+                this->head = 0;
+            }
+
+            std::vector<CSVRow> slots; /**< Preallocated record storage */
+            size_t head = 0;           /**< Logical index of the oldest record */
+            size_t n = 0;              /**< Number of queued records */
+        };
+    }
+
 #pragma region CSVField::get Specializations
     /** Retrieve this field's original string */
     template<>
@@ -315,6 +571,43 @@ namespace csv {
 
         return this->value;
     }
+
+    /** Retrieve this field's value as a double, parsing directly from
+     *  text when possible and never performing long double arithmetic
+     */
+    template<>
+    CONSTEXPR double CSVField::get<double>() {
+        if (this->_type == UNKNOWN) {
+            double result = 0;
+            if (internals::fast_parse_double(this->sv, result))
+                return result;
+        }
+
+        if (this->type() <= CSV_STRING)
+            throw std::runtime_error(internals::ERROR_NAN);
+
+        return static_cast<double>(this->value);
+    }
+
+    /** Retrieve this field's value as a 64-bit integer, parsing directly
+     *  from text when possible and never performing long double arithmetic
+     */
+    template<>
+    CONSTEXPR long long CSVField::get<long long>() {
+        if (this->_type == UNKNOWN) {
+            long long result = 0;
+            if (internals::fast_parse_int64(this->sv, result))
+                return result;
+        }
+
+        if (this->type() <= CSV_STRING)
+            throw std::runtime_error(internals::ERROR_NAN);
+
+        if (this->is_float())
+            throw std::runtime_error(internals::ERROR_FLOAT_TO_INT);
+
+        return static_cast<long long>(this->value);
+    }
 #pragma endregion CSVField::get Specializations
 
     /** Compares the contents of this field to a string */
@@ -335,4 +628,23 @@ namespace csv {
 inline std::ostream& operator << (std::ostream& os, csv::CSVField const& value) {
     os << std::string(value);
     return os;
-}
\ No newline at end of file
+}
+#ifdef CSV_EXTERN_TEMPLATES
+namespace csv {
+    /** When consuming the compiled library (which defines
+     *  CSV_EXTERN_TEMPLATES via its CMake target), the common arithmetic
+     *  get<>() instantiations are compiled once into the library — see
+     *  csv_instantiations.cpp — instead of once per client translation
+     *  unit. Types below are those without a dedicated specialization
+     *  above. The single header is unaffected.
+     */
+    extern template short CSVField::get<short>();
+    extern template unsigned short CSVField::get<unsigned short>();
+    extern template int CSVField::get<int>();
+    extern template unsigned int CSVField::get<unsigned int>();
+    extern template long CSVField::get<long>();
+    extern template unsigned long CSVField::get<unsigned long>();
+    extern template unsigned long long CSVField::get<unsigned long long>();
+    extern template float CSVField::get<float>();
+}
+#endif
@@ -2,20 +2,25 @@
  *  Implements JSON serialization abilities
  */
 
+#include <ostream>
+
 #include "csv_row.hpp"
+#include "csv_reader.hpp"
+#include "csv_reader_internals.hpp" // For vectorized scanning kernels
+#include "csv_utility.hpp"
 
 namespace csv {
     /*
-    The implementations for json_extra_space() and json_escape_string()
-    were modified from source code for JSON for Modern C++.
+    The escaping logic in this file was modified from source code for
+    JSON for Modern C++.
 
     The respective license is below:
 
     The code is licensed under the [MIT
     License](http://opensource.org/licenses/MIT):
-    
+
     Copyright &copy; 2013-2015 Niels Lohmann.
-    
+
     Permission is hereby granted, free of charge, to any person
     obtaining a copy of this software and associated documentation files
     (the "Software"), to deal in the Software without restriction,
@@ -23,10 +28,10 @@ namespace csv {
     publish, distribute, sublicense, and/or sell copies of the Software,
     and to permit persons to whom the Software is furnished to do so,
     subject to the following conditions:
-    
+
     The above copyright notice and this permission notice shall be
     included in all copies or substantial portions of the Software.
-    
+
     THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
     EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
     MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
@@ -38,152 +43,130 @@ namespace csv {
     */
 
     namespace internals {
-        /*!
-         @brief calculates the extra space to escape a JSON string
-
-         @param[in] s  the string to escape
-         @return the number of characters required to escape string @a s
-
-         @complexity Linear in the length of string @a s.
-        */
-        static std::size_t json_extra_space(csv::string_view& s) noexcept
-        {
-            std::size_t result = 0;
-
-
-            for (const auto& c : s)
-            {
-                switch (c)
-                {
-                case '"':
-                case '\\':
-                case '\b':
-                case '\f':
-                case '\n':
-                case '\r':
-                case '\t':
-                {
-                    // from c (1 byte) to \x (2 bytes)
-                    result += 1;
-                    break;
-                }
-
-
-                default:
-                {
-                    if (c >= 0x00 && c <= 0x1f)
-                    {
-                        // from c (1 byte) to \uxxxx (6 bytes)
-                        result += 5;
-                    }
-                    break;
-                }
-                }
+        /** Find the first character requiring JSON escaping (a quote, a
+         *  backslash, or a control character) at or after position i,
+         *  comparing 16-32 bytes at a time where vector instructions are
+         *  available
+         *
+         *  @return Index of the first such character, or s.size() if none remain
+         */
+        static size_t find_json_special(csv::string_view s, size_t i) noexcept {
+#if defined(CSV_HAS_AVX2)
+            const __m256i quote_v = _mm256_set1_epi8('"'),
+                backslash_v = _mm256_set1_epi8('\\'),
+                ctrl_max_v = _mm256_set1_epi8(0x1f);
+
+            for (; i + 32 <= s.size(); i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(s.data() + i));
+
+                // Unsigned c <= 0x1f test: min(c, 0x1f) == c
+                __m256i is_ctrl = _mm256_cmpeq_epi8(
+                    _mm256_min_epu8(chunk, ctrl_max_v), chunk);
+                __m256i special = _mm256_or_si256(is_ctrl, _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chunk, quote_v),
+                    _mm256_cmpeq_epi8(chunk, backslash_v)));
+
+                unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
             }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i quote_v = _mm_set1_epi8('"'),
+                backslash_v = _mm_set1_epi8('\\'),
+                ctrl_max_v = _mm_set1_epi8(0x1f);
+
+            for (; i + 16 <= s.size(); i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(s.data() + i));
+
+                // Unsigned c <= 0x1f test: min(c, 0x1f) == c
+                __m128i is_ctrl = _mm_cmpeq_epi8(
+                    _mm_min_epu8(chunk, ctrl_max_v), chunk);
+                __m128i special = _mm_or_si128(is_ctrl, _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, quote_v),
+                    _mm_cmpeq_epi8(chunk, backslash_v)));
+
+                unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#endif
 
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < s.size(); i++) {
+                const unsigned char c = (unsigned char)s[i];
+                if (c <= 0x1f || c == '"' || c == '\\') break;
+            }
 
-            return result;
+            return i;
         }
 
-        CSV_INLINE std::string json_escape_string(csv::string_view s) noexcept
+        /** Append the JSON-escaped form of s to result. Runs of ordinary
+         *  characters — the overwhelmingly common case — are located with a
+         *  vectorized scan and appended in bulk.
+         */
+        CSV_INLINE void json_append_escaped(std::string& result, csv::string_view s) noexcept
         {
-            const auto space = json_extra_space(s);
-            if (space == 0)
-            {
-                return std::string(s);
-            }
-
-            // create a result string of necessary size
-            std::string result(s.size() + space, '\\');
-            std::size_t pos = 0;
+            size_t i = 0;
+            while (i < s.size()) {
+                const size_t j = find_json_special(s, i);
+                result.append(s.data() + i, j - i);
+                if (j == s.size()) return;
 
-            for (const auto& c : s)
-            {
+                const char c = s[j];
                 switch (c)
                 {
                 // quotation mark (0x22)
                 case '"':
-                {
-                    result[pos + 1] = '"';
-                    pos += 2;
+                    result += "\\\"";
                     break;
-                }
-
 
                 // reverse solidus (0x5c)
                 case '\\':
-                {
-                    // nothing to change
-                    pos += 2;
+                    result += "\\\\";
                     break;
-                }
-
 
                 // backspace (0x08)
                 case '\b':
-                {
-                    result[pos + 1] = 'b';
-                    pos += 2;
+                    result += "\\b";
                     break;
-                }
-
 
                 // formfeed (0x0c)
                 case '\f':
-                {
-                    result[pos + 1] = 'f';
-                    pos += 2;
+                    result += "\\f";
                     break;
-                }
-
 
                 // newline (0x0a)
                 case '\n':
-                {
-                    result[pos + 1] = 'n';
-                    pos += 2;
+                    result += "\\n";
                     break;
-                }
-
 
                 // carriage return (0x0d)
                 case '\r':
-                {
-                    result[pos + 1] = 'r';
-                    pos += 2;
+                    result += "\\r";
                     break;
-                }
-
 
                 // horizontal tab (0x09)
                 case '\t':
-                {
-                    result[pos + 1] = 't';
-                    pos += 2;
+                    result += "\\t";
                     break;
-                }
-
 
                 default:
                 {
-                    if (c >= 0x00 && c <= 0x1f)
-                    {
-                        // print character c as \uxxxx
-                        sprintf(&result[pos + 1], "u%04x", int(c));
-                        pos += 6;
-                        // overwrite trailing null character
-                        result[pos] = '\\';
-                    }
-                    else
-                    {
-                        // all other characters are added as-is
-                        result[pos++] = c;
-                    }
+                    // print character c as \uxxxx
+                    char unicode[8];
+                    snprintf(unicode, sizeof(unicode), "\\u%04x", int(c));
+                    result += unicode;
                     break;
                 }
                 }
+
+                i = j + 1;
             }
+        }
 
+        CSV_INLINE std::string json_escape_string(csv::string_view s) noexcept
+        {
+            std::string result;
+            result.reserve(s.size());
+            json_append_escaped(result, s);
             return result;
         }
     }
@@ -196,34 +179,53 @@ namespace csv {
      *                    Leave empty for original columns.
      */
     CSV_INLINE std::string CSVRow::to_json(const std::vector<std::string>& subset) const {
+        std::string ret;
+        this->to_json_into(ret, subset);
+        return ret;
+    }
+
+    /** Append this row's JSON object representation to out.
+     *
+     *  Unlike to_json(), this reuses the caller's buffer, so tight export
+     *  loops can serialize millions of rows into one grow-once allocation.
+     *
+     *  @param[out] out    Buffer the JSON object is appended to
+     *  @param[in]  subset A subset of columns to contain in the JSON.
+     *                     Leave empty for original columns.
+     */
+    CSV_INLINE void CSVRow::to_json_into(std::string& out, const std::vector<std::string>& subset) const {
         std::vector<std::string> col_names = subset;
         if (subset.empty()) {
             col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
         }
 
         const size_t _n_cols = col_names.size();
-        std::string ret = "{";
-        
+        out += '{';
+
         for (size_t i = 0; i < _n_cols; i++) {
             auto& col = col_names[i];
             auto field = this->operator[](col);
 
-            // TODO: Possible performance enhancements by caching escaped column names
-            ret += '"' + internals::json_escape_string(col) + "\":";
+            out += '"';
+            internals::json_append_escaped(out, col);
+            out += "\":";
 
             // Add quotes around strings but not numbers
-            if (field.is_num())
-                 ret += internals::json_escape_string(field.get<csv::string_view>());
-            else
-                ret += '"' + internals::json_escape_string(field.get<csv::string_view>()) + '"';
+            if (field.is_num()) {
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+            }
+            else {
+                out += '"';
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+                out += '"';
+            }
 
             // Do not add comma after last string
             if (i + 1 < _n_cols)
-                ret += ',';
+                out += ',';
         }
 
-        ret += '}';
-        return ret;
+        out += '}';
     }
 
     /** Convert a CSV row to a JSON array, i.e.
@@ -234,28 +236,79 @@ namespace csv {
      *                    Leave empty for all columns.
      */
     CSV_INLINE std::string CSVRow::to_json_array(const std::vector<std::string>& subset) const {
+        std::string ret;
+        this->to_json_array_into(ret, subset);
+        return ret;
+    }
+
+    /** Append this row's JSON array representation to out.
+     *
+     *  @param[out] out    Buffer the JSON array is appended to
+     *  @param[in]  subset A subset of columns to contain in the JSON.
+     *                     Leave empty for all columns.
+     *  @see CSVRow::to_json_into()
+     */
+    CSV_INLINE void CSVRow::to_json_array_into(std::string& out, const std::vector<std::string>& subset) const {
         std::vector<std::string> col_names = subset;
         if (subset.empty())
             col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
 
         const size_t _n_cols = col_names.size();
-        std::string ret = "[";
+        out += '[';
 
         for (size_t i = 0; i < _n_cols; i++) {
             auto field = this->operator[](col_names[i]);
 
             // Add quotes around strings but not numbers
-            if (field.is_num())
-                ret += internals::json_escape_string(field.get<csv::string_view>());
-            else
-                ret += '"' + internals::json_escape_string(field.get<csv::string_view>()) + '"';
+            if (field.is_num()) {
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+            }
+            else {
+                out += '"';
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+                out += '"';
+            }
 
             // Do not add comma after last string
             if (i + 1 < _n_cols)
-                ret += ',';
+                out += ',';
         }
 
-        ret += ']';
-        return ret;
+        out += ']';
+    }
+
+    /** Export every remaining row of reader as JSON Lines.
+     *
+     *  Rows are serialized with CSVRow::to_json_into() into one reused
+     *  buffer which is flushed to out in large blocks, so export cost is
+     *  dominated by the (vectorized) escape scan rather than allocation.
+     *
+     *  @param[in]  reader The CSV source; consumed to end of file
+     *  @param[out] out    Stream receiving one JSON object per line
+     *
+     *  @return Number of rows written
+     */
+    CSV_INLINE RowCount to_jsonl(CSVReader& reader, std::ostream& out) {
+        constexpr size_t FLUSH_AT = 1048576; // 1MB
+
+        std::string buffer;
+        buffer.reserve(2 * FLUSH_AT);
+
+        RowCount written = 0;
+        CSVRow row;
+
+        while (reader.read_row(row)) {
+            row.to_json_into(buffer);
+            buffer += '\n';
+            written++;
+
+            if (buffer.size() >= FLUSH_AT) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+
+        out.write(buffer.data(), buffer.size());
+        return written;
     }
-}
\ No newline at end of file
+}
@@ -2,12 +2,408 @@
  *  Calculates statistics from CSV files
  */
 
+#include <algorithm>
+#include <cstring> // For std::memcpy()
+#include <mutex>
 #include <string>
 #include "csv_stat.hpp"
 
 namespace csv {
-    CSV_INLINE CSVStat::CSVStat(csv::string_view filename, CSVFormat format) :
-        CSVReader(filename, format) {
+    namespace internals {
+        /** Numeric values per column buffered before a vectorized flush */
+        static const size_t STAT_BATCH_SIZE = 4096;
+
+        /** Sum, minimum, and maximum of a contiguous batch in one
+         *  vectorized pass
+         *
+         *  @pre n > 0
+         */
+        static void reduce_batch(const double* x, size_t n,
+            double& sum, double& min, double& max) {
+            sum = 0;
+            min = x[0];
+            max = x[0];
+
+            size_t i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            if (n >= 4) {
+                __m256d sum_v = _mm256_setzero_pd(),
+                        min_v = _mm256_loadu_pd(x),
+                        max_v = min_v;
+
+                for (; i + 4 <= n; i += 4) {
+                    __m256d chunk = _mm256_loadu_pd(x + i);
+                    sum_v = _mm256_add_pd(sum_v, chunk);
+                    min_v = _mm256_min_pd(min_v, chunk);
+                    max_v = _mm256_max_pd(max_v, chunk);
+                }
+
+                double lanes[4];
+                _mm256_storeu_pd(lanes, sum_v);
+                sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+                _mm256_storeu_pd(lanes, min_v);
+                min = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+
+                _mm256_storeu_pd(lanes, max_v);
+                max = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            }
+#elif defined(CSV_HAS_SSE2)
+            if (n >= 2) {
+                __m128d sum_v = _mm_setzero_pd(),
+                        min_v = _mm_loadu_pd(x),
+                        max_v = min_v;
+
+                for (; i + 2 <= n; i += 2) {
+                    __m128d chunk = _mm_loadu_pd(x + i);
+                    sum_v = _mm_add_pd(sum_v, chunk);
+                    min_v = _mm_min_pd(min_v, chunk);
+                    max_v = _mm_max_pd(max_v, chunk);
+                }
+
+                double lanes[2];
+                _mm_storeu_pd(lanes, sum_v);
+                sum = lanes[0] + lanes[1];
+
+                _mm_storeu_pd(lanes, min_v);
+                min = std::min(lanes[0], lanes[1]);
+
+                _mm_storeu_pd(lanes, max_v);
+                max = std::max(lanes[0], lanes[1]);
+            }
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < n; i++) {
+                sum += x[i];
+                if (x[i] < min) min = x[i];
+                if (x[i] > max) max = x[i];
+            }
+        }
+
+        /** Sum of squared deviations from a known mean, vectorized.
+         *  Part of the numerically stable two-pass variance: the batch
+         *  mean comes from reduce_batch() first.
+         */
+        static double sumsq_deviations(const double* x, size_t n, double mean) {
+            double sumsq = 0;
+            size_t i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            const __m256d mean_v4 = _mm256_set1_pd(mean);
+            __m256d sumsq_v4 = _mm256_setzero_pd();
+
+            for (; i + 4 <= n; i += 4) {
+                __m256d delta = _mm256_sub_pd(_mm256_loadu_pd(x + i), mean_v4);
+                sumsq_v4 = _mm256_add_pd(sumsq_v4, _mm256_mul_pd(delta, delta));
+            }
+
+            double lanes4[4];
+            _mm256_storeu_pd(lanes4, sumsq_v4);
+            sumsq = lanes4[0] + lanes4[1] + lanes4[2] + lanes4[3];
+#elif defined(CSV_HAS_SSE2)
+            const __m128d mean_v2 = _mm_set1_pd(mean);
+            __m128d sumsq_v2 = _mm_setzero_pd();
+
+            for (; i + 2 <= n; i += 2) {
+                __m128d delta = _mm_sub_pd(_mm_loadu_pd(x + i), mean_v2);
+                sumsq_v2 = _mm_add_pd(sumsq_v2, _mm_mul_pd(delta, delta));
+            }
+
+            double lanes2[2];
+            _mm_storeu_pd(lanes2, sumsq_v2);
+            sumsq = lanes2[0] + lanes2[1];
+#endif
+
+            for (; i < n; i++) {
+                const double delta = x[i] - mean;
+                sumsq += delta * delta;
+            }
+
+            return sumsq;
+        }
+
+        CSV_INLINE size_t FreqCounter::hash(csv::string_view value) {
+            // FNV-1a
+            size_t h = (size_t)14695981039346656037ULL;
+            for (char ch : value) {
+                h ^= (unsigned char)ch;
+                h *= (size_t)1099511628211ULL;
+            }
+            return h;
+        }
+
+        CSV_INLINE csv::string_view FreqCounter::copy_to_arena(csv::string_view value) {
+            if (this->arena.empty() || this->arena_used + value.size() > ARENA_BLOCK_SIZE) {
+                // Oversized values get a block of their own
+                this->arena.push_back(std::unique_ptr<char[]>(
+                    new char[std::max(value.size(), (size_t)ARENA_BLOCK_SIZE)]));
+                this->arena_used = 0;
+            }
+
+            char * dest = this->arena.back().get() + this->arena_used;
+            std::memcpy(dest, value.data(), value.size());
+            this->arena_used += value.size();
+
+            return csv::string_view(dest, value.size());
+        }
+
+        CSV_INLINE void FreqCounter::rehash(size_t new_capacity) {
+            // Keys point into the arena, not the old table, so they
+            // can simply be reinserted
+            std::vector<Entry> old_slots(new_capacity);
+            old_slots.swap(this->slots);
+
+            const size_t mask = this->slots.size() - 1;
+            for (auto& entry : old_slots) {
+                if (entry.count == 0) continue;
+
+                size_t pos = hash(entry.key) & mask;
+                while (this->slots[pos].count > 0)
+                    pos = (pos + 1) & mask;
+
+                this->slots[pos] = entry;
+            }
+        }
+
+        CSV_INLINE void FreqCounter::add(csv::string_view value, RowCount count) {
+            // Keep the load factor below 0.7
+            if ((this->n_entries + 1) * 10 >= this->slots.size() * 7)
+                this->rehash(this->slots.size() * 2);
+
+            const size_t mask = this->slots.size() - 1;
+            size_t pos = hash(value) & mask;
+
+            while (this->slots[pos].count > 0) {
+                if (this->slots[pos].key == value) {
+                    this->slots[pos].count += count;
+                    return;
+                }
+
+                pos = (pos + 1) & mask;
+            }
+
+            this->slots[pos].key = this->copy_to_arena(value);
+            this->slots[pos].count = count;
+            this->n_entries++;
+        }
+
+        CSV_INLINE void FreqCounter::merge(const FreqCounter& other) {
+            for (auto& entry : other.slots) {
+                if (entry.count > 0)
+                    this->add(entry.key, entry.count);
+            }
+        }
+
+        CSV_INLINE std::unordered_map<std::string, RowCount> FreqCounter::to_map() const {
+            std::unordered_map<std::string, RowCount> ret;
+            for (auto& entry : this->slots) {
+                if (entry.count > 0)
+                    ret[std::string(entry.key)] = entry.count;
+            }
+            return ret;
+        }
+
+        CSV_INLINE void QuantileSketch::add(long double x) {
+            this->buffer.push_back(x);
+            this->total_weight++;
+
+            if (this->buffer.size() >= BUFFER_LIMIT)
+                this->compress();
+        }
+
+        CSV_INLINE void QuantileSketch::merge(const QuantileSketch& other) {
+            other.compress();
+
+            for (auto& centroid : other.centroids)
+                this->centroids.push_back(centroid);
+
+            this->total_weight += other.total_weight;
+            this->compress();
+        }
+
+        CSV_INLINE void QuantileSketch::compress() const {
+            for (auto x : this->buffer)
+                this->centroids.push_back({ x, 1 });
+            this->buffer.clear();
+
+            if (this->centroids.empty()) return;
+
+            std::sort(this->centroids.begin(), this->centroids.end(),
+                [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+            // Merge adjacent centroids as long as the result stays under
+            // the t-digest size bound, which shrinks towards the tails
+            std::vector<Centroid> merged = { this->centroids.front() };
+            long double cumulative = 0;
+
+            for (size_t i = 1; i < this->centroids.size(); i++) {
+                auto& candidate = this->centroids[i];
+                auto& tail = merged.back();
+
+                long double proposed = tail.weight + candidate.weight;
+                long double q = (cumulative + proposed / 2) / this->total_weight;
+                long double limit = 4 * this->total_weight * q * (1 - q) / COMPRESSION;
+
+                if (proposed <= limit) {
+                    tail.mean = (tail.mean * tail.weight + candidate.mean * candidate.weight) / proposed;
+                    tail.weight = proposed;
+                }
+                else {
+                    cumulative += tail.weight;
+                    merged.push_back(candidate);
+                }
+            }
+
+            this->centroids = std::move(merged);
+        }
+
+        CSV_INLINE long double QuantileSketch::quantile(double q) const {
+            this->compress();
+
+            if (this->centroids.empty()) return NAN;
+            if (q < 0) q = 0;
+            if (q > 1) q = 1;
+
+            // Walk the cumulative weight to the target, interpolating
+            // linearly between neighboring centroid midpoints
+            const long double target = (long double)q * this->total_weight;
+            long double cumulative = 0;
+            long double prev_mid = 0;
+            long double prev_mean = this->centroids.front().mean;
+
+            for (size_t i = 0; i < this->centroids.size(); i++) {
+                auto& centroid = this->centroids[i];
+                long double mid = cumulative + centroid.weight / 2;
+
+                if (mid >= target) {
+                    if (i == 0 || mid == prev_mid) return centroid.mean;
+                    return prev_mean + (centroid.mean - prev_mean) * (target - prev_mid) / (mid - prev_mid);
+                }
+
+                cumulative += centroid.weight;
+                prev_mid = mid;
+                prev_mean = centroid.mean;
+            }
+
+            return this->centroids.back().mean;
+        }
+
+        CSV_INLINE unsigned long long CardinalitySketch::hash(csv::string_view value) {
+            // FNV-1a followed by a finalizer to improve avalanche behavior
+            unsigned long long h = 14695981039346656037ULL;
+            for (char ch : value) {
+                h ^= (unsigned char)ch;
+                h *= 1099511628211ULL;
+            }
+
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebULL;
+            h ^= h >> 31;
+            return h;
+        }
+
+        CSV_INLINE void CardinalitySketch::add(csv::string_view value) {
+            unsigned long long h = hash(value);
+
+            // The top PRECISION bits pick a register; the position of the
+            // first set bit among the rest is the register's rank
+            size_t idx = (size_t)(h >> (64 - PRECISION));
+
+            unsigned long long bits = (h << PRECISION) | (1ULL << (PRECISION - 1));
+            unsigned char rank = 1;
+            while ((bits & 0x8000000000000000ULL) == 0) {
+                rank++;
+                bits <<= 1;
+            }
+
+            if (rank > this->registers[idx])
+                this->registers[idx] = rank;
+        }
+
+        CSV_INLINE void CardinalitySketch::merge(const CardinalitySketch& other) {
+            for (size_t i = 0; i < this->registers.size(); i++) {
+                if (other.registers[i] > this->registers[i])
+                    this->registers[i] = other.registers[i];
+            }
+        }
+
+        CSV_INLINE RowCount CardinalitySketch::estimate() const {
+            const size_t m = this->registers.size();
+
+            long double sum = 0;
+            size_t zeros = 0;
+            for (auto r : this->registers) {
+                sum += powl(2.0L, -(long double)r);
+                if (r == 0) zeros++;
+            }
+
+            long double alpha = 0.7213L / (1 + 1.079L / m);
+            long double raw = alpha * m * m / sum;
+
+            // Small range correction: fall back to linear counting
+            if (raw <= 2.5L * m && zeros > 0)
+                raw = m * logl((long double)m / zeros);
+
+            return (RowCount)(raw + 0.5L);
+        }
+
+        CSV_INLINE void HeavyHitterSketch::add(csv::string_view value, RowCount count) {
+            std::string key = std::string(value);
+
+            auto it = this->items.find(key);
+            if (it != this->items.end()) {
+                it->second += count;
+                return;
+            }
+
+            if (this->items.size() < this->capacity) {
+                this->items[std::move(key)] = count;
+                return;
+            }
+
+            // Space-saving: replace the smallest entry, inheriting its
+            // count as the new entry's error bound
+            auto min_it = this->items.begin();
+            for (auto curr = this->items.begin(); curr != this->items.end(); ++curr) {
+                if (curr->second < min_it->second)
+                    min_it = curr;
+            }
+
+            RowCount inherited = min_it->second;
+            this->items.erase(min_it);
+            this->items[std::move(key)] = inherited + count;
+        }
+
+        CSV_INLINE void HeavyHitterSketch::merge(const HeavyHitterSketch& other) {
+            for (auto& item : other.items)
+                this->items[item.first] += item.second;
+
+            this->trim();
+        }
+
+        CSV_INLINE void HeavyHitterSketch::trim() {
+            while (this->items.size() > this->capacity) {
+                auto min_it = this->items.begin();
+                for (auto curr = this->items.begin(); curr != this->items.end(); ++curr) {
+                    if (curr->second < min_it->second)
+                        min_it = curr;
+                }
+
+                this->items.erase(min_it);
+            }
+        }
+
+        CSV_INLINE std::unordered_map<std::string, RowCount> HeavyHitterSketch::to_map() const {
+            return this->items;
+        }
+    }
+
+    CSV_INLINE CSVStat::CSVStat(csv::string_view filename, CSVFormat format, StatsMode mode) :
+        CSVReader(filename, format), mode(mode) {
         /** Lazily calculate statistics for a potentially large file. Once this constructor
          *  is called, CSVStat will process the entire file iteratively. Once finished,
          *  methods like get_mean(), get_counts(), etc... can be used to retrieve statistics.
@@ -66,7 +462,7 @@ namespace csv {
     CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_counts() const {
         std::vector<FreqCount> ret;
         for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->counts[i]);
+            ret.push_back(this->counts[i].to_map());
         }
         return ret;
     }
@@ -80,9 +476,56 @@ namespace csv {
         return ret;
     }
 
+    /** Estimate the q-th quantile of each column via t-digest sketches
+     *
+     *  @param[in] q Quantile to estimate, between 0 and 1
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<long double> CSVStat::get_quantile(double q) const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<long double> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->quantile_sketches[i].quantile(q));
+        }
+        return ret;
+    }
+
+    /** Estimate the number of distinct values in each column via HyperLogLog
+     *
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<RowCount> CSVStat::get_cardinality() const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<RowCount> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->cardinality_sketches[i].estimate());
+        }
+        return ret;
+    }
+
+    /** Get the most frequent values of each column via space-saving sketches.
+     *  Counts are upper bounds on the true frequencies.
+     *
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_top_values() const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<FreqCount> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->top_value_sketches[i].to_map());
+        }
+        return ret;
+    }
+
     CSV_INLINE void CSVStat::calc() {
         /** Go through all records and calculate specified statistics */
-        for (size_t i = 0; i < this->col_names->size(); i++) {
+        while (this->rolling_means.size() < this->col_names->size()) {
             dtypes.push_back({});
             counts.push_back({});
             rolling_means.push_back(0);
@@ -90,127 +533,203 @@ namespace csv {
             mins.push_back(NAN);
             maxes.push_back(NAN);
             n.push_back(0);
+
+            if (this->mode == StatsMode::APPROXIMATE) {
+                quantile_sketches.push_back({});
+                cardinality_sketches.push_back({});
+                top_value_sketches.push_back({});
+            }
         }
 
+        // Shard rows across threads; each shard computes partial aggregates
+        // for every column, which are merged once all threads have finished
+        size_t n_threads = (size_t)std::thread::hardware_concurrency();
+        if (n_threads == 0) n_threads = 1;
+        n_threads = std::min(n_threads, std::max<size_t>(this->records.size() / 1000, 1));
+
+        const size_t shard_size = this->records.size() / n_threads;
+
+        std::vector<std::vector<ColumnStats>> partials;
+        for (size_t t = 0; t < n_threads; t++)
+            partials.emplace_back(this->col_names->size());
+
         std::vector<std::thread> pool;
 
+        // Exceptions can't propagate out of worker threads directly,
+        // so the first one is captured and rethrown after the join
+        std::exception_ptr worker_error = nullptr;
+        std::mutex error_lock;
+
         // Start threads
-        for (size_t i = 0; i < this->col_names->size(); i++)
-            pool.push_back(std::thread(&CSVStat::calc_worker, this, i));
+        for (size_t t = 0; t < n_threads; t++) {
+            auto begin = this->records.begin() + (std::ptrdiff_t)(t * shard_size);
+            auto end = (t + 1 == n_threads) ? this->records.end()
+                : begin + (std::ptrdiff_t)shard_size;
+
+            pool.push_back(std::thread([this, begin, end, t, &partials, &worker_error, &error_lock] {
+                try {
+                    this->calc_shard(begin, end, partials[t]);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (!worker_error) worker_error = std::current_exception();
+                }
+            }));
+        }
 
         // Block until done
         for (auto& th: pool)
             th.join();
 
+        if (worker_error)
+            std::rethrow_exception(worker_error);
+
+        for (auto& partial : partials)
+            this->merge_stats(partial);
+
         this->records.clear();
     }
 
-    CSV_INLINE void CSVStat::calc_worker(const size_t &i) {
-        /** Worker thread for CSVStat::calc() which calculates statistics for one column.
-         * 
-         *  @param[in] i Column index
+    CSV_INLINE void CSVStat::calc_shard(
+        internals::RecordRing::iterator begin,
+        internals::RecordRing::iterator end,
+        std::vector<ColumnStats>& stats) {
+        /** Worker thread for CSVStat::calc() which computes partial statistics
+         *  for every column over a contiguous range of rows
+         *
+         *  @param[in]  begin Iterator to the first row in this shard
+         *  @param[in]  end   Iterator past the last row in this shard
+         *  @param[out] stats Partial aggregates, one entry per column
          */
-
-        auto current_record = this->records.begin();
-        for (size_t processed = 0; current_record != this->records.end(); processed++) {
-            if (current_record->size() == this->n_cols) {
-                auto current_field = (*current_record)[i];
-
-                // Optimization: Don't count() if there's too many distinct values in the first 1000 rows
-                if (processed < 1000 || this->counts[i].size() <= 500)
-                    this->count(current_field, i);
-
-                this->dtype(current_field, i);
-
-                // Numeric Stuff
-                if (current_field.is_num()) {
-                    long double x_n = current_field.get<long double>();
-
-                    // This actually calculates mean AND variance
-                    this->variance(x_n, i);
-                    this->min_max(x_n, i);
+        const size_t _n_cols = this->col_names->size();
+
+        size_t processed = 0;
+        for (auto it = begin; it != end; ++it, processed++) {
+            if (it->size() == _n_cols) {
+                for (size_t i = 0; i < _n_cols; i++) {
+                    auto current_field = (*it)[i];
+                    auto& col = stats[i];
+
+                    if (this->mode == StatsMode::APPROXIMATE) {
+                        auto sv = current_field.get<csv::string_view>();
+                        col.cardinality.add(sv);
+                        col.top_values.add(sv);
+                    }
+                    // Optimization: Don't count if there's too many distinct values in the first 1000 rows
+                    else if (processed < 1000 || col.counts.size() <= 500) {
+                        col.counts.add(current_field.get<csv::string_view>());
+                    }
+
+                    col.dtypes[current_field.type()]++;
+
+                    // Numeric Stuff
+                    if (current_field.is_num()) {
+                        long double x_n = current_field.get<long double>();
+
+                        if (this->mode == StatsMode::APPROXIMATE)
+                            col.quantiles.add(x_n);
+
+                        // Buffer the value; mean/variance/min/max are
+                        // computed over whole batches by flush_numeric()
+                        col.pending.push_back((double)x_n);
+                        if (col.pending.size() >= internals::STAT_BATCH_SIZE)
+                            flush_numeric(col);
+                    }
                 }
             }
             else if (this->format.get_variable_column_policy() == VariableColumnPolicy::THROW) {
-                throw std::runtime_error("Line has different length than the others " + internals::format_row(*current_record));
+                throw std::runtime_error("Line has different length than the others " + internals::format_row(*it));
             }
-
-            ++current_record;
         }
+
+        for (auto& col : stats)
+            flush_numeric(col);
     }
 
-    CSV_INLINE void CSVStat::dtype(CSVField& data, const size_t &i) {
-        /** Given a record update the type counter
-         *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
-         */
-        
-        auto type = data.type();
-        if (this->dtypes[i].find(type) !=
-            this->dtypes[i].end()) {
-            // Increment count
-            this->dtypes[i][type]++;
-        } else {
-            // Initialize count
-            this->dtypes[i].insert(std::make_pair(type, 1));
-        }
-    }
-
-    CSV_INLINE void CSVStat::count(CSVField& data, const size_t &i) {
-        /** Given a record update the frequency counter
-         *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
+    CSV_INLINE void CSVStat::flush_numeric(ColumnStats& col) {
+        /** Fold a column's buffered numeric values into its partial
+         *  aggregates. The batch's sum, minimum, maximum, and sum of
+         *  squared deviations are each computed by a vectorized kernel
+         *  over the contiguous buffer, then combined with the running
+         *  aggregates using the same parallel Welford form (Chan et al.)
+         *  that merge_stats() uses across shards.
          */
+        const size_t batch_n = col.pending.size();
+        if (batch_n == 0) return;
 
-        auto item = data.get<std::string>();
+        double sum, batch_min, batch_max;
+        internals::reduce_batch(col.pending.data(), batch_n, sum, batch_min, batch_max);
+
+        const double batch_mean = sum / (double)batch_n;
+        const double batch_m2 = internals::sumsq_deviations(
+            col.pending.data(), batch_n, batch_mean);
+
+        if (col.n == 0) {
+            col.mean = batch_mean;
+            col.m2 = batch_m2;
+        }
+        else {
+            long double combined_n = col.n + (long double)batch_n;
+            long double delta = (long double)batch_mean - col.mean;
 
-        if (this->counts[i].find(item) !=
-            this->counts[i].end()) {
-            // Increment count
-            this->counts[i][item]++;
-        } else {
-            // Initialize count
-            this->counts[i].insert(std::make_pair(item, 1));
+            col.m2 += batch_m2 + delta * delta * (col.n * (long double)batch_n / combined_n);
+            col.mean += delta * ((long double)batch_n / combined_n);
         }
+
+        col.n += (long double)batch_n;
+
+        if (isnan(col.min) || batch_min < col.min)
+            col.min = batch_min;
+        if (isnan(col.max) || batch_max > col.max)
+            col.max = batch_max;
+
+        col.pending.clear();
     }
 
-    CSV_INLINE void CSVStat::min_max(const long double &x_n, const size_t &i) {
-        /** Update current minimum and maximum
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
+    CSV_INLINE void CSVStat::merge_stats(std::vector<ColumnStats>& partial) {
+        /** Fold one shard's partial aggregates into the rolling totals,
+         *  combining means and variances with the parallel form of
+         *  Welford's Algorithm (Chan et al.)
+         *
+         *  @param[in] partial Aggregates computed by one calc_shard() call
          */
-        if (isnan(this->mins[i]))
-            this->mins[i] = x_n;
-        if (isnan(this->maxes[i]))
-            this->maxes[i] = x_n;
-        
-        if (x_n < this->mins[i])
-            this->mins[i] = x_n;
-        else if (x_n > this->maxes[i])
-            this->maxes[i] = x_n;
-    }
-
-    CSV_INLINE void CSVStat::variance(const long double &x_n, const size_t &i) {
-        /** Given a record update rolling mean and variance for all columns
-         *  using Welford's Algorithm
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
-         */
-        long double& current_rolling_mean = this->rolling_means[i];
-        long double& current_rolling_var = this->rolling_vars[i];
-        long double& current_n = this->n[i];
-        long double delta;
-        long double delta2;
-
-        current_n++;
-        
-        if (current_n == 1) {
-            current_rolling_mean = x_n;
-        } else {
-            delta = x_n - current_rolling_mean;
-            current_rolling_mean += delta/current_n;
-            delta2 = x_n - current_rolling_mean;
-            current_rolling_var += delta*delta2;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            auto& col = partial[i];
+
+            this->counts[i].merge(col.counts);
+
+            if (this->mode == StatsMode::APPROXIMATE) {
+                this->quantile_sketches[i].merge(col.quantiles);
+                this->cardinality_sketches[i].merge(col.cardinality);
+                this->top_value_sketches[i].merge(col.top_values);
+            }
+
+            for (auto& item : col.dtypes)
+                this->dtypes[i][item.first] += item.second;
+
+            if (col.n > 0) {
+                long double& current_n = this->n[i];
+
+                if (current_n == 0) {
+                    this->rolling_means[i] = col.mean;
+                    this->rolling_vars[i] = col.m2;
+                }
+                else {
+                    long double combined_n = current_n + col.n;
+                    long double delta = col.mean - this->rolling_means[i];
+
+                    this->rolling_vars[i] += col.m2 +
+                        delta * delta * (current_n * col.n / combined_n);
+                    this->rolling_means[i] += delta * (col.n / combined_n);
+                }
+
+                current_n += col.n;
+
+                if (isnan(this->mins[i]) || (!isnan(col.min) && col.min < this->mins[i]))
+                    this->mins[i] = col.min;
+                if (isnan(this->maxes[i]) || (!isnan(col.max) && col.max > this->maxes[i]))
+                    this->maxes[i] = col.max;
+            }
         }
     }
 
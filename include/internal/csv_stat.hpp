@@ -3,11 +3,157 @@
  */
 
 #pragma once
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include "csv_reader.hpp"
 
 namespace csv {
+    /** Controls how much memory CSVStat spends on per-column statistics
+     *
+     *  In APPROXIMATE mode, exact frequency counting is replaced with
+     *  bounded-memory sketches: quantiles, distinct-count estimates, and
+     *  top values become available through get_quantile(),
+     *  get_cardinality(), and get_top_values(), while get_counts()
+     *  returns empty maps. A few MB per column suffice for any file size.
+     */
+    enum class StatsMode {
+        EXACT,
+        APPROXIMATE
+    };
+
+    namespace internals {
+        /** A frequency counter keyed by string_view into an append-only
+         *  arena. Each distinct value is copied exactly once, on first
+         *  sight; counting an already-seen value performs no allocations.
+         *  Lookups use an open-addressing table with linear probing.
+         */
+        class FreqCounter {
+        public:
+            /** One occupied slot in the table. A count of zero marks an empty slot. */
+            struct Entry {
+                csv::string_view key;
+                RowCount count = 0;
+            };
+
+            FreqCounter() : slots(INITIAL_CAPACITY) {};
+
+            /** Add count occurrences of value, copying it into the arena if new */
+            void add(csv::string_view value, RowCount count = 1);
+
+            /** Fold another counter's entries into this one */
+            void merge(const FreqCounter& other);
+
+            /** Number of distinct values seen */
+            size_t size() const { return this->n_entries; }
+
+            /** Copy the counts out into an ordinary map */
+            std::unordered_map<std::string, RowCount> to_map() const;
+
+        private:
+            static const size_t INITIAL_CAPACITY = 64; /**< Must be a power of two */
+            static const size_t ARENA_BLOCK_SIZE = 65536;
+
+            static size_t hash(csv::string_view value);
+
+            csv::string_view copy_to_arena(csv::string_view value);
+            void rehash(size_t new_capacity);
+
+            std::vector<Entry> slots;
+            size_t n_entries = 0;
+
+            /** Append-only storage for distinct values; blocks are never
+             *  reallocated, so keys stay valid as the table grows */
+            std::vector<std::unique_ptr<char[]>> arena;
+            size_t arena_used = ARENA_BLOCK_SIZE; /**< Bytes used in the last block */
+        };
+
+        /** A t-digest sketch for estimating arbitrary quantiles in
+         *  bounded memory. Observations are buffered, then compressed
+         *  into weighted centroids which cluster tightly near the tails.
+         */
+        class QuantileSketch {
+        public:
+            /** Record one observation */
+            void add(long double x);
+
+            /** Fold another sketch's centroids into this one */
+            void merge(const QuantileSketch& other);
+
+            /** Estimate the q-th quantile (q between 0 and 1)
+             *  @return NAN if no observations have been recorded
+             */
+            long double quantile(double q) const;
+
+        private:
+            struct Centroid {
+                long double mean;
+                long double weight;
+            };
+
+            static const size_t COMPRESSION = 100; /**< Maximum centroid resolution */
+            static const size_t BUFFER_LIMIT = 512;
+
+            void compress() const;
+
+            // Lazily compressed by quantile(), hence mutable
+            mutable std::vector<Centroid> centroids;
+            mutable std::vector<long double> buffer;
+            long double total_weight = 0;
+        };
+
+        /** A HyperLogLog sketch for estimating the number of distinct
+         *  values in a column using a few KB of registers
+         */
+        class CardinalitySketch {
+        public:
+            CardinalitySketch() : registers((size_t)1 << PRECISION, 0) {};
+
+            /** Record one observation */
+            void add(csv::string_view value);
+
+            /** Fold another sketch into this one by taking register maxima */
+            void merge(const CardinalitySketch& other);
+
+            /** Estimate the number of distinct values recorded */
+            RowCount estimate() const;
+
+        private:
+            static const int PRECISION = 12; /**< log2 of the register count */
+
+            static unsigned long long hash(csv::string_view value);
+
+            std::vector<unsigned char> registers;
+        };
+
+        /** A space-saving sketch tracking the top-k most frequent values
+         *  in a column. Counts are upper bounds: a value's true frequency
+         *  may be overestimated by at most the smallest tracked count.
+         */
+        class HeavyHitterSketch {
+        public:
+            HeavyHitterSketch(size_t _capacity = DEFAULT_CAPACITY) : capacity(_capacity) {};
+
+            /** Record count occurrences of value */
+            void add(csv::string_view value, RowCount count = 1);
+
+            /** Fold another sketch's entries into this one */
+            void merge(const HeavyHitterSketch& other);
+
+            /** Copy the tracked values and their estimated counts out */
+            std::unordered_map<std::string, RowCount> to_map() const;
+
+        private:
+            static const size_t DEFAULT_CAPACITY = 100;
+
+            /** Evict the smallest entries until at most capacity remain */
+            void trim();
+
+            size_t capacity;
+            std::unordered_map<std::string, RowCount> items;
+        };
+    }
+
     /** Class for calculating statistics from CSV files and in-memory sources
      *
      *  **Example**
@@ -27,26 +173,67 @@ namespace csv {
         std::vector<FreqCount> get_counts() const;
         std::vector<TypeCount> get_dtypes() const;
 
-        CSVStat(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv());
-        CSVStat(CSVFormat format = CSVFormat()) : CSVReader(format) {};
+        /** @name Approximate Statistics
+         *  @brief Only available when StatsMode::APPROXIMATE was requested,
+         *         otherwise these methods throw std::runtime_error
+         */
+        ///@{
+        std::vector<long double> get_quantile(double q) const;
+        std::vector<RowCount> get_cardinality() const;
+        std::vector<FreqCount> get_top_values() const;
+        ///@}
+
+        CSVStat(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv(),
+            StatsMode mode = StatsMode::EXACT);
+        CSVStat(CSVFormat format = CSVFormat(), StatsMode mode = StatsMode::EXACT)
+            : CSVReader(format), mode(mode) {};
     private:
+        StatsMode mode = StatsMode::EXACT;
         // An array of rolling averages
         // Each index corresponds to the rolling mean for the column at said index
         std::vector<long double> rolling_means;
         std::vector<long double> rolling_vars;
         std::vector<long double> mins;
         std::vector<long double> maxes;
-        std::vector<FreqCount> counts;
+        std::vector<internals::FreqCounter> counts;
         std::vector<TypeCount> dtypes;
         std::vector<long double> n;
 
-        // Statistic calculators
-        void variance(const long double&, const size_t&);
-        void count(CSVField&, const size_t&);
-        void min_max(const long double&, const size_t&);
-        void dtype(CSVField&, const size_t&);
+        // Sketches, only populated in StatsMode::APPROXIMATE
+        std::vector<internals::QuantileSketch> quantile_sketches;
+        std::vector<internals::CardinalitySketch> cardinality_sketches;
+        std::vector<internals::HeavyHitterSketch> top_value_sketches;
+
+        /** Partial aggregates for one column, computed over one shard of rows */
+        struct ColumnStats {
+            long double n = 0;       /**< Number of numeric observations */
+            long double mean = 0;    /**< Rolling mean */
+            long double m2 = 0;      /**< Sum of squared deviations from the mean */
+            long double min = NAN;
+            long double max = NAN;
+
+            /** Numeric values buffered until the next vectorized flush */
+            std::vector<double> pending;
+
+            internals::FreqCounter counts;
+            TypeCount dtypes;
+
+            // Sketches, only populated in StatsMode::APPROXIMATE
+            internals::QuantileSketch quantiles;
+            internals::CardinalitySketch cardinality;
+            internals::HeavyHitterSketch top_values;
+        };
 
         void calc();
-        void calc_worker(const size_t&);
+
+        /** Fold a column's buffered numeric values into its aggregates
+         *  using vectorized sum/min/max and sum-of-squares kernels
+         */
+        static void flush_numeric(ColumnStats& col);
+
+        void calc_shard(internals::RecordRing::iterator begin,
+            internals::RecordRing::iterator end,
+            std::vector<ColumnStats>& stats);
+        void merge_stats(std::vector<ColumnStats>& partial);
     };
 }
\ No newline at end of file
@@ -1,9 +1,215 @@
+#include <cstdio>   // For concat()
+#include <cstring>  // For memchr()
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "csv_utility.hpp"
 #include "csv_reader.hpp"
 
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace csv {
+    namespace internals {
+        /** Number of set bits in a 32-bit mask */
+        HEDLEY_CONST static inline size_t bit_count(unsigned int mask) {
+#if defined(_MSC_VER)
+            return (size_t)__popcnt(mask);
+#else
+            return (size_t)__builtin_popcount(mask);
+#endif
+        }
+
+        /** Count occurrences of '\n', vectorized where possible */
+        static size_t count_newlines(const char* data, size_t n) {
+            size_t count = 0,
+                   i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            const __m256i lf_v = _mm256_set1_epi8('\n');
+
+            for (; i + 32 <= n; i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+                count += bit_count(
+                    (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, lf_v)));
+            }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i lf_v = _mm_set1_epi8('\n');
+
+            for (; i + 16 <= n; i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+                count += bit_count(
+                    (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, lf_v)));
+            }
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < n; i++) {
+                count += data[i] == '\n';
+            }
+
+            return count;
+        }
+
+        /** Per-block result of the parallel newline counter
+         *
+         *  Blocks are tallied independently, so whether a block begins
+         *  inside a quoted field is unknown while it is being scanned.
+         *  Both outcomes are recorded: `outside` holds the newlines at even
+         *  quote parity (the right answer if the block starts outside a
+         *  quoted field), and `total - outside` covers the opposite case.
+         *  The caller picks one as it folds blocks together in file order,
+         *  flipping its carried parity whenever a block held an odd number
+         *  of quotes.
+         */
+        struct NewlineTally {
+            size_t total = 0;      /*< All newlines in the block */
+            size_t outside = 0;    /*< Newlines at even quote parity */
+            bool odd_quotes = false;
+        };
+
+        /** Tally a block's newlines, split by quote parity. Runs of
+         *  ordinary bytes between quotes are counted vectorized; only the
+         *  (rare) quote characters themselves are handled one at a time.
+         */
+        static NewlineTally tally_newlines(csv::string_view block, char quote) {
+            NewlineTally tally;
+            bool outside = true;
+
+            size_t pos = 0;
+            while (pos < block.size()) {
+                auto* next_quote = (const char*)std::memchr(
+                    block.data() + pos, quote, block.size() - pos);
+                const size_t segment_end = next_quote
+                    ? (size_t)(next_quote - block.data())
+                    : block.size();
+
+                const size_t n = count_newlines(block.data() + pos, segment_end - pos);
+                tally.total += n;
+                if (outside) tally.outside += n;
+
+                if (!next_quote) break;
+
+                outside = !outside;
+                tally.odd_quotes = !tally.odd_quotes;
+                pos = segment_end + 1;
+            }
+
+            return tally;
+        }
+
+        /** Append a field to out, quoting it only if it contains the
+         *  delimiter, a quote, or a line break (runtime counterpart of
+         *  csv_escape() for when the delimiter is not known statically)
+         */
+        static void write_escaped(std::string& out, csv::string_view field, char delim) {
+            const char specials[5] = { delim, '"', '\n', '\r', '\0' };
+
+            if (field.find_first_of(specials) == csv::string_view::npos) {
+                out.append(field.data(), field.size());
+                return;
+            }
+
+            out += '"';
+            for (size_t i = 0; i < field.size(); i++) {
+                if (field[i] == '"') out += '"';
+                out += field[i];
+            }
+            out += '"';
+        }
+
+        /** Byte offset of the first data row, one past the header row's
+         *  newline within the (cached) file head
+         */
+        static size_t data_start_offset(csv::string_view head, int header_row) {
+            size_t offset = 0;
+            for (int newlines = 0;
+                offset < head.size() && newlines <= header_row;
+                offset++) {
+                if (head[offset] == '\n') newlines++;
+            }
+
+            return offset;
+        }
+
+        /** Copy a file's bytes from offset to EOF into out, using zero-copy
+         *  kernel splicing where the platform provides it
+         *
+         *  @return Number of bytes copied
+         */
+        static size_t splice_bytes(std::FILE* out, const std::string& filename, size_t offset) {
+            size_t copied = 0;
+
+#if defined(__linux__) && defined(__GLIBC__) && __GLIBC_PREREQ(2, 27)
+            // copy_file_range() moves bytes inside the kernel without
+            // bouncing them through a user-space buffer
+            int in_fd = ::open(filename.c_str(), O_RDONLY);
+            if (in_fd != -1) {
+                std::fflush(out);
+                off_t in_pos = (off_t)offset;
+                bool usable = true;
+
+                while (usable) {
+                    ssize_t n = copy_file_range(in_fd, &in_pos, fileno(out), nullptr,
+                        (size_t)1 << 30, 0);
+                    if (n > 0) {
+                        copied += (size_t)n;
+                    }
+                    else if (n == 0) {
+                        ::close(in_fd);
+                        return copied;
+                    }
+                    else {
+                        // Unsupported filesystem pairing: fall through to
+                        // the buffered loop for the remainder
+                        usable = false;
+                        offset += copied;
+                    }
+                }
+
+                ::close(in_fd);
+            }
+#endif
+
+            std::ifstream infile(filename, std::ios::binary);
+            if (!infile.is_open())
+                throw std::runtime_error("Cannot open file " + filename);
+
+            infile.seekg((std::streamoff)offset, std::ios::beg);
+
+            std::vector<char> block((size_t)1 << 22); // 4 MB
+            while (infile) {
+                infile.read(block.data(), (std::streamsize)block.size());
+                const size_t n_read = (size_t)infile.gcount();
+                if (n_read == 0) break;
+
+                std::fwrite(block.data(), 1, n_read, out);
+                copied += n_read;
+            }
+
+            return copied;
+        }
+
+        /** Whether a file's final byte is a line terminator */
+        static bool ends_with_newline(const std::string& filename) {
+            std::ifstream infile(filename, std::ios::binary);
+            infile.seekg(0, std::ios::end);
+
+            if (infile.tellg() <= 0) return true;
+
+            infile.seekg(-1, std::ios::end);
+            const char last = (char)infile.get();
+            return last == '\n' || last == '\r';
+        }
+    }
+
     /** Shorthand function for parsing an in-memory CSV string,
      *  a collection of CSVRow objects
      *
@@ -42,22 +248,345 @@ namespace csv {
         return reader.index_of(col_name);
     }
 
+    /** Count the data-carrying newlines in a file at close to memory
+     *  bandwidth, without parsing it
+     *
+     *  Blocks of the file are scanned concurrently with a vectorized
+     *  newline counter; newlines embedded in quoted fields are excluded by
+     *  a per-block quote-parity scan, with parity carried across blocks as
+     *  their tallies are folded together in file order. A final row with no
+     *  trailing newline is counted.
+     *
+     *  @note Unlike a full parse, this counts every record terminator: rows
+     *        that a reader would drop (e.g. ragged rows under the default
+     *        variable column policy) and blank lines are all included.
+     *
+     *  @param[in] filename  Path to the CSV file
+     *  @param[in] n_threads Worker count, or 0 for one per hardware thread
+     */
+    CSV_INLINE RowCount count_rows(const std::string& filename, size_t n_threads) {
+        if (n_threads == 0) {
+            n_threads = (size_t)std::thread::hardware_concurrency();
+            if (n_threads == 0) n_threads = 4;
+        }
+
+        std::ifstream infile(filename, std::ios::binary);
+        if (!infile.is_open())
+            throw std::runtime_error("Cannot open file " + filename);
+
+        constexpr size_t BLOCK_SIZE = (size_t)1 << 22; // 4 MB
+
+        std::deque<std::future<internals::NewlineTally>> pending;
+        RowCount terminators = 0;
+        bool outside = true;
+        char last_char = '\n';
+
+        // Tallies must be folded in file order, since each block's quote
+        // parity determines how the next one is interpreted
+        auto fold_one = [&]() {
+            auto tally = pending.front().get();
+            pending.pop_front();
+
+            terminators += (RowCount)(outside
+                ? tally.outside
+                : tally.total - tally.outside);
+
+            if (tally.odd_quotes)
+                outside = !outside;
+        };
+
+        while (true) {
+            auto block = std::make_shared<std::vector<char>>(BLOCK_SIZE);
+            infile.read(block->data(), (std::streamsize)BLOCK_SIZE);
+
+            const size_t n_read = (size_t)infile.gcount();
+            if (n_read == 0) break;
+
+            last_char = (*block)[n_read - 1];
+
+            pending.push_back(std::async(std::launch::async, [block, n_read] {
+                return internals::tally_newlines(
+                    csv::string_view(block->data(), n_read), '"');
+            }));
+
+            // Bound the number of blocks in flight
+            if (pending.size() >= n_threads)
+                fold_one();
+        }
+
+        while (!pending.empty())
+            fold_one();
+
+        // A final row without a trailing newline still counts
+        if (last_char != '\n' && last_char != '\r')
+            terminators++;
+
+        return terminators;
+    }
+
+    /** Concatenate CSV shards sharing a header into one output file
+     *
+     *  Each input's column names are read from its (cached) head and must
+     *  match the first input's exactly. One header row is written, then
+     *  each shard's post-header bytes are spliced into the output without
+     *  parsing — using zero-copy kernel copies where the platform provides
+     *  them — so merging byte-identical shards runs at I/O speed. Shards
+     *  whose delimiter differs from the first input's, or which are
+     *  compressed, are transparently re-parsed and re-quoted instead.
+     *
+     *  @param[in] output Path of the merged file, overwritten if present
+     *  @param[in] inputs Shard files, in the order their rows should appear
+     *
+     *  @return Number of bytes written to the output
+     *  @throws std::runtime_error if an input's column names differ from
+     *          the first input's
+     */
+    CSV_INLINE size_t concat(const std::string& output, const std::vector<std::string>& inputs) {
+        std::FILE* out = std::fopen(output.c_str(), "wb");
+        if (!out)
+            throw std::runtime_error("Cannot open file " + output);
+
+        size_t written = 0;
+        std::vector<std::string> ref_names;
+        char ref_delim = ',';
+
+        try {
+            for (size_t k = 0; k < inputs.size(); k++) {
+                const auto& filename = inputs[k];
+                const Compression compression = internals::detect_compression(filename);
+
+                auto head = compression == Compression::NONE
+                    ? internals::get_csv_head(filename)
+                    : internals::get_compressed_head(filename, compression);
+                auto guess = internals::_guess_format(head);
+
+                CSVFormat format;
+                format.delimiter(guess.delim).header_row(guess.header_row);
+                auto col_names = internals::_get_col_names(head, format);
+
+                if (k == 0) {
+                    ref_names = col_names;
+                    ref_delim = guess.delim;
+
+                    // One header row covers the whole output
+                    std::string header;
+                    for (size_t i = 0; i < ref_names.size(); i++) {
+                        internals::write_escaped(header, ref_names[i], ref_delim);
+                        if (i + 1 < ref_names.size()) header += ref_delim;
+                    }
+                    header += '\n';
+
+                    std::fwrite(header.data(), 1, header.size(), out);
+                    written += header.size();
+                }
+                else if (col_names != ref_names) {
+                    throw std::runtime_error("Cannot concatenate " + filename +
+                        ": its column names differ from " + inputs.front());
+                }
+
+                // Byte-identical shards are spliced without parsing
+                if (compression == Compression::NONE && guess.delim == ref_delim) {
+                    const size_t data_start =
+                        internals::data_start_offset(head, guess.header_row);
+                    written += internals::splice_bytes(out, filename, data_start);
+
+                    // Keep the next shard's first row on its own line
+                    if (!internals::ends_with_newline(filename)) {
+                        std::fputc('\n', out);
+                        written++;
+                    }
+                }
+                else {
+                    // Formats differ: re-parse this shard and re-quote its
+                    // rows with the output's delimiter
+                    CSVReader reader(filename);
+                    CSVRow row;
+                    std::string buffer;
+
+                    while (reader.read_row(row)) {
+                        for (size_t i = 0; i < row.size(); i++) {
+                            internals::write_escaped(buffer, row.get_string_view(i), ref_delim);
+                            if (i + 1 < row.size()) buffer += ref_delim;
+                        }
+                        buffer += '\n';
+
+                        if (buffer.size() >= 1048576) {
+                            std::fwrite(buffer.data(), 1, buffer.size(), out);
+                            written += buffer.size();
+                            buffer.clear();
+                        }
+                    }
+
+                    std::fwrite(buffer.data(), 1, buffer.size(), out);
+                    written += buffer.size();
+                }
+            }
+        }
+        catch (...) {
+            std::fclose(out);
+            throw;
+        }
+
+        std::fclose(out);
+        return written;
+    }
+
     /** Get basic information about a CSV file
      *  @include programs/csv_info.cpp
      */
     CSV_INLINE CSVFileInfo get_file_info(const std::string& filename) {
         CSVReader reader(filename);
         CSVFormat format = reader.get_format();
-        for (auto it = reader.begin(); it != reader.end(); ++it);
+
+        // Rows are counted with the parallel newline counter rather than by
+        // parsing the whole file; everything up to and including the header
+        // row is excluded from the count
+        RowCount n_rows = count_rows(filename) - (RowCount)format.get_header() - 1;
+        if (n_rows < 0) n_rows = 0;
 
         CSVFileInfo info = {
             filename,
             reader.get_col_names(),
             format.get_delim(),
-            reader.num_rows,
+            n_rows,
             (int)reader.get_col_names().size()
         };
 
         return info;
     }
+
+    /** Profile a CSV file by sampling blocks spread across it
+     *
+     *  Unlike get_file_info(), this never reads the whole file: the format
+     *  and column names come from the (cached) file head, per-column types
+     *  are tallied over `n_blocks` blocks of `block_size` bytes spaced
+     *  evenly through the data, and the row count is extrapolated from rows
+     *  per sampled byte. Runtime is therefore independent of file size.
+     *
+     *  Sampled blocks rarely begin on a row boundary: parsing resumes at the
+     *  first newline in each block, and any row whose field count does not
+     *  match the header — a partial row at either edge of the block, or a
+     *  misparse caused by landing inside a quoted field — is discarded.
+     */
+    CSV_INLINE CSVFileProfile profile_csv(const std::string& filename,
+        size_t n_blocks, size_t block_size) {
+        auto head = internals::get_csv_head(filename);
+        auto guess = internals::_guess_format(head);
+
+        CSVFormat format;
+        format.delimiter(guess.delim).header_row(guess.header_row);
+
+        auto col_names = internals::_get_col_names(head, format);
+        const size_t n_cols = col_names.size();
+
+        CSVFileProfile profile = {
+            filename,
+            col_names,
+            format.get_delim(),
+            (int)n_cols,
+            0,
+            0,
+            std::vector<DataType>(n_cols, CSV_NULL),
+            std::vector<std::vector<size_t>>(n_cols,
+                std::vector<size_t>((size_t)CSV_DOUBLE + 1, 0))
+        };
+
+        std::ifstream infile(filename, std::ios::binary);
+        if (!infile.is_open())
+            throw std::runtime_error("Cannot open file " + filename);
+
+        infile.seekg(0, std::ios::end);
+        const size_t file_size = (size_t)infile.tellg();
+
+        // Data rows begin one past the header row's newline
+        size_t data_start = 0;
+        for (int newlines = 0;
+            data_start < head.size() && newlines <= guess.header_row;
+            data_start++) {
+            if (head[data_start] == '\n') newlines++;
+        }
+
+        const size_t span = file_size > data_start ? file_size - data_start : 0;
+        if (span == 0) return profile;
+
+        // When the sample would cover the whole file anyway, read it in one
+        // block starting at the known row boundary
+        if (n_blocks == 0) n_blocks = 1;
+        if (block_size * n_blocks >= span) {
+            n_blocks = 1;
+            block_size = span;
+        }
+
+        // Sampled blocks have no header of their own
+        CSVFormat block_format = format;
+        block_format.column_names(col_names);
+
+        std::vector<char> block(block_size);
+        size_t bytes_sampled = 0;
+
+        const size_t stride = span / n_blocks;
+        for (size_t k = 0; k < n_blocks; k++) {
+            infile.clear();
+            infile.seekg((std::streamoff)(data_start + k * stride), std::ios::beg);
+            infile.read(block.data(), (std::streamsize)block_size);
+
+            const size_t n_read = (size_t)infile.gcount();
+            if (n_read == 0) continue;
+
+            csv::string_view view(block.data(), n_read);
+
+            // Resynchronize onto a row boundary, except at data_start
+            // where the boundary is already known
+            if (k > 0) {
+                const size_t newline = view.find('\n');
+                if (newline == csv::string_view::npos) continue;
+
+                view.remove_prefix(newline + 1);
+            }
+
+            bytes_sampled += view.size();
+
+            // The last row of each block is dropped below: the block almost
+            // certainly ends mid-row
+            auto rows = parse(view, block_format);
+            CSVRow prev;
+            bool has_prev = false;
+
+            for (auto& row : rows) {
+                if (has_prev && prev.size() == n_cols) {
+                    for (size_t i = 0; i < n_cols; i++)
+                        profile.type_counts[i][(size_t)prev[i].type()]++;
+
+                    profile.n_rows_sampled++;
+                }
+
+                prev = std::move(row);
+                has_prev = true;
+            }
+        }
+
+        if (bytes_sampled > 0) {
+            profile.n_rows_estimate = (RowCount)(
+                (double)profile.n_rows_sampled * (double)span / (double)bytes_sampled + 0.5);
+        }
+
+        // Reduce each column's distribution to its widest observed type
+        for (size_t i = 0; i < n_cols; i++) {
+            auto& counts = profile.type_counts[i];
+
+            if (counts[CSV_STRING] > 0) {
+                profile.types[i] = CSV_STRING;
+            }
+            else if (counts[CSV_DOUBLE] > 0) {
+                profile.types[i] = CSV_DOUBLE;
+            }
+            else {
+                for (size_t t = CSV_INT8; t <= CSV_INT64; t++) {
+                    if (counts[t] > 0) profile.types[i] = (DataType)t;
+                }
+            }
+        }
+
+        return profile;
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "constants.hpp"
 #include "data_type.h"
 
+#include <iosfwd>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -17,6 +18,33 @@ namespace csv {
         int n_cols;                         /**< Number of columns in a CSV */
     };
 
+    /** Returned by profile_csv(): like CSVFileInfo, but gathered from a
+     *  handful of sampled blocks instead of a full scan, with per-column
+     *  type information
+     */
+    struct CSVFileProfile {
+        std::string filename;               /**< Filename */
+        std::vector<std::string> col_names; /**< CSV column names */
+        char delim;                         /**< Delimiting character */
+        int n_cols;                         /**< Number of columns in a CSV */
+
+        /** Estimated row count, extrapolated from rows per sampled byte */
+        RowCount n_rows_estimate;
+
+        /** Rows actually inspected across all sampled blocks */
+        RowCount n_rows_sampled;
+
+        /** Widest type observed per column: CSV_STRING if any sampled field
+         *  was non-numeric, otherwise CSV_DOUBLE or the widest integer type
+         */
+        std::vector<DataType> types;
+
+        /** type_counts[i][type] = number of sampled fields in column i
+         *  whose data_type() was `type`
+         */
+        std::vector<std::vector<size_t>> type_counts;
+    };
+
     /** @name Shorthand Parsing Functions
      *  @brief Convienience functions for parsing small strings
      */
@@ -28,9 +56,14 @@ namespace csv {
     /** @name Utility Functions */
     ///@{
     std::unordered_map<std::string, DataType> csv_data_types(const std::string&);
+    size_t concat(const std::string& output, const std::vector<std::string>& inputs);
     CSVFileInfo get_file_info(const std::string& filename);
+    RowCount count_rows(const std::string& filename, size_t n_threads = 0);
+    CSVFileProfile profile_csv(const std::string& filename,
+        size_t n_blocks = 8, size_t block_size = 65536);
     int get_col_pos(const std::string filename, const std::string col_name,
         const CSVFormat format = CSVFormat::guess_csv());
+    RowCount to_jsonl(CSVReader& reader, std::ostream& out);
     ///@}
 
     namespace internals {
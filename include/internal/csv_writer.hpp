@@ -3,11 +3,25 @@
   */
 
 #pragma once
+#include <cstdio>  // For snprintf()
+#include <cstdlib> // For strtold()
+#include <cstring> // For memchr()
 #include <iostream>
+#include <limits>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include <string>
 #include <fstream>
+#include <sstream>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    #include <charconv>
+    #define CSV_HAS_TO_CHARS
+#endif
+
 #include "compatibility.hpp"
+#include "csv_row.hpp"
 
 namespace csv {
     /** @name CSV Writing */
@@ -74,7 +88,9 @@ namespace csv {
     class DelimWriter {
     public:
         /** Construct a DelimWriter over the specified output stream */
-        DelimWriter(OutputStream& _out) : out(_out) {};
+        DelimWriter(OutputStream& _out) : out(_out) {
+            this->buffer.reserve(WRITE_BUFFER_SIZE);
+        };
 
         /** Construct a DelimWriter over the file
          *
@@ -82,10 +98,19 @@ namespace csv {
          */
         DelimWriter(const std::string& filename) : DelimWriter(std::ifstream(filename)) {};
 
+        /** Flush any remaining buffered rows */
+        ~DelimWriter() {
+            this->flush();
+        }
+
         /** Format a sequence of strings and write to CSV according to RFC 4180
          *
          *  @warning This does not check to make sure row lengths are consistent
          *
+         *  @note Rows are buffered internally and only reach the output
+         *        stream when the buffer fills, flush() is called, or this
+         *        writer is destroyed
+         *
          *  @param[in]  record          Sequence of strings to be formatted
          *  @param      quote_minimal   Only quote fields if necessary
          */
@@ -94,12 +119,53 @@ namespace csv {
             const size_t ilen = record.size();
             size_t i = 0;
             for (auto& field: record) {
-                out << csv_escape<Delim, Quote>(field, quote_minimal);
-                if (i + 1 != ilen) out << Delim;
+                this->write_field(field, quote_minimal);
+                if (i + 1 != ilen) this->buffer += Delim;
                 i++;
             }
 
-            out << std::endl;
+            this->buffer += '\n';
+
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
+        }
+
+        /** Format a parsed CSVRow, walking its split positions and copying
+         *  each field's bytes straight from the row's shared buffer into
+         *  the write buffer — no intermediate strings are created, making
+         *  filter-and-rewrite pipelines allocation-free per row.
+         *
+         *  @param[in]  record          Row obtained from a CSVReader
+         *  @param      quote_minimal   Only quote fields if necessary
+         */
+        void write_row(const CSVRow& record, bool quote_minimal = true) {
+            const size_t ilen = record.size();
+            for (size_t i = 0; i < ilen; i++) {
+                this->escape_to_buffer(record.get_string_view(i), quote_minimal);
+                if (i + 1 != ilen) this->buffer += Delim;
+            }
+
+            this->buffer += '\n';
+
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
+        }
+
+        /** Format a tuple of mixed string and arithmetic types, writing
+         *  each element with the formatter matching its compile-time type.
+         *  Numeric elements are formatted directly into the write buffer
+         *  without any intermediate strings.
+         *
+         *  @param[in]  record          Tuple of values to be formatted
+         *  @param      quote_minimal   Only quote fields if necessary
+         */
+        template<typename... T>
+        void write_row(const std::tuple<T...>& record, bool quote_minimal = true) {
+            this->write_tuple<0>(record, quote_minimal);
+            this->buffer += '\n';
+
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
         }
 
         /** @copydoc write_row
@@ -111,8 +177,160 @@ namespace csv {
             return *this;
         }
 
+        /** @copydoc write_row
+         *  @return  The current DelimWriter instance (allowing for operator chaining)
+         */
+        template<typename... T>
+        DelimWriter& operator<<(const std::tuple<T...>& record) {
+            this->write_row(record);
+            return *this;
+        }
+
+        /** @copydoc write_row
+         *  @return  The current DelimWriter instance (allowing for operator chaining)
+         */
+        DelimWriter& operator<<(const CSVRow& record) {
+            this->write_row(record);
+            return *this;
+        }
+
+        /** Write all buffered rows to the output stream and flush it,
+         *  e.g. at durability points
+         */
+        void flush() {
+            if (!this->buffer.empty()) {
+                this->out.write(this->buffer.data(), (std::streamsize)this->buffer.size());
+                this->buffer.clear();
+            }
+
+            this->out.flush();
+        }
+
     private:
+        /** Write one element of a tuple, dispatching on its type */
+        template<size_t I, typename... T>
+        typename std::enable_if<(I < sizeof...(T))>::type
+        write_tuple(const std::tuple<T...>& record, const bool quote_minimal) {
+            this->write_field(std::get<I>(record), quote_minimal);
+
+            IF_CONSTEXPR (I + 1 < sizeof...(T))
+                this->buffer += Delim;
+
+            this->write_tuple<I + 1>(record, quote_minimal);
+        }
+
+        /** Base case: the entire tuple has been written */
+        template<size_t I, typename... T>
+        typename std::enable_if<I == sizeof...(T)>::type
+        write_tuple(const std::tuple<T...>&, const bool) {}
+
+        /** Format an arithmetic field directly into the write buffer.
+         *  Numbers never require quoting.
+         */
+        template<typename T,
+            typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        void write_field(const T& field, const bool) {
+            this->format_number(field);
+        }
+
+        /** Format a string-like field, quoting as necessary */
+        template<typename T,
+            typename std::enable_if<!std::is_arithmetic<T>::value, int>::type = 0>
+        void write_field(const T& field, const bool quote_minimal) {
+            this->escape_to_buffer(field, quote_minimal);
+        }
+
+        /** Append an integer to the write buffer without allocating */
+        template<typename T>
+        typename std::enable_if<std::is_integral<T>::value>::type
+        format_number(const T value) {
+            char digits[24];
+            size_t pos = sizeof(digits);
+
+            // bool has no unsigned counterpart, so let it promote to int
+            using Unsigned = typename std::make_unsigned<
+                typename std::conditional<std::is_same<T, bool>::value, int, T>::type>::type;
+            Unsigned mag = value < 0
+                ? (Unsigned)0 - (Unsigned)value
+                : (Unsigned)value;
+
+            do {
+                digits[--pos] = (char)('0' + (char)(mag % 10));
+                mag /= 10;
+            } while (mag > 0);
+
+            if (value < 0) digits[--pos] = '-';
+
+            this->buffer.append(digits + pos, sizeof(digits) - pos);
+        }
+
+        /** Append a floating point value to the write buffer using
+         *  shortest-round-trip formatting
+         */
+        template<typename T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        format_number(const T value) {
+            char digits[64];
+
+#ifdef CSV_HAS_TO_CHARS
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            this->buffer.append(digits, (size_t)(result.ptr - digits));
+#else
+            // Probe for the smallest precision that round-trips
+            int len = 0;
+            for (int precision = 6; precision <= std::numeric_limits<T>::max_digits10; precision++) {
+                len = snprintf(digits, sizeof(digits), "%.*Lg", precision, (long double)value);
+                if ((T)strtold(digits, nullptr) == value) break;
+            }
+
+            // Some locales use a decimal comma, which would collide
+            // with the delimiter
+            for (int i = 0; i < len; i++) {
+                if (digits[i] == ',') digits[i] = '.';
+            }
+
+            this->buffer.append(digits, (size_t)len);
+#endif
+        }
+
+        /** Format one field directly into the write buffer.
+         *
+         *  A single pre-scan decides whether quoting is necessary;
+         *  unquoted fields (the common case) are appended verbatim.
+         */
+        void escape_to_buffer(csv::string_view in, const bool quote_minimal) {
+            const bool has_quote = !in.empty()
+                && std::memchr(in.data(), Quote, in.size()) != nullptr;
+            const bool needs_quotes = !quote_minimal || has_quote || (!in.empty() && (
+                std::memchr(in.data(), Delim, in.size()) != nullptr
+                || std::memchr(in.data(), '\n', in.size()) != nullptr
+                || std::memchr(in.data(), '\r', in.size()) != nullptr));
+
+            if (!needs_quotes) {
+                if (!in.empty()) this->buffer.append(in.data(), in.size());
+                return;
+            }
+
+            this->buffer += Quote;
+
+            if (!has_quote) {
+                if (!in.empty()) this->buffer.append(in.data(), in.size());
+            }
+            else {
+                for (size_t i = 0; i < in.size(); i++) {
+                    if (in[i] == Quote) this->buffer += Quote;
+                    this->buffer += in[i];
+                }
+            }
+
+            this->buffer += Quote;
+        }
+
+        /** Flush threshold for the internal write buffer */
+        static constexpr size_t WRITE_BUFFER_SIZE = 1048576;
+
         OutputStream & out;
+        std::string buffer; /**< Grow-once buffer holding formatted rows */
     };
 
     /* Uncomment when C++17 support is better
@@ -157,5 +375,25 @@ namespace csv {
         return TSVWriter<OutputStream>(out);
     }
 
+#ifdef CSV_EXTERN_TEMPLATES
+    /** When consuming the compiled library (which defines
+     *  CSV_EXTERN_TEMPLATES via its CMake target), the hot members of the
+     *  common writer configurations are compiled once into the library —
+     *  see csv_instantiations.cpp — instead of once per client translation
+     *  unit. The single header is unaffected.
+     */
+    extern template DelimWriter<std::ofstream, ',', '"'>::DelimWriter(std::ofstream&);
+    extern template void DelimWriter<std::ofstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::ofstream, ',', '"'>::flush();
+
+    extern template DelimWriter<std::ofstream, '\t', '"'>::DelimWriter(std::ofstream&);
+    extern template void DelimWriter<std::ofstream, '\t', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::ofstream, '\t', '"'>::flush();
+
+    extern template DelimWriter<std::stringstream, ',', '"'>::DelimWriter(std::stringstream&);
+    extern template void DelimWriter<std::stringstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::stringstream, ',', '"'>::flush();
+#endif
+
     ///@}
 }
\ No newline at end of file
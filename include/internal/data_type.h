@@ -340,5 +340,159 @@ namespace csv {
             // Just whitespace
             return CSV_NULL;
         }
+
+        /** Exact double values of 10^0 through 10^22 */
+        CONSTEXPR_VALUE double POW10_DOUBLE[] = {
+            1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /** Largest mantissa a double can represent exactly (2^53) */
+        CONSTEXPR_VALUE unsigned long long FAST_MANTISSA_MAX = 1ULL << 53;
+
+        /** A numeric string decomposed into mantissa * 10^exponent form
+         *  by scan_number()
+         */
+        struct DecimalComponents {
+            unsigned long long mantissa = 0;
+            int exponent = 0;       /**< Power of ten applied to the mantissa */
+            bool negative = false;
+            bool is_float = false;  /**< Whether a '.' or exponent was seen */
+            size_t digits = 0;      /**< Number of mantissa digits consumed */
+        };
+
+        /** Decompose a numeric string into exact integer components.
+         *
+         *  Handles the overwhelmingly common case: an optional sign, up
+         *  to 19 digits, an optional decimal point, and an optional
+         *  integer exponent. Returns false for anything else (padding,
+         *  embedded whitespace, too many digits, non-numeric text) so
+         *  callers can fall back to data_type().
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool scan_number(csv::string_view in, DecimalComponents& result) noexcept {
+            size_t i = 0;
+            const size_t n = in.size();
+
+            if (n == 0) return false;
+
+            if (in[i] == '-') {
+                result.negative = true;
+                i++;
+            }
+
+            for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                if (result.digits == 19) return false;
+                result.mantissa = result.mantissa * 10 + (unsigned long long)(in[i] - '0');
+                result.digits++;
+            }
+
+            if (i < n && in[i] == '.') {
+                result.is_float = true;
+                i++;
+
+                for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                    if (result.digits == 19) return false;
+                    result.mantissa = result.mantissa * 10 + (unsigned long long)(in[i] - '0');
+                    result.digits++;
+                    result.exponent--;
+                }
+            }
+
+            if (result.digits == 0) return false;
+
+            if (i < n && (in[i] == 'e' || in[i] == 'E')) {
+                result.is_float = true;
+                i++;
+
+                bool exp_negative = false;
+                if (i < n && (in[i] == '+' || in[i] == '-')) {
+                    exp_negative = in[i] == '-';
+                    i++;
+                }
+
+                int exp_value = 0;
+                size_t exp_digits = 0;
+                for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                    if (exp_digits == 3) return false;
+                    exp_value = exp_value * 10 + (in[i] - '0');
+                    exp_digits++;
+                }
+
+                if (exp_digits == 0) return false;
+                result.exponent += exp_negative ? -exp_value : exp_value;
+            }
+
+            // Trailing garbage
+            return i == n;
+        }
+
+        /** Fast-path equivalent of data_type(): classifies and converts
+         *  numeric strings using exact integer arithmetic, returning
+         *  UNKNOWN for hard cases (padding, huge values, extreme
+         *  exponents) which must go through data_type() instead.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        DataType data_type_fast(csv::string_view in, long double* const out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)) return UNKNOWN;
+
+            if (!number.is_float) {
+                long double value = (long double)number.mantissa;
+                if (out) *out = number.negative ? -value : value;
+                return _determine_integral_type(value);
+            }
+
+            // Clinger's fast path: a mantissa scaled by an exact power
+            // of ten rounds correctly in a single operation
+            if (number.mantissa > FAST_MANTISSA_MAX
+                || number.exponent < -22 || number.exponent > 22)
+                return UNKNOWN;
+
+            long double value = (long double)number.mantissa;
+            if (number.exponent >= 0)
+                value *= POW10_DOUBLE[number.exponent];
+            else
+                value /= POW10_DOUBLE[-number.exponent];
+
+            if (out) *out = number.negative ? -value : value;
+            return CSV_DOUBLE;
+        }
+
+        /** Parse a double directly from text, bypassing long double
+         *  arithmetic entirely. Returns false for hard or non-numeric cases.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool fast_parse_double(csv::string_view in, double& out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)
+                || number.mantissa > FAST_MANTISSA_MAX
+                || number.exponent < -22 || number.exponent > 22)
+                return false;
+
+            double value = (double)number.mantissa;
+            if (number.exponent >= 0)
+                value *= POW10_DOUBLE[number.exponent];
+            else
+                value /= POW10_DOUBLE[-number.exponent];
+
+            out = number.negative ? -value : value;
+            return true;
+        }
+
+        /** Parse a 64-bit integer directly from text. Returns false for
+         *  floats, out-of-range values, and non-numeric cases.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool fast_parse_int64(csv::string_view in, long long& out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)
+                || number.is_float
+                || number.mantissa > (unsigned long long)std::numeric_limits<long long>::max())
+                return false;
+
+            out = number.negative ? -(long long)number.mantissa : (long long)number.mantissa;
+            return true;
+        }
     }
 }
\ No newline at end of file
@@ -35,10 +35,18 @@ namespace csv {
         }
 
         CSV_INLINE RowData RawRowBuffer::get_row() {
-            return {
+            RowData row = {
                 this->get_row_string(),
                 this->get_splits()
             };
+
+            // A row with text but no recorded splits holds one field — a
+            // single-column CSV, or a projection keeping one column — and
+            // is distinct from a blank row, which has no text at all
+            if (row.col_pos.n_cols == 0 && row.row_str.second > 0)
+                row.col_pos.n_cols = 1;
+
+            return row;
         }
 
         /** Get the current row in the buffer
@@ -72,14 +80,62 @@ namespace csv {
         CSV_INLINE size_t RawRowBuffer::splits_size() const {
             return this->split_buffer.size() - this->current_split_idx;
         }
+
+        CSV_INLINE void RawRowBuffer::get_current_row(std::vector<csv::string_view>& fields) const {
+            fields.clear();
+
+            // Split positions are offsets from the start of the current row
+            const char* row_start = this->buffer.data() + this->current_end;
+            size_t start = 0;
+            for (size_t i = this->current_split_idx; i < this->split_buffer.size(); i++) {
+                fields.push_back(csv::string_view(
+                    row_start + start, this->split_buffer[i] - start));
+                start = this->split_buffer[i];
+            }
+
+            fields.push_back(csv::string_view(row_start + start, this->size() - start));
+        }
+
+        CSV_INLINE void RawRowBuffer::discard_row() {
+            this->buffer.resize(this->current_end);
+            this->split_buffer.resize(this->current_split_idx);
+        }
         
+        CSV_INLINE void RawRowBuffer::clear() {
+            this->buffer.clear();
+            this->split_buffer.clear();
+            this->current_end = 0;
+            this->current_split_idx = 0;
+        }
+
+        CSV_INLINE BufferPtr BufferPool::lease(const ColNamesPtr& col_names) {
+            for (auto& buff : this->pool) {
+                // use_count() == 1 --> every CSVRow referencing this buffer is gone,
+                // so its storage may be reused
+                if (buff.use_count() == 1) {
+                    buff->clear();
+                    buff->col_names = col_names;
+                    return buff;
+                }
+            }
+
+            auto fresh = BufferPtr(new RawRowBuffer(col_names));
+            if (this->pool.size() < MAX_POOLED_BUFFERS) {
+                this->pool.push_back(fresh);
+            }
+
+            return fresh;
+        }
+
         HEDLEY_WARN_UNUSED_RESULT CSV_INLINE
-        BufferPtr RawRowBuffer::reset() const {
+        BufferPtr RawRowBuffer::reset(BufferPool* pool) const {
             // Save current row in progress
-            auto new_buff = BufferPtr(new RawRowBuffer());
+            auto new_buff = pool ?
+                pool->lease(this->col_names) : BufferPtr(new RawRowBuffer());
 
-            // Save text
-            new_buff->buffer = this->buffer.substr(
+            // Save text. assign() reuses any capacity new_buff already holds.
+            new_buff->buffer.assign(
+                this->buffer,
                 this->current_end,   // Position
                 (this->buffer.size() - this->current_end) // Count
             );
@@ -11,9 +11,11 @@
 
 #include "compatibility.hpp" // For string view
 #include "constants.hpp"
+#include "data_type.h" // For column type hints
 
 namespace csv {
     namespace internals {
+        class BufferPool;
         class RawRowBuffer;
         struct RowData;
         struct ColumnPositions;
@@ -41,12 +43,27 @@ namespace csv {
             void set_col_names(const std::vector<std::string>&);
             int index_of(csv::string_view) const;
 
+            /** Record the expected DataType of each column, as determined
+             *  by CSVReader::sample_types()
+             */
+            void set_type_hints(const std::vector<DataType>& hints) {
+                this->type_hints = hints;
+            }
+
+            /** Return the expected DataType of the ith column, or UNKNOWN
+             *  if no expectation has been recorded
+             */
+            DataType get_type_hint(size_t i) const {
+                return i < this->type_hints.size() ? this->type_hints[i] : UNKNOWN;
+            }
+
             bool empty() const { return this->col_names.empty(); }
             size_t size() const;
 
         private:
             std::vector<std::string> col_names;
             std::unordered_map<std::string, size_t> col_pos;
+            std::vector<DataType> type_hints;
         };
 
         /** Class for reducing number of new string and new vector
@@ -87,7 +104,25 @@ namespace csv {
             RowData get_row();
             size_t size() const;             /**< Return size of current row */
             size_t splits_size() const;      /**< Return (num columns - 1) for current row */
-            BufferPtr reset() const;         /**< Create a new RawRowBuffer with this buffer's unfinished work */
+
+            /** Fill `fields` with views over the in-progress row without
+             *  materializing a CSVRow. The views are only valid until more
+             *  text is appended to this buffer.
+             */
+            void get_current_row(std::vector<csv::string_view>& fields) const;
+
+            /** Throw away the in-progress row, immediately reclaiming its
+             *  bytes and split entries
+             */
+            void discard_row();
+
+            /** Create or lease a RawRowBuffer with this buffer's unfinished work.
+             *  If a pool is given, retired buffers are recycled instead of allocated.
+             */
+            BufferPtr reset(BufferPool* pool = nullptr) const;
+
+            /** Prepare this buffer for reuse, keeping its allocated capacity */
+            void clear();
 
             /*
              * TODO: Investigate performance benefits by storing a row's text right next to its 
@@ -108,6 +143,32 @@ namespace csv {
             size_t current_split_idx = 0;    /**< Where we are currently in the split buffer */
         };
 
+        /** A pool of RawRowBuffers which recycles buffers no longer referenced
+         *  by any CSVRow
+         *
+         *  @par Motivation
+         *  Every chunk of input parsed previously allocated a brand new
+         *  RawRowBuffer (and re-grew its text and split storage from scratch).
+         *  Because each buffer's text and split arrays keep their capacity
+         *  between uses, a pooled buffer reaches a steady state where parsing
+         *  performs no heap allocations per chunk.
+         */
+        class BufferPool {
+        public:
+            /** Return a cleared, previously retired buffer if one is free,
+             *  or a freshly allocated one otherwise
+             */
+            BufferPtr lease(const ColNamesPtr& col_names);
+
+        private:
+            /** Upper bound on buffers retained for reuse. Beyond this, extra
+             *  buffers are handed out unpooled and freed by their last CSVRow.
+             */
+            static constexpr size_t MAX_POOLED_BUFFERS = 64;
+
+            std::vector<BufferPtr> pool = {}; /**< Every buffer this pool has leased out */
+        };
+
         struct ColumnPositions {
             ColumnPositions() = default;
             constexpr ColumnPositions(size_t _start, StrBufferPos _size) : start(_start), n_cols(_size) {};
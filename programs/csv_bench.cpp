@@ -36,5 +36,15 @@ int main(int argc, char** argv) {
 
     std::cout << "Parsing took: " << diff.count() << std::endl;
 
+    // Benchmark 3: Parsing Only, delimiter and quote fixed at compile time
+    start = std::chrono::system_clock::now();
+    BasicCSVReader<> static_reader;
+    static_reader.feed(csv_str);
+    static_reader.end_feed();
+    end = std::chrono::system_clock::now();
+    diff = end - start;
+
+    std::cout << "Parsing took (static format): " << diff.count() << std::endl;
+
     return 0;
 }
\ No newline at end of file
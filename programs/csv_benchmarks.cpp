@@ -0,0 +1,202 @@
+/** Throughput benchmarks for the library's hot paths.
+ *
+ *  Each benchmark runs over corpora generated on the fly (so results are
+ *  reproducible without fixture files) and prints one CSV line per
+ *  measurement:
+ *
+ *      benchmark,corpus,metric,value
+ *
+ *  Pipe the output into a file per release to track regressions.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+#include "csv.hpp"
+
+using namespace csv;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double seconds_since(Clock::time_point start) {
+        std::chrono::duration<double> diff = Clock::now() - start;
+        return diff.count();
+    }
+
+    void report(const std::string& benchmark, const std::string& corpus,
+        const std::string& metric, double value) {
+        std::cout << benchmark << "," << corpus << ","
+            << metric << "," << value << std::endl;
+    }
+
+    /** Build an in-memory CSV corpus.
+     *
+     *  @param[in] n_rows Number of data rows
+     *  @param[in] n_cols Number of columns
+     *  @param[in] quoted Whether fields are quoted strings containing
+     *                    delimiters (otherwise plain numbers)
+     */
+    std::string make_corpus(size_t n_rows, size_t n_cols, bool quoted) {
+        std::mt19937 gen(42); // Fixed seed: identical corpora across runs
+        std::uniform_real_distribution<double> d(1, 1000000);
+
+        std::string out;
+        for (size_t i = 0; i < n_cols; i++) {
+            out += "Col" + std::to_string(i);
+            out += (i + 1 < n_cols) ? ',' : '\n';
+        }
+
+        for (size_t row = 0; row < n_rows; row++) {
+            for (size_t i = 0; i < n_cols; i++) {
+                if (quoted) {
+                    out += "\"value," + std::to_string(d(gen)) + "\"";
+                }
+                else {
+                    out += std::to_string(d(gen));
+                }
+
+                out += (i + 1 < n_cols) ? ',' : '\n';
+            }
+        }
+
+        return out;
+    }
+
+    double mb(size_t bytes) { return (double)bytes / 1048576.0; }
+
+    /** Raw parse() throughput in MB/s over an in-memory corpus */
+    void bench_parse(const std::string& name, const std::string& corpus) {
+        auto start = Clock::now();
+        auto rows = parse(corpus);
+        report("parse", name, "mb_per_sec", mb(corpus.size()) / seconds_since(start));
+    }
+
+    /** read_row() vs. iterator overhead, in rows/s over a temp file */
+    void bench_read_row(const std::string& name, const std::string& corpus, size_t n_rows) {
+        const char* temp_file = "csv_benchmarks_corpus.csv";
+
+        {
+            std::ofstream out(temp_file, std::ios::binary);
+            out.write(corpus.data(), corpus.size());
+        }
+
+        {
+            CSVReader reader(temp_file);
+            CSVRow row;
+            auto start = Clock::now();
+            while (reader.read_row(row));
+            report("read_row", name, "rows_per_sec", n_rows / seconds_since(start));
+        }
+
+        {
+            CSVReader reader(temp_file);
+            size_t count = 0;
+            auto start = Clock::now();
+            for (auto& row : reader) {
+                (void)row;
+                count++;
+            }
+            report("iterator", name, "rows_per_sec", count / seconds_since(start));
+        }
+
+        std::remove(temp_file);
+    }
+
+    /** CSVField::get<double>() conversions per second */
+    void bench_field_get(const std::string& name, const std::string& corpus) {
+        auto rows = parse(corpus);
+
+        double sum = 0;
+        size_t fields = 0;
+        auto start = Clock::now();
+
+        for (auto& row : rows) {
+            for (auto& field : row) {
+                sum += field.get<double>();
+                fields++;
+            }
+        }
+
+        report("field_get_double", name, "fields_per_sec", fields / seconds_since(start));
+
+        // Defeat dead code elimination
+        if (sum < 0) std::cerr << sum;
+    }
+
+    /** DelimWriter output rate in MB/s */
+    void bench_writer(size_t n_rows) {
+        const char* temp_file = "csv_benchmarks_writer.csv";
+        std::vector<std::string> record = {
+            "123.456", "needs,quoting", "plain text", "789", "0.001"
+        };
+
+        auto start = Clock::now();
+        size_t written;
+
+        {
+            std::ofstream out(temp_file, std::ios::binary);
+            auto writer = make_csv_writer(out);
+            for (size_t i = 0; i < n_rows; i++) {
+                writer << record;
+            }
+
+            writer.flush();
+            written = (size_t)out.tellp();
+        }
+
+        report("writer", "mixed", "mb_per_sec", mb(written) / seconds_since(start));
+        std::remove(temp_file);
+    }
+
+    /** guess_format() latency in microseconds per call */
+    void bench_guess(const std::string& name, const std::string& corpus) {
+        const char* temp_file = "csv_benchmarks_guess.csv";
+
+        {
+            std::ofstream out(temp_file, std::ios::binary);
+            out.write(corpus.data(), corpus.size());
+        }
+
+        constexpr int TRIALS = 100;
+        auto start = Clock::now();
+        for (int i = 0; i < TRIALS; i++) {
+            guess_format(temp_file);
+        }
+
+        report("guess_format", name, "usec_per_call",
+            seconds_since(start) * 1e6 / TRIALS);
+        std::remove(temp_file);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n_rows = 500000;
+    if (argc > 1) {
+        n_rows = (size_t)std::stoull(argv[1]);
+    }
+
+    const auto narrow = make_corpus(n_rows, 5, false);
+    const auto quoted = make_corpus(n_rows, 5, true);
+    const auto wide = make_corpus(n_rows / 10, 50, false);
+
+    std::cout << "benchmark,corpus,metric,value" << std::endl;
+
+    bench_parse("narrow", narrow);
+    bench_parse("quoted", quoted);
+    bench_parse("wide", wide);
+
+    bench_read_row("narrow", narrow, n_rows);
+    bench_read_row("quoted", quoted, n_rows);
+
+    bench_field_get("narrow", narrow);
+
+    bench_writer(n_rows);
+
+    bench_guess("narrow", narrow);
+    bench_guess("quoted", quoted);
+
+    return 0;
+}
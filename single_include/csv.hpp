@@ -30,6 +30,7 @@ SOFTWARE.
 #define CSV_HPP
 
 
+#endif
 // Copyright 2017-2019 by Martin Moene
 //
 // string-view lite, a C++17-like string_view for C++98 and later.
@@ -2950,6 +2951,11 @@ namespace csv {
     struct CSVGuessResult {
         char delim;
         int header_row;
+
+        /** True if the sampled data contains no quote characters at all,
+         *  making it eligible for the quote-free parsing fast lane
+         */
+        bool no_quote = false;
     };
 
     /** Stores information about how to parse a CSV file.
@@ -3022,6 +3028,31 @@ namespace csv {
             return *this;
         }
 
+        /** Sets how many worker threads the parser may split chunks of
+         *  input across (default 1, i.e. single-threaded parsing)
+         */
+        CONSTEXPR CSVFormat& threads(int n) {
+            this->n_threads = n > 0 ? n : 1;
+            return *this;
+        }
+
+        /** Parse only the named columns, skipping over all others at parse
+         *  time: unselected fields are never copied into the row buffer and
+         *  never receive split entries, so memory traffic shrinks with the
+         *  projection ratio.
+         *
+         *  @note Columns are returned in file order, not selection order
+         *  @note Parsing in-memory sources requires column_names() to also
+         *        be set, since the selection cannot be resolved otherwise
+         *
+         *  @throws `std::runtime_error` thrown by CSVReader if a selected
+         *          column does not exist
+         */
+        CSVFormat& select(const std::vector<std::string>& cols) {
+            this->selected_cols = cols;
+            return *this;
+        }
+
         #ifndef DOXYGEN_SHOULD_SKIP_THIS
         char get_delim() const {
             // This error should never be received by end users.
@@ -3037,7 +3068,9 @@ namespace csv {
         CONSTEXPR int get_header() const { return this->header; }
         std::vector<char> get_possible_delims() const { return this->possible_delimiters; }
         std::vector<char> get_trim_chars() const { return this->trim_chars; }
+        std::vector<std::string> get_selected_cols() const { return this->selected_cols; }
         CONSTEXPR VariableColumnPolicy get_variable_column_policy() const { return this->variable_column_policy; }
+        CONSTEXPR int get_n_threads() const { return this->n_threads; }
         #endif
         
         /** CSVFormat for guessing the delimiter */
@@ -3079,172 +3112,19 @@ namespace csv {
         /**< Should be left empty unless file doesn't include header */
         std::vector<std::string> col_names = {};
 
+        /**< Columns to materialize when parsing (empty = all of them) */
+        std::vector<std::string> selected_cols = {};
+
         /**< Allow variable length columns? */
         VariableColumnPolicy variable_column_policy = VariableColumnPolicy::IGNORE_ROW;
 
+        /**< Maximum number of parse worker threads */
+        int n_threads = 1;
+
         /**< Detect and strip out Unicode byte order marks */
         bool unicode_detect = true;
     };
 }
-/** @file
-  *  A standalone header file for writing delimiter-separated files
-  */
-
-#include <iostream>
-#include <vector>
-#include <string>
-#include <fstream>
-
-namespace csv {
-    /** @name CSV Writing */
-    ///@{
-    #ifndef DOXYGEN_SHOULD_SKIP_THIS
-    template<char Delim = ',', char Quote = '"'>
-    inline std::string csv_escape(csv::string_view in, const bool quote_minimal = true) {
-        /** Format a string to be RFC 4180-compliant
-         *  @param[in]  in              String to be CSV-formatted
-         *  @param[out] quote_minimal   Only quote fields if necessary.
-         *                              If False, everything is quoted.
-         */
-
-        // Sequence used for escaping quote characters that appear in text
-        constexpr char double_quote[3] = { Quote, Quote };
-
-        std::string new_string;
-        bool quote_escape = false;     // Do we need a quote escape
-        new_string += Quote;           // Start initial quote escape sequence
-
-        for (size_t i = 0; i < in.size(); i++) {
-            switch (in[i]) {
-            case Quote:
-                new_string += double_quote;
-                quote_escape = true;
-                break;
-            case Delim:
-                quote_escape = true;
-                HEDLEY_FALL_THROUGH;
-            default:
-                new_string += in[i];
-            }
-        }
-
-        if (quote_escape || !quote_minimal) {
-            new_string += Quote; // Finish off quote escape
-            return new_string;
-        }
-
-        return std::string(in);
-    }
-    #endif
-
-    /** 
-     *  Class for writing delimiter separated values files
-     *
-     *  To write formatted strings, one should
-     *   -# Initialize a DelimWriter with respect to some output stream 
-     *   -# Call write_row() on std::vector<std::string>s of unformatted text
-     *
-     *  @tparam OutputStream The output stream, e.g. `std::ofstream`, `std::stringstream`
-     *  @tparam Delim        The delimiter character
-     *  @tparam Quote        The quote character
-     *
-     *  @par Hint
-     *  Use the aliases csv::CSVWriter<OutputStream> to write CSV
-     *  formatted strings and csv::TSVWriter<OutputStream>
-     *  to write tab separated strings
-     *
-     *  @par Example
-     *  @snippet test_write_csv.cpp CSV Writer Example
-     */
-    template<class OutputStream, char Delim, char Quote>
-    class DelimWriter {
-    public:
-        /** Construct a DelimWriter over the specified output stream */
-        DelimWriter(OutputStream& _out) : out(_out) {};
-
-        /** Construct a DelimWriter over the file
-         *
-         *  @param[out] filename  File to write to
-         */
-        DelimWriter(const std::string& filename) : DelimWriter(std::ifstream(filename)) {};
-
-        /** Format a sequence of strings and write to CSV according to RFC 4180
-         *
-         *  @warning This does not check to make sure row lengths are consistent
-         *
-         *  @param[in]  record          Sequence of strings to be formatted
-         *  @param      quote_minimal   Only quote fields if necessary
-         */
-        template<typename T, typename Alloc, template <typename, typename> class Container>
-        void write_row(const Container<T, Alloc>& record, bool quote_minimal = true) {
-            const size_t ilen = record.size();
-            size_t i = 0;
-            for (auto& field: record) {
-                out << csv_escape<Delim, Quote>(field, quote_minimal);
-                if (i + 1 != ilen) out << Delim;
-                i++;
-            }
-
-            out << std::endl;
-        }
-
-        /** @copydoc write_row
-         *  @return  The current DelimWriter instance (allowing for operator chaining)
-         */
-        template<typename T, typename Alloc, template <typename, typename> class Container>
-        DelimWriter& operator<<(const Container<T, Alloc>& record) {
-            this->write_row(record);
-            return *this;
-        }
-
-    private:
-        OutputStream & out;
-    };
-
-    /* Uncomment when C++17 support is better
-    template<class OutputStream>
-    DelimWriter(OutputStream&) -> DelimWriter<OutputStream>;
-    */
-
-    /** Class for writing CSV files
-     *
-     *  @sa csv::DelimWriter::write_row()
-     *  @sa csv::DelimWriter::operator<<()
-     *
-     *  @note Use `csv::make_csv_writer()` to in instatiate this class over
-     *        an actual output stream.
-     */
-    template<class OutputStream>
-    using CSVWriter = DelimWriter<OutputStream, ',', '"'>;
-
-    /** Class for writing tab-separated values files
-*
-     *  @sa csv::DelimWriter::write_row()
-     *  @sa csv::DelimWriter::operator<<()
-     *
-     *  @note Use `csv::make_tsv_writer()` to in instatiate this class over
-     *        an actual output stream.
-     */
-    template<class OutputStream>
-    using TSVWriter = DelimWriter<OutputStream, '\t', '"'>;
-
-    //
-    // Temporary: Until more C++17 compilers support template deduction guides
-    //
-    template<class OutputStream>
-    inline CSVWriter<OutputStream> make_csv_writer(OutputStream& out) {
-        /** Return a CSVWriter over the output stream */
-        return CSVWriter<OutputStream>(out);
-    }
-
-    template<class OutputStream>
-    inline TSVWriter<OutputStream> make_tsv_writer(OutputStream& out) {
-        /** Return a TSVWriter over the output stream */
-        return TSVWriter<OutputStream>(out);
-    }
-
-    ///@}
-}
 /** @file
  *  @brief Implements data type parsing functionality
  */
@@ -3585,6 +3465,160 @@ namespace csv {
             // Just whitespace
             return CSV_NULL;
         }
+
+        /** Exact double values of 10^0 through 10^22 */
+        CONSTEXPR_VALUE double POW10_DOUBLE[] = {
+            1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /** Largest mantissa a double can represent exactly (2^53) */
+        CONSTEXPR_VALUE unsigned long long FAST_MANTISSA_MAX = 1ULL << 53;
+
+        /** A numeric string decomposed into mantissa * 10^exponent form
+         *  by scan_number()
+         */
+        struct DecimalComponents {
+            unsigned long long mantissa = 0;
+            int exponent = 0;       /**< Power of ten applied to the mantissa */
+            bool negative = false;
+            bool is_float = false;  /**< Whether a '.' or exponent was seen */
+            size_t digits = 0;      /**< Number of mantissa digits consumed */
+        };
+
+        /** Decompose a numeric string into exact integer components.
+         *
+         *  Handles the overwhelmingly common case: an optional sign, up
+         *  to 19 digits, an optional decimal point, and an optional
+         *  integer exponent. Returns false for anything else (padding,
+         *  embedded whitespace, too many digits, non-numeric text) so
+         *  callers can fall back to data_type().
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool scan_number(csv::string_view in, DecimalComponents& result) noexcept {
+            size_t i = 0;
+            const size_t n = in.size();
+
+            if (n == 0) return false;
+
+            if (in[i] == '-') {
+                result.negative = true;
+                i++;
+            }
+
+            for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                if (result.digits == 19) return false;
+                result.mantissa = result.mantissa * 10 + (unsigned long long)(in[i] - '0');
+                result.digits++;
+            }
+
+            if (i < n && in[i] == '.') {
+                result.is_float = true;
+                i++;
+
+                for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                    if (result.digits == 19) return false;
+                    result.mantissa = result.mantissa * 10 + (unsigned long long)(in[i] - '0');
+                    result.digits++;
+                    result.exponent--;
+                }
+            }
+
+            if (result.digits == 0) return false;
+
+            if (i < n && (in[i] == 'e' || in[i] == 'E')) {
+                result.is_float = true;
+                i++;
+
+                bool exp_negative = false;
+                if (i < n && (in[i] == '+' || in[i] == '-')) {
+                    exp_negative = in[i] == '-';
+                    i++;
+                }
+
+                int exp_value = 0;
+                size_t exp_digits = 0;
+                for (; i < n && in[i] >= '0' && in[i] <= '9'; i++) {
+                    if (exp_digits == 3) return false;
+                    exp_value = exp_value * 10 + (in[i] - '0');
+                    exp_digits++;
+                }
+
+                if (exp_digits == 0) return false;
+                result.exponent += exp_negative ? -exp_value : exp_value;
+            }
+
+            // Trailing garbage
+            return i == n;
+        }
+
+        /** Fast-path equivalent of data_type(): classifies and converts
+         *  numeric strings using exact integer arithmetic, returning
+         *  UNKNOWN for hard cases (padding, huge values, extreme
+         *  exponents) which must go through data_type() instead.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        DataType data_type_fast(csv::string_view in, long double* const out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)) return UNKNOWN;
+
+            if (!number.is_float) {
+                long double value = (long double)number.mantissa;
+                if (out) *out = number.negative ? -value : value;
+                return _determine_integral_type(value);
+            }
+
+            // Clinger's fast path: a mantissa scaled by an exact power
+            // of ten rounds correctly in a single operation
+            if (number.mantissa > FAST_MANTISSA_MAX
+                || number.exponent < -22 || number.exponent > 22)
+                return UNKNOWN;
+
+            long double value = (long double)number.mantissa;
+            if (number.exponent >= 0)
+                value *= POW10_DOUBLE[number.exponent];
+            else
+                value /= POW10_DOUBLE[-number.exponent];
+
+            if (out) *out = number.negative ? -value : value;
+            return CSV_DOUBLE;
+        }
+
+        /** Parse a double directly from text, bypassing long double
+         *  arithmetic entirely. Returns false for hard or non-numeric cases.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool fast_parse_double(csv::string_view in, double& out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)
+                || number.mantissa > FAST_MANTISSA_MAX
+                || number.exponent < -22 || number.exponent > 22)
+                return false;
+
+            double value = (double)number.mantissa;
+            if (number.exponent >= 0)
+                value *= POW10_DOUBLE[number.exponent];
+            else
+                value /= POW10_DOUBLE[-number.exponent];
+
+            out = number.negative ? -value : value;
+            return true;
+        }
+
+        /** Parse a 64-bit integer directly from text. Returns false for
+         *  floats, out-of-range values, and non-numeric cases.
+         */
+        HEDLEY_PRIVATE CONSTEXPR
+        bool fast_parse_int64(csv::string_view in, long long& out) noexcept {
+            DecimalComponents number;
+            if (!scan_number(in, number)
+                || number.is_float
+                || number.mantissa > (unsigned long long)std::numeric_limits<long long>::max())
+                return false;
+
+            out = number.negative ? -(long long)number.mantissa : (long long)number.mantissa;
+            return true;
+        }
     }
 }
 /** @file
@@ -3624,6 +3658,16 @@ namespace csv {
          *  many bytes are read at a time
          */
         constexpr size_t ITERATION_CHUNK_SIZE = 50000000; // 50MB
+
+        /** Minimum amount of input each parallel parse worker should receive.
+         *  Below this, thread start-up costs outweigh any parsing speedup.
+         */
+        constexpr size_t PARALLEL_SLICE_MIN = 65536; // 64KB
+
+        /** How many raw compressed bytes are staged per read when
+         *  stream-decompressing gzip or zstd input
+         */
+        constexpr size_t COMPRESSED_CHUNK_SIZE = 1048576; // 1MB
     }
 
     /** Integer indicating a requested column wasn't found. */
@@ -3633,6 +3677,7 @@ namespace csv {
     using RowCount = long long int;
 }
 
+#include <iosfwd>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -3647,6 +3692,33 @@ namespace csv {
         int n_cols;                         /**< Number of columns in a CSV */
     };
 
+    /** Returned by profile_csv(): like CSVFileInfo, but gathered from a
+     *  handful of sampled blocks instead of a full scan, with per-column
+     *  type information
+     */
+    struct CSVFileProfile {
+        std::string filename;               /**< Filename */
+        std::vector<std::string> col_names; /**< CSV column names */
+        char delim;                         /**< Delimiting character */
+        int n_cols;                         /**< Number of columns in a CSV */
+
+        /** Estimated row count, extrapolated from rows per sampled byte */
+        RowCount n_rows_estimate;
+
+        /** Rows actually inspected across all sampled blocks */
+        RowCount n_rows_sampled;
+
+        /** Widest type observed per column: CSV_STRING if any sampled field
+         *  was non-numeric, otherwise CSV_DOUBLE or the widest integer type
+         */
+        std::vector<DataType> types;
+
+        /** type_counts[i][type] = number of sampled fields in column i
+         *  whose data_type() was `type`
+         */
+        std::vector<std::vector<size_t>> type_counts;
+    };
+
     /** @name Shorthand Parsing Functions
      *  @brief Convienience functions for parsing small strings
      */
@@ -3658,9 +3730,14 @@ namespace csv {
     /** @name Utility Functions */
     ///@{
     std::unordered_map<std::string, DataType> csv_data_types(const std::string&);
+    size_t concat(const std::string& output, const std::vector<std::string>& inputs);
     CSVFileInfo get_file_info(const std::string& filename);
+    RowCount count_rows(const std::string& filename, size_t n_threads = 0);
+    CSVFileProfile profile_csv(const std::string& filename,
+        size_t n_blocks = 8, size_t block_size = 65536);
     int get_col_pos(const std::string filename, const std::string col_name,
         const CSVFormat format = CSVFormat::guess_csv());
+    RowCount to_jsonl(CSVReader& reader, std::ostream& out);
     ///@}
 
     namespace internals {
@@ -3685,6 +3762,7 @@ namespace csv {
 
 namespace csv {
     namespace internals {
+        class BufferPool;
         class RawRowBuffer;
         struct RowData;
         struct ColumnPositions;
@@ -3712,12 +3790,27 @@ namespace csv {
             void set_col_names(const std::vector<std::string>&);
             int index_of(csv::string_view) const;
 
+            /** Record the expected DataType of each column, as determined
+             *  by CSVReader::sample_types()
+             */
+            void set_type_hints(const std::vector<DataType>& hints) {
+                this->type_hints = hints;
+            }
+
+            /** Return the expected DataType of the ith column, or UNKNOWN
+             *  if no expectation has been recorded
+             */
+            DataType get_type_hint(size_t i) const {
+                return i < this->type_hints.size() ? this->type_hints[i] : UNKNOWN;
+            }
+
             bool empty() const { return this->col_names.empty(); }
             size_t size() const;
 
         private:
             std::vector<std::string> col_names;
             std::unordered_map<std::string, size_t> col_pos;
+            std::vector<DataType> type_hints;
         };
 
         /** Class for reducing number of new string and new vector
@@ -3758,12 +3851,30 @@ namespace csv {
             RowData get_row();
             size_t size() const;             /**< Return size of current row */
             size_t splits_size() const;      /**< Return (num columns - 1) for current row */
-            BufferPtr reset() const;         /**< Create a new RawRowBuffer with this buffer's unfinished work */
 
-            /*
-             * TODO: Investigate performance benefits by storing a row's text right next to its 
-             * split_buffer. This would take greater advantage of locality, but would require a reworking
-             * of this data structure.
+            /** Fill `fields` with views over the in-progress row without
+             *  materializing a CSVRow. The views are only valid until more
+             *  text is appended to this buffer.
+             */
+            void get_current_row(std::vector<csv::string_view>& fields) const;
+
+            /** Throw away the in-progress row, immediately reclaiming its
+             *  bytes and split entries
+             */
+            void discard_row();
+
+            /** Create or lease a RawRowBuffer with this buffer's unfinished work.
+             *  If a pool is given, retired buffers are recycled instead of allocated.
+             */
+            BufferPtr reset(BufferPool* pool = nullptr) const;
+
+            /** Prepare this buffer for reuse, keeping its allocated capacity */
+            void clear();
+
+            /*
+             * TODO: Investigate performance benefits by storing a row's text right next to its 
+             * split_buffer. This would take greater advantage of locality, but would require a reworking
+             * of this data structure.
              */
 
             std::string buffer;              /**< Buffer for storing text */
@@ -3779,6 +3890,32 @@ namespace csv {
             size_t current_split_idx = 0;    /**< Where we are currently in the split buffer */
         };
 
+        /** A pool of RawRowBuffers which recycles buffers no longer referenced
+         *  by any CSVRow
+         *
+         *  @par Motivation
+         *  Every chunk of input parsed previously allocated a brand new
+         *  RawRowBuffer (and re-grew its text and split storage from scratch).
+         *  Because each buffer's text and split arrays keep their capacity
+         *  between uses, a pooled buffer reaches a steady state where parsing
+         *  performs no heap allocations per chunk.
+         */
+        class BufferPool {
+        public:
+            /** Return a cleared, previously retired buffer if one is free,
+             *  or a freshly allocated one otherwise
+             */
+            BufferPtr lease(const ColNamesPtr& col_names);
+
+        private:
+            /** Upper bound on buffers retained for reuse. Beyond this, extra
+             *  buffers are handed out unpooled and freed by their last CSVRow.
+             */
+            static constexpr size_t MAX_POOLED_BUFFERS = 64;
+
+            std::vector<BufferPtr> pool = {}; /**< Every buffer this pool has leased out */
+        };
+
         struct ColumnPositions {
             ColumnPositions() = default;
             constexpr ColumnPositions(size_t _start, StrBufferPos _size) : start(_start), n_cols(_size) {};
@@ -3799,6 +3936,7 @@ namespace csv {
  */
 
 #include <math.h>
+#include <tuple> // For CSVRow::unpack()
 #include <vector>
 #include <string>
 #include <iterator>
@@ -3814,10 +3952,49 @@ namespace csv {
         static const std::string ERROR_FLOAT_TO_INT =
             "Attempted to convert a floating point value to an integral type.";
         static const std::string ERROR_NEG_TO_UNSIGNED = "Negative numbers cannot be converted to unsigned types.";
+        static const std::string ERROR_UNPACK_ROW_SIZE = "Row has fewer fields than unpack() destinations.";
     
         std::string json_escape_string(csv::string_view s) noexcept;
+        void json_append_escaped(std::string& result, csv::string_view s) noexcept;
     }
 
+    class CSVReader;
+
+    /** A column name resolved to its position exactly once, so loops that
+     *  access the same columns by name on every row pay an integer index
+     *  instead of a hash lookup per access.
+     *
+     *  Created by CSVReader::column() and passed to CSVRow::operator[].
+     *  A handle stays valid for every row produced by the reader that
+     *  created it.
+     */
+    class ColumnHandle {
+    public:
+        ColumnHandle() = default;
+
+        /** Position of the column within its rows */
+        size_t index() const { return this->idx; }
+
+        /** Name this handle was resolved from */
+        std::string name() const { return this->col_name; }
+
+    private:
+        friend class CSVReader;
+        friend class CSVRow;
+
+        ColumnHandle(size_t _idx, std::string _name,
+            std::shared_ptr<internals::ColNames> _owner) :
+            idx(_idx), col_name(std::move(_name)), owner(std::move(_owner)) {};
+
+        size_t idx = 0;       /**< Resolved column position */
+        std::string col_name; /**< Original column name */
+
+        /** The column table the handle was resolved against, compared by
+         *  identity to reject handles from a different reader
+         */
+        std::shared_ptr<internals::ColNames> owner = nullptr;
+    };
+
     /**
     * @class CSVField
     * @brief Data type representing individual CSV values.
@@ -3825,8 +4002,11 @@ namespace csv {
     */
     class CSVField {
     public:
-        /** Constructs a CSVField from a string_view */
-        constexpr explicit CSVField(csv::string_view _sv) : sv(_sv) { };
+        /** Constructs a CSVField from a string_view, optionally with the
+         *  column's expected DataType (see CSVReader::sample_types())
+         */
+        constexpr explicit CSVField(csv::string_view _sv, DataType _type_hint = UNKNOWN)
+            : sv(_sv), type_hint(_type_hint) { };
 
         operator std::string() const {
             return std::string("<CSVField> ") + std::string(this->sv);
@@ -3962,12 +4142,35 @@ namespace csv {
         long double value = 0;    /**< Cached numeric value */
         csv::string_view sv = ""; /**< A pointer to this field's text */
         DataType _type = UNKNOWN; /**< Cached data type value */
+        DataType type_hint = UNKNOWN; /**< Expected type of this field's column */
+
+        /** Returns true if this field's first character rules out any
+         *  numeric or null interpretation
+         */
+        CONSTEXPR bool is_clearly_string() const {
+            if (this->sv.empty()) return false;
+
+            const char ch = this->sv[0];
+            return !(ch >= '0' && ch <= '9') && ch != '-' && ch != '.' && ch != ' ';
+        }
+
         CONSTEXPR void get_value() {
             /* Check to see if value has been cached previously, if not
              * evaluate it
              */
             if (_type < 0) {
-                this->_type = internals::data_type(this->sv, &this->value);
+                // A column known to hold strings can often skip
+                // inference entirely
+                if (this->type_hint == CSV_STRING && this->is_clearly_string()) {
+                    this->_type = CSV_STRING;
+                    return;
+                }
+
+                // Try the exact integer fast path first; hard cases
+                // fall back to the long double parser
+                this->_type = internals::data_type_fast(this->sv, &this->value);
+                if (this->_type == UNKNOWN)
+                    this->_type = internals::data_type(this->sv, &this->value);
             }
         }
     };
@@ -4000,15 +4203,66 @@ namespace csv {
         ///@{
         CSVField operator[](size_t n) const;
         CSVField operator[](const std::string&) const;
+        CSVField operator[](const ColumnHandle&) const;
         csv::string_view get_string_view(size_t n) const;
         std::string to_json(const std::vector<std::string>& subset = {}) const;
         std::string to_json_array(const std::vector<std::string>& subset = {}) const;
+        void to_json_into(std::string& out, const std::vector<std::string>& subset = {}) const;
+        void to_json_array_into(std::string& out, const std::vector<std::string>& subset = {}) const;
 
         /** Convert this CSVRow into a vector of strings.
          *  **Note**: This is a less efficient method of
          *  accessing data than using the [] operator.
          */
         operator std::vector<std::string>() const;
+
+        /** Unpack this row's leading fields into typed destinations in one
+         *  linear pass — e.g. straight into the members of a user struct:
+         *
+         *  @code
+         *  struct Reading { std::string station; double temp; int count; };
+         *
+         *  Reading r;
+         *  row.unpack(r.station, r.temp, r.count);
+         *  @endcode
+         *
+         *  Strings are assigned in place (reusing the destination's
+         *  capacity), string_views alias the row's buffer, and numeric
+         *  destinations convert with the same checked machinery as
+         *  CSVField::get<T>() — no intermediate strings are created.
+         *
+         *  @throws std::runtime_error if the row has fewer fields than
+         *          destinations, or a field fails numeric conversion
+         */
+        template<typename... Ts>
+        void unpack(Ts&... dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_into<0>(dests...);
+        }
+
+        /** @copydoc unpack
+         *  Tuple overload, e.g. for a `std::tie` of struct members
+         */
+        template<typename... Ts>
+        void unpack(std::tuple<Ts...>& dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_tuple<0>(dests);
+        }
+
+        /** @copydoc unpack
+         *  Accepts the reference tuples std::tie produces
+         */
+        template<typename... Ts>
+        void unpack(std::tuple<Ts&...>&& dests) const {
+            if (sizeof...(Ts) > this->size())
+                throw std::runtime_error(internals::ERROR_UNPACK_ROW_SIZE);
+
+            this->unpack_tuple<0>(dests);
+        }
         ///@}
 
         /** A random access iterator over the contents of a CSV row.
@@ -4019,15 +4273,7 @@ namespace csv {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
             using value_type = CSVField;
             using difference_type = int;
-
-            // Using CSVField * as pointer type causes segfaults in MSVC debug builds
-            // but using shared_ptr as pointer type won't compile in g++
-#ifdef _MSC_BUILD
-            using pointer = std::shared_ptr<CSVField>;
-#else
             using pointer = CSVField * ;
-#endif
-
             using reference = CSVField & ;
             using iterator_category = std::random_access_iterator_tag;
 #endif
@@ -4055,9 +4301,13 @@ namespace csv {
 #endif
 
         private:
-            const CSVRow * daddy = nullptr;            // Pointer to parent
-            std::shared_ptr<CSVField> field = nullptr; // Current field pointed at
-            int i = 0;                                 // Index of current field
+            const CSVRow * daddy = nullptr;        // Pointer to parent
+
+            // Current field pointed at. Held by value so iterating a row
+            // performs no heap allocations.
+            mutable CSVField field = CSVField("");
+
+            int i = 0;                             // Index of current field
         };
 
         /** A reverse iterator over the contents of a CSVRow. */
@@ -4074,6 +4324,49 @@ namespace csv {
         ///@}
 
     private:
+        /** @name unpack() helpers
+         *  One destination is filled per step, dispatching on its type
+         */
+        ///@{
+        /** Copy a field's bytes into a string, reusing its capacity */
+        void unpack_field(csv::string_view sv, std::string& dest) const {
+            dest.assign(sv.data(), sv.size());
+        }
+
+        /** Alias a field's bytes; only valid while this row is alive */
+        void unpack_field(csv::string_view sv, csv::string_view& dest) const {
+            dest = sv;
+        }
+
+        /** Convert a numeric field with CSVField's checked machinery */
+        template<typename T,
+            typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        void unpack_field(csv::string_view sv, T& dest) const {
+            dest = CSVField(sv).get<T>();
+        }
+
+        template<size_t I>
+        void unpack_into() const {}
+
+        template<size_t I, typename T, typename... Rest>
+        void unpack_into(T& dest, Rest&... rest) const {
+            this->unpack_field(this->get_string_view(I), dest);
+            this->unpack_into<I + 1>(rest...);
+        }
+
+        template<size_t I, typename... Ts>
+        typename std::enable_if<(I < sizeof...(Ts))>::type
+        unpack_tuple(std::tuple<Ts...>& dests) const {
+            this->unpack_field(this->get_string_view(I), std::get<I>(dests));
+            this->unpack_tuple<I + 1>(dests);
+        }
+
+        /** Base case: every destination has been filled */
+        template<size_t I, typename... Ts>
+        typename std::enable_if<I == sizeof...(Ts)>::type
+        unpack_tuple(std::tuple<Ts...>&) const {}
+        ///@}
+
         /** Get the index in CSVRow's text buffer where the n-th field begins */
         size_t split_at(size_t n) const;
 
@@ -4081,6 +4374,106 @@ namespace csv {
         internals::RowData data;               /**< Contains row string and column positions. */
     };
 
+    namespace internals {
+        /** A FIFO of CSVRow records backed by a preallocated power-of-two
+         *  ring, used for the parser-to-consumer row hand-off.
+         *
+         *  Unlike std::deque, pushing and popping in steady state performs
+         *  no allocation: slots are reused via move assignment, and the
+         *  contiguous backing array keeps draining loops prefetch-friendly.
+         *  When the queue outgrows its ring — bounded in practice by the
+         *  iteration chunk size — capacity doubles and the ring re-lays
+         *  itself out, so pathological inputs spill gracefully.
+         */
+        class RecordRing {
+        public:
+            /** An index-based iterator over the ring's logical order */
+            class iterator {
+            public:
+                #ifndef DOXYGEN_SHOULD_SKIP_THIS
+                using value_type = CSVRow;
+                using difference_type = std::ptrdiff_t;
+                using pointer = CSVRow*;
+                using reference = CSVRow&;
+                using iterator_category = std::forward_iterator_tag;
+                #endif
+
+                iterator(RecordRing* _ring, size_t _i) : ring(_ring), i(_i) {};
+
+                reference operator*() const { return (*this->ring)[this->i]; }
+                pointer operator->() const { return &(*this->ring)[this->i]; }
+                iterator& operator++() { this->i++; return *this; }
+                iterator operator+(difference_type n) const {
+                    return iterator(this->ring, this->i + (size_t)n);
+                }
+
+                bool operator==(const iterator& other) const { return this->i == other.i; }
+                bool operator!=(const iterator& other) const { return !operator==(other); }
+
+            private:
+                RecordRing* ring; /**< The ring being traversed */
+                size_t i;         /**< Logical position within it */
+            };
+
+            /** Initial ring size; must be a power of two */
+            static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+            RecordRing() : slots(DEFAULT_CAPACITY) {};
+
+            bool empty() const { return this->n == 0; }
+            size_t size() const { return this->n; }
+
+            /** Drop all records, keeping the ring's capacity for reuse */
+            void clear() {
+                while (this->n > 0) this->pop_front();
+                this->head = 0;
+            }
+
+            CSVRow& front() { return (*this)[0]; }
+            const CSVRow& front() const {
+                return this->slots[this->head & (this->slots.size() - 1)];
+            }
+
+            /** Retrieve the ith record in queue order */
+            CSVRow& operator[](size_t i) {
+                return this->slots[(this->head + i) & (this->slots.size() - 1)];
+            }
+
+            void push_back(CSVRow&& row) {
+                if (this->n == this->slots.size()) this->grow();
+                (*this)[this->n] = std::move(row);
+                this->n++;
+            }
+
+            void push_back(const CSVRow& row) { this->push_back(CSVRow(row)); }
+
+            void pop_front() {
+                // Release the slot's buffer reference; the slot itself is reused
+                this->front() = CSVRow();
+                this->head++;
+                this->n--;
+            }
+
+            iterator begin() { return iterator(this, 0); }
+            iterator end() { return iterator(this, this->n); }
+
+        private:
+            /** Double the ring, re-laying records out in queue order */
+            void grow() {
+                std::vector<CSVRow> bigger(this->slots.size() * 2);
+                for (size_t i = 0; i < this->n; i++)
+                    bigger[i] = std::move((*this)[i]);
+
+                this->slots.swap(bigger);
+                this->head = 0;
+            }
+
+            std::vector<CSVRow> slots; /**< Preallocated record storage */
+            size_t head = 0;           /**< Logical index of the oldest record */
+            size_t n = 0;              /**< Number of queued records */
+        };
+    }
+
 #pragma region CSVField::get Specializations
     /** Retrieve this field's original string */
     template<>
@@ -4106,6 +4499,43 @@ namespace csv {
 
         return this->value;
     }
+
+    /** Retrieve this field's value as a double, parsing directly from
+     *  text when possible and never performing long double arithmetic
+     */
+    template<>
+    CONSTEXPR double CSVField::get<double>() {
+        if (this->_type == UNKNOWN) {
+            double result = 0;
+            if (internals::fast_parse_double(this->sv, result))
+                return result;
+        }
+
+        if (this->type() <= CSV_STRING)
+            throw std::runtime_error(internals::ERROR_NAN);
+
+        return static_cast<double>(this->value);
+    }
+
+    /** Retrieve this field's value as a 64-bit integer, parsing directly
+     *  from text when possible and never performing long double arithmetic
+     */
+    template<>
+    CONSTEXPR long long CSVField::get<long long>() {
+        if (this->_type == UNKNOWN) {
+            long long result = 0;
+            if (internals::fast_parse_int64(this->sv, result))
+                return result;
+        }
+
+        if (this->type() <= CSV_STRING)
+            throw std::runtime_error(internals::ERROR_NAN);
+
+        if (this->is_float())
+            throw std::runtime_error(internals::ERROR_FLOAT_TO_INT);
+
+        return static_cast<long long>(this->value);
+    }
 #pragma endregion CSVField::get Specializations
 
     /** Compares the contents of this field to a string */
@@ -4127,1990 +4557,7812 @@ inline std::ostream& operator << (std::ostream& os, csv::CSVField const& value)
     os << std::string(value);
     return os;
 }
-#include <array>
-#include <deque>
-#include <functional>
-#include <fstream>
-#include <memory>
+#ifdef CSV_EXTERN_TEMPLATES
+namespace csv {
+    /** When consuming the compiled library (which defines
+     *  CSV_EXTERN_TEMPLATES via its CMake target), the common arithmetic
+     *  get<>() instantiations are compiled once into the library — see
+     *  csv_instantiations.cpp — instead of once per client translation
+     *  unit. Types below are those without a dedicated specialization
+     *  above. The single header is unaffected.
+     */
+    extern template short CSVField::get<short>();
+    extern template unsigned short CSVField::get<unsigned short>();
+    extern template int CSVField::get<int>();
+    extern template unsigned int CSVField::get<unsigned int>();
+    extern template long CSVField::get<long>();
+    extern template unsigned long CSVField::get<unsigned long>();
+    extern template unsigned long long CSVField::get<unsigned long long>();
+    extern template float CSVField::get<float>();
+}
+#endif
+
+/** @file
+  *  A standalone header file for writing delimiter-separated files
+  */
+
+#include <cstdio>  // For snprintf()
+#include <cstdlib> // For strtold()
+#include <cstring> // For memchr()
+#include <iostream>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 #include <string>
+#include <fstream>
+#include <sstream>
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    #include <charconv>
+    #define CSV_HAS_TO_CHARS
+#endif
 
 
 namespace csv {
-    namespace internals {
-        /**  @typedef ParseFlags
-         *   An enum used for describing the significance of each character
-         *   with respect to CSV parsing
+    /** @name CSV Writing */
+    ///@{
+    #ifndef DOXYGEN_SHOULD_SKIP_THIS
+    template<char Delim = ',', char Quote = '"'>
+    inline std::string csv_escape(csv::string_view in, const bool quote_minimal = true) {
+        /** Format a string to be RFC 4180-compliant
+         *  @param[in]  in              String to be CSV-formatted
+         *  @param[out] quote_minimal   Only quote fields if necessary.
+         *                              If False, everything is quoted.
          */
-        enum ParseFlags {
-            NOT_SPECIAL, /**< Characters with no special meaning */
-            QUOTE,       /**< Characters which may signify a quote escape */
-            DELIMITER,   /**< Characters which may signify a new field */
-            NEWLINE      /**< Characters which may signify a new row */
-        };
 
-        using ParseFlagMap = std::array<ParseFlags, 256>;
-        using WhitespaceMap = std::array<bool, 256>;
+        // Sequence used for escaping quote characters that appear in text
+        constexpr char double_quote[3] = { Quote, Quote };
 
-        /** Create a vector v where each index i corresponds to the
-         *  ASCII number for a character and, v[i + 128] labels it according to
-         *  the CSVReader::ParseFlags enum
-         */
-        HEDLEY_CONST CONSTEXPR ParseFlagMap make_parse_flags(char delimiter) {
-            std::array<ParseFlags, 256> ret = {};
-            for (int i = -128; i < 128; i++) {
-                const int arr_idx = i + 128;
-                char ch = char(i);
+        std::string new_string;
+        bool quote_escape = false;     // Do we need a quote escape
+        new_string += Quote;           // Start initial quote escape sequence
 
-                if (ch == delimiter)
-                    ret[arr_idx] = DELIMITER;
-                else if (ch == '\r' || ch == '\n')
-                    ret[arr_idx] = NEWLINE;
-                else
-                    ret[arr_idx] = NOT_SPECIAL;
+        for (size_t i = 0; i < in.size(); i++) {
+            switch (in[i]) {
+            case Quote:
+                new_string += double_quote;
+                quote_escape = true;
+                break;
+            case Delim:
+                quote_escape = true;
+                HEDLEY_FALL_THROUGH;
+            default:
+                new_string += in[i];
             }
+        }
 
-            return ret;
+        if (quote_escape || !quote_minimal) {
+            new_string += Quote; // Finish off quote escape
+            return new_string;
         }
 
-        /** Create a vector v where each index i corresponds to the
-         *  ASCII number for a character and, v[i + 128] labels it according to
-         *  the CSVReader::ParseFlags enum
+        return std::string(in);
+    }
+    #endif
+
+    /** 
+     *  Class for writing delimiter separated values files
+     *
+     *  To write formatted strings, one should
+     *   -# Initialize a DelimWriter with respect to some output stream 
+     *   -# Call write_row() on std::vector<std::string>s of unformatted text
+     *
+     *  @tparam OutputStream The output stream, e.g. `std::ofstream`, `std::stringstream`
+     *  @tparam Delim        The delimiter character
+     *  @tparam Quote        The quote character
+     *
+     *  @par Hint
+     *  Use the aliases csv::CSVWriter<OutputStream> to write CSV
+     *  formatted strings and csv::TSVWriter<OutputStream>
+     *  to write tab separated strings
+     *
+     *  @par Example
+     *  @snippet test_write_csv.cpp CSV Writer Example
+     */
+    template<class OutputStream, char Delim, char Quote>
+    class DelimWriter {
+    public:
+        /** Construct a DelimWriter over the specified output stream */
+        DelimWriter(OutputStream& _out) : out(_out) {
+            this->buffer.reserve(WRITE_BUFFER_SIZE);
+        };
+
+        /** Construct a DelimWriter over the file
+         *
+         *  @param[out] filename  File to write to
          */
-        HEDLEY_CONST CONSTEXPR ParseFlagMap make_parse_flags(char delimiter, char quote_char) {
-            std::array<ParseFlags, 256> ret = make_parse_flags(delimiter);
-            ret[(size_t)quote_char + 128] = QUOTE;
-            return ret;
+        DelimWriter(const std::string& filename) : DelimWriter(std::ifstream(filename)) {};
+
+        /** Flush any remaining buffered rows */
+        ~DelimWriter() {
+            this->flush();
         }
 
-        /** Create a vector v where each index i corresponds to the
-         *  ASCII number for a character c and, v[i + 128] is true if
-         *  c is a whitespace character
-         */
-        HEDLEY_CONST CONSTEXPR WhitespaceMap make_ws_flags(const char * ws_chars, size_t n_chars) {
-            std::array<bool, 256> ret = {};
-            for (int i = -128; i < 128; i++) {
-                const int arr_idx = i + 128;
-                char ch = char(i);
-                ret[arr_idx] = false;
+        /** Format a sequence of strings and write to CSV according to RFC 4180
+         *
+         *  @warning This does not check to make sure row lengths are consistent
+         *
+         *  @note Rows are buffered internally and only reach the output
+         *        stream when the buffer fills, flush() is called, or this
+         *        writer is destroyed
+         *
+         *  @param[in]  record          Sequence of strings to be formatted
+         *  @param      quote_minimal   Only quote fields if necessary
+         */
+        template<typename T, typename Alloc, template <typename, typename> class Container>
+        void write_row(const Container<T, Alloc>& record, bool quote_minimal = true) {
+            const size_t ilen = record.size();
+            size_t i = 0;
+            for (auto& field: record) {
+                this->write_field(field, quote_minimal);
+                if (i + 1 != ilen) this->buffer += Delim;
+                i++;
+            }
 
-                for (size_t j = 0; j < n_chars; j++) {
-                    if (ws_chars[j] == ch) {
-                        ret[arr_idx] = true;
-                    }
-                }
+            this->buffer += '\n';
+
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
+        }
+
+        /** Format a parsed CSVRow, walking its split positions and copying
+         *  each field's bytes straight from the row's shared buffer into
+         *  the write buffer — no intermediate strings are created, making
+         *  filter-and-rewrite pipelines allocation-free per row.
+         *
+         *  @param[in]  record          Row obtained from a CSVReader
+         *  @param      quote_minimal   Only quote fields if necessary
+         */
+        void write_row(const CSVRow& record, bool quote_minimal = true) {
+            const size_t ilen = record.size();
+            for (size_t i = 0; i < ilen; i++) {
+                this->escape_to_buffer(record.get_string_view(i), quote_minimal);
+                if (i + 1 != ilen) this->buffer += Delim;
             }
 
-            return ret;
+            this->buffer += '\n';
+
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
         }
 
-        struct GuessScore {
-            double score;
-            size_t header;
-        };
+        /** Format a tuple of mixed string and arithmetic types, writing
+         *  each element with the formatter matching its compile-time type.
+         *  Numeric elements are formatted directly into the write buffer
+         *  without any intermediate strings.
+         *
+         *  @param[in]  record          Tuple of values to be formatted
+         *  @param      quote_minimal   Only quote fields if necessary
+         */
+        template<typename... T>
+        void write_row(const std::tuple<T...>& record, bool quote_minimal = true) {
+            this->write_tuple<0>(record, quote_minimal);
+            this->buffer += '\n';
 
-        CSV_INLINE GuessScore calculate_score(csv::string_view head, CSVFormat format);
+            if (this->buffer.size() >= WRITE_BUFFER_SIZE)
+                this->flush();
+        }
 
-        CSVGuessResult _guess_format(csv::string_view head, const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
+        /** @copydoc write_row
+         *  @return  The current DelimWriter instance (allowing for operator chaining)
+         */
+        template<typename T, typename Alloc, template <typename, typename> class Container>
+        DelimWriter& operator<<(const Container<T, Alloc>& record) {
+            this->write_row(record);
+            return *this;
+        }
 
-        /** Parse a CSV field until a delimiter is hit
-         *  @return A value indicating whether or not text to be
-         *          saved to the text buffer
+        /** @copydoc write_row
+         *  @return  The current DelimWriter instance (allowing for operator chaining)
          */
-        CONSTEXPR bool parse_not_special(
-            csv::string_view in,
-            const csv::internals::ParseFlags* const parse_flags,
-            const bool* const ws_flags,
-            size_t& i,
-            size_t& start,
-            size_t& end) {
-            // Trim off leading whitespace
-            while (i < in.size() && ws_flags[in[i] + 128]) {
-                i++;
+        template<typename... T>
+        DelimWriter& operator<<(const std::tuple<T...>& record) {
+            this->write_row(record);
+            return *this;
+        }
+
+        /** @copydoc write_row
+         *  @return  The current DelimWriter instance (allowing for operator chaining)
+         */
+        DelimWriter& operator<<(const CSVRow& record) {
+            this->write_row(record);
+            return *this;
+        }
+
+        /** Write all buffered rows to the output stream and flush it,
+         *  e.g. at durability points
+         */
+        void flush() {
+            if (!this->buffer.empty()) {
+                this->out.write(this->buffer.data(), (std::streamsize)this->buffer.size());
+                this->buffer.clear();
             }
 
-            start = i;
+            this->out.flush();
+        }
 
-            // Case: This field is entirely whitespace
-            if (parse_flags[in[start] + 128] >= ParseFlags::DELIMITER) {
-                // Back the parser up one character so switch statement
-                // can process the delimiter or newline
-                i--;
-                return false;
+    private:
+        /** Write one element of a tuple, dispatching on its type */
+        template<size_t I, typename... T>
+        typename std::enable_if<(I < sizeof...(T))>::type
+        write_tuple(const std::tuple<T...>& record, const bool quote_minimal) {
+            this->write_field(std::get<I>(record), quote_minimal);
+
+            IF_CONSTEXPR (I + 1 < sizeof...(T))
+                this->buffer += Delim;
+
+            this->write_tuple<I + 1>(record, quote_minimal);
+        }
+
+        /** Base case: the entire tuple has been written */
+        template<size_t I, typename... T>
+        typename std::enable_if<I == sizeof...(T)>::type
+        write_tuple(const std::tuple<T...>&, const bool) {}
+
+        /** Format an arithmetic field directly into the write buffer.
+         *  Numbers never require quoting.
+         */
+        template<typename T,
+            typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        void write_field(const T& field, const bool) {
+            this->format_number(field);
+        }
+
+        /** Format a string-like field, quoting as necessary */
+        template<typename T,
+            typename std::enable_if<!std::is_arithmetic<T>::value, int>::type = 0>
+        void write_field(const T& field, const bool quote_minimal) {
+            this->escape_to_buffer(field, quote_minimal);
+        }
+
+        /** Append an integer to the write buffer without allocating */
+        template<typename T>
+        typename std::enable_if<std::is_integral<T>::value>::type
+        format_number(const T value) {
+            char digits[24];
+            size_t pos = sizeof(digits);
+
+            // bool has no unsigned counterpart, so let it promote to int
+            using Unsigned = typename std::make_unsigned<
+                typename std::conditional<std::is_same<T, bool>::value, int, T>::type>::type;
+            Unsigned mag = value < 0
+                ? (Unsigned)0 - (Unsigned)value
+                : (Unsigned)value;
+
+            do {
+                digits[--pos] = (char)('0' + (char)(mag % 10));
+                mag /= 10;
+            } while (mag > 0);
+
+            if (value < 0) digits[--pos] = '-';
+
+            this->buffer.append(digits + pos, sizeof(digits) - pos);
+        }
+
+        /** Append a floating point value to the write buffer using
+         *  shortest-round-trip formatting
+         */
+        template<typename T>
+        typename std::enable_if<std::is_floating_point<T>::value>::type
+        format_number(const T value) {
+            char digits[64];
+
+#ifdef CSV_HAS_TO_CHARS
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            this->buffer.append(digits, (size_t)(result.ptr - digits));
+#else
+            // Probe for the smallest precision that round-trips
+            int len = 0;
+            for (int precision = 6; precision <= std::numeric_limits<T>::max_digits10; precision++) {
+                len = snprintf(digits, sizeof(digits), "%.*Lg", precision, (long double)value);
+                if ((T)strtold(digits, nullptr) == value) break;
             }
 
-            // Optimization: Since NOT_SPECIAL characters tend to occur in contiguous
-            // sequences, use the loop below to avoid having to go through the outer
-            // switch statement as much as possible
-            while (i + 1 < in.size()
-                && parse_flags[in[i + 1] + 128] == ParseFlags::NOT_SPECIAL) {
-                i++;
+            // Some locales use a decimal comma, which would collide
+            // with the delimiter
+            for (int i = 0; i < len; i++) {
+                if (digits[i] == ',') digits[i] = '.';
             }
 
-            // Trim off trailing whitespace
-            end = i;
-            while (ws_flags[in[end] + 128]) {
-                end--;
+            this->buffer.append(digits, (size_t)len);
+#endif
+        }
+
+        /** Format one field directly into the write buffer.
+         *
+         *  A single pre-scan decides whether quoting is necessary;
+         *  unquoted fields (the common case) are appended verbatim.
+         */
+        void escape_to_buffer(csv::string_view in, const bool quote_minimal) {
+            const bool has_quote = !in.empty()
+                && std::memchr(in.data(), Quote, in.size()) != nullptr;
+            const bool needs_quotes = !quote_minimal || has_quote || (!in.empty() && (
+                std::memchr(in.data(), Delim, in.size()) != nullptr
+                || std::memchr(in.data(), '\n', in.size()) != nullptr
+                || std::memchr(in.data(), '\r', in.size()) != nullptr));
+
+            if (!needs_quotes) {
+                if (!in.empty()) this->buffer.append(in.data(), in.size());
+                return;
             }
 
-            return true;
+            this->buffer += Quote;
+
+            if (!has_quote) {
+                if (!in.empty()) this->buffer.append(in.data(), in.size());
+            }
+            else {
+                for (size_t i = 0; i < in.size(); i++) {
+                    if (in[i] == Quote) this->buffer += Quote;
+                    this->buffer += in[i];
+                }
+            }
+
+            this->buffer += Quote;
         }
 
-        struct ParseData {
-            csv::string_view in;
-            ParseFlagMap parse_flags;
-            WhitespaceMap ws_flags;
-            BufferPtr row_buffer;
-            bool& quote_escape; /*< Whether or not we are currently in a quote escaped field */
-            std::deque<CSVRow>& records;
-        };
+        /** Flush threshold for the internal write buffer */
+        static constexpr size_t WRITE_BUFFER_SIZE = 1048576;
 
-        CSV_INLINE BufferPtr parse(const ParseData& data);
-        CSV_INLINE void write_record(const ParseData& data);
+        OutputStream & out;
+        std::string buffer; /**< Grow-once buffer holding formatted rows */
+    };
 
-        /** Read the first 500KB of a CSV file */
-        CSV_INLINE std::string get_csv_head(csv::string_view filename);
+    /* Uncomment when C++17 support is better
+    template<class OutputStream>
+    DelimWriter(OutputStream&) -> DelimWriter<OutputStream>;
+    */
+
+    /** Class for writing CSV files
+     *
+     *  @sa csv::DelimWriter::write_row()
+     *  @sa csv::DelimWriter::operator<<()
+     *
+     *  @note Use `csv::make_csv_writer()` to in instatiate this class over
+     *        an actual output stream.
+     */
+    template<class OutputStream>
+    using CSVWriter = DelimWriter<OutputStream, ',', '"'>;
+
+    /** Class for writing tab-separated values files
+*
+     *  @sa csv::DelimWriter::write_row()
+     *  @sa csv::DelimWriter::operator<<()
+     *
+     *  @note Use `csv::make_tsv_writer()` to in instatiate this class over
+     *        an actual output stream.
+     */
+    template<class OutputStream>
+    using TSVWriter = DelimWriter<OutputStream, '\t', '"'>;
+
+    //
+    // Temporary: Until more C++17 compilers support template deduction guides
+    //
+    template<class OutputStream>
+    inline CSVWriter<OutputStream> make_csv_writer(OutputStream& out) {
+        /** Return a CSVWriter over the output stream */
+        return CSVWriter<OutputStream>(out);
+    }
+
+    template<class OutputStream>
+    inline TSVWriter<OutputStream> make_tsv_writer(OutputStream& out) {
+        /** Return a TSVWriter over the output stream */
+        return TSVWriter<OutputStream>(out);
     }
+
+#ifdef CSV_EXTERN_TEMPLATES
+    /** When consuming the compiled library (which defines
+     *  CSV_EXTERN_TEMPLATES via its CMake target), the hot members of the
+     *  common writer configurations are compiled once into the library —
+     *  see csv_instantiations.cpp — instead of once per client translation
+     *  unit. The single header is unaffected.
+     */
+    extern template DelimWriter<std::ofstream, ',', '"'>::DelimWriter(std::ofstream&);
+    extern template void DelimWriter<std::ofstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::ofstream, ',', '"'>::flush();
+
+    extern template DelimWriter<std::ofstream, '\t', '"'>::DelimWriter(std::ofstream&);
+    extern template void DelimWriter<std::ofstream, '\t', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::ofstream, '\t', '"'>::flush();
+
+    extern template DelimWriter<std::stringstream, ',', '"'>::DelimWriter(std::stringstream&);
+    extern template void DelimWriter<std::stringstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    extern template void DelimWriter<std::stringstream, ',', '"'>::flush();
+#endif
+
+    ///@}
 }
 /** @file
- *  @brief Defines functionality needed for basic CSV parsing
+ *  Defines a persistent row-offset index enabling fast random access
+ *  into large CSV files
  */
 
-
-#include <deque>
-#include <iterator>
-#include <memory>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <string>
 #include <vector>
 
 
-/** The all encompassing namespace */
 namespace csv {
-    /** Stuff that is generally not of interest to end-users */
-    namespace internals {
-        std::string format_row(const std::vector<std::string>& row, csv::string_view delim = ", ");
-
-        std::vector<std::string> _get_col_names( csv::string_view head, const CSVFormat format = CSVFormat::guess_csv());
-    }
-
-    std::vector<std::string> get_col_names(
-        csv::string_view filename,
-        const CSVFormat format = CSVFormat::guess_csv());
-
-    /** Guess the delimiter used by a delimiter-separated values file */
-    CSVGuessResult guess_format(csv::string_view filename,
-        const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
-
-    /** @class CSVReader
-     *  @brief Main class for parsing CSVs from files and in-memory sources
+    /** An index of the byte offsets where every k-th CSV row begins,
+     *  allowing row N of a large file to be retrieved without parsing
+     *  the N - 1 rows before it.
      *
-     *  All rows are compared to the column names for length consistency
-     *  - By default, rows that are too short or too long are dropped
-     *  - Custom behavior can be defined by overriding bad_row_handler in a subclass
+     *  Indexes are built with one quote-aware pass over the file, can be
+     *  saved to a compact binary sidecar file, and loaded back in later
+     *  runs. Retrieval seeks to the nearest recorded checkpoint and
+     *  resumes parsing from there, so lookup cost is O(stride) rows
+     *  instead of O(N).
+     *
+     *  @note Rows are numbered over the physical rows following the header,
+     *        before any variable-column policy is applied. For files where
+     *        CSVReader drops short or long rows, numbering will differ from
+     *        CSVReader::num_rows.
      */
-    class CSVReader {
+    class CSVIndex {
     public:
-        /**
-         * An input iterator capable of handling large files.
-         * @note Created by CSVReader::begin() and CSVReader::end().
-         *
-         * @par Iterating over a file
-         * @snippet tests/test_csv_iterator.cpp CSVReader Iterator 1
+        /** Default number of rows between recorded checkpoints */
+        static constexpr size_t DEFAULT_STRIDE = 64;
+
+        CSVIndex() = default;
+
+        /** Build an index by scanning filename once with a quote-aware
+         *  state machine
          *
-         * @par Using with `<algorithm>` library
-         * @snippet tests/test_csv_iterator.cpp CSVReader Iterator 2
+         *  @param[in] filename Path to CSV file
+         *  @param[in] format   Format of the CSV file
+         *  @param[in] stride   Record a checkpoint every stride rows
          */
-        class iterator {
-        public:
-            #ifndef DOXYGEN_SHOULD_SKIP_THIS
-            using value_type = CSVRow;
-            using difference_type = std::ptrdiff_t;
-            using pointer = CSVRow * ;
-            using reference = CSVRow & ;
-            using iterator_category = std::input_iterator_tag;
-            #endif
+        static CSVIndex build(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv(),
+            size_t stride = DEFAULT_STRIDE);
 
-            iterator() = default;
-            iterator(CSVReader* reader) : daddy(reader) {};
-            iterator(CSVReader*, CSVRow&&);
+        /** Load a previously saved index from a sidecar file */
+        static CSVIndex load(csv::string_view index_path);
 
-            /** Access the CSVRow held by the iterator */
-            CONSTEXPR reference operator*() { return this->row; }
+        /** Save this index to a binary sidecar file */
+        void save(csv::string_view index_path) const;
 
-            /** Return a pointer to the CSVRow the iterator has stopped at */
-            CONSTEXPR pointer operator->() { return &(this->row); }
+        /** Retrieve the n-th row (zero-based, header excluded) of the
+         *  indexed file
+         *
+         *  @throws std::runtime_error If n is out of bounds
+         */
+        CSVRow get_row(csv::string_view filename, RowCount n) const;
 
-            iterator& operator++();   /**< Pre-increment iterator */
-            iterator operator++(int); /**< Post-increment ierator */
-            iterator& operator--();
+        /** Number of data rows in the indexed file */
+        RowCount num_rows() const { return this->n_rows; }
 
-            /** Returns true if iterators were constructed from the same CSVReader
-             *  and point to the same row
-             */
-            CONSTEXPR bool operator==(const iterator& other) const {
-                return (this->daddy == other.daddy) && (this->i == other.i);
-            }
+        /** Number of checkpoints recorded */
+        size_t num_checkpoints() const { return this->offsets.size(); }
 
-            CONSTEXPR bool operator!=(const iterator& other) const { return !operator==(other); }
-        private:
-            CSVReader * daddy = nullptr;  // Pointer to parent
-            CSVRow row;                   // Current row
-            RowCount i = 0;               // Index of current row
-        };
+        /** Column names of the indexed file */
+        std::vector<std::string> get_col_names() const { return this->col_names; }
 
-        /** @name Constructors
-         *  Constructors for iterating over large files and parsing in-memory sources.
+    private:
+        size_t stride = DEFAULT_STRIDE; /**< Rows between checkpoints */
+        RowCount n_rows = 0;            /**< Number of data rows */
+        char delim = ',';               /**< Delimiting character */
+        char quote = '"';               /**< Quote character */
+        bool no_quote = false;          /**< Whether quoting is disabled */
+
+        /** Column names, stored so retrieved rows support name lookup */
+        std::vector<std::string> col_names = {};
+
+        /** Byte offset of the first byte of every (stride * k)-th data row */
+        std::vector<unsigned long long> offsets = {};
+    };
+}
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <fstream>
+#include <memory>
+#include <string>
+
+
+// Vectorized scanning kernels used by the CSV parser. SSE2 is part of the
+// x86-64 baseline; AVX2 is used if this library is compiled with it enabled.
+#if defined(__AVX2__)
+#define CSV_HAS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define CSV_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h> // For _BitScanForward()
+#endif
+
+namespace csv {
+    namespace internals {
+        /**  @typedef ParseFlags
+         *   An enum used for describing the significance of each character
+         *   with respect to CSV parsing
          */
-         ///@{
-        CSVReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv());
-        CSVReader(CSVFormat format = CSVFormat());
-        ///@}
+        enum ParseFlags {
+            NOT_SPECIAL, /**< Characters with no special meaning */
+            QUOTE,       /**< Characters which may signify a quote escape */
+            DELIMITER,   /**< Characters which may signify a new field */
+            NEWLINE      /**< Characters which may signify a new row */
+        };
 
-        CSVReader(const CSVReader&) = delete; // No copy constructor
-        CSVReader(CSVReader&&) = default;     // Move constructor
-        CSVReader& operator=(const CSVReader&) = delete; // No copy assignment
-        CSVReader& operator=(CSVReader&& other) = default;
-        ~CSVReader() { this->close(); }
+        using ParseFlagMap = std::array<ParseFlags, 256>;
+        using WhitespaceMap = std::array<bool, 256>;
 
-        /** @name Reading In-Memory Strings
-         *  You can piece together incomplete CSV fragments by calling feed() on them
-         *  before finally calling end_feed().
+        /** Create a vector v where each index i corresponds to the
+         *  ASCII number for a character and, v[i + 128] labels it according to
+         *  the CSVReader::ParseFlags enum
+         */
+        HEDLEY_CONST CONSTEXPR ParseFlagMap make_parse_flags(char delimiter) {
+            std::array<ParseFlags, 256> ret = {};
+            for (int i = -128; i < 128; i++) {
+                const int arr_idx = i + 128;
+                char ch = char(i);
+
+                if (ch == delimiter)
+                    ret[arr_idx] = DELIMITER;
+                else if (ch == '\r' || ch == '\n')
+                    ret[arr_idx] = NEWLINE;
+                else
+                    ret[arr_idx] = NOT_SPECIAL;
+            }
+
+            return ret;
+        }
+
+        /** Create a vector v where each index i corresponds to the
+         *  ASCII number for a character and, v[i + 128] labels it according to
+         *  the CSVReader::ParseFlags enum
+         */
+        HEDLEY_CONST CONSTEXPR ParseFlagMap make_parse_flags(char delimiter, char quote_char) {
+            std::array<ParseFlags, 256> ret = make_parse_flags(delimiter);
+            ret[(size_t)quote_char + 128] = QUOTE;
+            return ret;
+        }
+
+        /** Create a vector v where each index i corresponds to the
+         *  ASCII number for a character c and, v[i + 128] is true if
+         *  c is a whitespace character
+         */
+        HEDLEY_CONST CONSTEXPR WhitespaceMap make_ws_flags(const char * ws_chars, size_t n_chars) {
+            std::array<bool, 256> ret = {};
+            for (int i = -128; i < 128; i++) {
+                const int arr_idx = i + 128;
+                char ch = char(i);
+                ret[arr_idx] = false;
+
+                for (size_t j = 0; j < n_chars; j++) {
+                    if (ws_chars[j] == ch) {
+                        ret[arr_idx] = true;
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        struct GuessScore {
+            double score;
+            size_t header;
+        };
+
+        CSV_INLINE GuessScore calculate_score(csv::string_view head, CSVFormat format);
+
+        CSVGuessResult _guess_format(csv::string_view head, const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
+
+        /** Return the index of the lowest set bit in a non-zero bitmask */
+        HEDLEY_CONST inline size_t first_set_bit(unsigned int mask) {
+#if defined(_MSC_VER)
+            unsigned long pos = 0;
+            _BitScanForward(&pos, mask);
+            return (size_t)pos;
+#else
+            return (size_t)__builtin_ctz(mask);
+#endif
+        }
+
+        /** Find the first special character (as labeled by parse_flags) at or
+         *  after position i, comparing 16-32 bytes at a time where vector
+         *  instructions are available
          *
-         *  Alternatively, you can also use the parse() shorthand function for
-         *  smaller strings.
+         *  @note delim and quote are the same characters used to build parse_flags.
+         *        If quoting is disabled, pass the delimiter for both.
+         *
+         *  @return Index of the first special character, or in.size() if none remain
          */
-         ///@{
-        void feed(csv::string_view in);
-        void end_feed();
-        ///@}
+        inline size_t find_special(
+            csv::string_view in,
+            const ParseFlags* const parse_flags,
+            size_t i,
+            char delim,
+            char quote) {
+#if defined(CSV_HAS_AVX2)
+            const __m256i delim_v = _mm256_set1_epi8(delim),
+                quote_v = _mm256_set1_epi8(quote),
+                cr_v = _mm256_set1_epi8('\r'),
+                lf_v = _mm256_set1_epi8('\n');
+
+            for (; i + 32 <= in.size(); i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(in.data() + i));
+                __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, delim_v), _mm256_cmpeq_epi8(chunk, quote_v)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr_v), _mm256_cmpeq_epi8(chunk, lf_v)));
+
+                unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i delim_v = _mm_set1_epi8(delim),
+                quote_v = _mm_set1_epi8(quote),
+                cr_v = _mm_set1_epi8('\r'),
+                lf_v = _mm_set1_epi8('\n');
+
+            for (; i + 16 <= in.size(); i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(in.data() + i));
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, delim_v), _mm_cmpeq_epi8(chunk, quote_v)),
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, cr_v), _mm_cmpeq_epi8(chunk, lf_v)));
+
+                unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#else
+            (void)delim;
+            (void)quote;
+#endif
 
-        /** @name Retrieving CSV Rows */
-        ///@{
-        bool read_row(CSVRow &row);
-        iterator begin();
-        HEDLEY_CONST iterator end() const;
-        ///@}
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            while (i < in.size() && parse_flags[in[i] + 128] == ParseFlags::NOT_SPECIAL) {
+                i++;
+            }
 
-        /** @name CSV Metadata */
-        ///@{
-        CSVFormat get_format() const;
-        std::vector<std::string> get_col_names() const;
-        int index_of(csv::string_view col_name) const;
-        ///@}
-        
-        /** @name CSV Metadata: Attributes */
-        ///@{
-        RowCount num_rows = 0;   /**< How many rows (minus header)
-                                   *   have been parsed so far
-                                   */
-        bool utf8_bom = false;   /**< Set to true if UTF-8 BOM was detected */
-        ///@}
+            return i;
+        }
 
-        void close();
+        /** Parse a CSV field until a delimiter is hit
+         *  @return A value indicating whether or not text to be
+         *          saved to the text buffer
+         */
+        inline bool parse_not_special(
+            csv::string_view in,
+            const csv::internals::ParseFlags* const parse_flags,
+            const bool* const ws_flags,
+            size_t& i,
+            size_t& start,
+            size_t& end,
+            char delim,
+            char quote) {
+            // Trim off leading whitespace
+            while (i < in.size() && ws_flags[in[i] + 128]) {
+                i++;
+            }
 
-    protected:
-        /**
-         * \defgroup csv_internal CSV Parser Internals
-         * @brief Internals of CSVReader. Only maintainers and those looking to
-         *        extend the parser should read this.
-         * @{
+            start = i;
+
+            // Case: This field is entirely whitespace
+            if (parse_flags[in[start] + 128] >= ParseFlags::DELIMITER) {
+                // Back the parser up one character so switch statement
+                // can process the delimiter or newline
+                i--;
+                return false;
+            }
+
+            // Optimization: Since NOT_SPECIAL characters tend to occur in contiguous
+            // sequences, scan ahead for the next special character in one shot
+            // (vectorized where possible) to avoid having to go through the outer
+            // switch statement as much as possible
+            i = find_special(in, parse_flags, i + 1, delim, quote) - 1;
+
+            // Trim off trailing whitespace
+            end = i;
+            while (ws_flags[in[end] + 128]) {
+                end--;
+            }
+
+            return true;
+        }
+
+        /** Compile-time ParseFlags lookup for statically known delimiters
+         *  and quote characters
          */
+        template<char Delim, char Quote>
+        HEDLEY_CONST CONSTEXPR ParseFlags flag_for(char ch) {
+            return ch == Delim ? ParseFlags::DELIMITER
+                : ch == Quote ? ParseFlags::QUOTE
+                : (ch == '\r' || ch == '\n') ? ParseFlags::NEWLINE
+                : ParseFlags::NOT_SPECIAL;
+        }
 
-        /** A string buffer and its size. Consumed by read_csv_worker(). */
-        using WorkItem = std::pair<std::unique_ptr<char[]>, size_t>;
+        struct ParseData {
+            csv::string_view in;
+            ParseFlagMap parse_flags;
+            WhitespaceMap ws_flags;
+            BufferPtr row_buffer;
+            bool& quote_escape; /*< Whether or not we are currently in a quote escaped field */
+            RecordRing& records;
+        };
+
+        /** State for column projection push-down (see CSVFormat::select())
+         *
+         *  Fields whose column is not in the mask are skipped by the boundary
+         *  scanner only: no bytes are copied and no split entries recorded.
+         *  field_no and wrote_field persist the parser's position within a
+         *  row across chunk boundaries, like ParseData::quote_escape.
+         */
+        struct ProjectionState {
+            /** mask[i] is true if column i should be materialized */
+            std::vector<bool> mask;
+
+            /** Zero-based index of the field currently being parsed */
+            size_t field_no = 0;
+
+            /** Whether a selected field was already emitted for this row */
+            bool wrote_field = false;
+
+            /** Whether the given column should be materialized. Columns past
+             *  the end of the mask (overlong rows) are dropped.
+             */
+            bool is_selected(size_t col) const {
+                return col < this->mask.size() && this->mask[col];
+            }
+        };
+
+        /** State for predicate push-down row filtering
+         *  (see CSVReader::set_row_filter())
+         *
+         *  The predicate is evaluated over raw field views as soon as a row's
+         *  terminating newline is seen; rejected rows never become CSVRows
+         *  and their bytes are reclaimed on the spot by
+         *  RawRowBuffer::discard_row().
+         */
+        struct RowFilter {
+            /** Returns true if a row should be kept */
+            std::function<bool(const std::vector<csv::string_view>&)> predicate;
+
+            /** Rows delivered unfiltered (the header and anything before it) */
+            RowCount bypass_rows = 0;
+
+            /** Reused per-row scratch space for field views */
+            std::vector<csv::string_view> scratch;
+        };
+
+        /** Streaming state for the opt-in encoding validation stage
+         *  (see CSVReader::set_unicode_policy())
+         *
+         *  Chunk boundaries fall anywhere, so a multi-byte UTF-8 sequence,
+         *  a UTF-16 code unit, or a surrogate pair may straddle two chunks;
+         *  the carry fields below let validation resume mid-sequence.
+         */
+        struct UnicodeValidator {
+            /** Input encoding, detected from the first chunk's BOM */
+            enum class Encoding { UNKNOWN, UTF8, UTF16_LE, UTF16_BE };
+
+            Encoding encoding = Encoding::UNKNOWN;
+
+            /** Bytes of a UTF-8 sequence left unfinished by the last chunk */
+            unsigned char partial[4] = { 0, 0, 0, 0 };
+            size_t partial_len = 0;
+
+            /** A UTF-16 code unit split across chunks leaves its first byte here */
+            unsigned char odd_byte = 0;
+            bool has_odd_byte = false;
+
+            /** A high surrogate awaiting its low half (0 = none) */
+            unsigned int pending_high = 0;
+        };
+
+        /** Validate one chunk of UTF-8 in place, vectorized over ASCII runs
+         *
+         *  @param[in,out] state   Carry state across chunk boundaries
+         *  @param[in,out] data    Chunk bytes; malformed bytes are overwritten
+         *                         with '?' when replace is set
+         *  @param[in]     n       Valid bytes in data
+         *  @param[in]     replace Repair malformed bytes instead of failing
+         *
+         *  @return Offset of the first malformed byte, or npos if the chunk
+         *          is valid (or was repaired)
+         */
+        CSV_INLINE size_t validate_utf8_chunk(UnicodeValidator& state,
+            char* data, size_t n, bool replace);
+
+        /** Transcode one chunk of UTF-16 into UTF-8
+         *
+         *  @param[in,out] state   Carry state across chunk boundaries
+         *  @param[in]     data    Raw UTF-16 bytes (without BOM)
+         *  @param[in]     n       Valid bytes in data
+         *  @param[out]    out     Receives the UTF-8 transcoding
+         *  @param[in]     replace Emit U+FFFD for unpaired surrogates
+         *                         instead of failing
+         *
+         *  @return false if an unpaired surrogate was found and replace
+         *          is not set
+         */
+        CSV_INLINE bool transcode_utf16_chunk(UnicodeValidator& state,
+            const char* data, size_t n, std::string& out, bool replace);
+
+        CSV_INLINE BufferPtr parse(const ParseData& data, BufferPool* pool = nullptr,
+            ProjectionState* projection = nullptr, RowFilter* filter = nullptr,
+            size_t* peak_buffer_bytes = nullptr);
+
+        /** A two-symbol fast lane for formats with quoting disabled
+         *
+         *  With no quote state to track, only the delimiter and newlines are
+         *  special, so each field is one bulk copy between scanner hits.
+         *  Whitespace trimming, projection, and row filters are not
+         *  supported; such readers use the general parse() instead.
+         */
+        CSV_INLINE BufferPtr parse_no_quote(const ParseData& data, BufferPool* pool = nullptr,
+            size_t* peak_buffer_bytes = nullptr);
+
+        CSV_INLINE void write_record(const ParseData& data);
+
+        /** A version of parse() whose delimiter and quote character are fixed
+         *  at compile time, allowing the compiler to fold the per-character
+         *  flag lookups into immediate compares and unroll the inner loop
+         *
+         *  @note Whitespace trimming is not supported by this kernel; formats
+         *        with trim characters must use the runtime-dispatched parse().
+         */
+        template<char Delim, char Quote>
+        BufferPtr parse_static(const ParseData& data, BufferPool* pool = nullptr) {
+            // Only used for the scalar tail of find_special()
+            static const ParseFlagMap flag_map = make_parse_flags(Delim, Quote);
+
+            auto& in = data.in;
+            auto& row_buffer = *(data.row_buffer.get());
+            auto& text_buffer = row_buffer.buffer;
+            auto& split_buffer = row_buffer.split_buffer;
+            text_buffer.reserve(in.size());
+            split_buffer.reserve(in.size() / 10);
+
+            for (size_t i = 0; i < in.size(); i++) {
+                switch (flag_for<Delim, Quote>(in[i])) {
+                case ParseFlags::DELIMITER:
+                    if (!data.quote_escape) {
+                        split_buffer.push_back((StrBufferPos)row_buffer.size());
+                        break;
+                    }
+
+                    HEDLEY_FALL_THROUGH;
+                case ParseFlags::NEWLINE:
+                    if (!data.quote_escape) {
+                        // End of record -> Write record
+                        if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
+                            ++i;
+
+                        data.records.push_back(CSVRow(data.row_buffer));
+                        break;
+                    }
+
+                    // Treat as regular character
+                    text_buffer += in[i];
+                    break;
+                case ParseFlags::NOT_SPECIAL: {
+                    const size_t start = i;
+                    i = find_special(in, flag_map.data(), i + 1, Delim, Quote) - 1;
+
+                    // Finally append text
+#ifdef CSV_HAS_CXX17
+                    text_buffer += in.substr(start, i - start + 1);
+#else
+                    for (size_t j = start; j < i + 1; j++) {
+                        text_buffer += in[j];
+                    }
+#endif
+
+                    break;
+                }
+                default: // Quote
+                    if (!data.quote_escape) {
+                        // Don't deref past beginning
+                        if (i && flag_for<Delim, Quote>(in[i - 1]) >= ParseFlags::DELIMITER) {
+                            // Case: Previous character was delimiter or newline
+                            data.quote_escape = true;
+                        }
+                    }
+                    else if (i + 1 < in.size()) {
+                        auto next_ch = flag_for<Delim, Quote>(in[i + 1]);
+                        if (next_ch >= ParseFlags::DELIMITER) {
+                            // Case: Delim or newline => end of field
+                            data.quote_escape = false;
+                            break;
+                        }
+
+                        // Case: Escaped quote
+                        text_buffer += in[i];
+
+                        // Note: Unescaped single quotes can be handled by the parser
+                        if (next_ch == ParseFlags::QUOTE)
+                            ++i;  // Case: Two consecutive quotes
+
+                    }
+
+                    break;
+                }
+            }
+
+            return row_buffer.reset(pool);
+        }
+
+        /** Read the first 500KB of a CSV file */
+        CSV_INLINE std::string get_csv_head(csv::string_view filename);
+    }
+}
+/** @file
+ *  @brief Defines functionality needed for basic CSV parsing
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <string>
+#include <vector>
+
+
+/** The all encompassing namespace */
+namespace csv {
+    /** Compression formats CSVReader can detect and stream-decompress */
+    enum class Compression {
+        NONE, /**< Plain uncompressed text */
+        GZIP, /**< RFC 1952 gzip (requires building with CSV_HAS_ZLIB) */
+        ZSTD  /**< Zstandard frames (requires building with CSV_HAS_ZSTD) */
+    };
+
+    /** Stuff that is generally not of interest to end-users */
+    namespace internals {
+        std::string format_row(const std::vector<std::string>& row, csv::string_view delim = ", ");
+
+        /** Identify a file's compression format from its magic bytes */
+        Compression detect_compression(csv::string_view filename);
+
+        /** Decompress the first 500 KB of a compressed file, for format
+         *  guessing and column name retrieval (cf. get_csv_head())
+         */
+        std::string get_compressed_head(csv::string_view filename, Compression compression);
+
+        std::vector<std::string> _get_col_names( csv::string_view head, const CSVFormat format = CSVFormat::guess_csv());
+
+        /** A fixed-capacity, lock-free single-producer/single-consumer queue
+         *
+         *  Items are handed from the reader thread to the parse worker with plain
+         *  atomic index bumps; neither side ever takes a mutex or waits on a
+         *  condition variable. Callers should retry (e.g. with
+         *  std::this_thread::yield()) when the queue is full or empty.
+         */
+        template<typename T, size_t Capacity = 32>
+        class SPSCQueue {
+        public:
+            static_assert((Capacity & (Capacity - 1)) == 0,
+                "Capacity should be a power of two.");
+
+            /** Append an item, returning false if the queue is full.
+             *  May only be called from the producer thread.
+             */
+            bool try_push(T&& item) {
+                const size_t current_tail = this->tail.load(std::memory_order_relaxed);
+                if (current_tail - this->head.load(std::memory_order_acquire) == Capacity) {
+                    return false;
+                }
+
+                this->ring[current_tail & (Capacity - 1)] = std::move(item);
+                this->tail.store(current_tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /** Remove the oldest item, returning false if the queue is empty.
+             *  May only be called from the consumer thread.
+             */
+            bool try_pop(T& item) {
+                const size_t current_head = this->head.load(std::memory_order_relaxed);
+                if (this->tail.load(std::memory_order_acquire) == current_head) {
+                    return false;
+                }
+
+                item = std::move(this->ring[current_head & (Capacity - 1)]);
+                this->head.store(current_head + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            std::array<T, Capacity> ring; /**< Preallocated storage for queued items */
+            std::atomic<size_t> head = { 0 }; /**< Index of the oldest item */
+            std::atomic<size_t> tail = { 0 }; /**< Index one past the newest item */
+        };
+    }
+
+    std::vector<std::string> get_col_names(
+        csv::string_view filename,
+        const CSVFormat format = CSVFormat::guess_csv());
+
+    /** Guess the delimiter used by a delimiter-separated values file */
+    CSVGuessResult guess_format(csv::string_view filename,
+        const std::vector<char>& delims = { ',', '|', '\t', ';', '^', '~' });
+
+    /** Determines how CSVReader pulls bytes out of a file */
+    enum class IOMode {
+        STDIO, /**< Buffered reads through a std::FILE* (default) */
+        MMAP,  /**< Parse directly over a memory-mapped region */
+        ASYNC  /**< Keep a window of in-flight reads via io_uring (Linux only).
+                *   Falls back to STDIO when built without liburing or when
+                *   the input is compressed.
+                */
+    };
+
+    /** Determines whether, and how strictly, CSVReader validates that its
+     *  input is well-formed Unicode (see CSVReader::set_unicode_policy())
+     */
+    enum class UnicodePolicy {
+        NONE,    /**< Pass bytes through unexamined (default) */
+        THROW,   /**< Raise std::runtime_error on the first malformed sequence */
+        REPLACE  /**< Substitute malformed sequences and keep parsing */
+    };
+
+    /** A column-oriented batch of parsed rows
+     *
+     *  Produced by CSVReader::read_batch(). Each column's values are stored
+     *  contiguously so vectorized aggregation can stream over them without
+     *  per-field pointer chasing:
+     *  - Numeric columns are converted once into `doubles` or `ints`
+     *  - String columns keep their bytes back to back in `chars`, with
+     *    `offsets` (length `n_rows + 1`) delimiting individual values
+     *
+     *  A column's type is the widest type observed in the batch: integer
+     *  columns containing a float or an empty field are promoted to double
+     *  (empty fields become NaN), and columns mixing text with numbers are
+     *  kept as strings.
+     */
+    struct ColumnBatch {
+        struct Column {
+            DataType type = CSV_STRING;   /**< CSV_STRING, CSV_INT64, or CSV_DOUBLE */
+            std::vector<long long> ints;  /**< Values when type == CSV_INT64 */
+            std::vector<double> doubles;  /**< Values when type == CSV_DOUBLE */
+            std::string chars;            /**< Concatenated bytes when type == CSV_STRING */
+            std::vector<size_t> offsets;  /**< Value boundaries within chars */
+
+            /** Per-row dictionary codes. When non-empty, chars/offsets hold
+             *  one entry per distinct value instead of one per row, and
+             *  equality between rows is an integer compare of codes.
+             */
+            std::vector<int> codes;
+
+            /** Whether this column's strings are dictionary encoded */
+            bool is_dictionary() const { return !this->codes.empty(); }
+
+            /** Number of distinct values in a dictionary encoded column */
+            size_t dict_size() const {
+                return this->offsets.empty() ? 0 : this->offsets.size() - 1;
+            }
+
+            /** Retrieve the ith string value of a CSV_STRING column */
+            csv::string_view str(size_t i) const {
+                if (!this->codes.empty()) i = (size_t)this->codes[i];
+                return csv::string_view(this->chars.data() + this->offsets[i],
+                    this->offsets[i + 1] - this->offsets[i]);
+            }
+        };
+
+        std::vector<std::string> col_names; /**< Names of the batched columns */
+        std::vector<Column> columns;        /**< One entry per column, in file order */
+        size_t n_rows = 0;                  /**< Number of rows in this batch */
+    };
+
+    /** Snapshot of a CSVReader's hot-path instrumentation counters,
+     *  retrieved with CSVReader::metrics()
+     *
+     *  Counters answer "where is ingest time going" without a profiler:
+     *  bytes_read far ahead of bytes_parsed means the parser is behind the
+     *  disk (parse-bound); a large worker_wait_sec means the parser is
+     *  starved (I/O-bound); buffered rows piling up between read_row()
+     *  calls means the consumer is behind (consumer-bound).
+     *
+     *  Each counter is written by exactly one thread — no atomics touch
+     *  the hot path — so a snapshot taken while a read is in flight may
+     *  be momentarily inconsistent between fields.
+     */
+    struct CSVReaderMetrics {
+        size_t bytes_read = 0;        /**< Bytes pulled from the source (after decompression) */
+        size_t bytes_parsed = 0;      /**< Bytes fed through the parser */
+        size_t chunks_fed = 0;        /**< Chunks passed to feed() */
+        size_t rows_dropped = 0;      /**< Rows dropped by the variable column policy */
+        size_t peak_buffer_bytes = 0; /**< Largest row text buffer observed */
+        double worker_wait_sec = 0;   /**< Parse worker time spent waiting for chunks */
+    };
+
+    /** Fixed-size latency histogram with power-of-two nanosecond buckets
+     *
+     *  Bucket `i` counts durations in `[2^i, 2^(i+1))` nanoseconds, so 40
+     *  buckets cover roughly 1 ns through 18 minutes with the HDR-style
+     *  trade of at most 2x relative error per sample — enough to tell a
+     *  microsecond parse from a millisecond storage stall. Recording is a
+     *  bucket increment and a few compares; no allocation, ever.
+     */
+    struct LatencyHistogram {
+        static constexpr size_t N_BUCKETS = 40;
+
+        std::array<size_t, N_BUCKETS> buckets = {}; /**< buckets[i] counts samples in [2^i, 2^(i+1)) ns */
+        size_t count = 0;                           /**< Total samples recorded */
+        unsigned long long total_ns = 0;            /**< Sum of all samples */
+        unsigned long long min_ns = 0;              /**< Smallest sample (0 when empty) */
+        unsigned long long max_ns = 0;              /**< Largest sample */
+
+        /** Record one duration in nanoseconds */
+        void record(unsigned long long ns) {
+            size_t bucket = 0;
+            while ((ns >> (bucket + 1)) != 0 && bucket < N_BUCKETS - 1)
+                bucket++;
+
+            this->buckets[bucket]++;
+            this->total_ns += ns;
+            this->max_ns = std::max(this->max_ns, ns);
+            if (this->count == 0 || ns < this->min_ns) this->min_ns = ns;
+            this->count++;
+        }
+
+        /** Upper bound of the bucket holding the pth percentile sample,
+         *  e.g. percentile_ns(0.99) for p99 latency
+         */
+        unsigned long long percentile_ns(double p) const {
+            if (this->count == 0) return 0;
+
+            const size_t target = (size_t)((double)this->count * p);
+            size_t seen = 0;
+
+            for (size_t i = 0; i < N_BUCKETS; i++) {
+                seen += this->buckets[i];
+                if (seen > target)
+                    return ((unsigned long long)2 << i) - 1;
+            }
+
+            return this->max_ns;
+        }
+    };
+
+    /** Per-stage latency histograms for the reader pipeline, retrieved
+     *  with CSVReader::trace()
+     *
+     *  Populated only when the library is built with `CSV_TRACE` defined;
+     *  otherwise every histogram stays empty and no clock is read on the
+     *  hot path. Together the four stages separate storage stalls (`read`
+     *  slow), parse stalls (`parse` slow, `queue_full` filling up), and
+     *  consumer backpressure (`queue_empty` near zero while rows pile up).
+     */
+    struct CSVReaderTrace {
+        LatencyHistogram read;        /**< One read_chunk() or async next_chunk() call */
+        LatencyHistogram parse;       /**< One feed() of a chunk on the worker thread */
+        LatencyHistogram queue_full;  /**< Reader thread blocked: chunk queue full */
+        LatencyHistogram queue_empty; /**< Worker thread starved: chunk queue empty */
+
+        /** Render all four histograms as a JSON object, suitable for
+         *  shipping to whatever is collecting incident diagnostics
+         */
+        std::string to_json() const;
+    };
+
+    /** @class CSVReader
+     *  @brief Main class for parsing CSVs from files and in-memory sources
+     *
+     *  All rows are compared to the column names for length consistency
+     *  - By default, rows that are too short or too long are dropped
+     *  - Custom behavior can be defined by overriding bad_row_handler in a subclass
+     */
+    class CSVReader {
+    public:
+        /**
+         * An input iterator capable of handling large files.
+         * @note Created by CSVReader::begin() and CSVReader::end().
+         *
+         * @par Iterating over a file
+         * @snippet tests/test_csv_iterator.cpp CSVReader Iterator 1
+         *
+         * @par Using with `<algorithm>` library
+         * @snippet tests/test_csv_iterator.cpp CSVReader Iterator 2
+         */
+        class iterator {
+        public:
+            #ifndef DOXYGEN_SHOULD_SKIP_THIS
+            using value_type = CSVRow;
+            using difference_type = std::ptrdiff_t;
+            using pointer = CSVRow * ;
+            using reference = CSVRow & ;
+            using iterator_category = std::input_iterator_tag;
+            #endif
+
+            iterator() = default;
+            iterator(CSVReader* reader) : daddy(reader) {};
+            iterator(CSVReader*, CSVRow&&);
+
+            /** Access the CSVRow held by the iterator */
+            CONSTEXPR reference operator*() { return this->row; }
+
+            /** Return a pointer to the CSVRow the iterator has stopped at */
+            CONSTEXPR pointer operator->() { return &(this->row); }
+
+            iterator& operator++();   /**< Pre-increment iterator */
+            iterator operator++(int); /**< Post-increment ierator */
+            iterator& operator--();
+
+            /** Returns true if iterators were constructed from the same CSVReader
+             *  and point to the same row
+             */
+            CONSTEXPR bool operator==(const iterator& other) const {
+                return (this->daddy == other.daddy) && (this->i == other.i);
+            }
+
+            CONSTEXPR bool operator!=(const iterator& other) const { return !operator==(other); }
+        private:
+            CSVReader * daddy = nullptr;  // Pointer to parent
+            CSVRow row;                   // Current row
+            RowCount i = 0;               // Index of current row
+        };
+
+        /** @name Constructors
+         *  Constructors for iterating over large files and parsing in-memory sources.
+         */
+         ///@{
+        CSVReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv(),
+            IOMode io_mode = IOMode::STDIO);
+        CSVReader(CSVFormat format = CSVFormat());
+        ///@}
+
+        /** Point this reader at another file, reusing its parse tables and
+         *  every buffer the previous file warmed up
+         *
+         *  Unlike constructing a fresh CSVReader, open() keeps the parse and
+         *  whitespace flag tables, the row buffer pool, and the threading
+         *  state, so switching files costs little more than the fopen() —
+         *  the difference dominates when churning through many small files
+         *  (see ParserSession). Column names fixed by the format carry over;
+         *  otherwise they are taken from each file's header row. A format
+         *  guessed while constructing over a file is locked in by the
+         *  constructor and applies to every subsequently opened file.
+         */
+        void open(csv::string_view filename, IOMode io_mode = IOMode::STDIO);
+
+        CSVReader(const CSVReader&) = delete; // No copy constructor
+        CSVReader(CSVReader&&) = default;     // Move constructor
+        CSVReader& operator=(const CSVReader&) = delete; // No copy assignment
+        CSVReader& operator=(CSVReader&& other) = default;
+        virtual ~CSVReader() {
+            if (this->prefetch_thread.joinable())
+                this->prefetch_thread.join();
+
+            this->close();
+        }
+
+        /** @name Reading In-Memory Strings
+         *  You can piece together incomplete CSV fragments by calling feed() on them
+         *  before finally calling end_feed().
+         *
+         *  Alternatively, you can also use the parse() shorthand function for
+         *  smaller strings.
+         */
+         ///@{
+        void feed(csv::string_view in);
+        void end_feed();
+        ///@}
+
+        /** @name Retrieving CSV Rows */
+        ///@{
+        bool read_row(CSVRow &row);
+        size_t read_rows(std::vector<CSVRow>& out, size_t n);
+        size_t read_batch(ColumnBatch& batch, size_t n);
+        void sample_types(size_t sample_size = 100);
+        iterator begin();
+        HEDLEY_CONST iterator end() const;
+        ///@}
+
+        /** @name CSV Metadata */
+        ///@{
+        CSVFormat get_format() const;
+        std::vector<std::string> get_col_names() const;
+        int index_of(csv::string_view col_name) const;
+        ColumnHandle column(const std::string& col_name) const;
+        ///@}
+
+        /** @name Memory Budget
+         *  Bound how much memory this reader holds between read_row() calls
+         */
+        ///@{
+        /** Set how many bytes each parsing round pulls from disk */
+        void set_chunk_size(size_t bytes) {
+            this->iteration_chunk_size = std::max(bytes, (size_t)1);
+        }
+
+        /** How many bytes each parsing round pulls from disk */
+        size_t get_chunk_size() const { return this->iteration_chunk_size; }
+
+        /** Stop a parsing round early once this many rows are buffered
+         *  (0 = only bounded by the chunk size). The cap is checked between
+         *  chunks, so it may be overshot by up to one chunk's worth of rows.
+         */
+        void set_max_buffered_rows(size_t n_rows) { this->max_buffered_rows = n_rows; }
+
+        /** Number of parsed rows awaiting retrieval */
+        size_t get_buffered_rows() const { return this->records.size(); }
+
+        /** Keep only rows for which the predicate returns true
+         *
+         *  The predicate is evaluated over raw field string_views before a
+         *  CSVRow is materialized: rejected rows never allocate and their
+         *  bytes are reclaimed immediately. The header row always bypasses
+         *  the filter, and when columns are projected (CSVFormat::select())
+         *  the predicate sees only the projected fields.
+         *
+         *  @note Views passed to the predicate are invalidated when it returns
+         */
+        void set_row_filter(std::function<bool(const std::vector<csv::string_view>&)> predicate);
+
+        /** Invoke a callback for every row whose field count differs from
+         *  the header — whether the variable column policy then keeps or
+         *  drops it — e.g. to log or divert dirty vendor rows in the same
+         *  pass that parses the clean ones. Rows rejected under
+         *  VariableColumnPolicy::THROW still throw instead.
+         *
+         *  @note The CSVRow passed to the callback may be inspected but
+         *        should not be stored if the policy drops it afterwards
+         */
+        void set_bad_row_handler(std::function<void(const CSVRow&)> handler) {
+            this->bad_row_handler = std::move(handler);
+        }
+
+        /** Bytes read from disk but not yet parsed. Only non-zero while a
+         *  parsing round is in flight.
+         */
+        size_t get_buffered_bytes() const { return this->feed_state->queued_bytes.load(); }
+
+        /** Read and parse the next chunk in the background once buffered rows
+         *  drop to the given low-water mark, so steady-state iteration never
+         *  blocks on I/O (classic double buffering)
+         *
+         *  @warning A reader must not be moved while a prefetch is in flight
+         */
+        void set_prefetch(bool on, size_t low_water_rows = 1000) {
+            this->prefetch_enabled = on;
+            this->prefetch_low_water = low_water_rows;
+        }
+
+        /** Follow a file that is still being written, like `tail -f`
+         *
+         *  In follow mode, reaching end of file no longer finalizes the
+         *  reader: the stream stays open and the parser keeps its partial
+         *  state — quote_escape and any incomplete trailing line — so
+         *  parsing continues exactly where it left off when new bytes land.
+         *  read_row() returning false then means "no complete row yet"
+         *  rather than "done"; call poll() (or simply read_row() again)
+         *  after the producer appends. Each poll costs one read attempt
+         *  plus parsing of whatever bytes arrived — never a re-scan.
+         *
+         *  Turning follow mode off lets the next read finish normally,
+         *  flushing a trailing unterminated row and closing the file.
+         *
+         *  @note Only applies to plain stdio reads; memory-mapped,
+         *        compressed, and async inputs are finalized at EOF as usual
+         */
+        void set_follow(bool on) { this->follow_mode = on; }
+
+        /** Attempt to read newly appended bytes, returning true if at
+         *  least one complete row is now buffered
+         */
+        bool poll();
+
+        /** Validate that the input is well-formed Unicode as it is read
+         *
+         *  Validation runs on the reader thread over each chunk, overlapped
+         *  with parsing on the worker thread. A UTF-16 byte order mark
+         *  (FF FE or FE FF) switches the reader into a streaming transcode
+         *  which feeds the parser UTF-8; otherwise the input is checked as
+         *  UTF-8 in place. Sequences split across chunk boundaries are
+         *  carried between reads.
+         *
+         *  Under UnicodePolicy::THROW, the first malformed sequence raises
+         *  std::runtime_error; under UnicodePolicy::REPLACE, malformed
+         *  UTF-8 bytes become '?' and unpaired UTF-16 surrogates become
+         *  U+FFFD, and parsing continues.
+         *
+         *  @note Only applies to stdio and async reads; memory-mapped
+         *        input is parsed in place over a read-only mapping and
+         *        passes through unexamined
+         *
+         *  @note Format guessing and header parsing examine raw file
+         *        bytes, so UTF-16 input should be paired with an explicit
+         *        CSVFormat (delimiter and column names)
+         */
+        void set_unicode_policy(UnicodePolicy policy) {
+            this->unicode_policy = policy;
+        }
+
+        /** Intern repeated string values when batching with read_batch().
+         *  Each string column is sampled for cardinality; low-cardinality
+         *  columns (country codes, enum states, ...) store each distinct
+         *  value once plus an integer code per row, instead of repeating
+         *  the bytes for every occurrence. See ColumnBatch::Column::codes.
+         */
+        void set_dictionary_encoding(bool on) { this->dict_encoding = on; }
+        ///@}
+
+        /** @name Instrumentation */
+        ///@{
+        /** Snapshot this reader's hot-path counters. See CSVReaderMetrics
+         *  for how to read them.
+         */
+        CSVReaderMetrics metrics() const { return this->metrics_data; }
+
+        /** Snapshot this reader's per-stage latency histograms. Empty
+         *  unless the library was built with `CSV_TRACE` defined; see
+         *  CSVReaderTrace.
+         */
+        CSVReaderTrace trace() const { return this->trace_data; }
+        ///@}
+        
+        /** @name CSV Metadata: Attributes */
+        ///@{
+        RowCount num_rows = 0;   /**< How many rows (minus header)
+                                   *   have been parsed so far
+                                   */
+        bool utf8_bom = false;   /**< Set to true if UTF-8 BOM was detected */
+        ///@}
+
+        void close();
+
+    protected:
+        /**
+         * \defgroup csv_internal CSV Parser Internals
+         * @brief Internals of CSVReader. Only maintainers and those looking to
+         *        extend the parser should read this.
+         * @{
+         */
+
+        /** A string buffer and its size. Consumed by read_csv_worker(). */
+        using WorkItem = std::pair<std::unique_ptr<char[]>, size_t>;
+
+        /** Multi-threaded Reading State, including synchronization objects that cannot be moved. */
+        struct ThreadedReadingState {
+            internals::SPSCQueue<WorkItem> feed_buffer;    /**< Lock-free message queue for worker */
+            internals::SPSCQueue<WorkItem> recycle_buffer; /**< Returns consumed chunk buffers to the reader */
+            std::atomic<size_t> queued_bytes = { 0 };      /**< Bytes read from disk but not yet parsed */
+            std::atomic<size_t> parsed_rows = { 0 };       /**< Rows currently sitting in records */
+        };
+
+        /** Open a file for reading. Implementation is compiler specific. */
+        void fopen(csv::string_view filename);
+
+        /** Map a file into memory for zero-copy reading. Falls back to
+         *  fopen() on platforms without memory mapping.
+         */
+        void open_mmap(csv::string_view filename);
+
+        /** Sets this reader's column names and associated data */
+        void set_col_names(const std::vector<std::string>&);
+
+        /** Resolve a column selection against the full column set, building
+         *  the projection mask and returning the projected column names
+         */
+        std::vector<std::string> apply_projection(
+            const std::vector<std::string>& full_names,
+            const std::vector<std::string>& selected);
+
+        /** Returns true if we have reached end of file */
+        bool eof() {
+            if (this->io_mode == IOMode::MMAP)
+                return !this->mmap_base || this->mmap_pos >= this->mmap_len;
+
+            if (this->compression != Compression::NONE)
+                return this->decompress_done;
+
+            if (this->async_ctx)
+                return this->async_done;
+
+            return !(this->infile);
+        };
+
+        /** @name CSV Settings **/
+        ///@{
+        CSVFormat format;
+
+        /** An array where the (i + 128)th slot gives the ParseFlags for ASCII character i */
+        internals::ParseFlagMap parse_flags;
+
+        /** An array where the (i + 128)th slot determines whether ASCII character i should
+         *  be trimmed
+         */
+        internals::WhitespaceMap ws_flags;
+        ///@}
+
+        /** @name Parser State */
+        ///@{
+        /** Pointer to a object containing column information */
+        internals::ColNamesPtr col_names = std::make_shared<internals::ColNames>();
+
+        /** Buffer for current row being parsed */
+        internals::BufferPtr record_buffer = internals::BufferPtr(new internals::RawRowBuffer(this->col_names));
+
+        /** Recycles RawRowBuffers that no CSVRow references anymore */
+        internals::BufferPool buffer_pool;
+
+        /** Queue of parsed CSV rows */
+        internals::RecordRing records;
+
+        /** Rows parsed by an in-flight prefetch. The background thread owns
+         *  this deque exclusively while use_staging is set; the consumer
+         *  swaps it into records after joining (see fill_records()).
+         */
+        internals::RecordRing staging_records;
+
+        /** Whether newly parsed rows are delivered to staging_records */
+        bool use_staging = false;
+
+        /** Whether prefetching was requested via set_prefetch() */
+        bool prefetch_enabled = false;
+
+        /** Whether EOF is treated as "no new bytes yet" (see set_follow()) */
+        bool follow_mode = false;
+
+        /** Whether read_batch() dictionary encodes low-cardinality columns */
+        bool dict_encoding = false;
+
+        /** Hot-path counters; each field is written by one thread only */
+        CSVReaderMetrics metrics_data;
+
+        /** Pipeline latency histograms; recorded into only under CSV_TRACE */
+        CSVReaderTrace trace_data;
+
+        /** Buffered row count at which the next prefetch is launched */
+        size_t prefetch_low_water = 0;
+
+        /** Background thread running the current prefetch, if any */
+        std::thread prefetch_thread;
+
+        /** Ensure records holds rows if any remain, harvesting or launching
+         *  prefetches as configured
+         */
+        void fill_records();
+
+        /** Whether or not we are in a quote-escaped field */
+        bool quote_escape = false;
+
+        /** Column projection push-down state; an empty mask parses every column */
+        internals::ProjectionState projection;
+
+        /** Row filter push-down state; rows are kept when no predicate is set */
+        internals::RowFilter row_filter;
+
+        /** Observer for rows whose field count differs from the header */
+        std::function<void(const CSVRow&)> bad_row_handler;
+
+        /** Whether or not an attempt to find Unicode BOM has been made */
+        bool unicode_bom_scan = false;
+
+        /** How malformed input bytes are handled (see set_unicode_policy()) */
+        UnicodePolicy unicode_policy = UnicodePolicy::NONE;
+
+        /** Detected encoding, plus Unicode sequences split across chunks */
+        internals::UnicodeValidator unicode_state;
+
+        /** Whether or not rows before header were trimmed */
+        bool header_trimmed = false;
+
+        /** The number of columns in this CSV */
+        size_t n_cols = 0;
+
+        /** How many bytes read_csv() pulls from disk per round */
+        size_t iteration_chunk_size = internals::ITERATION_CHUNK_SIZE;
+
+        /** Row count at which a parsing round stops early (0 = no cap) */
+        size_t max_buffered_rows = 0;
+        ///@}
+
+        /** @name Multi-Threaded File Reading Functions */
+        ///@{
+        void feed(WorkItem&&); /**< @brief Helper for read_csv_worker() */
+
+        /** Split a chunk of input into newline-aligned slices and parse
+         *  them on multiple threads
+         */
+        void feed_parallel(csv::string_view in, size_t n_threads);
+
+        /** Parse one chunk of input into records. Virtual so that readers
+         *  with statically known formats can substitute a specialized kernel.
+         */
+        virtual void parse_chunk(csv::string_view in);
+        void read_csv(const size_t& bytes = internals::ITERATION_CHUNK_SIZE);
+        void read_csv_worker();
+
+        /** Parse the next chunk of a memory-mapped file in place */
+        void read_csv_mmap(const size_t& bytes);
+
+        /** Validate or transcode one freshly read chunk (see set_unicode_policy()) */
+        bool validate_chunk(std::unique_ptr<char[]>& buffer, size_t& n_read,
+            size_t buffer_size, std::string& error);
+        ///@}
+
+        /** @name Multi-Threaded File Reading: Flags and State */
+        ///@{
+        /** Current file handle. Destroyed by ~CSVReader(). */
+        std::FILE* HEDLEY_RESTRICT infile = nullptr;
+        std::unique_ptr<ThreadedReadingState> feed_state;
+
+        /** How bytes are pulled from the current file */
+        IOMode io_mode = IOMode::STDIO;
+
+        /** Base address of the current memory mapping. Unmapped by close(). */
+        const char* mmap_base = nullptr;
+
+        /** Length of the current memory mapping in bytes */
+        size_t mmap_len = 0;
+
+        /** How far into the memory mapping the parser has advanced */
+        size_t mmap_pos = 0;
+
+        /** Opaque handle to the io_uring submission state
+         *  (an internals::UringReader*). Released by close().
+         */
+        void* async_ctx = nullptr;
+
+        /** Whether the async read stream has been fully consumed */
+        bool async_done = false;
+        ///@}
+
+        /** @name Compressed Input State */
+        ///@{
+        /** Compression format of the current file, detected from magic bytes */
+        Compression compression = Compression::NONE;
+
+        /** Opaque handle to the active decompression stream
+         *  (a gzFile or ZSTD_DStream*). Released by close().
+         */
+        void* decompress_ctx = nullptr;
+
+        /** Staging buffer for raw compressed bytes awaiting decompression */
+        std::unique_ptr<char[]> compressed_buffer;
+
+        /** Valid bytes in compressed_buffer */
+        size_t compressed_len = 0;
+
+        /** Consumed bytes in compressed_buffer */
+        size_t compressed_pos = 0;
+
+        /** Whether the compressed stream has been fully decompressed */
+        bool decompress_done = false;
+
+        /** Open the decompression stream matching this->compression */
+        void init_decompression(csv::string_view filename);
+
+        /** Read up to n bytes of plaintext, decompressing when necessary */
+        size_t read_chunk(char* out, size_t n);
+        ///@}
+
+        /**@}*/ // End of parser internals
+
+    private:
+        /** Set parse and whitespace flags */
+        void set_parse_flags(const CSVFormat& format);
+    };
+
+    /** A CSVReader whose delimiter and quote character are fixed at
+     *  compile time
+     *
+     *  For files whose format is known statically -- e.g. plain RFC 4180
+     *  comma/double-quote data -- this reader parses chunks with
+     *  internals::parse_static(), which replaces the runtime ParseFlagMap
+     *  lookups with immediate compares the compiler can fold.
+     *
+     *  @tparam Delim The delimiter character
+     *  @tparam Quote The quote character
+     */
+    template<char Delim = ',', char Quote = '"'>
+    class BasicCSVReader : public CSVReader {
+    public:
+        /** Parse in-memory sources with a statically known format */
+        BasicCSVReader() : CSVReader(static_format()) {};
+
+        /** Read a file with a statically known format */
+        BasicCSVReader(csv::string_view filename) : CSVReader(filename, static_format()) {};
+
+    protected:
+        void parse_chunk(csv::string_view in) override {
+            this->record_buffer = internals::parse_static<Delim, Quote>({
+                in,
+                this->parse_flags,
+                this->ws_flags,
+                this->record_buffer,
+                this->quote_escape,
+                this->use_staging ? this->staging_records : this->records
+            }, &this->buffer_pool);
+        }
+
+    private:
+        /** Return a CSVFormat matching this reader's template parameters */
+        static CSVFormat static_format() {
+            CSVFormat format;
+            format.delimiter(Delim).quote(Quote);
+            return format;
+        }
+    };
+
+    /** A reusable parsing session for churning through many small files
+     *
+     *  Constructing a CSVReader per file rebuilds the parse flag tables and
+     *  allocates fresh column name, row buffer, and threading state — for
+     *  files of a few KB, that setup dwarfs the parsing itself. A
+     *  ParserSession constructs one CSVReader up front and re-points it at
+     *  each file with CSVReader::open(), so all of those allocations are
+     *  paid once per session rather than once per file.
+     *
+     *  @par Example
+     *  @code
+     *  csv::ParserSession session(format);
+     *  for (auto& path : paths) {
+     *      csv::CSVReader& reader = session.open(path);
+     *      for (auto& row : reader) { ... }
+     *  }
+     *  @endcode
+     *
+     *  @warning Rows from one file should be consumed before the next
+     *           open(): switching files discards any still buffered.
+     */
+    class ParserSession {
+    public:
+        /** Construct a session whose format applies to every opened file */
+        ParserSession(CSVFormat format = CSVFormat()) : reader(format) {};
+
+        /** Begin reading the given file, reusing the session's reader */
+        CSVReader& open(csv::string_view filename, IOMode io_mode = IOMode::STDIO) {
+            this->reader.open(filename, io_mode);
+            return this->reader;
+        }
+
+        /** The reader over the most recently opened file */
+        CSVReader& current() { return this->reader; }
+
+    private:
+        CSVReader reader;
+    };
+}
+/** @file
+ *  Calculates statistics from CSV files
+ */
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace csv {
+    /** Controls how much memory CSVStat spends on per-column statistics
+     *
+     *  In APPROXIMATE mode, exact frequency counting is replaced with
+     *  bounded-memory sketches: quantiles, distinct-count estimates, and
+     *  top values become available through get_quantile(),
+     *  get_cardinality(), and get_top_values(), while get_counts()
+     *  returns empty maps. A few MB per column suffice for any file size.
+     */
+    enum class StatsMode {
+        EXACT,
+        APPROXIMATE
+    };
+
+    namespace internals {
+        /** A frequency counter keyed by string_view into an append-only
+         *  arena. Each distinct value is copied exactly once, on first
+         *  sight; counting an already-seen value performs no allocations.
+         *  Lookups use an open-addressing table with linear probing.
+         */
+        class FreqCounter {
+        public:
+            /** One occupied slot in the table. A count of zero marks an empty slot. */
+            struct Entry {
+                csv::string_view key;
+                RowCount count = 0;
+            };
+
+            FreqCounter() : slots(INITIAL_CAPACITY) {};
+
+            /** Add count occurrences of value, copying it into the arena if new */
+            void add(csv::string_view value, RowCount count = 1);
+
+            /** Fold another counter's entries into this one */
+            void merge(const FreqCounter& other);
+
+            /** Number of distinct values seen */
+            size_t size() const { return this->n_entries; }
+
+            /** Copy the counts out into an ordinary map */
+            std::unordered_map<std::string, RowCount> to_map() const;
+
+        private:
+            static const size_t INITIAL_CAPACITY = 64; /**< Must be a power of two */
+            static const size_t ARENA_BLOCK_SIZE = 65536;
+
+            static size_t hash(csv::string_view value);
+
+            csv::string_view copy_to_arena(csv::string_view value);
+            void rehash(size_t new_capacity);
+
+            std::vector<Entry> slots;
+            size_t n_entries = 0;
+
+            /** Append-only storage for distinct values; blocks are never
+             *  reallocated, so keys stay valid as the table grows */
+            std::vector<std::unique_ptr<char[]>> arena;
+            size_t arena_used = ARENA_BLOCK_SIZE; /**< Bytes used in the last block */
+        };
+
+        /** A t-digest sketch for estimating arbitrary quantiles in
+         *  bounded memory. Observations are buffered, then compressed
+         *  into weighted centroids which cluster tightly near the tails.
+         */
+        class QuantileSketch {
+        public:
+            /** Record one observation */
+            void add(long double x);
+
+            /** Fold another sketch's centroids into this one */
+            void merge(const QuantileSketch& other);
+
+            /** Estimate the q-th quantile (q between 0 and 1)
+             *  @return NAN if no observations have been recorded
+             */
+            long double quantile(double q) const;
+
+        private:
+            struct Centroid {
+                long double mean;
+                long double weight;
+            };
+
+            static const size_t COMPRESSION = 100; /**< Maximum centroid resolution */
+            static const size_t BUFFER_LIMIT = 512;
+
+            void compress() const;
+
+            // Lazily compressed by quantile(), hence mutable
+            mutable std::vector<Centroid> centroids;
+            mutable std::vector<long double> buffer;
+            long double total_weight = 0;
+        };
+
+        /** A HyperLogLog sketch for estimating the number of distinct
+         *  values in a column using a few KB of registers
+         */
+        class CardinalitySketch {
+        public:
+            CardinalitySketch() : registers((size_t)1 << PRECISION, 0) {};
+
+            /** Record one observation */
+            void add(csv::string_view value);
+
+            /** Fold another sketch into this one by taking register maxima */
+            void merge(const CardinalitySketch& other);
+
+            /** Estimate the number of distinct values recorded */
+            RowCount estimate() const;
+
+        private:
+            static const int PRECISION = 12; /**< log2 of the register count */
+
+            static unsigned long long hash(csv::string_view value);
+
+            std::vector<unsigned char> registers;
+        };
+
+        /** A space-saving sketch tracking the top-k most frequent values
+         *  in a column. Counts are upper bounds: a value's true frequency
+         *  may be overestimated by at most the smallest tracked count.
+         */
+        class HeavyHitterSketch {
+        public:
+            HeavyHitterSketch(size_t _capacity = DEFAULT_CAPACITY) : capacity(_capacity) {};
+
+            /** Record count occurrences of value */
+            void add(csv::string_view value, RowCount count = 1);
+
+            /** Fold another sketch's entries into this one */
+            void merge(const HeavyHitterSketch& other);
+
+            /** Copy the tracked values and their estimated counts out */
+            std::unordered_map<std::string, RowCount> to_map() const;
+
+        private:
+            static const size_t DEFAULT_CAPACITY = 100;
+
+            /** Evict the smallest entries until at most capacity remain */
+            void trim();
+
+            size_t capacity;
+            std::unordered_map<std::string, RowCount> items;
+        };
+    }
+
+    /** Class for calculating statistics from CSV files and in-memory sources
+     *
+     *  **Example**
+     *  \include programs/csv_stats.cpp
+     *
+     */
+    class CSVStat : public CSVReader {
+    public:
+        using FreqCount = std::unordered_map<std::string, RowCount>;
+        using TypeCount = std::unordered_map<DataType, RowCount>;
+
+        void end_feed();
+        std::vector<long double> get_mean() const;
+        std::vector<long double> get_variance() const;
+        std::vector<long double> get_mins() const;
+        std::vector<long double> get_maxes() const;
+        std::vector<FreqCount> get_counts() const;
+        std::vector<TypeCount> get_dtypes() const;
+
+        /** @name Approximate Statistics
+         *  @brief Only available when StatsMode::APPROXIMATE was requested,
+         *         otherwise these methods throw std::runtime_error
+         */
+        ///@{
+        std::vector<long double> get_quantile(double q) const;
+        std::vector<RowCount> get_cardinality() const;
+        std::vector<FreqCount> get_top_values() const;
+        ///@}
+
+        CSVStat(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv(),
+            StatsMode mode = StatsMode::EXACT);
+        CSVStat(CSVFormat format = CSVFormat(), StatsMode mode = StatsMode::EXACT)
+            : CSVReader(format), mode(mode) {};
+    private:
+        StatsMode mode = StatsMode::EXACT;
+        // An array of rolling averages
+        // Each index corresponds to the rolling mean for the column at said index
+        std::vector<long double> rolling_means;
+        std::vector<long double> rolling_vars;
+        std::vector<long double> mins;
+        std::vector<long double> maxes;
+        std::vector<internals::FreqCounter> counts;
+        std::vector<TypeCount> dtypes;
+        std::vector<long double> n;
+
+        // Sketches, only populated in StatsMode::APPROXIMATE
+        std::vector<internals::QuantileSketch> quantile_sketches;
+        std::vector<internals::CardinalitySketch> cardinality_sketches;
+        std::vector<internals::HeavyHitterSketch> top_value_sketches;
+
+        /** Partial aggregates for one column, computed over one shard of rows */
+        struct ColumnStats {
+            long double n = 0;       /**< Number of numeric observations */
+            long double mean = 0;    /**< Rolling mean */
+            long double m2 = 0;      /**< Sum of squared deviations from the mean */
+            long double min = NAN;
+            long double max = NAN;
+
+            /** Numeric values buffered until the next vectorized flush */
+            std::vector<double> pending;
+
+            internals::FreqCounter counts;
+            TypeCount dtypes;
+
+            // Sketches, only populated in StatsMode::APPROXIMATE
+            internals::QuantileSketch quantiles;
+            internals::CardinalitySketch cardinality;
+            internals::HeavyHitterSketch top_values;
+        };
+
+        void calc();
+
+        /** Fold a column's buffered numeric values into its aggregates
+         *  using vectorized sum/min/max and sum-of-squares kernels
+         */
+        static void flush_numeric(ColumnStats& col);
+
+        void calc_shard(internals::RecordRing::iterator begin,
+            internals::RecordRing::iterator end,
+            std::vector<ColumnStats>& stats);
+        void merge_stats(std::vector<ColumnStats>& partial);
+    };
+}
+/** @file
+ *  Defines an awaitable row stream for C++20 coroutine consumers
+ *
+ *  Everything here is guarded by CSV_HAS_COROUTINES and compiles away
+ *  entirely on C++14/17 builds. Unlike the rest of the library, this file
+ *  is header-only: its symbols cannot live in the precompiled library,
+ *  which may have been built under an older standard.
+ */
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define CSV_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef CSV_HAS_COROUTINES
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace csv {
+    /** @class AsyncReader
+     *  @brief Reads rows for coroutine-based consumers without blocking them
+     *
+     *  A dedicated reader thread parses the file chunk by chunk into a
+     *  bounded row buffer. `co_await reader.next(row)` completes immediately
+     *  while buffered rows remain; when the buffer runs dry, the awaiting
+     *  coroutine suspends — freeing its thread for other work — and is
+     *  resumed by the reader thread once the next chunk has been parsed.
+     *  This lets many concurrent streams share a small thread pool instead
+     *  of each pinning a thread inside read_row().
+     *
+     *  At most one coroutine may be awaiting a given AsyncReader at a time,
+     *  and the AsyncReader must outlive any coroutine suspended on it.
+     */
+    class AsyncReader {
+    public:
+        /** Awaitable returned by next(); resolves to true if a row was read */
+        class RowAwaiter {
+        public:
+            RowAwaiter(AsyncReader& reader, CSVRow& out) :
+                owner(reader), row(out) {};
+
+            bool await_ready() {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+                return this->try_pop();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+
+                // A chunk may have been parsed between await_ready() and
+                // here; resume immediately rather than suspend
+                if (!this->owner.ready.empty() || this->owner.done)
+                    return false;
+
+                this->owner.waiter = handle;
+                return true;
+            }
+
+            bool await_resume() {
+                std::unique_lock<std::mutex> lock(this->owner.lock);
+                if (this->got_row) return true;
+                if (this->try_pop()) return true;
+
+                // Stream exhausted: surface any reader thread failure
+                if (this->owner.reader_error)
+                    std::rethrow_exception(this->owner.reader_error);
+
+                return false;
+            }
+
+        private:
+            /** Move the next buffered row into the caller's slot.
+             *  @pre owner.lock is held
+             */
+            bool try_pop() {
+                if (this->owner.ready.empty()) return false;
+
+                this->row = std::move(this->owner.ready.front());
+                this->owner.ready.pop_front();
+                this->got_row = true;
+                this->owner.space_available.notify_one();
+                return true;
+            }
+
+            AsyncReader& owner;
+            CSVRow& row;
+            bool got_row = false;
+        };
+
+        AsyncReader(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv()) :
+            reader(filename, format) {
+            this->reader_thread = std::thread(&AsyncReader::reader_main, this);
+        }
+
+        ~AsyncReader() {
+            {
+                std::unique_lock<std::mutex> lock(this->lock);
+                this->shutting_down = true;
+            }
+
+            this->space_available.notify_all();
+            if (this->reader_thread.joinable())
+                this->reader_thread.join();
+        }
+
+        AsyncReader(const AsyncReader&) = delete;
+        AsyncReader& operator=(const AsyncReader&) = delete;
+
+        /** Await the next row, suspending the caller if none is buffered
+         *
+         *  @param[out] row The variable where the parsed row will be stored
+         *  @return An awaitable resolving to true if a row was read,
+         *          or false once the stream is exhausted
+         */
+        RowAwaiter next(CSVRow& row) { return RowAwaiter(*this, row); }
+
+        std::vector<std::string> get_col_names() const {
+            return this->reader.get_col_names();
+        }
+
+    private:
+        /** Rows buffered ahead of the consumer before the reader thread
+         *  pauses and waits for the stream to drain
+         */
+        static constexpr size_t HIGH_WATER = 10000;
+
+        /** Rows pulled from the CSVReader per wakeup */
+        static constexpr size_t READ_BATCH = 1000;
+
+        void reader_main() {
+            std::vector<CSVRow> batch;
+
+            while (true) {
+                batch.clear();
+
+                size_t n_read = 0;
+                try {
+                    n_read = this->reader.read_rows(batch, READ_BATCH);
+                }
+                catch (...) {
+                    std::unique_lock<std::mutex> lock(this->lock);
+                    this->reader_error = std::current_exception();
+                }
+
+                std::coroutine_handle<> handle = nullptr;
+
+                {
+                    std::unique_lock<std::mutex> lock(this->lock);
+                    for (auto& row : batch)
+                        this->ready.push_back(std::move(row));
+
+                    if (n_read == 0 || this->reader_error)
+                        this->done = true;
+
+                    // The consumer suspends only when the buffer is empty,
+                    // so new rows (or EOF) always warrant a resume
+                    if (this->waiter) {
+                        handle = this->waiter;
+                        this->waiter = nullptr;
+                    }
+                }
+
+                // Resumed outside the lock: the consumer immediately
+                // re-enters next(), which locks to pop its row
+                if (handle) handle.resume();
+                if (this->done) break;
+
+                std::unique_lock<std::mutex> lock(this->lock);
+                this->space_available.wait(lock, [this] {
+                    return this->ready.size() < HIGH_WATER || this->shutting_down;
+                });
+
+                if (this->shutting_down) break;
+            }
+        }
+
+        CSVReader reader;
+        std::thread reader_thread;
+
+        std::mutex lock;
+        std::condition_variable space_available;
+        std::deque<CSVRow> ready;
+        std::coroutine_handle<> waiter = nullptr;
+        std::exception_ptr reader_error = nullptr;
+        bool done = false;
+        bool shutting_down = false;
+    };
+}
+#endif
+
+/** @file
+ *  Defines a binary columnar cache that eliminates parsing cost on
+ *  repeat reads of the same CSV file
+ */
+
+#include <string>
+#include <vector>
+
+
+namespace csv {
+    /** A parsed, column-oriented snapshot of a CSV file that can be saved
+     *  to a versioned binary sidecar and reloaded without re-parsing.
+     *
+     *  The cache stores the file's ColumnBatch representation: column
+     *  names, per-column types from data_type(), contiguous numeric value
+     *  arrays, and string arenas with offset tables. Loading a sidecar is
+     *  a handful of bulk reads straight into those arrays — no tokenizing,
+     *  quoting, or type inference — so repeat reads cost I/O only.
+     *
+     *  Sidecars record the source file's size and modification time;
+     *  open() transparently rebuilds the cache when the source changes.
+     */
+    class CSVCache {
+    public:
+        CSVCache() = default;
+
+        /** The sidecar path used by open() for a given CSV file */
+        static std::string default_cache_path(csv::string_view filename) {
+            return std::string(filename) + ".csvcache";
+        }
+
+        /** Parse filename in full and build its columnar snapshot
+         *
+         *  @param[in] filename Path to CSV file
+         *  @param[in] format   Format of the CSV file
+         */
+        static CSVCache build(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv());
+
+        /** Load a previously saved cache from a sidecar file */
+        static CSVCache load(csv::string_view cache_path);
+
+        /** Save this cache to a binary sidecar file */
+        void save(csv::string_view cache_path) const;
+
+        /** Returns true if cache_path exists and was built from the
+         *  current size and modification time of filename
+         */
+        static bool is_fresh(csv::string_view filename, csv::string_view cache_path);
+
+        /** Retrieve the columnar snapshot of filename, loading its sidecar
+         *  when fresh and rebuilding (and re-saving) it otherwise
+         */
+        static CSVCache open(csv::string_view filename,
+            CSVFormat format = CSVFormat::guess_csv());
+
+        /** The cached columnar data */
+        const ColumnBatch& data() const { return this->batch; }
+
+        /** Number of data rows in the cached file */
+        RowCount num_rows() const { return (RowCount)this->batch.n_rows; }
+
+        /** Column names of the cached file */
+        std::vector<std::string> get_col_names() const { return this->batch.col_names; }
+
+    private:
+        ColumnBatch batch;                    /**< The cached columns */
+        unsigned long long source_size = 0;   /**< Source file size at build time */
+        unsigned long long source_mtime = 0;  /**< Source mtime at build time */
+    };
+}
+
+/** @file
+ *  A compressing file sink for DelimWriter
+ */
+
+#include <condition_variable>
+#include <cstring> // For strlen()
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+#ifdef CSV_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef CSV_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace csv {
+    /** A file sink which compresses CSV output as it is written,
+     *  for use as the output stream of a DelimWriter
+     *
+     *  Each chunk handed over by the writer — a whole number of rows, since
+     *  DelimWriter's buffer always ends on a row boundary — is compressed
+     *  into one independent gzip member or zstd frame on a background
+     *  thread, pipelining row formatting with compression. Because every
+     *  frame is self-contained, flush() establishes a point at which the
+     *  file so far decompresses to complete rows, so tailing consumers
+     *  never see a torn record.
+     *
+     *  @par Example
+     *  @code
+     *  csv::CompressedOutput out("rows.csv.gz");
+     *  auto writer = csv::make_csv_writer(out);
+     *  @endcode
+     *
+     *  @note Requires building with zlib (gzip) or zstd support,
+     *        like CSVReader's transparent decompression.
+     */
+    class CompressedOutput {
+    public:
+        /** Open a compressed file sink, deducing the codec from the
+         *  filename: `.gz` selects gzip and `.zst` selects zstd
+         */
+        CompressedOutput(const std::string& filename)
+            : CompressedOutput(filename, deduce_codec(filename)) {};
+
+        /** Open a compressed file sink with an explicit codec */
+        CompressedOutput(const std::string& filename, Compression _codec)
+            : codec(_codec) {
+#ifndef CSV_HAS_ZLIB
+            if (this->codec == Compression::GZIP)
+                throw std::runtime_error(
+                    "This library was built without zlib support.");
+#endif
+#ifndef CSV_HAS_ZSTD
+            if (this->codec == Compression::ZSTD)
+                throw std::runtime_error(
+                    "This library was built without zstd support.");
+#endif
+            if (this->codec == Compression::NONE)
+                throw std::runtime_error(
+                    "CompressedOutput requires a compression codec");
+
+            this->out.open(filename, std::ios::binary);
+            if (!this->out.is_open())
+                throw std::runtime_error("Cannot open file " + filename);
+
+            this->worker = std::thread(&CompressedOutput::worker_main, this);
+        }
+
+        /** Drain pending frames and close the file */
+        ~CompressedOutput() {
+            {
+                std::unique_lock<std::mutex> guard(this->lock);
+                this->shutting_down = true;
+            }
+
+            this->frame_ready.notify_all();
+            this->worker.join();
+        }
+
+        /** Enqueue one chunk of formatted rows as a compression frame.
+         *  Called by DelimWriter whenever its buffer fills; blocks only
+         *  when compression has fallen MAX_PENDING_FRAMES behind.
+         */
+        void write(const char* data, std::streamsize n) {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->frame_done.wait(guard, [this] {
+                return this->frames.size() < MAX_PENDING_FRAMES || this->worker_error;
+            });
+
+            if (this->worker_error)
+                std::rethrow_exception(this->worker_error);
+
+            this->frames.push_back(std::string(data, (size_t)n));
+            this->frame_ready.notify_all();
+        }
+
+        /** Wait for every pending frame to be compressed and written,
+         *  then flush the underlying file. The output up to this point
+         *  decompresses to complete rows.
+         */
+        void flush() {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->frame_done.wait(guard, [this] {
+                return (this->frames.empty() && !this->busy) || this->worker_error;
+            });
+
+            if (this->worker_error)
+                std::rethrow_exception(this->worker_error);
+
+            this->out.flush();
+        }
+
+    private:
+        /** Upper bound on frames formatted but not yet compressed */
+        static const size_t MAX_PENDING_FRAMES = 8;
+
+        static Compression deduce_codec(const std::string& filename) {
+            auto ends_with = [&filename](const char* suffix) {
+                const size_t len = std::strlen(suffix);
+                return filename.size() >= len
+                    && filename.compare(filename.size() - len, len, suffix) == 0;
+            };
+
+            if (ends_with(".gz")) return Compression::GZIP;
+            if (ends_with(".zst")) return Compression::ZSTD;
+
+            throw std::runtime_error(
+                "Cannot deduce compression codec from filename " + filename);
+        }
+
+        /** Compress one chunk into a self-contained gzip member or
+         *  zstd frame
+         */
+        std::string compress_frame(const std::string& raw) {
+            std::string frame;
+
+            if (this->codec == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+                z_stream stream = {};
+
+                // windowBits of 15 + 16 selects the gzip wrapper
+                if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                    15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                    throw std::runtime_error("Could not initialize gzip compressor");
+
+                frame.resize((size_t)deflateBound(&stream, (uLong)raw.size()));
+                stream.next_in = (Bytef*)raw.data();
+                stream.avail_in = (uInt)raw.size();
+                stream.next_out = (Bytef*)&frame[0];
+                stream.avail_out = (uInt)frame.size();
+
+                int ret = deflate(&stream, Z_FINISH);
+                frame.resize(frame.size() - (size_t)stream.avail_out);
+                deflateEnd(&stream);
+
+                if (ret != Z_STREAM_END)
+                    throw std::runtime_error("gzip compression failed");
+#endif
+            }
+            else {
+#ifdef CSV_HAS_ZSTD
+                frame.resize(ZSTD_compressBound(raw.size()));
+                size_t n = ZSTD_compress(&frame[0], frame.size(),
+                    raw.data(), raw.size(), ZSTD_CLEVEL_DEFAULT);
+
+                if (ZSTD_isError(n))
+                    throw std::runtime_error("zstd compression failed");
+
+                frame.resize(n);
+#endif
+            }
+
+            return frame;
+        }
+
+        void worker_main() {
+            std::unique_lock<std::mutex> guard(this->lock);
+
+            while (true) {
+                this->frame_ready.wait(guard, [this] {
+                    return !this->frames.empty() || this->shutting_down;
+                });
+
+                if (this->frames.empty()) return;
+
+                std::string raw = std::move(this->frames.front());
+                this->frames.pop_front();
+                this->busy = true;
+
+                // Compress and write without holding the lock; flush()
+                // never touches the file while a frame is in flight
+                guard.unlock();
+
+                try {
+                    std::string frame = this->compress_frame(raw);
+                    this->out.write(frame.data(), (std::streamsize)frame.size());
+
+                    guard.lock();
+                }
+                catch (...) {
+                    guard.lock();
+                    this->worker_error = std::current_exception();
+                    this->frames.clear();
+                }
+
+                this->busy = false;
+                this->frame_done.notify_all();
+            }
+        }
+
+        Compression codec;
+        std::ofstream out;
+        std::thread worker;
+
+        std::mutex lock;
+        std::condition_variable frame_ready; /**< Signals a queued frame */
+        std::condition_variable frame_done;  /**< Signals compression progress */
+        std::deque<std::string> frames;      /**< Chunks awaiting compression */
+        bool busy = false;                   /**< A frame is being compressed */
+        bool shutting_down = false;
+        std::exception_ptr worker_error;
+    };
+}
+
+/** @file
+ *  Defines a multi-threaded reader which parses many CSV files at once
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace csv {
+    /** Parses a set of shard files on a pool of worker threads, exposing
+     *  one merged row stream.
+     *
+     *  Workers claim whole files from a shared queue as they finish their
+     *  previous one, so skewed shard sizes balance automatically: a worker
+     *  that draws a small file simply claims the next, instead of idling
+     *  while a sibling grinds through a large one. Each worker runs the
+     *  ordinary CSVReader pipeline with its own buffers.
+     *
+     *  Rows from different files are interleaved in no particular order,
+     *  but rows from any single file arrive in file order. Per-file
+     *  completion can be observed with on_file_complete().
+     *
+     *  @par Example
+     *  @code
+     *  csv::MultiReader shards(filenames);
+     *  csv::CSVRow row;
+     *  while (shards.read_row(row)) process(row);
+     *  @endcode
+     */
+    class MultiReader {
+    public:
+        /** Prepare to read filenames on a pool of worker threads
+         *
+         *  @param[in] _filenames Paths of the CSV files to parse
+         *  @param[in] _format    Format shared by all files
+         *  @param[in] _n_threads Worker count; 0 uses the hardware concurrency
+         *
+         *  @note Workers start on the first read_row() call, so callbacks
+         *        may be registered after construction.
+         */
+        MultiReader(std::vector<std::string> _filenames,
+            CSVFormat _format = CSVFormat::guess_csv(),
+            size_t _n_threads = 0);
+
+        MultiReader(const MultiReader&) = delete;
+        MultiReader& operator=(const MultiReader&) = delete;
+        ~MultiReader();
+
+        /** Register a callback invoked (from a worker thread) after each
+         *  file has been fully parsed, with the filename and its row count
+         */
+        void on_file_complete(std::function<void(const std::string&, RowCount)> callback) {
+            this->file_callback = std::move(callback);
+        }
+
+        /** Retrieve the next row from the merged stream, blocking until one
+         *  is available or every file has been consumed
+         *
+         *  @return True if a row was retrieved, false upon end of input
+         *  @throws Any exception raised inside a worker's CSVReader
+         */
+        bool read_row(CSVRow& row);
+
+        /** Number of files fully parsed so far */
+        size_t files_completed() const { return this->n_complete.load(); }
+
+    private:
+        /** Rows a worker hands over per queue access */
+        static constexpr size_t WORKER_BATCH = 1024;
+
+        /** Merged rows held before workers are made to wait for the consumer */
+        static constexpr size_t QUEUE_CAPACITY = 65536;
+
+        void start();
+        void worker_main();
+        void finish_worker();
+
+        std::vector<std::string> filenames; /**< Work queue of shard files */
+        CSVFormat format;                   /**< Format shared by all files */
+
+        /** Per-file completion callback, if any */
+        std::function<void(const std::string&, RowCount)> file_callback;
+
+        std::atomic<size_t> next_file = { 0 };  /**< Next unclaimed file */
+        std::atomic<size_t> n_complete = { 0 }; /**< Files fully parsed */
+
+        std::deque<CSVRow> merged;     /**< Rows awaiting the consumer */
+        std::mutex lock;               /**< Guards merged and the fields below */
+        size_t active_workers = 0;     /**< Workers still producing rows */
+        bool shutting_down = false;    /**< Set by the destructor */
+        std::exception_ptr worker_error = nullptr; /**< First worker failure */
+
+        std::condition_variable rows_available;  /**< Signals the consumer */
+        std::condition_variable space_available; /**< Signals the workers */
+
+        std::vector<std::thread> pool; /**< The worker threads */
+        bool started = false;          /**< Whether the pool is running */
+    };
+}
+
+
+/** @file
+ *  Implements JSON serialization abilities
+ */
+
+#include <ostream>
+
+
+namespace csv {
+    /*
+    The escaping logic in this file was modified from source code for
+    JSON for Modern C++.
+
+    The respective license is below:
+
+    The code is licensed under the [MIT
+    License](http://opensource.org/licenses/MIT):
+
+    Copyright &copy; 2013-2015 Niels Lohmann.
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation files
+    (the "Software"), to deal in the Software without restriction,
+    including without limitation the rights to use, copy, modify, merge,
+    publish, distribute, sublicense, and/or sell copies of the Software,
+    and to permit persons to whom the Software is furnished to do so,
+    subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+    BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+    ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+    */
+
+    namespace internals {
+        /** Find the first character requiring JSON escaping (a quote, a
+         *  backslash, or a control character) at or after position i,
+         *  comparing 16-32 bytes at a time where vector instructions are
+         *  available
+         *
+         *  @return Index of the first such character, or s.size() if none remain
+         */
+        static size_t find_json_special(csv::string_view s, size_t i) noexcept {
+#if defined(CSV_HAS_AVX2)
+            const __m256i quote_v = _mm256_set1_epi8('"'),
+                backslash_v = _mm256_set1_epi8('\\'),
+                ctrl_max_v = _mm256_set1_epi8(0x1f);
+
+            for (; i + 32 <= s.size(); i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(s.data() + i));
+
+                // Unsigned c <= 0x1f test: min(c, 0x1f) == c
+                __m256i is_ctrl = _mm256_cmpeq_epi8(
+                    _mm256_min_epu8(chunk, ctrl_max_v), chunk);
+                __m256i special = _mm256_or_si256(is_ctrl, _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chunk, quote_v),
+                    _mm256_cmpeq_epi8(chunk, backslash_v)));
+
+                unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i quote_v = _mm_set1_epi8('"'),
+                backslash_v = _mm_set1_epi8('\\'),
+                ctrl_max_v = _mm_set1_epi8(0x1f);
+
+            for (; i + 16 <= s.size(); i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(s.data() + i));
+
+                // Unsigned c <= 0x1f test: min(c, 0x1f) == c
+                __m128i is_ctrl = _mm_cmpeq_epi8(
+                    _mm_min_epu8(chunk, ctrl_max_v), chunk);
+                __m128i special = _mm_or_si128(is_ctrl, _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, quote_v),
+                    _mm_cmpeq_epi8(chunk, backslash_v)));
+
+                unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+                if (mask) return i + first_set_bit(mask);
+            }
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < s.size(); i++) {
+                const unsigned char c = (unsigned char)s[i];
+                if (c <= 0x1f || c == '"' || c == '\\') break;
+            }
+
+            return i;
+        }
+
+        /** Append the JSON-escaped form of s to result. Runs of ordinary
+         *  characters — the overwhelmingly common case — are located with a
+         *  vectorized scan and appended in bulk.
+         */
+        CSV_INLINE void json_append_escaped(std::string& result, csv::string_view s) noexcept
+        {
+            size_t i = 0;
+            while (i < s.size()) {
+                const size_t j = find_json_special(s, i);
+                result.append(s.data() + i, j - i);
+                if (j == s.size()) return;
+
+                const char c = s[j];
+                switch (c)
+                {
+                // quotation mark (0x22)
+                case '"':
+                    result += "\\\"";
+                    break;
+
+                // reverse solidus (0x5c)
+                case '\\':
+                    result += "\\\\";
+                    break;
+
+                // backspace (0x08)
+                case '\b':
+                    result += "\\b";
+                    break;
+
+                // formfeed (0x0c)
+                case '\f':
+                    result += "\\f";
+                    break;
+
+                // newline (0x0a)
+                case '\n':
+                    result += "\\n";
+                    break;
+
+                // carriage return (0x0d)
+                case '\r':
+                    result += "\\r";
+                    break;
+
+                // horizontal tab (0x09)
+                case '\t':
+                    result += "\\t";
+                    break;
+
+                default:
+                {
+                    // print character c as \uxxxx
+                    char unicode[8];
+                    snprintf(unicode, sizeof(unicode), "\\u%04x", int(c));
+                    result += unicode;
+                    break;
+                }
+                }
+
+                i = j + 1;
+            }
+        }
+
+        CSV_INLINE std::string json_escape_string(csv::string_view s) noexcept
+        {
+            std::string result;
+            result.reserve(s.size());
+            json_append_escaped(result, s);
+            return result;
+        }
+    }
+
+    /** Convert a CSV row to a JSON object, i.e.
+     *  `{"col1":"value1","col2":"value2"}`
+     *
+     *  @note All strings are properly escaped. Numeric values are not quoted.
+     *  @param[in] subset A subset of columns to contain in the JSON.
+     *                    Leave empty for original columns.
+     */
+    CSV_INLINE std::string CSVRow::to_json(const std::vector<std::string>& subset) const {
+        std::string ret;
+        this->to_json_into(ret, subset);
+        return ret;
+    }
+
+    /** Append this row's JSON object representation to out.
+     *
+     *  Unlike to_json(), this reuses the caller's buffer, so tight export
+     *  loops can serialize millions of rows into one grow-once allocation.
+     *
+     *  @param[out] out    Buffer the JSON object is appended to
+     *  @param[in]  subset A subset of columns to contain in the JSON.
+     *                     Leave empty for original columns.
+     */
+    CSV_INLINE void CSVRow::to_json_into(std::string& out, const std::vector<std::string>& subset) const {
+        std::vector<std::string> col_names = subset;
+        if (subset.empty()) {
+            col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
+        }
+
+        const size_t _n_cols = col_names.size();
+        out += '{';
+
+        for (size_t i = 0; i < _n_cols; i++) {
+            auto& col = col_names[i];
+            auto field = this->operator[](col);
+
+            out += '"';
+            internals::json_append_escaped(out, col);
+            out += "\":";
+
+            // Add quotes around strings but not numbers
+            if (field.is_num()) {
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+            }
+            else {
+                out += '"';
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+                out += '"';
+            }
+
+            // Do not add comma after last string
+            if (i + 1 < _n_cols)
+                out += ',';
+        }
+
+        out += '}';
+    }
+
+    /** Convert a CSV row to a JSON array, i.e.
+     *  `["value1","value2",...]`
+     *
+     *  @note All strings are properly escaped. Numeric values are not quoted.
+     *  @param[in] subset A subset of columns to contain in the JSON.
+     *                    Leave empty for all columns.
+     */
+    CSV_INLINE std::string CSVRow::to_json_array(const std::vector<std::string>& subset) const {
+        std::string ret;
+        this->to_json_array_into(ret, subset);
+        return ret;
+    }
+
+    /** Append this row's JSON array representation to out.
+     *
+     *  @param[out] out    Buffer the JSON array is appended to
+     *  @param[in]  subset A subset of columns to contain in the JSON.
+     *                     Leave empty for all columns.
+     *  @see CSVRow::to_json_into()
+     */
+    CSV_INLINE void CSVRow::to_json_array_into(std::string& out, const std::vector<std::string>& subset) const {
+        std::vector<std::string> col_names = subset;
+        if (subset.empty())
+            col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
+
+        const size_t _n_cols = col_names.size();
+        out += '[';
+
+        for (size_t i = 0; i < _n_cols; i++) {
+            auto field = this->operator[](col_names[i]);
+
+            // Add quotes around strings but not numbers
+            if (field.is_num()) {
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+            }
+            else {
+                out += '"';
+                internals::json_append_escaped(out, field.get<csv::string_view>());
+                out += '"';
+            }
+
+            // Do not add comma after last string
+            if (i + 1 < _n_cols)
+                out += ',';
+        }
+
+        out += ']';
+    }
+
+    /** Export every remaining row of reader as JSON Lines.
+     *
+     *  Rows are serialized with CSVRow::to_json_into() into one reused
+     *  buffer which is flushed to out in large blocks, so export cost is
+     *  dominated by the (vectorized) escape scan rather than allocation.
+     *
+     *  @param[in]  reader The CSV source; consumed to end of file
+     *  @param[out] out    Stream receiving one JSON object per line
+     *
+     *  @return Number of rows written
+     */
+    CSV_INLINE RowCount to_jsonl(CSVReader& reader, std::ostream& out) {
+        constexpr size_t FLUSH_AT = 1048576; // 1MB
+
+        std::string buffer;
+        buffer.reserve(2 * FLUSH_AT);
+
+        RowCount written = 0;
+        CSVRow row;
+
+        while (reader.read_row(row)) {
+            row.to_json_into(buffer);
+            buffer += '\n';
+            written++;
+
+            if (buffer.size() >= FLUSH_AT) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+
+        out.write(buffer.data(), buffer.size());
+        return written;
+    }
+}
+
+/** @file
+ *  Defines the data type used for storing information about a CSV row
+ */
+
+#include <cassert>
+#include <functional>
+
+namespace csv {
+    /** Return a string view of the nth field
+     *
+     *  @complexity
+     *  Constant
+     *
+     *  @throws
+     *  std::runtime_error If n is out of bounds
+     */
+    CSV_INLINE csv::string_view CSVRow::get_string_view(size_t n) const {
+        csv::string_view ret(this->row_str());
+
+        // First assume that field comprises entire row, then adjust accordingly
+        size_t beg = 0,
+            end = this->row_str().size(),
+            r_size = this->size();
+
+        if (n >= r_size)
+            throw std::runtime_error("Index out of bounds.");
+
+        if (r_size > 1) {
+            if (n == 0) {
+                end = this->split_at(0);
+            }
+            else if (r_size == 2) {
+                beg = this->split_at(0);
+            }
+            else {
+                beg = this->split_at(n - 1);
+                if (n != r_size - 1) end = this->split_at(n);
+            }
+        }
+        
+        return ret.substr(
+            beg,
+            end - beg // Number of characters
+        );
+    }
+
+    /** Return a CSVField object corrsponding to the nth value in the row.
+     *
+     *  @note This method performs bounds checking, and will throw an
+     *        `std::runtime_error` if n is invalid.
+     *
+     *  @complexity
+     *  Constant, by calling csv::CSVRow::get_csv::string_view()
+     *
+     */
+    CSV_INLINE CSVField CSVRow::operator[](size_t n) const {
+        return CSVField(this->get_string_view(n),
+            this->buffer->col_names->get_type_hint(n));
+    }
+
+    /** Retrieve a value by its associated column name. If the column
+     *  specified can't be round, a runtime error is thrown.
+     *
+     *  @complexity
+     *  Constant. This calls the other CSVRow::operator[]() after
+     *  converting column names into indices using a hash table.
+     *
+     *  @param[in] col_name The column to look for
+     */
+    CSV_INLINE CSVField CSVRow::operator[](const std::string& col_name) const {
+        auto & col_names = this->buffer->col_names;
+        auto col_pos = col_names->index_of(col_name);
+        if (col_pos > -1) {
+            // A known column that a ragged row is too short to contain
+            // reads as a null field (see VariableColumnPolicy::KEEP)
+            if ((size_t)col_pos >= this->size())
+                return CSVField(csv::string_view());
+
+            return this->operator[](col_pos);
+        }
+
+        throw std::runtime_error("Can't find a column named " + col_name);
+    }
+
+    /** Retrieve a value by a pre-resolved column handle, skipping the
+     *  per-access hash lookup that name-based retrieval performs.
+     *
+     *  @note Bounds checking still applies; a handle created by a
+     *        different reader throws an `std::runtime_error`.
+     *
+     *  @complexity
+     *  Constant, with no string hashing.
+     *
+     *  @param[in] handle Handle obtained from CSVReader::column()
+     */
+    CSV_INLINE CSVField CSVRow::operator[](const ColumnHandle& handle) const {
+        if (!this->buffer || this->buffer->col_names != handle.owner) {
+            throw std::runtime_error("Column handle for " + handle.col_name
+                + " does not belong to this row's reader.");
+        }
+
+        // Matches name-based lookup: missing columns of ragged rows are null
+        if (handle.idx >= this->size())
+            return CSVField(csv::string_view());
+
+        return this->operator[](handle.idx);
+    }
+
+    CSV_INLINE CSVRow::operator std::vector<std::string>() const {
+
+        std::vector<std::string> ret;
+        for (size_t i = 0; i < size(); i++)
+            ret.push_back(std::string(this->get_string_view(i)));
+
+        return ret;
+    }
+
+#pragma region CSVRow Iterator
+    /** Return an iterator pointing to the first field. */
+    CSV_INLINE CSVRow::iterator CSVRow::begin() const {
+        return CSVRow::iterator(this, 0);
+    }
+
+    /** Return an iterator pointing to just after the end of the CSVRow.
+     *
+     *  @warning Attempting to dereference the end iterator results
+     *           in dereferencing a null pointer.
+     */
+    CSV_INLINE CSVRow::iterator CSVRow::end() const {
+        return CSVRow::iterator(this, (int)this->size());
+    }
+
+    CSV_INLINE CSVRow::reverse_iterator CSVRow::rbegin() const {
+        return std::reverse_iterator<CSVRow::iterator>(this->end());
+    }
+
+    CSV_INLINE CSVRow::reverse_iterator CSVRow::rend() const {
+        return std::reverse_iterator<CSVRow::iterator>(this->begin());
+    }
+
+    CSV_INLINE size_t CSVRow::split_at(size_t n) const
+    {
+        return this->buffer->split_buffer[this->data.col_pos.start + n];
+    }
+
+    CSV_INLINE HEDLEY_NON_NULL(2)
+    CSVRow::iterator::iterator(const CSVRow* _reader, int _i)
+        : daddy(_reader), i(_i) {
+        if (_i < (int)this->daddy->size())
+            this->field = this->daddy->operator[](_i);
+    }
+
+    CSV_INLINE CSVRow::iterator::reference CSVRow::iterator::operator*() const {
+        return this->field;
+    }
+
+    CSV_INLINE CSVRow::iterator::pointer CSVRow::iterator::operator->() const {
+        return &(this->field);
+    }
+
+    CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator++() {
+        // Pre-increment operator
+        this->i++;
+        if (this->i < (int)this->daddy->size())
+            this->field = this->daddy->operator[](i);
+        return *this;
+    }
+
+    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator++(int) {
+        // Post-increment operator
+        auto temp = *this;
+        this->operator++();
+        return temp;
+    }
+
+    CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator--() {
+        // Pre-decrement operator
+        this->i--;
+        this->field = this->daddy->operator[](this->i);
+        return *this;
+    }
+
+    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator--(int) {
+        // Post-decrement operator
+        auto temp = *this;
+        this->operator--();
+        return temp;
+    }
+    
+    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator+(difference_type n) const {
+        // Allows for iterator arithmetic
+        return CSVRow::iterator(this->daddy, i + (int)n);
+    }
+
+    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator-(difference_type n) const {
+        // Allows for iterator arithmetic
+        return CSVRow::iterator::operator+(-n);
+    }
+#pragma endregion CSVRow Iterator
+}
+
+/** @file
+ *  Calculates statistics from CSV files
+ */
+
+#include <algorithm>
+#include <cstring> // For std::memcpy()
+#include <mutex>
+#include <string>
+
+namespace csv {
+    namespace internals {
+        /** Numeric values per column buffered before a vectorized flush */
+        static const size_t STAT_BATCH_SIZE = 4096;
+
+        /** Sum, minimum, and maximum of a contiguous batch in one
+         *  vectorized pass
+         *
+         *  @pre n > 0
+         */
+        static void reduce_batch(const double* x, size_t n,
+            double& sum, double& min, double& max) {
+            sum = 0;
+            min = x[0];
+            max = x[0];
+
+            size_t i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            if (n >= 4) {
+                __m256d sum_v = _mm256_setzero_pd(),
+                        min_v = _mm256_loadu_pd(x),
+                        max_v = min_v;
+
+                for (; i + 4 <= n; i += 4) {
+                    __m256d chunk = _mm256_loadu_pd(x + i);
+                    sum_v = _mm256_add_pd(sum_v, chunk);
+                    min_v = _mm256_min_pd(min_v, chunk);
+                    max_v = _mm256_max_pd(max_v, chunk);
+                }
+
+                double lanes[4];
+                _mm256_storeu_pd(lanes, sum_v);
+                sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+                _mm256_storeu_pd(lanes, min_v);
+                min = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+
+                _mm256_storeu_pd(lanes, max_v);
+                max = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            }
+#elif defined(CSV_HAS_SSE2)
+            if (n >= 2) {
+                __m128d sum_v = _mm_setzero_pd(),
+                        min_v = _mm_loadu_pd(x),
+                        max_v = min_v;
+
+                for (; i + 2 <= n; i += 2) {
+                    __m128d chunk = _mm_loadu_pd(x + i);
+                    sum_v = _mm_add_pd(sum_v, chunk);
+                    min_v = _mm_min_pd(min_v, chunk);
+                    max_v = _mm_max_pd(max_v, chunk);
+                }
+
+                double lanes[2];
+                _mm_storeu_pd(lanes, sum_v);
+                sum = lanes[0] + lanes[1];
+
+                _mm_storeu_pd(lanes, min_v);
+                min = std::min(lanes[0], lanes[1]);
+
+                _mm_storeu_pd(lanes, max_v);
+                max = std::max(lanes[0], lanes[1]);
+            }
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < n; i++) {
+                sum += x[i];
+                if (x[i] < min) min = x[i];
+                if (x[i] > max) max = x[i];
+            }
+        }
+
+        /** Sum of squared deviations from a known mean, vectorized.
+         *  Part of the numerically stable two-pass variance: the batch
+         *  mean comes from reduce_batch() first.
+         */
+        static double sumsq_deviations(const double* x, size_t n, double mean) {
+            double sumsq = 0;
+            size_t i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            const __m256d mean_v4 = _mm256_set1_pd(mean);
+            __m256d sumsq_v4 = _mm256_setzero_pd();
+
+            for (; i + 4 <= n; i += 4) {
+                __m256d delta = _mm256_sub_pd(_mm256_loadu_pd(x + i), mean_v4);
+                sumsq_v4 = _mm256_add_pd(sumsq_v4, _mm256_mul_pd(delta, delta));
+            }
+
+            double lanes4[4];
+            _mm256_storeu_pd(lanes4, sumsq_v4);
+            sumsq = lanes4[0] + lanes4[1] + lanes4[2] + lanes4[3];
+#elif defined(CSV_HAS_SSE2)
+            const __m128d mean_v2 = _mm_set1_pd(mean);
+            __m128d sumsq_v2 = _mm_setzero_pd();
+
+            for (; i + 2 <= n; i += 2) {
+                __m128d delta = _mm_sub_pd(_mm_loadu_pd(x + i), mean_v2);
+                sumsq_v2 = _mm_add_pd(sumsq_v2, _mm_mul_pd(delta, delta));
+            }
+
+            double lanes2[2];
+            _mm_storeu_pd(lanes2, sumsq_v2);
+            sumsq = lanes2[0] + lanes2[1];
+#endif
+
+            for (; i < n; i++) {
+                const double delta = x[i] - mean;
+                sumsq += delta * delta;
+            }
+
+            return sumsq;
+        }
+
+        CSV_INLINE size_t FreqCounter::hash(csv::string_view value) {
+            // FNV-1a
+            size_t h = (size_t)14695981039346656037ULL;
+            for (char ch : value) {
+                h ^= (unsigned char)ch;
+                h *= (size_t)1099511628211ULL;
+            }
+            return h;
+        }
+
+        CSV_INLINE csv::string_view FreqCounter::copy_to_arena(csv::string_view value) {
+            if (this->arena.empty() || this->arena_used + value.size() > ARENA_BLOCK_SIZE) {
+                // Oversized values get a block of their own
+                this->arena.push_back(std::unique_ptr<char[]>(
+                    new char[std::max(value.size(), (size_t)ARENA_BLOCK_SIZE)]));
+                this->arena_used = 0;
+            }
+
+            char * dest = this->arena.back().get() + this->arena_used;
+            std::memcpy(dest, value.data(), value.size());
+            this->arena_used += value.size();
+
+            return csv::string_view(dest, value.size());
+        }
+
+        CSV_INLINE void FreqCounter::rehash(size_t new_capacity) {
+            // Keys point into the arena, not the old table, so they
+            // can simply be reinserted
+            std::vector<Entry> old_slots(new_capacity);
+            old_slots.swap(this->slots);
+
+            const size_t mask = this->slots.size() - 1;
+            for (auto& entry : old_slots) {
+                if (entry.count == 0) continue;
+
+                size_t pos = hash(entry.key) & mask;
+                while (this->slots[pos].count > 0)
+                    pos = (pos + 1) & mask;
+
+                this->slots[pos] = entry;
+            }
+        }
+
+        CSV_INLINE void FreqCounter::add(csv::string_view value, RowCount count) {
+            // Keep the load factor below 0.7
+            if ((this->n_entries + 1) * 10 >= this->slots.size() * 7)
+                this->rehash(this->slots.size() * 2);
+
+            const size_t mask = this->slots.size() - 1;
+            size_t pos = hash(value) & mask;
+
+            while (this->slots[pos].count > 0) {
+                if (this->slots[pos].key == value) {
+                    this->slots[pos].count += count;
+                    return;
+                }
+
+                pos = (pos + 1) & mask;
+            }
+
+            this->slots[pos].key = this->copy_to_arena(value);
+            this->slots[pos].count = count;
+            this->n_entries++;
+        }
+
+        CSV_INLINE void FreqCounter::merge(const FreqCounter& other) {
+            for (auto& entry : other.slots) {
+                if (entry.count > 0)
+                    this->add(entry.key, entry.count);
+            }
+        }
+
+        CSV_INLINE std::unordered_map<std::string, RowCount> FreqCounter::to_map() const {
+            std::unordered_map<std::string, RowCount> ret;
+            for (auto& entry : this->slots) {
+                if (entry.count > 0)
+                    ret[std::string(entry.key)] = entry.count;
+            }
+            return ret;
+        }
+
+        CSV_INLINE void QuantileSketch::add(long double x) {
+            this->buffer.push_back(x);
+            this->total_weight++;
+
+            if (this->buffer.size() >= BUFFER_LIMIT)
+                this->compress();
+        }
+
+        CSV_INLINE void QuantileSketch::merge(const QuantileSketch& other) {
+            other.compress();
+
+            for (auto& centroid : other.centroids)
+                this->centroids.push_back(centroid);
+
+            this->total_weight += other.total_weight;
+            this->compress();
+        }
+
+        CSV_INLINE void QuantileSketch::compress() const {
+            for (auto x : this->buffer)
+                this->centroids.push_back({ x, 1 });
+            this->buffer.clear();
+
+            if (this->centroids.empty()) return;
+
+            std::sort(this->centroids.begin(), this->centroids.end(),
+                [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+            // Merge adjacent centroids as long as the result stays under
+            // the t-digest size bound, which shrinks towards the tails
+            std::vector<Centroid> merged = { this->centroids.front() };
+            long double cumulative = 0;
+
+            for (size_t i = 1; i < this->centroids.size(); i++) {
+                auto& candidate = this->centroids[i];
+                auto& tail = merged.back();
+
+                long double proposed = tail.weight + candidate.weight;
+                long double q = (cumulative + proposed / 2) / this->total_weight;
+                long double limit = 4 * this->total_weight * q * (1 - q) / COMPRESSION;
+
+                if (proposed <= limit) {
+                    tail.mean = (tail.mean * tail.weight + candidate.mean * candidate.weight) / proposed;
+                    tail.weight = proposed;
+                }
+                else {
+                    cumulative += tail.weight;
+                    merged.push_back(candidate);
+                }
+            }
+
+            this->centroids = std::move(merged);
+        }
+
+        CSV_INLINE long double QuantileSketch::quantile(double q) const {
+            this->compress();
+
+            if (this->centroids.empty()) return NAN;
+            if (q < 0) q = 0;
+            if (q > 1) q = 1;
+
+            // Walk the cumulative weight to the target, interpolating
+            // linearly between neighboring centroid midpoints
+            const long double target = (long double)q * this->total_weight;
+            long double cumulative = 0;
+            long double prev_mid = 0;
+            long double prev_mean = this->centroids.front().mean;
+
+            for (size_t i = 0; i < this->centroids.size(); i++) {
+                auto& centroid = this->centroids[i];
+                long double mid = cumulative + centroid.weight / 2;
+
+                if (mid >= target) {
+                    if (i == 0 || mid == prev_mid) return centroid.mean;
+                    return prev_mean + (centroid.mean - prev_mean) * (target - prev_mid) / (mid - prev_mid);
+                }
+
+                cumulative += centroid.weight;
+                prev_mid = mid;
+                prev_mean = centroid.mean;
+            }
+
+            return this->centroids.back().mean;
+        }
+
+        CSV_INLINE unsigned long long CardinalitySketch::hash(csv::string_view value) {
+            // FNV-1a followed by a finalizer to improve avalanche behavior
+            unsigned long long h = 14695981039346656037ULL;
+            for (char ch : value) {
+                h ^= (unsigned char)ch;
+                h *= 1099511628211ULL;
+            }
+
+            h ^= h >> 30;
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 27;
+            h *= 0x94d049bb133111ebULL;
+            h ^= h >> 31;
+            return h;
+        }
+
+        CSV_INLINE void CardinalitySketch::add(csv::string_view value) {
+            unsigned long long h = hash(value);
+
+            // The top PRECISION bits pick a register; the position of the
+            // first set bit among the rest is the register's rank
+            size_t idx = (size_t)(h >> (64 - PRECISION));
+
+            unsigned long long bits = (h << PRECISION) | (1ULL << (PRECISION - 1));
+            unsigned char rank = 1;
+            while ((bits & 0x8000000000000000ULL) == 0) {
+                rank++;
+                bits <<= 1;
+            }
+
+            if (rank > this->registers[idx])
+                this->registers[idx] = rank;
+        }
+
+        CSV_INLINE void CardinalitySketch::merge(const CardinalitySketch& other) {
+            for (size_t i = 0; i < this->registers.size(); i++) {
+                if (other.registers[i] > this->registers[i])
+                    this->registers[i] = other.registers[i];
+            }
+        }
+
+        CSV_INLINE RowCount CardinalitySketch::estimate() const {
+            const size_t m = this->registers.size();
+
+            long double sum = 0;
+            size_t zeros = 0;
+            for (auto r : this->registers) {
+                sum += powl(2.0L, -(long double)r);
+                if (r == 0) zeros++;
+            }
+
+            long double alpha = 0.7213L / (1 + 1.079L / m);
+            long double raw = alpha * m * m / sum;
+
+            // Small range correction: fall back to linear counting
+            if (raw <= 2.5L * m && zeros > 0)
+                raw = m * logl((long double)m / zeros);
+
+            return (RowCount)(raw + 0.5L);
+        }
+
+        CSV_INLINE void HeavyHitterSketch::add(csv::string_view value, RowCount count) {
+            std::string key = std::string(value);
+
+            auto it = this->items.find(key);
+            if (it != this->items.end()) {
+                it->second += count;
+                return;
+            }
+
+            if (this->items.size() < this->capacity) {
+                this->items[std::move(key)] = count;
+                return;
+            }
+
+            // Space-saving: replace the smallest entry, inheriting its
+            // count as the new entry's error bound
+            auto min_it = this->items.begin();
+            for (auto curr = this->items.begin(); curr != this->items.end(); ++curr) {
+                if (curr->second < min_it->second)
+                    min_it = curr;
+            }
+
+            RowCount inherited = min_it->second;
+            this->items.erase(min_it);
+            this->items[std::move(key)] = inherited + count;
+        }
+
+        CSV_INLINE void HeavyHitterSketch::merge(const HeavyHitterSketch& other) {
+            for (auto& item : other.items)
+                this->items[item.first] += item.second;
+
+            this->trim();
+        }
+
+        CSV_INLINE void HeavyHitterSketch::trim() {
+            while (this->items.size() > this->capacity) {
+                auto min_it = this->items.begin();
+                for (auto curr = this->items.begin(); curr != this->items.end(); ++curr) {
+                    if (curr->second < min_it->second)
+                        min_it = curr;
+                }
+
+                this->items.erase(min_it);
+            }
+        }
+
+        CSV_INLINE std::unordered_map<std::string, RowCount> HeavyHitterSketch::to_map() const {
+            return this->items;
+        }
+    }
+
+    CSV_INLINE CSVStat::CSVStat(csv::string_view filename, CSVFormat format, StatsMode mode) :
+        CSVReader(filename, format), mode(mode) {
+        /** Lazily calculate statistics for a potentially large file. Once this constructor
+         *  is called, CSVStat will process the entire file iteratively. Once finished,
+         *  methods like get_mean(), get_counts(), etc... can be used to retrieve statistics.
+         */
+        while (!this->eof()) {
+            this->read_csv(internals::ITERATION_CHUNK_SIZE);
+            this->calc();
+        }
+
+        if (!this->records.empty())
+            this->calc();
+    }
+
+    CSV_INLINE void CSVStat::end_feed() {
+        CSVReader::end_feed();
+        this->calc();
+    }
+
+    /** Return current means */
+    CSV_INLINE std::vector<long double> CSVStat::get_mean() const {
+        std::vector<long double> ret;        
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->rolling_means[i]);
+        }
+        return ret;
+    }
+
+    /** Return current variances */
+    CSV_INLINE std::vector<long double> CSVStat::get_variance() const {
+        std::vector<long double> ret;        
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->rolling_vars[i]/(this->n[i] - 1));
+        }
+        return ret;
+    }
+
+    /** Return current mins */
+    CSV_INLINE std::vector<long double> CSVStat::get_mins() const {
+        std::vector<long double> ret;        
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->mins[i]);
+        }
+        return ret;
+    }
+
+    /** Return current maxes */
+    CSV_INLINE std::vector<long double> CSVStat::get_maxes() const {
+        std::vector<long double> ret;        
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->maxes[i]);
+        }
+        return ret;
+    }
+
+    /** Get counts for each column */
+    CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_counts() const {
+        std::vector<FreqCount> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->counts[i].to_map());
+        }
+        return ret;
+    }
+
+    /** Get data type counts for each column */
+    CSV_INLINE std::vector<CSVStat::TypeCount> CSVStat::get_dtypes() const {
+        std::vector<TypeCount> ret;        
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->dtypes[i]);
+        }
+        return ret;
+    }
+
+    /** Estimate the q-th quantile of each column via t-digest sketches
+     *
+     *  @param[in] q Quantile to estimate, between 0 and 1
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<long double> CSVStat::get_quantile(double q) const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<long double> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->quantile_sketches[i].quantile(q));
+        }
+        return ret;
+    }
+
+    /** Estimate the number of distinct values in each column via HyperLogLog
+     *
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<RowCount> CSVStat::get_cardinality() const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<RowCount> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->cardinality_sketches[i].estimate());
+        }
+        return ret;
+    }
+
+    /** Get the most frequent values of each column via space-saving sketches.
+     *  Counts are upper bounds on the true frequencies.
+     *
+     *  @throws std::runtime_error If StatsMode::APPROXIMATE was not requested
+     */
+    CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_top_values() const {
+        if (this->mode != StatsMode::APPROXIMATE)
+            throw std::runtime_error("Approximate statistics were not enabled for this CSVStat.");
+
+        std::vector<FreqCount> ret;
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            ret.push_back(this->top_value_sketches[i].to_map());
+        }
+        return ret;
+    }
+
+    CSV_INLINE void CSVStat::calc() {
+        /** Go through all records and calculate specified statistics */
+        while (this->rolling_means.size() < this->col_names->size()) {
+            dtypes.push_back({});
+            counts.push_back({});
+            rolling_means.push_back(0);
+            rolling_vars.push_back(0);
+            mins.push_back(NAN);
+            maxes.push_back(NAN);
+            n.push_back(0);
+
+            if (this->mode == StatsMode::APPROXIMATE) {
+                quantile_sketches.push_back({});
+                cardinality_sketches.push_back({});
+                top_value_sketches.push_back({});
+            }
+        }
+
+        // Shard rows across threads; each shard computes partial aggregates
+        // for every column, which are merged once all threads have finished
+        size_t n_threads = (size_t)std::thread::hardware_concurrency();
+        if (n_threads == 0) n_threads = 1;
+        n_threads = std::min(n_threads, std::max<size_t>(this->records.size() / 1000, 1));
+
+        const size_t shard_size = this->records.size() / n_threads;
+
+        std::vector<std::vector<ColumnStats>> partials;
+        for (size_t t = 0; t < n_threads; t++)
+            partials.emplace_back(this->col_names->size());
+
+        std::vector<std::thread> pool;
+
+        // Exceptions can't propagate out of worker threads directly,
+        // so the first one is captured and rethrown after the join
+        std::exception_ptr worker_error = nullptr;
+        std::mutex error_lock;
+
+        // Start threads
+        for (size_t t = 0; t < n_threads; t++) {
+            auto begin = this->records.begin() + (std::ptrdiff_t)(t * shard_size);
+            auto end = (t + 1 == n_threads) ? this->records.end()
+                : begin + (std::ptrdiff_t)shard_size;
+
+            pool.push_back(std::thread([this, begin, end, t, &partials, &worker_error, &error_lock] {
+                try {
+                    this->calc_shard(begin, end, partials[t]);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(error_lock);
+                    if (!worker_error) worker_error = std::current_exception();
+                }
+            }));
+        }
+
+        // Block until done
+        for (auto& th: pool)
+            th.join();
+
+        if (worker_error)
+            std::rethrow_exception(worker_error);
+
+        for (auto& partial : partials)
+            this->merge_stats(partial);
+
+        this->records.clear();
+    }
+
+    CSV_INLINE void CSVStat::calc_shard(
+        internals::RecordRing::iterator begin,
+        internals::RecordRing::iterator end,
+        std::vector<ColumnStats>& stats) {
+        /** Worker thread for CSVStat::calc() which computes partial statistics
+         *  for every column over a contiguous range of rows
+         *
+         *  @param[in]  begin Iterator to the first row in this shard
+         *  @param[in]  end   Iterator past the last row in this shard
+         *  @param[out] stats Partial aggregates, one entry per column
+         */
+        const size_t _n_cols = this->col_names->size();
+
+        size_t processed = 0;
+        for (auto it = begin; it != end; ++it, processed++) {
+            if (it->size() == _n_cols) {
+                for (size_t i = 0; i < _n_cols; i++) {
+                    auto current_field = (*it)[i];
+                    auto& col = stats[i];
+
+                    if (this->mode == StatsMode::APPROXIMATE) {
+                        auto sv = current_field.get<csv::string_view>();
+                        col.cardinality.add(sv);
+                        col.top_values.add(sv);
+                    }
+                    // Optimization: Don't count if there's too many distinct values in the first 1000 rows
+                    else if (processed < 1000 || col.counts.size() <= 500) {
+                        col.counts.add(current_field.get<csv::string_view>());
+                    }
+
+                    col.dtypes[current_field.type()]++;
+
+                    // Numeric Stuff
+                    if (current_field.is_num()) {
+                        long double x_n = current_field.get<long double>();
+
+                        if (this->mode == StatsMode::APPROXIMATE)
+                            col.quantiles.add(x_n);
+
+                        // Buffer the value; mean/variance/min/max are
+                        // computed over whole batches by flush_numeric()
+                        col.pending.push_back((double)x_n);
+                        if (col.pending.size() >= internals::STAT_BATCH_SIZE)
+                            flush_numeric(col);
+                    }
+                }
+            }
+            else if (this->format.get_variable_column_policy() == VariableColumnPolicy::THROW) {
+                throw std::runtime_error("Line has different length than the others " + internals::format_row(*it));
+            }
+        }
+
+        for (auto& col : stats)
+            flush_numeric(col);
+    }
+
+    CSV_INLINE void CSVStat::flush_numeric(ColumnStats& col) {
+        /** Fold a column's buffered numeric values into its partial
+         *  aggregates. The batch's sum, minimum, maximum, and sum of
+         *  squared deviations are each computed by a vectorized kernel
+         *  over the contiguous buffer, then combined with the running
+         *  aggregates using the same parallel Welford form (Chan et al.)
+         *  that merge_stats() uses across shards.
+         */
+        const size_t batch_n = col.pending.size();
+        if (batch_n == 0) return;
+
+        double sum, batch_min, batch_max;
+        internals::reduce_batch(col.pending.data(), batch_n, sum, batch_min, batch_max);
+
+        const double batch_mean = sum / (double)batch_n;
+        const double batch_m2 = internals::sumsq_deviations(
+            col.pending.data(), batch_n, batch_mean);
+
+        if (col.n == 0) {
+            col.mean = batch_mean;
+            col.m2 = batch_m2;
+        }
+        else {
+            long double combined_n = col.n + (long double)batch_n;
+            long double delta = (long double)batch_mean - col.mean;
+
+            col.m2 += batch_m2 + delta * delta * (col.n * (long double)batch_n / combined_n);
+            col.mean += delta * ((long double)batch_n / combined_n);
+        }
+
+        col.n += (long double)batch_n;
+
+        if (isnan(col.min) || batch_min < col.min)
+            col.min = batch_min;
+        if (isnan(col.max) || batch_max > col.max)
+            col.max = batch_max;
+
+        col.pending.clear();
+    }
+
+    CSV_INLINE void CSVStat::merge_stats(std::vector<ColumnStats>& partial) {
+        /** Fold one shard's partial aggregates into the rolling totals,
+         *  combining means and variances with the parallel form of
+         *  Welford's Algorithm (Chan et al.)
+         *
+         *  @param[in] partial Aggregates computed by one calc_shard() call
+         */
+        for (size_t i = 0; i < this->col_names->size(); i++) {
+            auto& col = partial[i];
+
+            this->counts[i].merge(col.counts);
+
+            if (this->mode == StatsMode::APPROXIMATE) {
+                this->quantile_sketches[i].merge(col.quantiles);
+                this->cardinality_sketches[i].merge(col.cardinality);
+                this->top_value_sketches[i].merge(col.top_values);
+            }
+
+            for (auto& item : col.dtypes)
+                this->dtypes[i][item.first] += item.second;
+
+            if (col.n > 0) {
+                long double& current_n = this->n[i];
+
+                if (current_n == 0) {
+                    this->rolling_means[i] = col.mean;
+                    this->rolling_vars[i] = col.m2;
+                }
+                else {
+                    long double combined_n = current_n + col.n;
+                    long double delta = col.mean - this->rolling_means[i];
+
+                    this->rolling_vars[i] += col.m2 +
+                        delta * delta * (current_n * col.n / combined_n);
+                    this->rolling_means[i] += delta * (col.n / combined_n);
+                }
+
+                current_n += col.n;
+
+                if (isnan(this->mins[i]) || (!isnan(col.min) && col.min < this->mins[i]))
+                    this->mins[i] = col.min;
+                if (isnan(this->maxes[i]) || (!isnan(col.max) && col.max > this->maxes[i]))
+                    this->maxes[i] = col.max;
+            }
+        }
+    }
+
+    /** Useful for uploading CSV files to SQL databases.
+     *
+     *  Return a data type for each column such that every value in a column can be
+     *  converted to the corresponding data type without data loss.
+     *  @param[in]  filename The CSV file
+     *
+     *  \return A mapping of column names to csv::DataType enums
+     */
+    CSV_INLINE std::unordered_map<std::string, DataType> csv_data_types(const std::string& filename) {
+        CSVStat stat(filename);
+        std::unordered_map<std::string, DataType> csv_dtypes;
+
+        auto col_names = stat.get_col_names();
+        auto temp = stat.get_dtypes();
+
+        for (size_t i = 0; i < stat.get_col_names().size(); i++) {
+            auto& col = temp[i];
+            auto& col_name = col_names[i];
+
+            if (col[CSV_STRING])
+                csv_dtypes[col_name] = CSV_STRING;
+            else if (col[CSV_INT64])
+                csv_dtypes[col_name] = CSV_INT64;
+            else if (col[CSV_INT32])
+                csv_dtypes[col_name] = CSV_INT32;
+            else if (col[CSV_INT16])
+                csv_dtypes[col_name] = CSV_INT16;
+            else if (col[CSV_INT8])
+                csv_dtypes[col_name] = CSV_INT8;
+            else
+                csv_dtypes[col_name] = CSV_DOUBLE;
+        }
+
+        return csv_dtypes;
+    }
+}
+/** @file
+ *  Defines an object which can store CSV data in
+ *  continuous regions of memory
+ */
+
+
+namespace csv {
+    namespace internals {
+        //////////////
+        // ColNames //
+        //////////////
+        CSV_INLINE std::vector<std::string> ColNames::get_col_names() const {
+            return this->col_names;
+        }
+
+        CSV_INLINE void ColNames::set_col_names(const std::vector<std::string>& cnames) {
+            this->col_names = cnames;
+
+            for (size_t i = 0; i < cnames.size(); i++) {
+                this->col_pos[cnames[i]] = i;
+            }
+        }
+
+        CSV_INLINE int ColNames::index_of(csv::string_view col_name) const {
+            auto pos = this->col_pos.find(col_name.data());
+            if (pos != this->col_pos.end())
+                return (int)pos->second;
+
+            return CSV_NOT_FOUND;
+        }
+
+        CSV_INLINE size_t ColNames::size() const {
+            return this->col_names.size();
+        }
+
+        CSV_INLINE RowData RawRowBuffer::get_row() {
+            RowData row = {
+                this->get_row_string(),
+                this->get_splits()
+            };
+
+            // A row with text but no recorded splits holds one field — a
+            // single-column CSV, or a projection keeping one column — and
+            // is distinct from a blank row, which has no text at all
+            if (row.col_pos.n_cols == 0 && row.row_str.second > 0)
+                row.col_pos.n_cols = 1;
+
+            return row;
+        }
+
+        /** Get the current row in the buffer
+         *  @note Has the side effect of updating the current end pointer
+         */
+        CSV_INLINE std::pair<size_t, size_t> RawRowBuffer::get_row_string() {
+            auto ret = std::make_pair(
+                this->current_end, // Beginning of string
+                (this->buffer.size() - this->current_end) // Count
+            );
+
+            this->current_end = this->buffer.size();
+            return ret;
+        }
+
+        CSV_INLINE ColumnPositions RawRowBuffer::get_splits()
+        {
+            const size_t head_idx = this->current_split_idx,
+                new_split_idx = this->split_buffer.size();
+            StrBufferPos n_cols = (new_split_idx - head_idx > 0) ?
+                (StrBufferPos)(new_split_idx - head_idx + 1): 0;
+
+            this->current_split_idx = new_split_idx;
+            return ColumnPositions(head_idx, n_cols);
+        }
+
+        CSV_INLINE size_t RawRowBuffer::size() const {
+            return this->buffer.size() - this->current_end;
+        }
+
+        CSV_INLINE size_t RawRowBuffer::splits_size() const {
+            return this->split_buffer.size() - this->current_split_idx;
+        }
+
+        CSV_INLINE void RawRowBuffer::get_current_row(std::vector<csv::string_view>& fields) const {
+            fields.clear();
+
+            // Split positions are offsets from the start of the current row
+            const char* row_start = this->buffer.data() + this->current_end;
+            size_t start = 0;
+            for (size_t i = this->current_split_idx; i < this->split_buffer.size(); i++) {
+                fields.push_back(csv::string_view(
+                    row_start + start, this->split_buffer[i] - start));
+                start = this->split_buffer[i];
+            }
+
+            fields.push_back(csv::string_view(row_start + start, this->size() - start));
+        }
+
+        CSV_INLINE void RawRowBuffer::discard_row() {
+            this->buffer.resize(this->current_end);
+            this->split_buffer.resize(this->current_split_idx);
+        }
+        
+        CSV_INLINE void RawRowBuffer::clear() {
+            this->buffer.clear();
+            this->split_buffer.clear();
+            this->current_end = 0;
+            this->current_split_idx = 0;
+        }
+
+        CSV_INLINE BufferPtr BufferPool::lease(const ColNamesPtr& col_names) {
+            for (auto& buff : this->pool) {
+                // use_count() == 1 --> every CSVRow referencing this buffer is gone,
+                // so its storage may be reused
+                if (buff.use_count() == 1) {
+                    buff->clear();
+                    buff->col_names = col_names;
+                    return buff;
+                }
+            }
+
+            auto fresh = BufferPtr(new RawRowBuffer(col_names));
+            if (this->pool.size() < MAX_POOLED_BUFFERS) {
+                this->pool.push_back(fresh);
+            }
+
+            return fresh;
+        }
+
+        HEDLEY_WARN_UNUSED_RESULT CSV_INLINE
+        BufferPtr RawRowBuffer::reset(BufferPool* pool) const {
+            // Save current row in progress
+            auto new_buff = pool ?
+                pool->lease(this->col_names) : BufferPtr(new RawRowBuffer());
+
+            // Save text. assign() reuses any capacity new_buff already holds.
+            new_buff->buffer.assign(
+                this->buffer,
+                this->current_end,   // Position
+                (this->buffer.size() - this->current_end) // Count
+            );
+
+            // Save split buffer in progress
+            for (size_t i = this->current_split_idx; i < this->split_buffer.size(); i++) {
+                new_buff->split_buffer.push_back(this->split_buffer[i]);
+            }
+
+            new_buff->col_names = this->col_names;
+
+            // No need to remove unnecessary bits from this buffer
+            // (memory savings would be marginal anyways)
+            return new_buff;
+        }
+    }
+}
+/** @file
+ *  Defines a binary columnar cache that eliminates parsing cost on
+ *  repeat reads of the same CSV file
+ */
+
+#include <cstring> // For std::memcmp()
+#include <fstream>
+#include <limits>
+
+#include <sys/stat.h> // For is_fresh()
+
+
+namespace csv {
+    namespace internals {
+        /** Magic bytes identifying a columnar cache sidecar file */
+        static const char CACHE_MAGIC[8] = { 'C', 'S', 'V', 'C', 'C', 'H', '0', '2' };
+
+        /** Retrieve a source file's size and mtime for freshness checks */
+        static bool stat_source(csv::string_view filename,
+            unsigned long long& size, unsigned long long& mtime) {
+            struct stat st;
+            if (stat(std::string(filename).c_str(), &st) != 0) {
+                return false;
+            }
+
+            size = (unsigned long long)st.st_size;
+            mtime = (unsigned long long)st.st_mtime;
+            return true;
+        }
+    }
+
+    CSV_INLINE CSVCache CSVCache::build(csv::string_view filename, CSVFormat format) {
+        CSVCache cache;
+        if (!internals::stat_source(filename, cache.source_size, cache.source_mtime)) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        CSVReader reader(filename, format);
+        // Caches hold retained reference data, where interning repeated
+        // values pays off both in memory and in sidecar size
+        reader.set_dictionary_encoding(true);
+        reader.read_batch(cache.batch, std::numeric_limits<size_t>::max());
+        return cache;
+    }
+
+    CSV_INLINE void CSVCache::save(csv::string_view cache_path) const {
+        std::ofstream out(cache_path.data(), std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(cache_path));
+        }
+
+        auto write_u64 = [&out](unsigned long long value) {
+            out.write((const char*)&value, sizeof(value));
+        };
+
+        out.write(internals::CACHE_MAGIC, sizeof(internals::CACHE_MAGIC));
+        write_u64(this->source_size);
+        write_u64(this->source_mtime);
+        write_u64((unsigned long long)this->batch.n_rows);
+
+        write_u64((unsigned long long)this->batch.col_names.size());
+        for (auto& name : this->batch.col_names) {
+            write_u64((unsigned long long)name.size());
+            out.write(name.data(), name.size());
+        }
+
+        for (auto& col : this->batch.columns) {
+            out.put((char)col.type);
+
+            switch (col.type) {
+            case CSV_INT64:
+                out.write((const char*)col.ints.data(),
+                    col.ints.size() * sizeof(long long));
+                break;
+            case CSV_DOUBLE:
+                out.write((const char*)col.doubles.data(),
+                    col.doubles.size() * sizeof(double));
+                break;
+            default:
+                write_u64((unsigned long long)col.chars.size());
+                out.write(col.chars.data(), col.chars.size());
+                write_u64((unsigned long long)col.offsets.size());
+                out.write((const char*)col.offsets.data(),
+                    col.offsets.size() * sizeof(size_t));
+                write_u64((unsigned long long)col.codes.size());
+                out.write((const char*)col.codes.data(),
+                    col.codes.size() * sizeof(int));
+                break;
+            }
+        }
+    }
+
+    CSV_INLINE CSVCache CSVCache::load(csv::string_view cache_path) {
+        std::ifstream in(cache_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(cache_path));
+        }
+
+        auto read_u64 = [&in]() {
+            unsigned long long value = 0;
+            in.read((char*)&value, sizeof(value));
+            return value;
+        };
+
+        char magic[sizeof(internals::CACHE_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::CACHE_MAGIC, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a CSV cache file " + std::string(cache_path));
+        }
+
+        CSVCache cache;
+        cache.source_size = read_u64();
+        cache.source_mtime = read_u64();
+        cache.batch.n_rows = (size_t)read_u64();
+
+        const size_t n_names = (size_t)read_u64();
+        for (size_t i = 0; i < n_names; i++) {
+            std::string name((size_t)read_u64(), '\0');
+            in.read(&name[0], name.size());
+            cache.batch.col_names.push_back(std::move(name));
+        }
+
+        // Each column is at most three bulk reads straight into its arrays
+        cache.batch.columns.resize(n_names);
+        for (auto& col : cache.batch.columns) {
+            col.type = (DataType)in.get();
+
+            switch (col.type) {
+            case CSV_INT64:
+                col.ints.resize(cache.batch.n_rows);
+                in.read((char*)col.ints.data(),
+                    col.ints.size() * sizeof(long long));
+                break;
+            case CSV_DOUBLE:
+                col.doubles.resize(cache.batch.n_rows);
+                in.read((char*)col.doubles.data(),
+                    col.doubles.size() * sizeof(double));
+                break;
+            default:
+                col.chars.resize((size_t)read_u64());
+                in.read(&col.chars[0], col.chars.size());
+                col.offsets.resize((size_t)read_u64());
+                in.read((char*)col.offsets.data(),
+                    col.offsets.size() * sizeof(size_t));
+                col.codes.resize((size_t)read_u64());
+                in.read((char*)col.codes.data(),
+                    col.codes.size() * sizeof(int));
+                break;
+            }
+        }
+
+        if (!in) {
+            throw std::runtime_error("Truncated CSV cache file " + std::string(cache_path));
+        }
+
+        return cache;
+    }
+
+    CSV_INLINE bool CSVCache::is_fresh(csv::string_view filename, csv::string_view cache_path) {
+        unsigned long long size = 0, mtime = 0;
+        if (!internals::stat_source(filename, size, mtime)) {
+            return false;
+        }
+
+        std::ifstream in(cache_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+
+        char magic[sizeof(internals::CACHE_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::CACHE_MAGIC, sizeof(magic)) != 0) {
+            return false;
+        }
+
+        unsigned long long stored_size = 0, stored_mtime = 0;
+        in.read((char*)&stored_size, sizeof(stored_size));
+        in.read((char*)&stored_mtime, sizeof(stored_mtime));
+
+        return in && stored_size == size && stored_mtime == mtime;
+    }
+
+    CSV_INLINE CSVCache CSVCache::open(csv::string_view filename, CSVFormat format) {
+        const auto cache_path = default_cache_path(filename);
+
+        if (is_fresh(filename, cache_path)) {
+            return load(cache_path);
+        }
+
+        auto cache = build(filename, format);
+        cache.save(cache_path);
+        return cache;
+    }
+}
+
+/** @file
+ *  Defines an object used to store CSV format settings
+ */
+
+#include <algorithm>
+#include <set>
+
+
+namespace csv {
+    CSV_INLINE CSVFormat& CSVFormat::delimiter(char delim) {
+        this->possible_delimiters = { delim };
+        this->assert_no_char_overlap();
+        return *this;
+    }
+
+    CSV_INLINE CSVFormat& CSVFormat::delimiter(const std::vector<char> & delim) {
+        this->possible_delimiters = delim;
+        this->assert_no_char_overlap();
+        return *this;
+    }
+
+    CSV_INLINE CSVFormat& CSVFormat::quote(char quote) {
+        this->no_quote = false;
+        this->quote_char = quote;
+        this->assert_no_char_overlap();
+        return *this;
+    }
+
+    CSV_INLINE CSVFormat& CSVFormat::trim(const std::vector<char> & chars) {
+        this->trim_chars = chars;
+        this->assert_no_char_overlap();
+        return *this;
+    }
+
+    CSV_INLINE CSVFormat& CSVFormat::column_names(const std::vector<std::string>& names) {
+        this->col_names = names;
+        this->header = -1;
+        return *this;
+    }
+
+    CSV_INLINE CSVFormat& CSVFormat::header_row(int row) {
+        this->header = row;
+        this->col_names = {};
+        return *this;
+    }
+
+    CSV_INLINE void CSVFormat::assert_no_char_overlap()
+    {
+        auto delims = std::set<char>(
+            this->possible_delimiters.begin(), this->possible_delimiters.end()),
+            trims = std::set<char>(
+                this->trim_chars.begin(), this->trim_chars.end());
+
+        // Stores intersection of possible delimiters and trim characters
+        std::vector<char> intersection = {};
+
+        // Find which characters overlap, if any
+        std::set_intersection(
+            delims.begin(), delims.end(),
+            trims.begin(), trims.end(),
+            std::back_inserter(intersection));
+
+        // Make sure quote character is not contained in possible delimiters
+        // or whitespace characters
+        if (delims.find(this->quote_char) != delims.end() ||
+            trims.find(this->quote_char) != trims.end()) {
+            intersection.push_back(this->quote_char);
+        }
+
+        if (!intersection.empty()) {
+            std::string err_msg = "There should be no overlap between the quote character, "
+                "the set of possible delimiters "
+                "and the set of whitespace characters. Offending characters: ";
+
+            // Create a pretty error message with the list of overlapping
+            // characters
+            for (size_t i = 0; i < intersection.size(); i++) {
+                err_msg += "'";
+                err_msg += intersection[i];
+                err_msg += "'";
+
+                if (i + 1 < intersection.size())
+                    err_msg += ", ";
+            }
+
+            throw std::runtime_error(err_msg + '.');
+        }
+    }
+}
+/** @file
+ *  Defines an input iterator for csv::CSVReader
+ */
+
+
+namespace csv {
+    /** Return an iterator to the first row in the reader */
+    CSV_INLINE CSVReader::iterator CSVReader::begin() {
+        if (this->records.empty()) {
+            this->fill_records();
+        }
+
+        CSVReader::iterator ret(this, std::move(this->records.front()));
+        this->records.pop_front();
+        return ret;
+    }
+
+    /** A placeholder for the imaginary past the end row in a CSV.
+     *  Attempting to deference this will lead to bad things.
+     */
+    CSV_INLINE HEDLEY_CONST CSVReader::iterator CSVReader::end() const {
+        return CSVReader::iterator();
+    }
+
+    /////////////////////////
+    // CSVReader::iterator //
+    /////////////////////////
+
+    CSV_INLINE CSVReader::iterator::iterator(CSVReader* _daddy, CSVRow&& _row) :
+        daddy(_daddy) {
+        row = std::move(_row);
+    }
+
+    /** Advance the iterator by one row. If this CSVReader has an
+     *  associated file, then the iterator will lazily pull more data from
+     *  that file until EOF.
+     */
+    CSV_INLINE CSVReader::iterator& CSVReader::iterator::operator++() {
+        if (!daddy->read_row(this->row)) {
+            this->daddy = nullptr; // this == end()
+        }
+
+        return *this;
+    }
+
+    /** Post-increment iterator */
+    CSV_INLINE CSVReader::iterator CSVReader::iterator::operator++(int) {
+        auto temp = *this;
+        if (!daddy->read_row(this->row)) {
+            this->daddy = nullptr; // this == end()
+        }
+
+        return temp;
+    }
+}
+/** @file
+ *  Defines a persistent row-offset index enabling fast random access
+ *  into large CSV files
+ */
+
+#include <cstring> // For std::memcmp()
+#include <deque>
+#include <fstream>
+
+
+namespace csv {
+    namespace internals {
+        /** Magic bytes identifying an index sidecar file */
+        static const char INDEX_MAGIC[8] = { 'C', 'S', 'V', 'I', 'D', 'X', '0', '1' };
+    }
+
+    CSV_INLINE CSVIndex CSVIndex::build(csv::string_view filename, CSVFormat format, size_t stride) {
+        using internals::ParseFlags;
+
+        CSVIndex index;
+        index.stride = stride > 0 ? stride : DEFAULT_STRIDE;
+
+        /** Guess delimiter and header row */
+        if (format.guess_delim()) {
+            auto guess_result = guess_format(filename, format.get_possible_delims());
+            format.delimiter(guess_result.delim).header_row(guess_result.header_row);
+        }
+
+        index.delim = format.get_delim();
+        index.quote = format.get_quote_char();
+        index.no_quote = !format.is_quoting_enabled();
+        index.col_names = csv::get_col_names(filename, format);
+
+        auto parse_flags = index.no_quote
+            ? internals::make_parse_flags(index.delim)
+            : internals::make_parse_flags(index.delim, index.quote);
+
+        std::ifstream infile(filename.data(), std::ios::binary);
+        if (!infile.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        constexpr size_t BLOCK = 65536;
+        std::unique_ptr<char[]> block(new char[BLOCK]);
+
+        // Rows before (and including) the header are not data rows
+        const RowCount skip = (RowCount)format.get_header() + 1;
+
+        bool quote_escape = false;
+        bool at_row_start = true;     /*< Next byte begins a new row */
+        bool row_has_content = false; /*< Current row contains at least one byte */
+        RowCount rows_started = 0;    /*< Physical rows begun so far */
+        unsigned long long offset = 0;
+        unsigned long long row_start_offset = 0;
+        ParseFlags prev_flag = ParseFlags::NEWLINE;
+
+        // Checkpoints and n_rows must count rows identically, or get_row()'s
+        // numbering drifts: a checkpoint is recorded only once a row turns
+        // out to be a data row — past the header and non-blank — so blank
+        // physical lines never shift the mapping
+        auto count_data_row = [&]() {
+            if (rows_started - 1 - skip >= 0 && row_has_content) {
+                if (index.n_rows % (RowCount)index.stride == 0) {
+                    index.offsets.push_back(row_start_offset);
+                }
+
+                index.n_rows++;
+            }
+        };
+
+        size_t leftover = 0;
+        while (true) {
+            infile.read(block.get() + leftover, BLOCK - leftover);
+            const size_t len = leftover + (size_t)infile.gcount();
+            if (len == 0) break;
+
+            // Unless this is the final block, hold one byte back so the
+            // quote state machine always has its lookahead character
+            const bool last_block = infile.eof();
+            const size_t limit = last_block ? len : len - 1;
+
+            size_t i = 0;
+            for (; i < limit; i++) {
+                const char ch = block[i];
+
+                if (at_row_start) {
+                    row_start_offset = offset;
+                    rows_started++;
+                    at_row_start = false;
+                    row_has_content = false;
+                }
+
+                switch (parse_flags[ch + 128]) {
+                case ParseFlags::QUOTE:
+                    if (!quote_escape) {
+                        // Mirrors parse(): only a quote following a delimiter
+                        // or newline opens a quoted field
+                        if (prev_flag >= ParseFlags::DELIMITER) {
+                            quote_escape = true;
+                        }
+                    }
+                    else if (i + 1 < len) {
+                        auto next_ch = parse_flags[block[i + 1] + 128];
+                        if (next_ch >= ParseFlags::DELIMITER) {
+                            quote_escape = false;
+                        }
+                        else if (next_ch == ParseFlags::QUOTE) {
+                            i++; // Case: Two consecutive quotes
+                            offset++;
+                        }
+                    }
+                    else {
+                        // End of file closes the field
+                        quote_escape = false;
+                    }
+
+                    row_has_content = true;
+                    break;
+                case ParseFlags::NEWLINE:
+                    if (!quote_escape) {
+                        // End of record; catches CRLF (or LFLF) like parse()
+                        if (i + 1 < len && block[i + 1] == '\n') {
+                            i++;
+                            offset++;
+                        }
+
+                        // The current row's index is rows_started - 1
+                        count_data_row();
+
+                        at_row_start = true;
+                    }
+                    else {
+                        row_has_content = true;
+                    }
+
+                    break;
+                default:
+                    row_has_content = true;
+                    break;
+                }
+
+                prev_flag = parse_flags[block[i] + 128];
+                offset++;
+            }
+
+            // Carry the lookahead byte into the next block
+            leftover = len - i;
+            if (leftover > 0) block[0] = block[i];
+            if (last_block) break;
+        }
+
+        // A final row without a trailing newline still counts
+        if (!at_row_start) {
+            count_data_row();
+        }
+
+        return index;
+    }
+
+    CSV_INLINE void CSVIndex::save(csv::string_view index_path) const {
+        std::ofstream out(index_path.data(), std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(index_path));
+        }
+
+        auto write_u64 = [&out](unsigned long long value) {
+            out.write((const char*)&value, sizeof(value));
+        };
+
+        out.write(internals::INDEX_MAGIC, sizeof(internals::INDEX_MAGIC));
+        write_u64((unsigned long long)this->stride);
+        write_u64((unsigned long long)this->n_rows);
+        out.put(this->delim);
+        out.put(this->quote);
+        out.put(this->no_quote ? 1 : 0);
+
+        write_u64((unsigned long long)this->col_names.size());
+        for (auto& name : this->col_names) {
+            write_u64((unsigned long long)name.size());
+            out.write(name.data(), name.size());
+        }
+
+        write_u64((unsigned long long)this->offsets.size());
+        for (auto checkpoint : this->offsets) {
+            write_u64(checkpoint);
+        }
+    }
+
+    CSV_INLINE CSVIndex CSVIndex::load(csv::string_view index_path) {
+        std::ifstream in(index_path.data(), std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(index_path));
+        }
+
+        auto read_u64 = [&in]() {
+            unsigned long long value = 0;
+            in.read((char*)&value, sizeof(value));
+            return value;
+        };
+
+        char magic[sizeof(internals::INDEX_MAGIC)] = {};
+        in.read(magic, sizeof(magic));
+        if (!in || std::memcmp(magic, internals::INDEX_MAGIC, sizeof(magic)) != 0) {
+            throw std::runtime_error("Not a CSV index file " + std::string(index_path));
+        }
+
+        CSVIndex index;
+        index.stride = (size_t)read_u64();
+        index.n_rows = (RowCount)read_u64();
+        index.delim = (char)in.get();
+        index.quote = (char)in.get();
+        index.no_quote = in.get() != 0;
+
+        const size_t n_names = (size_t)read_u64();
+        for (size_t i = 0; i < n_names; i++) {
+            std::string name((size_t)read_u64(), '\0');
+            in.read(&name[0], name.size());
+            index.col_names.push_back(std::move(name));
+        }
+
+        const size_t n_checkpoints = (size_t)read_u64();
+        for (size_t i = 0; i < n_checkpoints; i++) {
+            index.offsets.push_back(read_u64());
+        }
+
+        if (!in) {
+            throw std::runtime_error("Truncated CSV index file " + std::string(index_path));
+        }
+
+        return index;
+    }
+
+    CSV_INLINE CSVRow CSVIndex::get_row(csv::string_view filename, RowCount n) const {
+        if (n < 0 || n >= this->n_rows) {
+            throw std::runtime_error("Row index out of bounds.");
+        }
+
+        const size_t checkpoint = (size_t)(n / (RowCount)this->stride);
+        const size_t to_skip = (size_t)(n % (RowCount)this->stride);
+
+        std::ifstream infile(filename.data(), std::ios::binary);
+        if (!infile.is_open()) {
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+        }
+
+        infile.seekg((std::streamoff)this->offsets[checkpoint]);
+
+        // Resume parsing from the checkpoint: by construction, checkpoints
+        // are row boundaries outside of any quoted field
+        auto parse_flags = this->no_quote
+            ? internals::make_parse_flags(this->delim)
+            : internals::make_parse_flags(this->delim, this->quote);
+        auto ws_flags = internals::make_ws_flags({}, 0);
+
+        auto col_names_ptr = std::make_shared<internals::ColNames>(this->col_names);
+        auto buffer = internals::BufferPtr(new internals::RawRowBuffer(col_names_ptr));
+
+        bool quote_escape = false;
+        internals::RecordRing rows;
+
+        constexpr size_t BLOCK = 65536;
+        std::unique_ptr<char[]> block(new char[BLOCK]);
+
+        // Blank physical lines parse into zero-field records, but build()
+        // excludes them from the index's numbering; skip them here the
+        // same way so row n means the same row in both
+        auto is_blank = [](const CSVRow& row) {
+            return row.size() == 0;
+        };
+
+        auto content_rows = [&rows, &is_blank]() {
+            size_t n = 0;
+            for (size_t i = 0; i < rows.size(); i++) {
+                if (!is_blank(rows[i])) n++;
+            }
+
+            return n;
+        };
+
+        while (content_rows() <= to_skip && infile) {
+            infile.read(block.get(), BLOCK);
+            const size_t len = (size_t)infile.gcount();
+            if (len == 0) break;
+
+            buffer = internals::parse({
+                csv::string_view(block.get(), len),
+                parse_flags,
+                ws_flags,
+                buffer,
+                quote_escape,
+                rows
+            });
+        }
+
+        // Handle a final row without a trailing newline
+        if (content_rows() <= to_skip && buffer->size() > 0) {
+            rows.push_back(CSVRow(buffer));
+        }
+
+        size_t seen = 0;
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (is_blank(rows[i])) continue;
+            if (seen == to_skip) return rows[i];
+            seen++;
+        }
+
+        throw std::runtime_error("Row index out of bounds.");
+    }
+}
+
+#include <cstdio>   // For concat()
+#include <cstring>  // For memchr()
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace csv {
+    namespace internals {
+        /** Number of set bits in a 32-bit mask */
+        HEDLEY_CONST static inline size_t bit_count(unsigned int mask) {
+#if defined(_MSC_VER)
+            return (size_t)__popcnt(mask);
+#else
+            return (size_t)__builtin_popcount(mask);
+#endif
+        }
+
+        /** Count occurrences of '\n', vectorized where possible */
+        static size_t count_newlines(const char* data, size_t n) {
+            size_t count = 0,
+                   i = 0;
+
+#if defined(CSV_HAS_AVX2)
+            const __m256i lf_v = _mm256_set1_epi8('\n');
+
+            for (; i + 32 <= n; i += 32) {
+                __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+                count += bit_count(
+                    (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, lf_v)));
+            }
+#elif defined(CSV_HAS_SSE2)
+            const __m128i lf_v = _mm_set1_epi8('\n');
+
+            for (; i + 16 <= n; i += 16) {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+                count += bit_count(
+                    (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, lf_v)));
+            }
+#endif
+
+            // Scalar tail (and fallback when vector instructions are unavailable)
+            for (; i < n; i++) {
+                count += data[i] == '\n';
+            }
+
+            return count;
+        }
+
+        /** Per-block result of the parallel newline counter
+         *
+         *  Blocks are tallied independently, so whether a block begins
+         *  inside a quoted field is unknown while it is being scanned.
+         *  Both outcomes are recorded: `outside` holds the newlines at even
+         *  quote parity (the right answer if the block starts outside a
+         *  quoted field), and `total - outside` covers the opposite case.
+         *  The caller picks one as it folds blocks together in file order,
+         *  flipping its carried parity whenever a block held an odd number
+         *  of quotes.
+         */
+        struct NewlineTally {
+            size_t total = 0;      /*< All newlines in the block */
+            size_t outside = 0;    /*< Newlines at even quote parity */
+            bool odd_quotes = false;
+        };
+
+        /** Tally a block's newlines, split by quote parity. Runs of
+         *  ordinary bytes between quotes are counted vectorized; only the
+         *  (rare) quote characters themselves are handled one at a time.
+         */
+        static NewlineTally tally_newlines(csv::string_view block, char quote) {
+            NewlineTally tally;
+            bool outside = true;
+
+            size_t pos = 0;
+            while (pos < block.size()) {
+                auto* next_quote = (const char*)std::memchr(
+                    block.data() + pos, quote, block.size() - pos);
+                const size_t segment_end = next_quote
+                    ? (size_t)(next_quote - block.data())
+                    : block.size();
+
+                const size_t n = count_newlines(block.data() + pos, segment_end - pos);
+                tally.total += n;
+                if (outside) tally.outside += n;
+
+                if (!next_quote) break;
+
+                outside = !outside;
+                tally.odd_quotes = !tally.odd_quotes;
+                pos = segment_end + 1;
+            }
+
+            return tally;
+        }
+
+        /** Append a field to out, quoting it only if it contains the
+         *  delimiter, a quote, or a line break (runtime counterpart of
+         *  csv_escape() for when the delimiter is not known statically)
+         */
+        static void write_escaped(std::string& out, csv::string_view field, char delim) {
+            const char specials[5] = { delim, '"', '\n', '\r', '\0' };
+
+            if (field.find_first_of(specials) == csv::string_view::npos) {
+                out.append(field.data(), field.size());
+                return;
+            }
+
+            out += '"';
+            for (size_t i = 0; i < field.size(); i++) {
+                if (field[i] == '"') out += '"';
+                out += field[i];
+            }
+            out += '"';
+        }
+
+        /** Byte offset of the first data row, one past the header row's
+         *  newline within the (cached) file head
+         */
+        static size_t data_start_offset(csv::string_view head, int header_row) {
+            size_t offset = 0;
+            for (int newlines = 0;
+                offset < head.size() && newlines <= header_row;
+                offset++) {
+                if (head[offset] == '\n') newlines++;
+            }
+
+            return offset;
+        }
+
+        /** Copy a file's bytes from offset to EOF into out, using zero-copy
+         *  kernel splicing where the platform provides it
+         *
+         *  @return Number of bytes copied
+         */
+        static size_t splice_bytes(std::FILE* out, const std::string& filename, size_t offset) {
+            size_t copied = 0;
+
+#if defined(__linux__) && defined(__GLIBC__) && __GLIBC_PREREQ(2, 27)
+            // copy_file_range() moves bytes inside the kernel without
+            // bouncing them through a user-space buffer
+            int in_fd = ::open(filename.c_str(), O_RDONLY);
+            if (in_fd != -1) {
+                std::fflush(out);
+                off_t in_pos = (off_t)offset;
+                bool usable = true;
+
+                while (usable) {
+                    ssize_t n = copy_file_range(in_fd, &in_pos, fileno(out), nullptr,
+                        (size_t)1 << 30, 0);
+                    if (n > 0) {
+                        copied += (size_t)n;
+                    }
+                    else if (n == 0) {
+                        ::close(in_fd);
+                        return copied;
+                    }
+                    else {
+                        // Unsupported filesystem pairing: fall through to
+                        // the buffered loop for the remainder
+                        usable = false;
+                        offset += copied;
+                    }
+                }
+
+                ::close(in_fd);
+            }
+#endif
+
+            std::ifstream infile(filename, std::ios::binary);
+            if (!infile.is_open())
+                throw std::runtime_error("Cannot open file " + filename);
+
+            infile.seekg((std::streamoff)offset, std::ios::beg);
+
+            std::vector<char> block((size_t)1 << 22); // 4 MB
+            while (infile) {
+                infile.read(block.data(), (std::streamsize)block.size());
+                const size_t n_read = (size_t)infile.gcount();
+                if (n_read == 0) break;
+
+                std::fwrite(block.data(), 1, n_read, out);
+                copied += n_read;
+            }
+
+            return copied;
+        }
+
+        /** Whether a file's final byte is a line terminator */
+        static bool ends_with_newline(const std::string& filename) {
+            std::ifstream infile(filename, std::ios::binary);
+            infile.seekg(0, std::ios::end);
+
+            if (infile.tellg() <= 0) return true;
+
+            infile.seekg(-1, std::ios::end);
+            const char last = (char)infile.get();
+            return last == '\n' || last == '\r';
+        }
+    }
+
+    /** Shorthand function for parsing an in-memory CSV string,
+     *  a collection of CSVRow objects
+     *
+     *  @snippet tests/test_read_csv.cpp Parse Example
+     */
+    CSV_INLINE CSVReader parse(csv::string_view in, CSVFormat format) {
+        CSVReader parser(format);
+        parser.feed(in);
+        parser.end_feed();
+        return parser;
+    }
+
+    /** Parse a RFC 4180 CSV string, returning a collection
+     *  of CSVRow objects
+     *
+     *  @par Example
+     *  @snippet tests/test_read_csv.cpp Escaped Comma
+     *
+     */
+    CSV_INLINE CSVReader operator ""_csv(const char* in, size_t n) {
+        return parse(csv::string_view(in, n));
+    }
+
+    /**
+     *  Find the position of a column in a CSV file or CSV_NOT_FOUND otherwise
+     *
+     *  @param[in] filename  Path to CSV file
+     *  @param[in] col_name  Column whose position we should resolve
+     *  @param[in] format    Format of the CSV file
+     */
+    CSV_INLINE int get_col_pos(
+        const std::string filename,
+        const std::string col_name,
+        const CSVFormat format) {
+        CSVReader reader(filename, format);
+        return reader.index_of(col_name);
+    }
+
+    /** Count the data-carrying newlines in a file at close to memory
+     *  bandwidth, without parsing it
+     *
+     *  Blocks of the file are scanned concurrently with a vectorized
+     *  newline counter; newlines embedded in quoted fields are excluded by
+     *  a per-block quote-parity scan, with parity carried across blocks as
+     *  their tallies are folded together in file order. A final row with no
+     *  trailing newline is counted.
+     *
+     *  @note Unlike a full parse, this counts every record terminator: rows
+     *        that a reader would drop (e.g. ragged rows under the default
+     *        variable column policy) and blank lines are all included.
+     *
+     *  @param[in] filename  Path to the CSV file
+     *  @param[in] n_threads Worker count, or 0 for one per hardware thread
+     */
+    CSV_INLINE RowCount count_rows(const std::string& filename, size_t n_threads) {
+        if (n_threads == 0) {
+            n_threads = (size_t)std::thread::hardware_concurrency();
+            if (n_threads == 0) n_threads = 4;
+        }
+
+        std::ifstream infile(filename, std::ios::binary);
+        if (!infile.is_open())
+            throw std::runtime_error("Cannot open file " + filename);
+
+        constexpr size_t BLOCK_SIZE = (size_t)1 << 22; // 4 MB
+
+        std::deque<std::future<internals::NewlineTally>> pending;
+        RowCount terminators = 0;
+        bool outside = true;
+        char last_char = '\n';
+
+        // Tallies must be folded in file order, since each block's quote
+        // parity determines how the next one is interpreted
+        auto fold_one = [&]() {
+            auto tally = pending.front().get();
+            pending.pop_front();
+
+            terminators += (RowCount)(outside
+                ? tally.outside
+                : tally.total - tally.outside);
+
+            if (tally.odd_quotes)
+                outside = !outside;
+        };
+
+        while (true) {
+            auto block = std::make_shared<std::vector<char>>(BLOCK_SIZE);
+            infile.read(block->data(), (std::streamsize)BLOCK_SIZE);
+
+            const size_t n_read = (size_t)infile.gcount();
+            if (n_read == 0) break;
+
+            last_char = (*block)[n_read - 1];
+
+            pending.push_back(std::async(std::launch::async, [block, n_read] {
+                return internals::tally_newlines(
+                    csv::string_view(block->data(), n_read), '"');
+            }));
+
+            // Bound the number of blocks in flight
+            if (pending.size() >= n_threads)
+                fold_one();
+        }
+
+        while (!pending.empty())
+            fold_one();
+
+        // A final row without a trailing newline still counts
+        if (last_char != '\n' && last_char != '\r')
+            terminators++;
+
+        return terminators;
+    }
+
+    /** Concatenate CSV shards sharing a header into one output file
+     *
+     *  Each input's column names are read from its (cached) head and must
+     *  match the first input's exactly. One header row is written, then
+     *  each shard's post-header bytes are spliced into the output without
+     *  parsing — using zero-copy kernel copies where the platform provides
+     *  them — so merging byte-identical shards runs at I/O speed. Shards
+     *  whose delimiter differs from the first input's, or which are
+     *  compressed, are transparently re-parsed and re-quoted instead.
+     *
+     *  @param[in] output Path of the merged file, overwritten if present
+     *  @param[in] inputs Shard files, in the order their rows should appear
+     *
+     *  @return Number of bytes written to the output
+     *  @throws std::runtime_error if an input's column names differ from
+     *          the first input's
+     */
+    CSV_INLINE size_t concat(const std::string& output, const std::vector<std::string>& inputs) {
+        std::FILE* out = std::fopen(output.c_str(), "wb");
+        if (!out)
+            throw std::runtime_error("Cannot open file " + output);
+
+        size_t written = 0;
+        std::vector<std::string> ref_names;
+        char ref_delim = ',';
+
+        try {
+            for (size_t k = 0; k < inputs.size(); k++) {
+                const auto& filename = inputs[k];
+                const Compression compression = internals::detect_compression(filename);
+
+                auto head = compression == Compression::NONE
+                    ? internals::get_csv_head(filename)
+                    : internals::get_compressed_head(filename, compression);
+                auto guess = internals::_guess_format(head);
+
+                CSVFormat format;
+                format.delimiter(guess.delim).header_row(guess.header_row);
+                auto col_names = internals::_get_col_names(head, format);
+
+                if (k == 0) {
+                    ref_names = col_names;
+                    ref_delim = guess.delim;
+
+                    // One header row covers the whole output
+                    std::string header;
+                    for (size_t i = 0; i < ref_names.size(); i++) {
+                        internals::write_escaped(header, ref_names[i], ref_delim);
+                        if (i + 1 < ref_names.size()) header += ref_delim;
+                    }
+                    header += '\n';
+
+                    std::fwrite(header.data(), 1, header.size(), out);
+                    written += header.size();
+                }
+                else if (col_names != ref_names) {
+                    throw std::runtime_error("Cannot concatenate " + filename +
+                        ": its column names differ from " + inputs.front());
+                }
+
+                // Byte-identical shards are spliced without parsing
+                if (compression == Compression::NONE && guess.delim == ref_delim) {
+                    const size_t data_start =
+                        internals::data_start_offset(head, guess.header_row);
+                    written += internals::splice_bytes(out, filename, data_start);
+
+                    // Keep the next shard's first row on its own line
+                    if (!internals::ends_with_newline(filename)) {
+                        std::fputc('\n', out);
+                        written++;
+                    }
+                }
+                else {
+                    // Formats differ: re-parse this shard and re-quote its
+                    // rows with the output's delimiter
+                    CSVReader reader(filename);
+                    CSVRow row;
+                    std::string buffer;
+
+                    while (reader.read_row(row)) {
+                        for (size_t i = 0; i < row.size(); i++) {
+                            internals::write_escaped(buffer, row.get_string_view(i), ref_delim);
+                            if (i + 1 < row.size()) buffer += ref_delim;
+                        }
+                        buffer += '\n';
+
+                        if (buffer.size() >= 1048576) {
+                            std::fwrite(buffer.data(), 1, buffer.size(), out);
+                            written += buffer.size();
+                            buffer.clear();
+                        }
+                    }
+
+                    std::fwrite(buffer.data(), 1, buffer.size(), out);
+                    written += buffer.size();
+                }
+            }
+        }
+        catch (...) {
+            std::fclose(out);
+            throw;
+        }
+
+        std::fclose(out);
+        return written;
+    }
+
+    /** Get basic information about a CSV file
+     *  @include programs/csv_info.cpp
+     */
+    CSV_INLINE CSVFileInfo get_file_info(const std::string& filename) {
+        CSVReader reader(filename);
+        CSVFormat format = reader.get_format();
+
+        // Rows are counted with the parallel newline counter rather than by
+        // parsing the whole file; everything up to and including the header
+        // row is excluded from the count
+        RowCount n_rows = count_rows(filename) - (RowCount)format.get_header() - 1;
+        if (n_rows < 0) n_rows = 0;
+
+        CSVFileInfo info = {
+            filename,
+            reader.get_col_names(),
+            format.get_delim(),
+            n_rows,
+            (int)reader.get_col_names().size()
+        };
+
+        return info;
+    }
+
+    /** Profile a CSV file by sampling blocks spread across it
+     *
+     *  Unlike get_file_info(), this never reads the whole file: the format
+     *  and column names come from the (cached) file head, per-column types
+     *  are tallied over `n_blocks` blocks of `block_size` bytes spaced
+     *  evenly through the data, and the row count is extrapolated from rows
+     *  per sampled byte. Runtime is therefore independent of file size.
+     *
+     *  Sampled blocks rarely begin on a row boundary: parsing resumes at the
+     *  first newline in each block, and any row whose field count does not
+     *  match the header — a partial row at either edge of the block, or a
+     *  misparse caused by landing inside a quoted field — is discarded.
+     */
+    CSV_INLINE CSVFileProfile profile_csv(const std::string& filename,
+        size_t n_blocks, size_t block_size) {
+        auto head = internals::get_csv_head(filename);
+        auto guess = internals::_guess_format(head);
+
+        CSVFormat format;
+        format.delimiter(guess.delim).header_row(guess.header_row);
+
+        auto col_names = internals::_get_col_names(head, format);
+        const size_t n_cols = col_names.size();
+
+        CSVFileProfile profile = {
+            filename,
+            col_names,
+            format.get_delim(),
+            (int)n_cols,
+            0,
+            0,
+            std::vector<DataType>(n_cols, CSV_NULL),
+            std::vector<std::vector<size_t>>(n_cols,
+                std::vector<size_t>((size_t)CSV_DOUBLE + 1, 0))
+        };
+
+        std::ifstream infile(filename, std::ios::binary);
+        if (!infile.is_open())
+            throw std::runtime_error("Cannot open file " + filename);
+
+        infile.seekg(0, std::ios::end);
+        const size_t file_size = (size_t)infile.tellg();
+
+        // Data rows begin one past the header row's newline
+        size_t data_start = 0;
+        for (int newlines = 0;
+            data_start < head.size() && newlines <= guess.header_row;
+            data_start++) {
+            if (head[data_start] == '\n') newlines++;
+        }
+
+        const size_t span = file_size > data_start ? file_size - data_start : 0;
+        if (span == 0) return profile;
+
+        // When the sample would cover the whole file anyway, read it in one
+        // block starting at the known row boundary
+        if (n_blocks == 0) n_blocks = 1;
+        if (block_size * n_blocks >= span) {
+            n_blocks = 1;
+            block_size = span;
+        }
+
+        // Sampled blocks have no header of their own
+        CSVFormat block_format = format;
+        block_format.column_names(col_names);
+
+        std::vector<char> block(block_size);
+        size_t bytes_sampled = 0;
+
+        const size_t stride = span / n_blocks;
+        for (size_t k = 0; k < n_blocks; k++) {
+            infile.clear();
+            infile.seekg((std::streamoff)(data_start + k * stride), std::ios::beg);
+            infile.read(block.data(), (std::streamsize)block_size);
+
+            const size_t n_read = (size_t)infile.gcount();
+            if (n_read == 0) continue;
+
+            csv::string_view view(block.data(), n_read);
+
+            // Resynchronize onto a row boundary, except at data_start
+            // where the boundary is already known
+            if (k > 0) {
+                const size_t newline = view.find('\n');
+                if (newline == csv::string_view::npos) continue;
+
+                view.remove_prefix(newline + 1);
+            }
+
+            bytes_sampled += view.size();
+
+            // The last row of each block is dropped below: the block almost
+            // certainly ends mid-row
+            auto rows = parse(view, block_format);
+            CSVRow prev;
+            bool has_prev = false;
+
+            for (auto& row : rows) {
+                if (has_prev && prev.size() == n_cols) {
+                    for (size_t i = 0; i < n_cols; i++)
+                        profile.type_counts[i][(size_t)prev[i].type()]++;
+
+                    profile.n_rows_sampled++;
+                }
+
+                prev = std::move(row);
+                has_prev = true;
+            }
+        }
+
+        if (bytes_sampled > 0) {
+            profile.n_rows_estimate = (RowCount)(
+                (double)profile.n_rows_sampled * (double)span / (double)bytes_sampled + 0.5);
+        }
+
+        // Reduce each column's distribution to its widest observed type
+        for (size_t i = 0; i < n_cols; i++) {
+            auto& counts = profile.type_counts[i];
+
+            if (counts[CSV_STRING] > 0) {
+                profile.types[i] = CSV_STRING;
+            }
+            else if (counts[CSV_DOUBLE] > 0) {
+                profile.types[i] = CSV_DOUBLE;
+            }
+            else {
+                for (size_t t = CSV_INT8; t <= CSV_INT64; t++) {
+                    if (counts[t] > 0) profile.types[i] = (DataType)t;
+                }
+            }
+        }
+
+        return profile;
+    }
+}
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sys/stat.h> // For get_csv_head()'s staleness check
+
+namespace csv {
+    namespace internals {
+        CSV_INLINE GuessScore calculate_score(csv::string_view head, CSVFormat format) {
+            // Frequency counter of row length
+            std::unordered_map<size_t, size_t> row_tally = { { 0, 0 } };
+
+            // Map row lengths to row num where they first occurred
+            std::unordered_map<size_t, size_t> row_when = { { 0, 0 } };
+
+            // Parse the CSV
+            auto buffer_ptr = internals::BufferPtr(new internals::RawRowBuffer());
+            internals::RecordRing rows;
+            bool quote_escape = false;
+
+            internals::parse({
+                head,
+                internals::make_parse_flags(format.get_delim(), '"'),
+                internals::make_ws_flags({}, 0),
+                buffer_ptr,
+                quote_escape,
+                rows
+            });
+
+            for (size_t i = 0; i < rows.size(); i++) {
+                auto& row = rows[i];
+
+                // Ignore zero-length rows
+                if (row.size() > 0) {
+                    if (row_tally.find(row.size()) != row_tally.end()) {
+                        row_tally[row.size()]++;
+                    }
+                    else {
+                        row_tally[row.size()] = 1;
+                        row_when[row.size()] = i;
+                    }
+                }
+            }
+
+            // Most common numbers of columns
+            auto max = std::max_element(row_tally.begin(), row_tally.end(),
+                [](const std::pair<size_t, size_t>& x,
+                    const std::pair<size_t, size_t>& y) {
+                        return x.second < y.second; });
+
+            return {
+                (double)(max->first * max->second),
+                row_when[max->first]
+            };
+        }
+
+        /** Guess the delimiter used by a delimiter-separated values file */
+        CSV_INLINE CSVGuessResult _guess_format(csv::string_view head, const std::vector<char>& delims) {
+            /** For each delimiter, find out which row length was most common.
+             *  The delimiter with the longest mode row length wins.
+             *  Then, the line number of the header row is the first row with
+             *  the mode row length.
+             *
+             *  All candidates are scored simultaneously in one scan of the
+             *  head: each runs a small state machine mirroring parse()'s
+             *  quote handling, so the head is touched once instead of once
+             *  per candidate.
+             */
+            struct Candidate {
+                char delim;
+                size_t n_fields = 0;      /*< Delimiters seen in the current row */
+                size_t n_rows = 0;        /*< Rows terminated so far */
+                bool quote_escape = false;
+                bool skip_char = false;   /*< Consume the next character blindly */
+                bool prev_special = false; /*< Previous character was a delimiter or newline */
+                std::unordered_map<size_t, size_t> row_tally;
+                std::unordered_map<size_t, size_t> row_when;
+            };
 
-        /** Multi-threaded Reading State, including synchronization objects that cannot be moved. */
-        struct ThreadedReadingState {
-            std::deque<WorkItem> feed_buffer;    /**< Message queue for worker */
-            std::mutex feed_lock;                /**< Allow only one worker to write */
-            std::condition_variable feed_cond;   /**< Wake up worker */
-        };
+            std::vector<Candidate> candidates;
+            for (char cand_delim : delims) {
+                candidates.push_back({});
+                candidates.back().delim = cand_delim;
+            }
 
-        /** Open a file for reading. Implementation is compiler specific. */
-        void fopen(csv::string_view filename);
+            const size_t n = head.size();
+            for (size_t i = 0; i < n; i++) {
+                const char ch = head[i];
 
-        /** Sets this reader's column names and associated data */
-        void set_col_names(const std::vector<std::string>&);
+                for (auto& cand : candidates) {
+                    if (cand.skip_char) {
+                        cand.skip_char = false;
+                        continue;
+                    }
 
-        /** Returns true if we have reached end of file */
-        bool eof() { return !(this->infile); };
+                    if (cand.quote_escape) {
+                        if (ch == '"' && i + 1 < n) {
+                            const char next_ch = head[i + 1];
+                            if (next_ch == cand.delim || next_ch == '\r' || next_ch == '\n')
+                                cand.quote_escape = false;
+                            else if (next_ch == '"')
+                                cand.skip_char = true; // Two consecutive quotes
+                        }
 
-        /** @name CSV Settings **/
-        ///@{
-        CSVFormat format;
+                        continue;
+                    }
 
-        /** An array where the (i + 128)th slot gives the ParseFlags for ASCII character i */
-        internals::ParseFlagMap parse_flags;
+                    if (ch == cand.delim) {
+                        cand.n_fields++;
+                        cand.prev_special = true;
+                    }
+                    else if (ch == '\r' || ch == '\n') {
+                        // End of record; catches CRLF (or LFLF) like parse()
+                        const size_t row_len = cand.n_fields + 1;
+                        if (cand.row_tally.find(row_len) != cand.row_tally.end()) {
+                            cand.row_tally[row_len]++;
+                        }
+                        else {
+                            cand.row_tally[row_len] = 1;
+                            cand.row_when[row_len] = cand.n_rows;
+                        }
 
-        /** An array where the (i + 128)th slot determines whether ASCII character i should
-         *  be trimmed
-         */
-        internals::WhitespaceMap ws_flags;
-        ///@}
+                        cand.n_fields = 0;
+                        cand.n_rows++;
+                        cand.prev_special = true;
 
-        /** @name Parser State */
-        ///@{
-        /** Pointer to a object containing column information */
-        internals::ColNamesPtr col_names = std::make_shared<internals::ColNames>();
+                        if (i + 1 < n && head[i + 1] == '\n')
+                            cand.skip_char = true;
+                    }
+                    else {
+                        // Mirrors parse(): a quote only opens a field when
+                        // it follows a delimiter or newline
+                        if (ch == '"' && cand.prev_special)
+                            cand.quote_escape = true;
 
-        /** Buffer for current row being parsed */
-        internals::BufferPtr record_buffer = internals::BufferPtr(new internals::RawRowBuffer(this->col_names));
+                        cand.prev_special = false;
+                    }
+                }
+            }
 
-        /** Queue of parsed CSV rows */
-        std::deque<CSVRow> records;
+            size_t max_score = 0,
+                   header = 0;
+            char current_delim = delims[0];
 
-        /** Whether or not we are in a quote-escaped field */
-        bool quote_escape = false;
+            for (auto& cand : candidates) {
+                if (cand.row_tally.empty()) continue;
 
-        /** Whether or not an attempt to find Unicode BOM has been made */
-        bool unicode_bom_scan = false;
+                // Most common number of columns
+                auto max = std::max_element(cand.row_tally.begin(), cand.row_tally.end(),
+                    [](const std::pair<size_t, size_t>& x,
+                        const std::pair<size_t, size_t>& y) {
+                            return x.second < y.second; });
 
-        /** Whether or not rows before header were trimmed */
-        bool header_trimmed = false;
+                const size_t score = max->first * max->second;
+                if (score > max_score) {
+                    max_score = score;
+                    current_delim = cand.delim;
+                    header = cand.row_when[max->first];
+                }
+            }
 
-        /** The number of columns in this CSV */
-        size_t n_cols = 0;
-        ///@}
+            return {
+                current_delim,
+                (int)header,
+                head.find('"') == csv::string_view::npos
+            };
+        }
 
-        /** @name Multi-Threaded File Reading Functions */
-        ///@{
-        void feed(WorkItem&&); /**< @brief Helper for read_csv_worker() */
-        void read_csv(const size_t& bytes = internals::ITERATION_CHUNK_SIZE);
-        void read_csv_worker();
-        ///@}
+        CSV_INLINE BufferPtr parse(const ParseData& data, BufferPool* pool,
+            ProjectionState* projection, RowFilter* filter,
+            size_t* peak_buffer_bytes) {
+            using internals::ParseFlags;
 
-        /** @name Multi-Threaded File Reading: Flags and State */
-        ///@{
-        /** Current file handle. Destroyed by ~CSVReader(). */
-        std::FILE* HEDLEY_RESTRICT infile = nullptr;
-        std::unique_ptr<ThreadedReadingState> feed_state;
-        ///@} 
+            auto * HEDLEY_RESTRICT proj = projection;
 
-        /**@}*/ // End of parser internals
+            // Optimizations
+            auto * HEDLEY_RESTRICT parse_flags = data.parse_flags.data();
+            auto * HEDLEY_RESTRICT ws_flags = data.ws_flags.data();
+            auto& in = data.in;
+            auto& row_buffer = *(data.row_buffer.get());
+            auto& text_buffer = row_buffer.buffer;
+            auto& split_buffer = row_buffer.split_buffer;
+            text_buffer.reserve(data.in.size());
+            split_buffer.reserve(data.in.size() / 10);
 
-    private:
-        /** Set parse and whitespace flags */
-        void set_parse_flags(const CSVFormat& format);
-    };
-}
-/** @file
- *  Calculates statistics from CSV files
- */
+            // Recover the raw special characters for the vectorized scanner
+            char delim = ',', quote = '\0';
+            bool has_quote = false;
+            for (size_t ch = 0; ch < data.parse_flags.size(); ch++) {
+                if (parse_flags[ch] == ParseFlags::DELIMITER) {
+                    delim = (char)((int)ch - 128);
+                }
+                else if (parse_flags[ch] == ParseFlags::QUOTE) {
+                    quote = (char)((int)ch - 128);
+                    has_quote = true;
+                }
+            }
 
-#include <unordered_map>
-#include <vector>
+            // With quoting disabled, only three characters are special
+            if (!has_quote) quote = delim;
 
-namespace csv {
-    /** Class for calculating statistics from CSV files and in-memory sources
-     *
-     *  **Example**
-     *  \include programs/csv_stats.cpp
-     *
-     */
-    class CSVStat : public CSVReader {
-    public:
-        using FreqCount = std::unordered_map<std::string, RowCount>;
-        using TypeCount = std::unordered_map<DataType, RowCount>;
+            for (size_t i = 0; i < in.size(); i++) {
+                switch (parse_flags[data.in[i] + 128]) {
+                case ParseFlags::DELIMITER:
+                    if (!data.quote_escape) {
+                        if (proj == nullptr) {
+                            split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
+                        }
+                        else {
+                            // A field boundary is only recorded between two
+                            // materialized fields
+                            if (proj->is_selected(proj->field_no))
+                                proj->wrote_field = true;
 
-        void end_feed();
-        std::vector<long double> get_mean() const;
-        std::vector<long double> get_variance() const;
-        std::vector<long double> get_mins() const;
-        std::vector<long double> get_maxes() const;
-        std::vector<FreqCount> get_counts() const;
-        std::vector<TypeCount> get_dtypes() const;
+                            proj->field_no++;
 
-        CSVStat(csv::string_view filename, CSVFormat format = CSVFormat::guess_csv());
-        CSVStat(CSVFormat format = CSVFormat()) : CSVReader(format) {};
-    private:
-        // An array of rolling averages
-        // Each index corresponds to the rolling mean for the column at said index
-        std::vector<long double> rolling_means;
-        std::vector<long double> rolling_vars;
-        std::vector<long double> mins;
-        std::vector<long double> maxes;
-        std::vector<FreqCount> counts;
-        std::vector<TypeCount> dtypes;
-        std::vector<long double> n;
+                            if (proj->wrote_field && proj->is_selected(proj->field_no))
+                                split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
+                        }
 
-        // Statistic calculators
-        void variance(const long double&, const size_t&);
-        void count(CSVField&, const size_t&);
-        void min_max(const long double&, const size_t&);
-        void dtype(CSVField&, const size_t&);
+                        break;
+                    }
 
-        void calc();
-        void calc_worker(const size_t&);
-    };
-}
+                    HEDLEY_FALL_THROUGH;
+                case ParseFlags::NEWLINE:
+                    if (!data.quote_escape) {
+                        // End of record -> Write record
+                        if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
+                            ++i;
 
-/** @file
- *  Defines an object used to store CSV format settings
- */
+                        bool keep = true;
+                        if (filter != nullptr) {
+                            if (filter->bypass_rows > 0) {
+                                filter->bypass_rows--;
+                            }
+                            else {
+                                row_buffer.get_current_row(filter->scratch);
+                                keep = filter->predicate(filter->scratch);
+                            }
+                        }
 
-#include <algorithm>
-#include <set>
+                        if (keep)
+                            data.records.push_back(CSVRow(data.row_buffer));
+                        else
+                            row_buffer.discard_row();
 
+                        if (proj != nullptr) {
+                            proj->field_no = 0;
+                            proj->wrote_field = false;
+                        }
 
-namespace csv {
-    CSV_INLINE CSVFormat& CSVFormat::delimiter(char delim) {
-        this->possible_delimiters = { delim };
-        this->assert_no_char_overlap();
-        return *this;
-    }
+                        break;
+                    }
 
-    CSV_INLINE CSVFormat& CSVFormat::delimiter(const std::vector<char> & delim) {
-        this->possible_delimiters = delim;
-        this->assert_no_char_overlap();
-        return *this;
-    }
+                    // Treat as regular character
+                    if (proj == nullptr || proj->is_selected(proj->field_no))
+                        text_buffer += in[i];
 
-    CSV_INLINE CSVFormat& CSVFormat::quote(char quote) {
-        this->no_quote = false;
-        this->quote_char = quote;
-        this->assert_no_char_overlap();
-        return *this;
-    }
+                    break;
+                case ParseFlags::NOT_SPECIAL: {
+                    size_t start, end;
 
-    CSV_INLINE CSVFormat& CSVFormat::trim(const std::vector<char> & chars) {
-        this->trim_chars = chars;
-        this->assert_no_char_overlap();
-        return *this;
-    }
+                    if (!parse_not_special(
+                        in,
+                        parse_flags,
+                        ws_flags,
+                        i,
+                        start,
+                        end,
+                        delim,
+                        quote
+                    )) {
+                        break;
+                    }
 
-    CSV_INLINE CSVFormat& CSVFormat::column_names(const std::vector<std::string>& names) {
-        this->col_names = names;
-        this->header = -1;
-        return *this;
-    }
+                    // Skipped fields only pay for the boundary scan above
+                    if (proj != nullptr && !proj->is_selected(proj->field_no))
+                        break;
 
-    CSV_INLINE CSVFormat& CSVFormat::header_row(int row) {
-        this->header = row;
-        this->col_names = {};
-        return *this;
-    }
+                    // Finally append text
+#ifdef CSV_HAS_CXX17
+                    text_buffer += in.substr(start, end - start + 1);
+#else
+                    for (; start < end + 1; start++) {
+                        text_buffer += in[start];
+                    }
+#endif
 
-    CSV_INLINE void CSVFormat::assert_no_char_overlap()
-    {
-        auto delims = std::set<char>(
-            this->possible_delimiters.begin(), this->possible_delimiters.end()),
-            trims = std::set<char>(
-                this->trim_chars.begin(), this->trim_chars.end());
+                    break;
+                }
+                default: // Quote
+                    if (!data.quote_escape) {
+                        // Don't deref past beginning
+                        if (i && parse_flags[in[i - 1] + 128] >= ParseFlags::DELIMITER) {
+                            // Case: Previous character was delimiter or newline
+                            data.quote_escape = true;
+                        }
+                    }
+                    else if (i + 1 < in.size()) {
+                        auto next_ch = parse_flags[in[i + 1] + 128];
+                        if (next_ch >= ParseFlags::DELIMITER) {
+                            // Case: Delim or newline => end of field
+                            data.quote_escape = false;
+                            break;
+                        }
 
-        // Stores intersection of possible delimiters and trim characters
-        std::vector<char> intersection = {};
+                        // Case: Escaped quote
+                        if (proj == nullptr || proj->is_selected(proj->field_no))
+                            text_buffer += in[i];
 
-        // Find which characters overlap, if any
-        std::set_intersection(
-            delims.begin(), delims.end(),
-            trims.begin(), trims.end(),
-            std::back_inserter(intersection));
+                        // Note: Unescaped single quotes can be handled by the parser
+                        if (next_ch == ParseFlags::QUOTE)
+                            ++i;  // Case: Two consecutive quotes
+                    }
 
-        // Make sure quote character is not contained in possible delimiters
-        // or whitespace characters
-        if (delims.find(this->quote_char) != delims.end() ||
-            trims.find(this->quote_char) != trims.end()) {
-            intersection.push_back(this->quote_char);
-        }
+                    break;
+                }
+            }
 
-        if (!intersection.empty()) {
-            std::string err_msg = "There should be no overlap between the quote character, "
-                "the set of possible delimiters "
-                "and the set of whitespace characters. Offending characters: ";
+            // Record the buffer's high-water mark before it is swapped out
+            if (peak_buffer_bytes != nullptr && text_buffer.size() > *peak_buffer_bytes)
+                *peak_buffer_bytes = text_buffer.size();
 
-            // Create a pretty error message with the list of overlapping
-            // characters
-            for (size_t i = 0; i < intersection.size(); i++) {
-                err_msg += "'";
-                err_msg += intersection[i];
-                err_msg += "'";
+            return row_buffer.reset(pool);
+        }
 
-                if (i + 1 < intersection.size())
-                    err_msg += ", ";
+        CSV_INLINE BufferPtr parse_no_quote(const ParseData& data, BufferPool* pool,
+            size_t* peak_buffer_bytes) {
+            using internals::ParseFlags;
+
+            auto * HEDLEY_RESTRICT parse_flags = data.parse_flags.data();
+            auto& in = data.in;
+            auto& row_buffer = *(data.row_buffer.get());
+            auto& text_buffer = row_buffer.buffer;
+            auto& split_buffer = row_buffer.split_buffer;
+            text_buffer.reserve(in.size());
+            split_buffer.reserve(in.size() / 10);
+
+            // Recover the raw delimiter for the vectorized scanner
+            char delim = ',';
+            for (size_t ch = 0; ch < data.parse_flags.size(); ch++) {
+                if (parse_flags[ch] == ParseFlags::DELIMITER)
+                    delim = (char)((int)ch - 128);
             }
 
-            throw std::runtime_error(err_msg + '.');
-        }
-    }
-}
-/** @file
- *  @brief Defines functionality needed for basic CSV parsing
- */
+            // With no quote state to track, parsing reduces to alternating
+            // between bulk-copying runs of ordinary characters and acting on
+            // the delimiter or newline that terminated each run
+            size_t i = 0;
+            while (i < in.size()) {
+                const size_t start = i;
+                i = find_special(in, parse_flags, i, delim, delim);
 
-#include <algorithm>
-#include <cstdio>   // For read_csv()
-#include <cstring>  // For read_csv()
-#include <fstream>
-#include <sstream>
+                if (i > start) {
+#ifdef CSV_HAS_CXX17
+                    text_buffer += in.substr(start, i - start);
+#else
+                    for (size_t j = start; j < i; j++) {
+                        text_buffer += in[j];
+                    }
+#endif
+                }
 
+                if (i >= in.size()) break;
 
-namespace csv {
-    namespace internals {
-        CSV_INLINE std::string format_row(const std::vector<std::string>& row, csv::string_view delim) {
-            /** Print a CSV row */
-            std::stringstream ret;
-            for (size_t i = 0; i < row.size(); i++) {
-                ret << row[i];
-                if (i + 1 < row.size()) ret << delim;
-                else ret << std::endl;
+                if (in[i] == delim) {
+                    split_buffer.push_back((StrBufferPos)row_buffer.size());
+                }
+                else {
+                    // End of record -> Write record
+                    if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
+                        ++i;
+
+                    data.records.push_back(CSVRow(data.row_buffer));
+                }
+
+                i++;
             }
 
-            return ret.str();
+            if (peak_buffer_bytes != nullptr && text_buffer.size() > *peak_buffer_bytes)
+                *peak_buffer_bytes = text_buffer.size();
+
+            return row_buffer.reset(pool);
         }
 
-        /** Return a CSV's column names
-         *
-         *  @param[in] filename  Path to CSV file
-         *  @param[in] format    Format of the CSV file
+        /** Outcome of examining one UTF-8 sequence */
+        enum class Utf8Result {
+            VALID,
+            INVALID,
+            INCOMPLETE /**< The sequence continues past the available bytes */
+        };
+
+        /** Examine the UTF-8 sequence starting at p, applying the
+         *  second-byte range restrictions that reject overlong encodings
+         *  and surrogate code points
          *
+         *  @param[in]  p     First byte of the sequence
+         *  @param[in]  avail Bytes available at p
+         *  @param[out] len   Full length of the sequence (1-4), set for
+         *                    VALID and INCOMPLETE results
          */
-        CSV_INLINE std::vector<std::string> _get_col_names(csv::string_view head, CSVFormat format) {
-            auto parse_flags = internals::make_parse_flags(format.get_delim());
-            if (format.is_quoting_enabled()) {
-                parse_flags = internals::make_parse_flags(format.get_delim(), format.get_quote_char());
+        static Utf8Result check_utf8_sequence(const unsigned char* p, size_t avail, size_t& len) {
+            const unsigned char c = p[0];
+
+            if (c < 0x80) {
+                len = 1;
+                return Utf8Result::VALID;
             }
 
-            // Parse the CSV
-            auto buffer_ptr = internals::BufferPtr(new internals::RawRowBuffer());
-            auto trim_chars = format.get_trim_chars();
+            unsigned char lo = 0x80, hi = 0xBF;
 
-            std::deque<CSVRow> rows;
-            bool quote_escape = false;
+            if (c >= 0xC2 && c <= 0xDF) { len = 2; }
+            else if (c == 0xE0) { len = 3; lo = 0xA0; } // Reject overlong
+            else if (c >= 0xE1 && c <= 0xEC) { len = 3; }
+            else if (c == 0xED) { len = 3; hi = 0x9F; } // Reject surrogates
+            else if (c >= 0xEE && c <= 0xEF) { len = 3; }
+            else if (c == 0xF0) { len = 4; lo = 0x90; } // Reject overlong
+            else if (c >= 0xF1 && c <= 0xF3) { len = 4; }
+            else if (c == 0xF4) { len = 4; hi = 0x8F; } // Reject > U+10FFFF
+            else return Utf8Result::INVALID;            // 0x80-0xC1, 0xF5-0xFF
 
-            internals::parse({
-                head,
-                parse_flags,
-                internals::make_ws_flags(trim_chars.data(), trim_chars.size()),
-                buffer_ptr,
-                quote_escape,
-                rows
-            });
+            for (size_t i = 1; i < len; i++) {
+                if (i >= avail) return Utf8Result::INCOMPLETE;
 
-            return rows[format.get_header()];
+                const unsigned char cc = p[i];
+                if (i == 1 ? (cc < lo || cc > hi) : (cc < 0x80 || cc > 0xBF))
+                    return Utf8Result::INVALID;
+            }
+
+            return Utf8Result::VALID;
         }
-    }
 
-    /** Return a CSV's column names
-     *
-     *  @param[in] filename  Path to CSV file
-     *  @param[in] format    Format of the CSV file
-     *
-     */
-    CSV_INLINE std::vector<std::string> get_col_names(csv::string_view filename, CSVFormat format) {
-        auto head = internals::get_csv_head(filename);
+        CSV_INLINE size_t validate_utf8_chunk(UnicodeValidator& state,
+            char* data, size_t n, bool replace) {
+            auto* bytes = (unsigned char*)data;
+            size_t i = 0;
 
-        /** Guess delimiter and header row */
-        if (format.guess_delim()) {
-            auto guess_result = guess_format(filename, format.get_possible_delims());
-            format.delimiter(guess_result.delim).header_row(guess_result.header_row);
-        }
+            // Finish a sequence the previous chunk left incomplete
+            if (state.partial_len > 0) {
+                const size_t take = std::min(n, (size_t)4 - state.partial_len);
+                std::memcpy(state.partial + state.partial_len, bytes, take);
 
-        return internals::_get_col_names(head, format);
-    }
+                size_t len = 0;
+                switch (check_utf8_sequence(state.partial, state.partial_len + take, len)) {
+                case Utf8Result::VALID:
+                    i = len - state.partial_len;
+                    state.partial_len = 0;
+                    break;
+                case Utf8Result::INCOMPLETE: // Only possible for a tiny chunk
+                    state.partial_len += take;
+                    return csv::string_view::npos;
+                case Utf8Result::INVALID:
+                    // The sequence's lead byte went out with the previous
+                    // chunk and is beyond repair; rescan this chunk's bytes
+                    // from the top so a valid lead byte is not swallowed
+                    if (!replace) return 0;
+                    state.partial_len = 0;
+                    break;
+                }
+            }
 
-    /** Guess the delimiter used by a delimiter-separated values file */
-    CSV_INLINE CSVGuessResult guess_format(csv::string_view filename, const std::vector<char>& delims) {
-        auto head = internals::get_csv_head(filename);
-        return internals::_guess_format(head, delims);
-    }
+            while (i < n) {
+                // Runs of ASCII — the overwhelming share of typical CSV —
+                // are validated a register at a time via the sign bit
+#if defined(CSV_HAS_AVX2)
+                while (i + 32 <= n) {
+                    __m256i chunk = _mm256_loadu_si256((const __m256i*)(bytes + i));
+                    if (_mm256_movemask_epi8(chunk) != 0) break;
+                    i += 32;
+                }
+#elif defined(CSV_HAS_SSE2)
+                while (i + 16 <= n) {
+                    __m128i chunk = _mm_loadu_si128((const __m128i*)(bytes + i));
+                    if (_mm_movemask_epi8(chunk) != 0) break;
+                    i += 16;
+                }
+#endif
 
-    /** Allows parsing in-memory sources (by calling feed() and end_feed()). */
-    CSV_INLINE CSVReader::CSVReader(CSVFormat format) : 
-        unicode_bom_scan(!format.unicode_detect), feed_state(new ThreadedReadingState)  {
-        if (!format.col_names.empty()) {
-            this->set_col_names(format.col_names);
-        }
-        
-        this->set_parse_flags(format);
-    }
+                if (i >= n) break;
 
-    /** Allows reading a CSV file in chunks, using overlapped
-     *  threads for simulatenously reading from disk and parsing.
-     *  Rows should be retrieved with read_row() or by using
-     *  CSVReader::iterator.
-     *
-     *  **Details:** Reads the first 500kB of a CSV file to infer file information
-     *              such as column names and delimiting character.
-     *
-     *  @param[in] filename  Path to CSV file
-     *  @param[in] format    Format of the CSV file
-     *
-     *  \snippet tests/test_read_csv.cpp CSVField Example
-     *
-     */
-    CSV_INLINE CSVReader::CSVReader(csv::string_view filename, CSVFormat format) : feed_state(new ThreadedReadingState) {
-        auto head = internals::get_csv_head(filename);
+                if (bytes[i] < 0x80) {
+                    i++;
+                    continue;
+                }
 
-        /** Guess delimiter and header row */
-        if (format.guess_delim()) {
-            auto guess_result = internals::_guess_format(head, format.possible_delimiters);
-            format.delimiter(guess_result.delim);
-            format.header = guess_result.header_row;
-        }
+                size_t len = 0;
+                switch (check_utf8_sequence(bytes + i, n - i, len)) {
+                case Utf8Result::VALID:
+                    i += len;
+                    break;
+                case Utf8Result::INCOMPLETE:
+                    std::memcpy(state.partial, bytes + i, n - i);
+                    state.partial_len = n - i;
+                    i = n;
+                    break;
+                case Utf8Result::INVALID:
+                    if (!replace) return i;
+                    bytes[i] = '?';
+                    i++;
+                    break;
+                }
+            }
 
-        if (format.col_names.empty()) {
-            this->set_col_names(internals::_get_col_names(head, format));
-        }
-        else {
-            this->set_col_names(format.col_names);
+            return csv::string_view::npos;
         }
 
-        this->set_parse_flags(format);
-        this->fopen(filename);
-    }
+        CSV_INLINE bool transcode_utf16_chunk(UnicodeValidator& state,
+            const char* data, size_t n, std::string& out, bool replace) {
+            const auto* bytes = (const unsigned char*)data;
+            const bool big_endian =
+                state.encoding == UnicodeValidator::Encoding::UTF16_BE;
+            size_t i = 0;
 
-    /** Return the format of the original raw CSV */
-    CSV_INLINE CSVFormat CSVReader::get_format() const {
-        CSVFormat new_format = this->format;
+            // Worst case: every 2-byte unit becomes 3 UTF-8 bytes
+            out.clear();
+            out.reserve(n + n / 2);
 
-        // Since users are normally not allowed to set 
-        // column names and header row simulatenously,
-        // we will set the backing variables directly here
-        new_format.col_names = this->col_names->get_col_names();
-        new_format.header = this->format.header;
+            // Pull the next 16-bit code unit, absorbing a byte carried over
+            // from the previous chunk and carrying a trailing odd byte
+            auto read_unit = [&](unsigned int& unit) -> bool {
+                unsigned char b0, b1;
 
-        return new_format;
-    }
+                if (state.has_odd_byte) {
+                    if (i >= n) return false;
 
-    /** Return the CSV's column names as a vector of strings. */
-    CSV_INLINE std::vector<std::string> CSVReader::get_col_names() const {
-        if (this->col_names) {
-            return this->col_names->get_col_names();
-        }
+                    b0 = state.odd_byte;
+                    b1 = bytes[i++];
+                    state.has_odd_byte = false;
+                }
+                else {
+                    if (i + 2 > n) {
+                        if (i < n) {
+                            state.odd_byte = bytes[i++];
+                            state.has_odd_byte = true;
+                        }
 
-        return std::vector<std::string>();
-    }
+                        return false;
+                    }
 
-    /** Return the index of the column name if found or
-     *         csv::CSV_NOT_FOUND otherwise.
-     */
-    CSV_INLINE int CSVReader::index_of(csv::string_view col_name) const {
-        auto _col_names = this->get_col_names();
-        for (size_t i = 0; i < _col_names.size(); i++)
-            if (_col_names[i] == col_name) return (int)i;
+                    b0 = bytes[i++];
+                    b1 = bytes[i++];
+                }
 
-        return CSV_NOT_FOUND;
-    }
+                unit = big_endian
+                    ? ((unsigned int)b0 << 8) | b1
+                    : ((unsigned int)b1 << 8) | b0;
+                return true;
+            };
 
-    CSV_INLINE void CSVReader::feed(WorkItem&& buff) {
-        this->feed( csv::string_view(buff.first.get(), buff.second) );
-    }
+            auto emit = [&out](unsigned int cp) {
+                if (cp < 0x80) {
+                    out += (char)cp;
+                }
+                else if (cp < 0x800) {
+                    out += (char)(0xC0 | (cp >> 6));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+                else if (cp < 0x10000) {
+                    out += (char)(0xE0 | (cp >> 12));
+                    out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+                else {
+                    out += (char)(0xF0 | (cp >> 18));
+                    out += (char)(0x80 | ((cp >> 12) & 0x3F));
+                    out += (char)(0x80 | ((cp >> 6) & 0x3F));
+                    out += (char)(0x80 | (cp & 0x3F));
+                }
+            };
 
-    /** Parse a CSV-formatted string.
-     *
-     *  @par Usage
-     *  Incomplete CSV fragments can be joined together by calling feed() on them sequentially.
-     *
-     *  @note
-     *  `end_feed()` should be called after the last string.
-     */
-    CSV_INLINE void CSVReader::feed(csv::string_view in) {
-        /** Handle possible Unicode byte order mark */
-        if (!this->unicode_bom_scan) {
-            if (in[0] == '\xEF' && in[1] == '\xBB' && in[2] == '\xBF') {
-                in.remove_prefix(3); // Remove BOM from input string
-                this->utf8_bom = true;
+            unsigned int unit = 0;
+            while (read_unit(unit)) {
+                if (state.pending_high) {
+                    if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                        emit(0x10000
+                            + ((state.pending_high - 0xD800) << 10)
+                            + (unit - 0xDC00));
+                        state.pending_high = 0;
+                        continue;
+                    }
+
+                    // Unpaired high surrogate; reprocess this unit below
+                    if (!replace) return false;
+                    emit(0xFFFD);
+                    state.pending_high = 0;
+                }
+
+                if (unit >= 0xD800 && unit <= 0xDBFF) {
+                    state.pending_high = unit;
+                }
+                else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                    // Low surrogate with no high half
+                    if (!replace) return false;
+                    emit(0xFFFD);
+                }
+                else {
+                    emit(unit);
+                }
             }
 
-            this->unicode_bom_scan = true;
+            return true;
         }
 
-        this->record_buffer = internals::parse({
-            in,
-            this->parse_flags,
-            this->ws_flags,
-            this->record_buffer,
-            this->quote_escape,
-            this->records
-        });
+        CSV_INLINE std::string get_csv_head(csv::string_view filename) {
+            const size_t bytes = 500000;
 
-        if (!this->header_trimmed) {
-            for (int i = 0; i <= this->format.header && !this->records.empty(); i++) {
-                if (i == this->format.header && this->col_names->empty()) {
-                    this->set_col_names(this->records.front());
-                }
+            // Cache the most recently read head: guessing a format and then
+            // retrieving column names hits the same file back to back, and
+            // this avoids reading its first 500 KB from disk twice
+            static std::mutex head_cache_lock;
+            static std::string head_cache_name;
+            static long long head_cache_size = -1;
+            static long long head_cache_mtime = -1;
+            static std::string head_cache;
 
-                this->records.pop_front();
+            std::ifstream infile(filename.data());
+            if (!infile.is_open()) {
+                throw std::runtime_error("Cannot open file " + std::string(filename));
             }
 
-            this->header_trimmed = true;
-        }
-    }
+            // Use the file size and modification time as a cheap staleness
+            // check; size alone misses rewrites with same-length content
+            infile.seekg(0, std::ios::end);
+            const long long file_size = (long long)infile.tellg();
+            infile.seekg(0, std::ios::beg);
+
+            long long file_mtime = -1;
+            struct stat file_info;
+            if (stat(filename.data(), &file_info) == 0) {
+#if defined(__linux__)
+                // Sub-second resolution catches files rewritten in-process
+                file_mtime = (long long)file_info.st_mtim.tv_sec * 1000000000LL
+                    + file_info.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+                file_mtime = (long long)file_info.st_mtimespec.tv_sec * 1000000000LL
+                    + file_info.st_mtimespec.tv_nsec;
+#else
+                file_mtime = (long long)file_info.st_mtime;
+#endif
+            }
 
-    CSV_INLINE void CSVReader::end_feed() {
-        /** Indicate that there is no more data to receive,
-         *  and handle the last row
-         */
-        if (this->record_buffer->size() > 0) {
-            this->records.push_back(CSVRow(this->record_buffer));
-        }
-    }
+            {
+                std::lock_guard<std::mutex> guard(head_cache_lock);
+                if (head_cache_size == file_size && head_cache_mtime == file_mtime
+                    && head_cache_name == filename)
+                    return head_cache;
+            }
 
-    /** Worker thread for read_csv() which parses CSV rows (while the main
-     *  thread pulls data from disk)
-     */
-    CSV_INLINE void CSVReader::read_csv_worker() {
-        while (true) {
-            std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock }; // Get lock
-            this->feed_state->feed_cond.wait(lock,                            // Wait
-                [this] { return !(this->feed_state->feed_buffer.empty()); });
+            std::unique_ptr<char[]> buffer(new char[bytes + 1]);
+            char * head_buffer = buffer.get();
 
-            // Wake-up
-            auto in = std::move(this->feed_state->feed_buffer.front());
-            this->feed_state->feed_buffer.pop_front();
+            for (size_t i = 0; i < bytes + 1; i++) {
+                head_buffer[i] = '\0';
+            }
 
-            // Nullptr --> Die
-            if (!in.first) break;
+            infile.read(head_buffer, bytes);
 
-            lock.unlock();      // Release lock
-            this->feed(std::move(in));
-        }
-    }
+            std::string head(head_buffer);
 
-    CSV_INLINE void CSVReader::set_parse_flags(const CSVFormat& format)
-    {
-        this->format = format;
-        if (format.no_quote) {
-            this->parse_flags = internals::make_parse_flags(format.get_delim());
-        }
-        else {
-            this->parse_flags = internals::make_parse_flags(format.get_delim(), format.quote_char);
-        }
+            {
+                std::lock_guard<std::mutex> guard(head_cache_lock);
+                head_cache_name = std::string(filename);
+                head_cache_size = file_size;
+                head_cache_mtime = file_mtime;
+                head_cache = head;
+            }
 
-        this->ws_flags = internals::make_ws_flags(format.trim_chars.data(), format.trim_chars.size());
+            return head;
+        }
     }
+}
+/** @file
+ *  @brief Defines functionality needed for basic CSV parsing
+ */
 
-    CSV_INLINE void CSVReader::fopen(csv::string_view filename) {
-        if (!this->infile) {
-#ifdef _MSC_BUILD
-            // Silence compiler warnings in Microsoft Visual C++
-            size_t err = fopen_s(&(this->infile), filename.data(), "rb");
-            if (err)
-                throw std::runtime_error("Cannot open file " + std::string(filename));
+#include <algorithm>
+#include <chrono>   // For worker wait metrics
+#include <cstdio>   // For read_csv()
+#include <cstring>  // For validate_chunk()
+#include <fstream>
+#include <limits>        // For read_batch()
+#include <unordered_map> // For dictionary encoding
+#include <unordered_set>
+#include <sstream>
+
+
+/** Latency tracing hooks (see CSVReaderTrace): each site expands to a
+ *  steady_clock read and a histogram record when CSV_TRACE is defined,
+ *  and to nothing at all otherwise, keeping the release hot path clean
+ */
+#ifdef CSV_TRACE
+#define CSV_TRACE_START(name) const auto name = std::chrono::steady_clock::now()
+#define CSV_TRACE_STOP(hist, name) (hist).record( \
+    (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>( \
+        std::chrono::steady_clock::now() - (name)).count())
 #else
-            this->infile = std::fopen(filename.data(), "rb");
-            if (!this->infile)
-                throw std::runtime_error("Cannot open file " + std::string(filename));
+#define CSV_TRACE_START(name)
+#define CSV_TRACE_STOP(hist, name)
 #endif
-        }
-    }
 
-    /**
-     *  @param[in] names Column names
-     */
-    CSV_INLINE void CSVReader::set_col_names(const std::vector<std::string>& names)
-    {
-        this->col_names->set_col_names(names);
-        this->n_cols = names.size();
-    }
+#if !defined(_WIN32) && (defined(__linux__) || defined(__APPLE__))
+#include <fcntl.h>    // For open_mmap()
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-    /**
-     * Parse a CSV file using multiple threads
-     *
-     * @pre CSVReader::infile points to a valid file handle, i.e. CSVReader::fopen was called
-     *
-     * @param[in] bytes Number of bytes to read.
-     * @see CSVReader::read_row()
-     */
-    CSV_INLINE void CSVReader::read_csv(const size_t& bytes) {
-        const size_t BUFFER_UPPER_LIMIT = std::min(bytes, (size_t)1000000);
-        std::unique_ptr<char[]> buffer(new char[BUFFER_UPPER_LIMIT]);
-        auto * HEDLEY_RESTRICT line_buffer = buffer.get();
-        line_buffer[0] = '\0';
+#ifdef CSV_HAS_ZLIB
+#include <zlib.h>
+#endif
 
-        std::thread worker(&CSVReader::read_csv_worker, this);
+#ifdef CSV_HAS_ZSTD
+#include <zstd.h>
+#endif
 
-        for (size_t processed = 0; processed < bytes; ) {
-            char * HEDLEY_RESTRICT result = std::fgets(line_buffer, internals::PAGE_SIZE, this->infile);
-            if (result == NULL) break;
-            line_buffer += std::strlen(line_buffer);
-            size_t current_strlen = line_buffer - buffer.get();
+#ifdef CSV_HAS_IO_URING
+#include <cstring>    // For strerror()
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+
+namespace csv {
+    namespace internals {
+        /** Streams a file as a sequence of WorkItem-sized chunks while keeping
+         *  a fixed window of read requests in flight via io_uring, so the next
+         *  chunks are already being fetched while the current one is parsed.
+         *
+         *  Each of the QUEUE_DEPTH slots owns one chunk buffer and always has
+         *  a read outstanding against the next unclaimed file offset; chunks
+         *  are consumed strictly in file order, and completed buffers are
+         *  moved out whole so read_csv() can feed them to the parser without
+         *  an extra copy.
+         */
+        class UringReader {
+        public:
+            /** Structurally identical to CSVReader::WorkItem */
+            using WorkItem = std::pair<std::unique_ptr<char[]>, size_t>;
+
+            UringReader(csv::string_view filename) {
+                this->fd = ::open(filename.data(), O_RDONLY);
+                if (this->fd < 0)
+                    throw std::runtime_error("Cannot open file " + std::string(filename));
+
+                if (io_uring_queue_init(QUEUE_DEPTH, &this->ring, 0) < 0) {
+                    ::close(this->fd);
+                    throw std::runtime_error("Cannot initialize io_uring for file "
+                        + std::string(filename));
+                }
 
-            if (current_strlen >= 0.9 * BUFFER_UPPER_LIMIT) {
-                processed += (line_buffer - buffer.get());
-                std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock };
+                // Prime the window: one read per slot
+                for (size_t i = 0; i < QUEUE_DEPTH; i++)
+                    this->submit(i);
+            }
 
-                this->feed_state->feed_buffer.push_back(std::make_pair<>(std::move(buffer), current_strlen));
+            ~UringReader() {
+                // Reap any still-outstanding completions before tearing down
+                while (this->in_flight > 0) {
+                    struct io_uring_cqe* cqe;
+                    if (io_uring_wait_cqe(&this->ring, &cqe) < 0) break;
 
-                buffer = std::unique_ptr<char[]>(new char[BUFFER_UPPER_LIMIT]); // New pointer
-                line_buffer = buffer.get();
-                line_buffer[0] = '\0';
+                    io_uring_cqe_seen(&this->ring, cqe);
+                    this->in_flight--;
+                }
 
-                this->feed_state->feed_cond.notify_one();
+                io_uring_queue_exit(&this->ring);
+                ::close(this->fd);
             }
-        }
 
-        // Feed remaining bits
-        std::unique_lock<std::mutex> lock{ this->feed_state->feed_lock };
-        this->feed_state->feed_buffer.push_back(std::make_pair<>(std::move(buffer), line_buffer - buffer.get()));
-        this->feed_state->feed_buffer.push_back(std::make_pair<>(nullptr, 0)); // Termination signal
-        this->feed_state->feed_cond.notify_one();
-        lock.unlock();
-        worker.join();
+            /** Block until the next chunk in file order has completed
+             *
+             *  @return The chunk's buffer and byte count, or a (nullptr, 0)
+             *          WorkItem once the end of the file is reached
+             */
+            WorkItem next_chunk() {
+                if (this->hit_eof)
+                    return std::make_pair<>(nullptr, 0);
+
+                // Drain completions until the in-order slot is ready; other
+                // slots finishing early are simply marked for later
+                const size_t slot = this->consume_index % QUEUE_DEPTH;
+                while (!this->slots[slot].ready) {
+                    struct io_uring_cqe* cqe;
+                    if (io_uring_wait_cqe(&this->ring, &cqe) < 0)
+                        throw std::runtime_error("io_uring wait failed");
+
+                    const size_t done = (size_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+                    this->slots[done].result = cqe->res;
+                    this->slots[done].ready = true;
+
+                    io_uring_cqe_seen(&this->ring, cqe);
+                    this->in_flight--;
+                }
 
-        if (std::feof(this->infile)) {
-            this->end_feed();
-            this->close();
-        }
-    }
+                auto& current = this->slots[slot];
+                current.ready = false;
 
-    /** Close the open file handle.
-     *
-     *  @note Automatically called by ~CSVReader().
-     */
-    CSV_INLINE void CSVReader::close() {
-        if (this->infile) {
-            std::fclose(this->infile);
-            this->infile = nullptr;
-        }
-    }
+                if (current.result < 0)
+                    throw std::runtime_error("Asynchronous read failed: "
+                        + std::string(std::strerror(-current.result)));
 
-    /**
-     * Retrieve rows as CSVRow objects, returning true if more rows are available.
-     *
-     * **Performance Notes**:
-     *  - The number of rows read in at a time is determined by csv::ITERATION_CHUNK_SIZE
-     *  - For performance details, read the documentation for CSVRow and CSVField.
-     *
-     * @param[out] row The variable where the parsed row will be stored
-     * @see CSVRow, CSVField
-     *
-     * **Example:**
-     * \snippet tests/test_read_csv.cpp CSVField Example
-     *
-     */
-    CSV_INLINE bool CSVReader::read_row(CSVRow &row) {
-        if (this->records.empty()) {
-            if (!this->eof()) {
-                // TODO/Suggestion: Make this call non-blocking, 
-                // i.e. move to it another thread
-                this->read_csv(internals::ITERATION_CHUNK_SIZE);
-            }
-            else return false; // Stop reading
-        }
+                const size_t n_read = (size_t)current.result;
+                if (n_read == 0) {
+                    this->hit_eof = true;
+                    return std::make_pair<>(nullptr, 0);
+                }
 
-        while (!this->records.empty()) {
-            if (this->records.front().size() != this->n_cols &&
-                this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
-                if (this->format.variable_column_policy == VariableColumnPolicy::THROW) {
-                    if (this->records.front().size() < this->n_cols) {
-                        throw std::runtime_error("Line too short " + internals::format_row(this->records.front()));
-                    }
+                WorkItem chunk = std::make_pair<>(std::move(current.buffer), n_read);
+                this->consume_index++;
 
-                    throw std::runtime_error("Line too long " + internals::format_row(this->records.front()));
+                if (n_read < CHUNK_SIZE) {
+                    // Short read => the file ends inside this chunk; reads
+                    // already queued past it complete with 0 bytes and are
+                    // reaped by the destructor
+                    this->hit_eof = true;
+                }
+                else {
+                    this->submit(slot);
                 }
 
-                // Silently drop row (default)
-                this->records.pop_front();
+                return chunk;
             }
-            else {
-                row = std::move(this->records.front());
-                this->num_rows++;
-                this->records.pop_front();
-                return true;
+
+            bool done() const { return this->hit_eof; }
+
+        private:
+            /** Reads kept in flight at once */
+            static constexpr size_t QUEUE_DEPTH = 4;
+
+            /** Matches the 1 MB WorkItem buffers used by read_csv() */
+            static constexpr size_t CHUNK_SIZE = 1000000;
+
+            struct Slot {
+                std::unique_ptr<char[]> buffer;
+                int result = 0;
+                bool ready = false;
+            };
+
+            /** Queue a read of the next unclaimed file offset into a slot */
+            void submit(size_t slot) {
+                if (!this->slots[slot].buffer)
+                    this->slots[slot].buffer = std::unique_ptr<char[]>(new char[CHUNK_SIZE]);
+
+                struct io_uring_sqe* sqe = io_uring_get_sqe(&this->ring);
+                io_uring_prep_read(sqe, this->fd, this->slots[slot].buffer.get(),
+                    (unsigned)CHUNK_SIZE, this->next_offset);
+                io_uring_sqe_set_data(sqe, (void*)(uintptr_t)slot);
+                io_uring_submit(&this->ring);
+
+                this->next_offset += CHUNK_SIZE;
+                this->in_flight++;
             }
-        }
-    
-        return false;
+
+            struct io_uring ring;
+            int fd = -1;
+            Slot slots[QUEUE_DEPTH];
+            size_t consume_index = 0;
+            size_t in_flight = 0;
+            unsigned long long next_offset = 0;
+            bool hit_eof = false;
+        };
     }
 }
-#include <iostream>
+#endif
 
 namespace csv {
     namespace internals {
-        CSV_INLINE GuessScore calculate_score(csv::string_view head, CSVFormat format) {
-            // Frequency counter of row length
-            std::unordered_map<size_t, size_t> row_tally = { { 0, 0 } };
+        CSV_INLINE std::string format_row(const std::vector<std::string>& row, csv::string_view delim) {
+            /** Print a CSV row */
+            std::stringstream ret;
+            for (size_t i = 0; i < row.size(); i++) {
+                ret << row[i];
+                if (i + 1 < row.size()) ret << delim;
+                else ret << std::endl;
+            }
 
-            // Map row lengths to row num where they first occurred
-            std::unordered_map<size_t, size_t> row_when = { { 0, 0 } };
+            return ret.str();
+        }
+
+        /** Return a CSV's column names
+         *
+         *  @param[in] filename  Path to CSV file
+         *  @param[in] format    Format of the CSV file
+         *
+         */
+        CSV_INLINE std::vector<std::string> _get_col_names(csv::string_view head, CSVFormat format) {
+            auto parse_flags = internals::make_parse_flags(format.get_delim());
+            if (format.is_quoting_enabled()) {
+                parse_flags = internals::make_parse_flags(format.get_delim(), format.get_quote_char());
+            }
 
             // Parse the CSV
             auto buffer_ptr = internals::BufferPtr(new internals::RawRowBuffer());
-            std::deque<CSVRow> rows;
+            auto trim_chars = format.get_trim_chars();
+
+            internals::RecordRing rows;
             bool quote_escape = false;
 
             internals::parse({
                 head,
-                internals::make_parse_flags(format.get_delim(), '"'),
-                internals::make_ws_flags({}, 0),
+                parse_flags,
+                internals::make_ws_flags(trim_chars.data(), trim_chars.size()),
                 buffer_ptr,
                 quote_escape,
                 rows
             });
 
-            for (size_t i = 0; i < rows.size(); i++) {
-                auto& row = rows[i];
+            return rows[format.get_header()];
+        }
 
-                // Ignore zero-length rows
-                if (row.size() > 0) {
-                    if (row_tally.find(row.size()) != row_tally.end()) {
-                        row_tally[row.size()]++;
-                    }
-                    else {
-                        row_tally[row.size()] = 1;
-                        row_when[row.size()] = i;
-                    }
+        CSV_INLINE Compression detect_compression(csv::string_view filename) {
+            std::ifstream file(filename.data(), std::ios::binary);
+            unsigned char magic[4] = { 0, 0, 0, 0 };
+            file.read((char*)magic, sizeof(magic));
+
+            if (magic[0] == 0x1F && magic[1] == 0x8B)
+                return Compression::GZIP;
+
+            if (magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+                return Compression::ZSTD;
+
+            return Compression::NONE;
+        }
+
+        CSV_INLINE std::string get_compressed_head(csv::string_view filename, Compression compression) {
+            const size_t bytes = 500000;
+            std::string head(bytes, '\0');
+            size_t total = 0;
+
+            if (compression == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+                gzFile file = gzopen(filename.data(), "rb");
+                if (!file)
+                    throw std::runtime_error("Cannot open file " + std::string(filename));
+
+                int n_read = gzread(file, &head[0], (unsigned)bytes);
+                gzclose(file);
+
+                if (n_read > 0) total = (size_t)n_read;
+#else
+                throw std::runtime_error("File " + std::string(filename) +
+                    " is gzip-compressed, but this library was built without zlib support.");
+#endif
+            }
+            else if (compression == Compression::ZSTD) {
+#ifdef CSV_HAS_ZSTD
+                std::ifstream file(filename.data(), std::ios::binary);
+                std::string raw((std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+
+                ZSTD_DStream* stream = ZSTD_createDStream();
+                ZSTD_inBuffer in_buf = { raw.data(), raw.size(), 0 };
+                ZSTD_outBuffer out_buf = { &head[0], bytes, 0 };
+
+                while (out_buf.pos < out_buf.size && in_buf.pos < in_buf.size) {
+                    size_t ret = ZSTD_decompressStream(stream, &out_buf, &in_buf);
+                    if (ZSTD_isError(ret) || ret == 0) break;
                 }
+
+                ZSTD_freeDStream(stream);
+                total = out_buf.pos;
+#else
+                throw std::runtime_error("File " + std::string(filename) +
+                    " is zstd-compressed, but this library was built without zstd support.");
+#endif
             }
 
-            // Most common numbers of columns
-            auto max = std::max_element(row_tally.begin(), row_tally.end(),
-                [](const std::pair<size_t, size_t>& x,
-                    const std::pair<size_t, size_t>& y) {
-                        return x.second < y.second; });
+            head.resize(total);
+            return head;
+        }
+    }
 
-            return {
-                (double)(max->first * max->second),
-                row_when[max->first]
-            };
+    /** Return a CSV's column names
+     *
+     *  @param[in] filename  Path to CSV file
+     *  @param[in] format    Format of the CSV file
+     *
+     */
+    /** Render all four pipeline histograms as one JSON object keyed by
+     *  stage name, each with summary statistics and the raw bucket counts
+     */
+    CSV_INLINE std::string CSVReaderTrace::to_json() const {
+        auto histogram = [](const LatencyHistogram& hist) {
+            std::string ret = "{\"count\":" + std::to_string(hist.count)
+                + ",\"total_ns\":" + std::to_string(hist.total_ns)
+                + ",\"min_ns\":" + std::to_string(hist.min_ns)
+                + ",\"max_ns\":" + std::to_string(hist.max_ns)
+                + ",\"p50_ns\":" + std::to_string(hist.percentile_ns(0.5))
+                + ",\"p99_ns\":" + std::to_string(hist.percentile_ns(0.99))
+                + ",\"buckets\":[";
+
+            for (size_t i = 0; i < LatencyHistogram::N_BUCKETS; i++) {
+                if (i > 0) ret += ',';
+                ret += std::to_string(hist.buckets[i]);
+            }
+
+            return ret + "]}";
+        };
+
+        return "{\"read\":" + histogram(this->read)
+            + ",\"parse\":" + histogram(this->parse)
+            + ",\"queue_full\":" + histogram(this->queue_full)
+            + ",\"queue_empty\":" + histogram(this->queue_empty) + "}";
+    }
+
+    CSV_INLINE std::vector<std::string> get_col_names(csv::string_view filename, CSVFormat format) {
+        auto head = internals::get_csv_head(filename);
+
+        /** Guess delimiter and header row using the head we already read */
+        if (format.guess_delim()) {
+            auto guess_result = internals::_guess_format(head, format.get_possible_delims());
+            format.delimiter(guess_result.delim).header_row(guess_result.header_row);
         }
 
-        /** Guess the delimiter used by a delimiter-separated values file */
-        CSV_INLINE CSVGuessResult _guess_format(csv::string_view head, const std::vector<char>& delims) {
-            /** For each delimiter, find out which row length was most common.
-             *  The delimiter with the longest mode row length wins.
-             *  Then, the line number of the header row is the first row with
-             *  the mode row length.
-             */
+        return internals::_get_col_names(head, format);
+    }
 
-            CSVFormat format;
-            size_t max_score = 0,
-                   header = 0;
-            char current_delim = delims[0];
+    /** Guess the delimiter used by a delimiter-separated values file */
+    CSV_INLINE CSVGuessResult guess_format(csv::string_view filename, const std::vector<char>& delims) {
+        auto head = internals::get_csv_head(filename);
+        return internals::_guess_format(head, delims);
+    }
+
+    /** Allows parsing in-memory sources (by calling feed() and end_feed()). */
+    CSV_INLINE CSVReader::CSVReader(CSVFormat format) :
+        unicode_bom_scan(!format.unicode_detect), feed_state(new ThreadedReadingState)  {
+        if (!format.col_names.empty()) {
+            if (!format.selected_cols.empty()) {
+                this->set_col_names(this->apply_projection(format.col_names, format.selected_cols));
+            }
+            else {
+                this->set_col_names(format.col_names);
+            }
+        }
+        else if (!format.selected_cols.empty()) {
+            throw std::runtime_error("Cannot select columns when parsing in-memory"
+                " sources without explicit column names.");
+        }
+
+        this->set_parse_flags(format);
+    }
+
+    /** Allows reading a CSV file in chunks, using overlapped
+     *  threads for simulatenously reading from disk and parsing.
+     *  Rows should be retrieved with read_row() or by using
+     *  CSVReader::iterator.
+     *
+     *  **Details:** Reads the first 500kB of a CSV file to infer file information
+     *              such as column names and delimiting character.
+     *
+     *  @param[in] filename  Path to CSV file
+     *  @param[in] format    Format of the CSV file
+     *
+     *  \snippet tests/test_read_csv.cpp CSVField Example
+     *
+     */
+    CSV_INLINE CSVReader::CSVReader(csv::string_view filename, CSVFormat format, IOMode io_mode) :
+        feed_state(new ThreadedReadingState), io_mode(io_mode) {
+        this->compression = internals::detect_compression(filename);
 
-            for (char cand_delim : delims) {
-                auto result = calculate_score(head, format.delimiter(cand_delim));
+        auto head = this->compression == Compression::NONE
+            ? internals::get_csv_head(filename)
+            : internals::get_compressed_head(filename, this->compression);
 
-                if (result.score > max_score) {
-                    max_score = result.score;
-                    current_delim = cand_delim;
-                    header = result.header;
-                }
-            }
+        /** Guess delimiter and header row */
+        if (format.guess_delim()) {
+            auto guess_result = internals::_guess_format(head, format.possible_delimiters);
+            format.delimiter(guess_result.delim);
+            format.header = guess_result.header_row;
 
-            return { current_delim, (int)header };
+            // Only trust quote-free detection when the sample covered the
+            // whole file (the head is capped at 500 KB by get_csv_head());
+            // a quoted field past the sampled head would otherwise mis-parse
+            if (guess_result.no_quote && head.size() < 500000)
+                format.quote(false);
         }
 
-        CSV_INLINE BufferPtr parse(const ParseData& data) {
-            using internals::ParseFlags;
+        auto full_names = format.col_names.empty()
+            ? internals::_get_col_names(head, format)
+            : format.col_names;
 
-            // Optimizations
-            auto * HEDLEY_RESTRICT parse_flags = data.parse_flags.data();
-            auto * HEDLEY_RESTRICT ws_flags = data.ws_flags.data();
-            auto& in = data.in;
-            auto& row_buffer = *(data.row_buffer.get());
-            auto& text_buffer = row_buffer.buffer;
-            auto& split_buffer = row_buffer.split_buffer;
-            text_buffer.reserve(data.in.size());
-            split_buffer.reserve(data.in.size() / 10);
+        if (!format.selected_cols.empty()) {
+            this->set_col_names(this->apply_projection(full_names, format.selected_cols));
+        }
+        else {
+            this->set_col_names(full_names);
+        }
 
-            for (size_t i = 0; i < in.size(); i++) {
-                switch (parse_flags[data.in[i] + 128]) {
-                case ParseFlags::DELIMITER:
-                    if (!data.quote_escape) {
-                        split_buffer.push_back((internals::StrBufferPos)row_buffer.size());
-                        break;
-                    }
+        this->set_parse_flags(format);
 
-                    HEDLEY_FALL_THROUGH;
-                case ParseFlags::NEWLINE:
-                    if (!data.quote_escape) {
-                        // End of record -> Write record
-                        if (i + 1 < in.size() && in[i + 1] == '\n') // Catches CRLF (or LFLF)
-                            ++i;
+        if (this->io_mode == IOMode::MMAP) {
+            this->open_mmap(filename);
+        }
+        else {
+            this->fopen(filename);
+        }
+    }
 
-                        data.records.push_back(CSVRow(data.row_buffer));
-                        break;
-                    }
+    /** Point this reader at another file, resetting per-file state while
+     *  keeping every reusable structure warm
+     *
+     *  @see CSVReader::open() in csv_reader.hpp for usage notes
+     */
+    CSV_INLINE void CSVReader::open(csv::string_view filename, IOMode io_mode) {
+        // Note: an unresolved guessing format cannot reach this point; the
+        // in-memory constructor already rejects it, and the file constructor
+        // locks in its guess. this->format is always concrete here.
+        if (!this->format.selected_cols.empty() && this->format.col_names.empty())
+            throw std::runtime_error("Cannot reuse a reader that projects columns"
+                " resolved against one file's header; provide explicit column names.");
 
-                    // Treat as regular character
-                    text_buffer += in[i];
-                    break;
-                case ParseFlags::NOT_SPECIAL: {
-                    size_t start, end;
+        if (this->prefetch_thread.joinable())
+            this->prefetch_thread.join();
 
-                    if (!parse_not_special(
-                        in,
-                        parse_flags,
-                        ws_flags,
-                        i,
-                        start,
-                        end
-                    )) {
-                        break;
-                    }
+        this->close();
 
-                    // Finally append text
-#ifdef CSV_HAS_CXX17
-                    text_buffer += in.substr(start, end - start + 1);
-#else
-                    for (; start < end + 1; start++) {
-                        text_buffer += in[start];
-                    }
-#endif
+        // Per-file parser state. The parse and whitespace flag tables, the
+        // buffer pool, and the threading state all carry over untouched.
+        this->records.clear();
+        this->staging_records.clear();
+        this->use_staging = false;
+        this->quote_escape = false;
+        this->header_trimmed = false;
+        this->unicode_bom_scan = !this->format.unicode_detect;
+        this->utf8_bom = false;
+        this->num_rows = 0;
+        this->metrics_data = CSVReaderMetrics();
+        this->trace_data = CSVReaderTrace();
+        this->unicode_state = internals::UnicodeValidator();
+        this->feed_state->queued_bytes = 0;
+        this->feed_state->parsed_rows = 0;
+
+        this->compression = internals::detect_compression(filename);
+
+        // Column names fixed by the format survive across files; otherwise
+        // the new file's header row supplies them. Rows from previous files
+        // keep their own ColNames, so a fresh one is allocated rather than
+        // mutated underneath them.
+        if (this->format.col_names.empty()) {
+            this->col_names = std::make_shared<internals::ColNames>();
+
+            auto head = this->compression == Compression::NONE
+                ? internals::get_csv_head(filename)
+                : internals::get_compressed_head(filename, this->compression);
+
+            this->set_col_names(internals::_get_col_names(head, this->format));
+        }
 
-                    break;
-                }
-                default: // Quote
-                    if (!data.quote_escape) {
-                        // Don't deref past beginning
-                        if (i && parse_flags[in[i - 1] + 128] >= ParseFlags::DELIMITER) {
-                            // Case: Previous character was delimiter or newline
-                            data.quote_escape = true;
-                        }
-                    }
-                    else if (i + 1 < in.size()) {
-                        auto next_ch = parse_flags[in[i + 1] + 128];
-                        if (next_ch >= ParseFlags::DELIMITER) {
-                            // Case: Delim or newline => end of field
-                            data.quote_escape = false;
-                            break;
-                        }
+        this->record_buffer = this->buffer_pool.lease(this->col_names);
 
-                        // Case: Escaped quote
-                        text_buffer += in[i];
+        // A row filter's header bypass re-arms for the new file's header
+        if (this->row_filter.predicate)
+            this->row_filter.bypass_rows = (RowCount)this->format.header + 1;
 
-                        // Note: Unescaped single quotes can be handled by the parser
-                        if (next_ch == ParseFlags::QUOTE)
-                            ++i;  // Case: Two consecutive quotes
-                    }
+        // Per-file I/O state
+        this->mmap_pos = 0;
+        this->mmap_len = 0;
+        this->async_done = false;
+        this->decompress_done = false;
+        this->compressed_len = 0;
+        this->compressed_pos = 0;
 
-                    break;
-                }
-            }
+        this->io_mode = io_mode;
 
-            return row_buffer.reset();
+        if (this->io_mode == IOMode::MMAP) {
+            this->open_mmap(filename);
         }
+        else {
+            this->fopen(filename);
+        }
+    }
 
-        CSV_INLINE std::string get_csv_head(csv::string_view filename) {
-            const size_t bytes = 500000;
-            std::ifstream infile(filename.data());
-            if (!infile.is_open()) {
-                throw std::runtime_error("Cannot open file " + std::string(filename));
-            }
-
-            std::unique_ptr<char[]> buffer(new char[bytes + 1]);
-            char * head_buffer = buffer.get();
+    /** Return the format of the original raw CSV */
+    CSV_INLINE CSVFormat CSVReader::get_format() const {
+        CSVFormat new_format = this->format;
 
-            for (size_t i = 0; i < bytes + 1; i++) {
-                head_buffer[i] = '\0';
-            }
+        // Since users are normally not allowed to set 
+        // column names and header row simulatenously,
+        // we will set the backing variables directly here
+        new_format.col_names = this->col_names->get_col_names();
+        new_format.header = this->format.header;
 
-            infile.read(head_buffer, bytes);
-            return std::string(head_buffer);
-        }
+        return new_format;
     }
-}
-/** @file
- *  Defines an input iterator for csv::CSVReader
- */
 
-
-namespace csv {
-    /** Return an iterator to the first row in the reader */
-    CSV_INLINE CSVReader::iterator CSVReader::begin() {
-        if (this->records.empty()) {
-            this->read_csv();
+    /** Return the CSV's column names as a vector of strings. */
+    CSV_INLINE std::vector<std::string> CSVReader::get_col_names() const {
+        if (this->col_names) {
+            return this->col_names->get_col_names();
         }
 
-        CSVReader::iterator ret(this, std::move(this->records.front()));
-        this->records.pop_front();
-        return ret;
+        return std::vector<std::string>();
     }
 
-    /** A placeholder for the imaginary past the end row in a CSV.
-     *  Attempting to deference this will lead to bad things.
+    /** Return the index of the column name if found or
+     *         csv::CSV_NOT_FOUND otherwise.
      */
-    CSV_INLINE HEDLEY_CONST CSVReader::iterator CSVReader::end() const {
-        return CSVReader::iterator();
-    }
-
-    /////////////////////////
-    // CSVReader::iterator //
-    /////////////////////////
+    CSV_INLINE int CSVReader::index_of(csv::string_view col_name) const {
+        auto _col_names = this->get_col_names();
+        for (size_t i = 0; i < _col_names.size(); i++)
+            if (_col_names[i] == col_name) return (int)i;
 
-    CSV_INLINE CSVReader::iterator::iterator(CSVReader* _daddy, CSVRow&& _row) :
-        daddy(_daddy) {
-        row = std::move(_row);
+        return CSV_NOT_FOUND;
     }
 
-    /** Advance the iterator by one row. If this CSVReader has an
-     *  associated file, then the iterator will lazily pull more data from
-     *  that file until EOF.
+    /** Resolve a column name to a reusable handle.
+     *
+     *  The hash lookup happens once, here; every subsequent
+     *  `row[handle]` access is a bounds-checked integer index. Use this
+     *  for loops that retrieve the same columns by name on every row.
+     *
+     *  @throws std::runtime_error If no such column exists
+     *  @see CSVRow::operator[](const ColumnHandle&)
      */
-    CSV_INLINE CSVReader::iterator& CSVReader::iterator::operator++() {
-        if (!daddy->read_row(this->row)) {
-            this->daddy = nullptr; // this == end()
+    CSV_INLINE ColumnHandle CSVReader::column(const std::string& col_name) const {
+        const int idx = this->col_names ? this->col_names->index_of(col_name) : CSV_NOT_FOUND;
+        if (idx == CSV_NOT_FOUND) {
+            throw std::runtime_error("Can't find a column named " + col_name);
         }
 
-        return *this;
+        return ColumnHandle((size_t)idx, col_name, this->col_names);
     }
 
-    /** Post-increment iterator */
-    CSV_INLINE CSVReader::iterator CSVReader::iterator::operator++(int) {
-        auto temp = *this;
-        if (!daddy->read_row(this->row)) {
-            this->daddy = nullptr; // this == end()
-        }
-
-        return temp;
+    CSV_INLINE void CSVReader::feed(WorkItem&& buff) {
+        this->feed( csv::string_view(buff.first.get(), buff.second) );
     }
-}
-/** @file
- *  Defines the data type used for storing information about a CSV row
- */
-
-#include <cassert>
-#include <functional>
 
-namespace csv {
-    /** Return a string view of the nth field
+    /** Parse a CSV-formatted string.
      *
-     *  @complexity
-     *  Constant
+     *  @par Usage
+     *  Incomplete CSV fragments can be joined together by calling feed() on them sequentially.
      *
-     *  @throws
-     *  std::runtime_error If n is out of bounds
+     *  @note
+     *  `end_feed()` should be called after the last string.
      */
-    CSV_INLINE csv::string_view CSVRow::get_string_view(size_t n) const {
-        csv::string_view ret(this->row_str());
+    CSV_INLINE void CSVReader::feed(csv::string_view in) {
+        this->metrics_data.chunks_fed++;
+        this->metrics_data.bytes_parsed += in.size();
 
-        // First assume that field comprises entire row, then adjust accordingly
-        size_t beg = 0,
-            end = this->row_str().size(),
-            r_size = this->size();
+        /** Handle possible Unicode byte order mark */
+        if (!this->unicode_bom_scan) {
+            if (in[0] == '\xEF' && in[1] == '\xBB' && in[2] == '\xBF') {
+                in.remove_prefix(3); // Remove BOM from input string
+                this->utf8_bom = true;
+            }
 
-        if (n >= r_size)
-            throw std::runtime_error("Index out of bounds.");
+            this->unicode_bom_scan = true;
+        }
 
-        if (r_size > 1) {
-            if (n == 0) {
-                end = this->split_at(0);
-            }
-            else if (r_size == 2) {
-                beg = this->split_at(0);
-            }
-            else {
-                beg = this->split_at(n - 1);
-                if (n != r_size - 1) end = this->split_at(n);
+        /** Input may only be split across threads where the quote state at each
+         *  candidate boundary is known. Rather than guess, only engage the parallel
+         *  path when the chunk provably contains no quoted fields; everything else
+         *  takes the serial path below.
+         */
+        const size_t n_threads = (size_t)this->format.get_n_threads();
+        const bool parallelizable = n_threads > 1
+            && !this->quote_escape
+            && !this->row_filter.predicate // Filters are evaluated serially
+            && in.size() >= 2 * internals::PARALLEL_SLICE_MIN
+            && (!this->format.is_quoting_enabled()
+                || in.find(this->format.get_quote_char()) == csv::string_view::npos);
+
+        if (parallelizable) {
+            this->feed_parallel(in, n_threads);
+        }
+        else {
+            this->parse_chunk(in);
+        }
+
+        if (!this->header_trimmed) {
+            auto& sink = this->use_staging ? this->staging_records : this->records;
+            for (int i = 0; i <= this->format.header && !sink.empty(); i++) {
+                if (i == this->format.header && this->col_names->empty()) {
+                    this->set_col_names(sink.front());
+                }
+
+                sink.pop_front();
             }
+
+            this->header_trimmed = true;
         }
-        
-        return ret.substr(
-            beg,
-            end - beg // Number of characters
-        );
     }
 
-    /** Return a CSVField object corrsponding to the nth value in the row.
-     *
-     *  @note This method performs bounds checking, and will throw an
-     *        `std::runtime_error` if n is invalid.
-     *
-     *  @complexity
-     *  Constant, by calling csv::CSVRow::get_csv::string_view()
+    /** Parse one chunk of input into records using the runtime-dispatched parser */
+    CSV_INLINE void CSVReader::parse_chunk(csv::string_view in) {
+        // Quote-free formats without trimming, projection, or filtering take
+        // the two-symbol fast lane, which skips quote tracking entirely
+        if (this->format.no_quote && this->format.trim_chars.empty()
+            && this->projection.mask.empty() && !this->row_filter.predicate) {
+            this->record_buffer = internals::parse_no_quote({
+                in,
+                this->parse_flags,
+                this->ws_flags,
+                this->record_buffer,
+                this->quote_escape,
+                this->use_staging ? this->staging_records : this->records
+            }, &this->buffer_pool, &this->metrics_data.peak_buffer_bytes);
+
+            return;
+        }
+
+        this->record_buffer = internals::parse({
+            in,
+            this->parse_flags,
+            this->ws_flags,
+            this->record_buffer,
+            this->quote_escape,
+            this->use_staging ? this->staging_records : this->records
+        }, &this->buffer_pool,
+            this->projection.mask.empty() ? nullptr : &this->projection,
+            this->row_filter.predicate ? &this->row_filter : nullptr,
+            &this->metrics_data.peak_buffer_bytes);
+    }
+
+    /** Keep only rows matching the given predicate
      *
+     *  @see CSVReader::set_row_filter
      */
-    CSV_INLINE CSVField CSVRow::operator[](size_t n) const {
-        return CSVField(this->get_string_view(n));
+    CSV_INLINE void CSVReader::set_row_filter(
+        std::function<bool(const std::vector<csv::string_view>&)> predicate) {
+        this->row_filter.predicate = std::move(predicate);
+
+        // The header row (and anything before it) is never filtered
+        this->row_filter.bypass_rows = this->header_trimmed
+            ? 0 : (RowCount)this->format.header + 1;
     }
 
-    /** Retrieve a value by its associated column name. If the column
-     *  specified can't be round, a runtime error is thrown.
+    /** Parse one chunk of input on multiple threads
      *
-     *  @complexity
-     *  Constant. This calls the other CSVRow::operator[]() after
-     *  converting column names into indices using a hash table.
+     *  Slices are aligned on newline boundaries, so every row except possibly
+     *  the last one of the final slice is wholly contained in one slice. Each
+     *  worker parses into a private RawRowBuffer and row queue; results are
+     *  merged into CSVReader::records in their original order.
      *
-     *  @param[in] col_name The column to look for
+     *  @pre The chunk contains no quoted fields and the parser is not
+     *       currently inside one (see CSVReader::feed())
      */
-    CSV_INLINE CSVField CSVRow::operator[](const std::string& col_name) const {
-        auto & col_names = this->buffer->col_names;
-        auto col_pos = col_names->index_of(col_name);
-        if (col_pos > -1) {
-            return this->operator[](col_pos);
+    CSV_INLINE void CSVReader::feed_parallel(csv::string_view in, size_t n_threads) {
+        // Don't create more slices than can pull their own weight
+        n_threads = std::min(n_threads, in.size() / internals::PARALLEL_SLICE_MIN);
+
+        // Find newline-aligned slice boundaries
+        std::vector<size_t> bounds = { 0 };
+        for (size_t k = 1; k < n_threads; k++) {
+            size_t target = (in.size() * k) / n_threads;
+            if (target < bounds.back()) continue;
+
+            size_t newline_pos = in.find('\n', target);
+            if (newline_pos == csv::string_view::npos) break;
+
+            // Slices begin just after a newline
+            if (newline_pos + 1 < in.size() && newline_pos + 1 > bounds.back())
+                bounds.push_back(newline_pos + 1);
         }
 
-        throw std::runtime_error("Can't find a column named " + col_name);
-    }
+        bounds.push_back(in.size());
+        const size_t n_slices = bounds.size() - 1;
+
+        // Per-slice parser state: the first slice continues the row left
+        // unfinished by the previous chunk
+        std::vector<internals::BufferPtr> buffers = { this->record_buffer };
+        for (size_t k = 1; k < n_slices; k++)
+            buffers.push_back(internals::BufferPtr(new internals::RawRowBuffer(this->col_names)));
+
+        std::vector<internals::RecordRing> slice_records(n_slices);
+        std::vector<internals::BufferPtr> leftovers(n_slices);
+        std::unique_ptr<bool[]> slice_escapes(new bool[n_slices]());
+
+        // Later slices start on fresh rows; the first continues the row (and
+        // projection position) left unfinished by the previous chunk
+        const bool project = !this->projection.mask.empty();
+        std::vector<internals::ProjectionState> slice_projections;
+        if (project) {
+            slice_projections.resize(n_slices);
+            for (auto& state : slice_projections)
+                state.mask = this->projection.mask;
+
+            slice_projections.front() = this->projection;
+        }
 
-    CSV_INLINE CSVRow::operator std::vector<std::string>() const {
+        std::vector<std::thread> pool;
+        for (size_t k = 0; k < n_slices; k++) {
+            pool.push_back(std::thread([&, k] {
+                leftovers[k] = internals::parse({
+                    in.substr(bounds[k], bounds[k + 1] - bounds[k]),
+                    this->parse_flags,
+                    this->ws_flags,
+                    buffers[k],
+                    slice_escapes[k],
+                    slice_records[k]
+                }, nullptr, project ? &slice_projections[k] : nullptr);
+            }));
+        }
 
-        std::vector<std::string> ret;
-        for (size_t i = 0; i < size(); i++)
-            ret.push_back(std::string(this->get_string_view(i)));
+        for (auto& worker : pool)
+            worker.join();
 
-        return ret;
+        // Merge rows in order; only the final slice may leave a row in progress
+        auto& sink = this->use_staging ? this->staging_records : this->records;
+        for (auto& slice : slice_records)
+            for (auto& row : slice)
+                sink.push_back(std::move(row));
+
+        this->record_buffer = leftovers.back();
+        this->quote_escape = slice_escapes[n_slices - 1];
+
+        if (project)
+            this->projection = slice_projections.back();
     }
 
-#pragma region CSVRow Iterator
-    /** Return an iterator pointing to the first field. */
-    CSV_INLINE CSVRow::iterator CSVRow::begin() const {
-        return CSVRow::iterator(this, 0);
+    CSV_INLINE void CSVReader::end_feed() {
+        /** Indicate that there is no more data to receive,
+         *  and handle the last row
+         */
+        if (this->record_buffer->size() > 0) {
+            bool keep = true;
+            if (this->row_filter.predicate) {
+                if (this->row_filter.bypass_rows > 0) {
+                    this->row_filter.bypass_rows--;
+                }
+                else {
+                    this->record_buffer->get_current_row(this->row_filter.scratch);
+                    keep = this->row_filter.predicate(this->row_filter.scratch);
+                }
+            }
+
+            if (keep) {
+                auto& sink = this->use_staging ? this->staging_records : this->records;
+                sink.push_back(CSVRow(this->record_buffer));
+            }
+        }
     }
 
-    /** Return an iterator pointing to just after the end of the CSVRow.
-     *
-     *  @warning Attempting to dereference the end iterator results
-     *           in dereferencing a null pointer.
+    /** Worker thread for read_csv() which parses CSV rows (while the main
+     *  thread pulls data from disk)
      */
-    CSV_INLINE CSVRow::iterator CSVRow::end() const {
-        return CSVRow::iterator(this, (int)this->size());
-    }
+    CSV_INLINE void CSVReader::read_csv_worker() {
+        while (true) {
+            WorkItem in;
+            if (!this->feed_state->feed_buffer.try_pop(in)) { // Queue empty
+                const auto wait_start = std::chrono::steady_clock::now();
+                while (!this->feed_state->feed_buffer.try_pop(in))
+                    std::this_thread::yield();
 
-    CSV_INLINE CSVRow::reverse_iterator CSVRow::rbegin() const {
-        return std::reverse_iterator<CSVRow::iterator>(this->end());
-    }
+                std::chrono::duration<double> waited =
+                    std::chrono::steady_clock::now() - wait_start;
+                this->metrics_data.worker_wait_sec += waited.count();
 
-    CSV_INLINE CSVRow::reverse_iterator CSVRow::rend() const {
-        return std::reverse_iterator<CSVRow::iterator>(this->begin());
+                CSV_TRACE_STOP(this->trace_data.queue_empty, wait_start);
+            }
+
+            // Nullptr --> Die
+            if (!in.first) break;
+
+            CSV_TRACE_START(parse_start);
+            this->feed(csv::string_view(in.first.get(), in.second));
+            CSV_TRACE_STOP(this->trace_data.parse, parse_start);
+
+            this->feed_state->queued_bytes -= in.second;
+            this->feed_state->parsed_rows.store((this->use_staging ? this->staging_records : this->records).size());
+
+            // Hand the consumed chunk buffer back to the reader thread for
+            // reuse; if the return lane is full, the buffer is simply freed
+            this->feed_state->recycle_buffer.try_push(std::move(in));
+        }
     }
 
-    CSV_INLINE size_t CSVRow::split_at(size_t n) const
+    CSV_INLINE void CSVReader::set_parse_flags(const CSVFormat& format)
     {
-        return this->buffer->split_buffer[this->data.col_pos.start + n];
-    }
+        this->format = format;
+        if (format.no_quote) {
+            this->parse_flags = internals::make_parse_flags(format.get_delim());
+        }
+        else {
+            this->parse_flags = internals::make_parse_flags(format.get_delim(), format.quote_char);
+        }
 
-    CSV_INLINE HEDLEY_NON_NULL(2)
-    CSVRow::iterator::iterator(const CSVRow* _reader, int _i)
-        : daddy(_reader), i(_i) {
-        if (_i < (int)this->daddy->size())
-            this->field = std::make_shared<CSVField>(
-                this->daddy->operator[](_i));
-        else
-            this->field = nullptr;
+        this->ws_flags = internals::make_ws_flags(format.trim_chars.data(), format.trim_chars.size());
     }
 
-    CSV_INLINE CSVRow::iterator::reference CSVRow::iterator::operator*() const {
-        return *(this->field.get());
-    }
+    CSV_INLINE void CSVReader::fopen(csv::string_view filename) {
+        // Decompression is pull-based, so compressed input always takes the
+        // portable stdio path, as do builds without liburing
+        if (this->io_mode == IOMode::ASYNC) {
+#ifdef CSV_HAS_IO_URING
+            if (this->compression == Compression::NONE) {
+                this->async_ctx = (void*)new internals::UringReader(filename);
+                return;
+            }
+#endif
+            this->io_mode = IOMode::STDIO;
+        }
 
-    CSV_INLINE CSVRow::iterator::pointer CSVRow::iterator::operator->() const {
-        // Using CSVField * as pointer type causes segfaults in MSVC debug builds
-        #ifdef _MSC_BUILD
-        return this->field;
-        #else
-        return this->field.get();
-        #endif
-    }
+        // Compressed files are decompressed on the fly by read_chunk();
+        // gzip streams are handled entirely by zlib's gzFile interface
+        if (this->compression == Compression::GZIP) {
+            this->init_decompression(filename);
+            return;
+        }
 
-    CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator++() {
-        // Pre-increment operator
-        this->i++;
-        if (this->i < (int)this->daddy->size())
-            this->field = std::make_shared<CSVField>(
-                this->daddy->operator[](i));
-        else // Reached the end of row
-            this->field = nullptr;
-        return *this;
-    }
+        if (!this->infile) {
+#ifdef _MSC_BUILD
+            // Silence compiler warnings in Microsoft Visual C++
+            size_t err = fopen_s(&(this->infile), filename.data(), "rb");
+            if (err)
+                throw std::runtime_error("Cannot open file " + std::string(filename));
+#else
+            this->infile = std::fopen(filename.data(), "rb");
+            if (!this->infile)
+                throw std::runtime_error("Cannot open file " + std::string(filename));
+#endif
+        }
 
-    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator++(int) {
-        // Post-increment operator
-        auto temp = *this;
-        this->operator++();
-        return temp;
+        if (this->compression == Compression::ZSTD)
+            this->init_decompression(filename);
     }
 
-    CSV_INLINE CSVRow::iterator& CSVRow::iterator::operator--() {
-        // Pre-decrement operator
-        this->i--;
-        this->field = std::make_shared<CSVField>(
-            this->daddy->operator[](this->i));
-        return *this;
-    }
+    /** Open the decompression stream matching this->compression
+     *
+     *  @throws std::runtime_error if the required codec was not compiled in
+     */
+    CSV_INLINE void CSVReader::init_decompression(csv::string_view filename) {
+        if (this->compression == Compression::GZIP) {
+#ifdef CSV_HAS_ZLIB
+            gzFile file = gzopen(filename.data(), "rb");
+            if (!file)
+                throw std::runtime_error("Cannot open file " + std::string(filename));
 
-    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator--(int) {
-        // Post-decrement operator
-        auto temp = *this;
-        this->operator--();
-        return temp;
-    }
-    
-    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator+(difference_type n) const {
-        // Allows for iterator arithmetic
-        return CSVRow::iterator(this->daddy, i + (int)n);
+            // Larger internal buffer than zlib's 8 KB default
+            gzbuffer(file, 131072);
+            this->decompress_ctx = (void*)file;
+#else
+            throw std::runtime_error("File " + std::string(filename) +
+                " is gzip-compressed, but this library was built without zlib support.");
+#endif
+        }
+        else if (this->compression == Compression::ZSTD) {
+#ifdef CSV_HAS_ZSTD
+            this->decompress_ctx = (void*)ZSTD_createDStream();
+            this->compressed_buffer = std::unique_ptr<char[]>(
+                new char[internals::COMPRESSED_CHUNK_SIZE]);
+#else
+            throw std::runtime_error("File " + std::string(filename) +
+                " is zstd-compressed, but this library was built without zstd support.");
+#endif
+        }
     }
 
-    CSV_INLINE CSVRow::iterator CSVRow::iterator::operator-(difference_type n) const {
-        // Allows for iterator arithmetic
-        return CSVRow::iterator::operator+(-n);
+    /** Read up to n bytes of plaintext into `out`, stream-decompressing
+     *  compressed input as necessary
+     */
+    CSV_INLINE size_t CSVReader::read_chunk(char* out, size_t n) {
+        switch (this->compression) {
+#ifdef CSV_HAS_ZLIB
+        case Compression::GZIP: {
+            int n_read = gzread((gzFile)this->decompress_ctx, out, (unsigned)n);
+            if (n_read <= 0 || gzeof((gzFile)this->decompress_ctx))
+                this->decompress_done = true;
+
+            return n_read > 0 ? (size_t)n_read : 0;
+        }
+#endif
+#ifdef CSV_HAS_ZSTD
+        case Compression::ZSTD: {
+            auto* stream = (ZSTD_DStream*)this->decompress_ctx;
+            ZSTD_outBuffer out_buf = { out, n, 0 };
+
+            while (out_buf.pos < out_buf.size) {
+                if (this->compressed_pos >= this->compressed_len) {
+                    this->compressed_len = std::fread(this->compressed_buffer.get(), 1,
+                        internals::COMPRESSED_CHUNK_SIZE, this->infile);
+                    this->compressed_pos = 0;
+
+                    if (this->compressed_len == 0) break; // Raw input exhausted
+                }
+
+                ZSTD_inBuffer in_buf = {
+                    this->compressed_buffer.get() + this->compressed_pos,
+                    this->compressed_len - this->compressed_pos, 0
+                };
+
+                size_t ret = ZSTD_decompressStream(stream, &out_buf, &in_buf);
+                this->compressed_pos += in_buf.pos;
+
+                if (ZSTD_isError(ret))
+                    throw std::runtime_error("Corrupt zstd stream: " +
+                        std::string(ZSTD_getErrorName(ret)));
+            }
+
+            if (out_buf.pos == 0)
+                this->decompress_done = true;
+
+            return out_buf.pos;
+        }
+#endif
+        default:
+            return std::fread(out, 1, n, this->infile);
+        }
     }
-#pragma endregion CSVRow Iterator
-}
 
-/** @file
- *  Implements JSON serialization abilities
- */
+    /** Map a file into memory so parse() can run directly over its contents,
+     *  avoiding the WorkItem copies made by read_csv().
+     *
+     *  On platforms without memory mapping this quietly falls back to fopen().
+     */
+    CSV_INLINE void CSVReader::open_mmap(csv::string_view filename) {
+        // A mapping of compressed bytes is useless to the parser
+        if (this->compression != Compression::NONE) {
+            this->io_mode = IOMode::STDIO;
+            this->fopen(filename);
+            return;
+        }
 
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filename.data(), GENERIC_READ, FILE_SHARE_READ,
+            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        this->mmap_len = (size_t)file_size.QuadPart;
+
+        if (this->mmap_len > 0) {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping) {
+                this->mmap_base = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping); // View keeps the mapping alive
+            }
 
-namespace csv {
-    /*
-    The implementations for json_extra_space() and json_escape_string()
-    were modified from source code for JSON for Modern C++.
+            if (!this->mmap_base) {
+                CloseHandle(file);
+                throw std::runtime_error("Cannot memory map file " + std::string(filename));
+            }
+        }
 
-    The respective license is below:
+        CloseHandle(file);
+#elif defined(__linux__) || defined(__APPLE__)
+        // Qualified so the POSIX open(2) wins over CSVReader::open()
+        int fd = ::open(filename.data(), O_RDONLY);
+        if (fd == -1)
+            throw std::runtime_error("Cannot open file " + std::string(filename));
+
+        struct stat file_stat = {};
+        fstat(fd, &file_stat);
+        this->mmap_len = (size_t)file_stat.st_size;
+
+        if (this->mmap_len > 0) {
+            void* map = mmap(nullptr, this->mmap_len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot memory map file " + std::string(filename));
+            }
 
-    The code is licensed under the [MIT
-    License](http://opensource.org/licenses/MIT):
-    
-    Copyright &copy; 2013-2015 Niels Lohmann.
-    
-    Permission is hereby granted, free of charge, to any person
-    obtaining a copy of this software and associated documentation files
-    (the "Software"), to deal in the Software without restriction,
-    including without limitation the rights to use, copy, modify, merge,
-    publish, distribute, sublicense, and/or sell copies of the Software,
-    and to permit persons to whom the Software is furnished to do so,
-    subject to the following conditions:
-    
-    The above copyright notice and this permission notice shall be
-    included in all copies or substantial portions of the Software.
-    
-    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
-    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
-    BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-    ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
-    CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-    SOFTWARE.
-    */
+            // The parser only ever moves forward
+            madvise(map, this->mmap_len, MADV_SEQUENTIAL);
+            this->mmap_base = (const char*)map;
+        }
 
-    namespace internals {
-        /*!
-         @brief calculates the extra space to escape a JSON string
+        ::close(fd);
+#else
+        // No memory mapping facilities: use buffered reads instead
+        this->io_mode = IOMode::STDIO;
+        this->fopen(filename);
+#endif
+    }
 
-         @param[in] s  the string to escape
-         @return the number of characters required to escape string @a s
+    /**
+     *  @param[in] names Column names
+     */
+    CSV_INLINE void CSVReader::set_col_names(const std::vector<std::string>& names)
+    {
+        this->col_names->set_col_names(names);
+        this->n_cols = names.size();
+    }
 
-         @complexity Linear in the length of string @a s.
-        */
-        static std::size_t json_extra_space(csv::string_view& s) noexcept
-        {
-            std::size_t result = 0;
+    /** Resolve a column selection against the full column set
+     *
+     *  @return The selected column names in file order
+     *  @throws std::runtime_error if a selected column does not exist
+     */
+    CSV_INLINE std::vector<std::string> CSVReader::apply_projection(
+        const std::vector<std::string>& full_names,
+        const std::vector<std::string>& selected)
+    {
+        for (auto& name : selected) {
+            if (std::find(full_names.begin(), full_names.end(), name) == full_names.end())
+                throw std::runtime_error("Selected column \"" + name + "\" not found.");
+        }
 
+        this->projection.mask.assign(full_names.size(), false);
 
-            for (const auto& c : s)
-            {
-                switch (c)
-                {
-                case '"':
-                case '\\':
-                case '\b':
-                case '\f':
-                case '\n':
-                case '\r':
-                case '\t':
-                {
-                    // from c (1 byte) to \x (2 bytes)
-                    result += 1;
-                    break;
-                }
+        std::vector<std::string> projected;
+        for (size_t i = 0; i < full_names.size(); i++) {
+            if (std::find(selected.begin(), selected.end(), full_names[i]) != selected.end()) {
+                this->projection.mask[i] = true;
+                projected.push_back(full_names[i]);
+            }
+        }
 
+        return projected;
+    }
 
-                default:
-                {
-                    if (c >= 0x00 && c <= 0x1f)
-                    {
-                        // from c (1 byte) to \uxxxx (6 bytes)
-                        result += 5;
-                    }
-                    break;
-                }
-                }
+    /**
+     * Parse a CSV file using multiple threads
+     *
+     * @pre CSVReader::infile points to a valid file handle, i.e. CSVReader::fopen was called
+     *
+     * @param[in] bytes Number of bytes to read.
+     * @see CSVReader::read_row()
+     */
+    CSV_INLINE void CSVReader::read_csv(const size_t& bytes) {
+        if (this->io_mode == IOMode::MMAP) {
+            this->read_csv_mmap(bytes);
+            return;
+        }
+
+        const size_t BUFFER_UPPER_LIMIT = std::min(bytes, (size_t)1000000);
+
+        // Chunk buffers are only recycled at the fixed 1 MB size, so a buffer
+        // allocated by an earlier call can never be smaller than expected
+        const bool reuse_chunks = BUFFER_UPPER_LIMIT == (size_t)1000000;
+        auto acquire_buffer = [&]() -> std::unique_ptr<char[]> {
+            WorkItem recycled;
+            if (reuse_chunks && this->feed_state->recycle_buffer.try_pop(recycled)) {
+                return std::move(recycled.first);
             }
 
+            return std::unique_ptr<char[]>(new char[BUFFER_UPPER_LIMIT]);
+        };
+
+        this->feed_state->parsed_rows.store((this->use_staging ? this->staging_records : this->records).size());
+
+        std::string unicode_error;
+        std::thread worker(&CSVReader::read_csv_worker, this);
 
-            return result;
-        }
+        // Each chunk is read straight into a WorkItem buffer in one fread()
+        // call; parse() handles chunks that end mid-row (or mid-quote) by
+        // carrying quote_escape state and the partial row between feeds
+        for (size_t processed = 0; processed < bytes; ) {
+            // Backpressure: once the row cap is hit, stop reading and let
+            // the caller drain records before the next parsing round
+            if (this->max_buffered_rows > 0
+                && this->feed_state->parsed_rows.load() >= this->max_buffered_rows)
+                break;
 
-        CSV_INLINE std::string json_escape_string(csv::string_view s) noexcept
-        {
-            const auto space = json_extra_space(s);
-            if (space == 0)
-            {
-                return std::string(s);
-            }
+            std::unique_ptr<char[]> buffer;
+            size_t n_read = 0;
 
-            // create a result string of necessary size
-            std::string result(s.size() + space, '\\');
-            std::size_t pos = 0;
+            CSV_TRACE_START(read_start);
 
-            for (const auto& c : s)
+#ifdef CSV_HAS_IO_URING
+            if (this->async_ctx) {
+                // The next chunk was already in flight while the previous
+                // ones were being parsed; its buffer is fed to the worker
+                // directly instead of being copied into a fresh WorkItem
+                WorkItem chunk = static_cast<internals::UringReader*>(this->async_ctx)->next_chunk();
+                buffer = std::move(chunk.first);
+                n_read = chunk.second;
+                this->async_done = static_cast<internals::UringReader*>(this->async_ctx)->done();
+            }
+            else
+#endif
             {
-                switch (c)
-                {
-                // quotation mark (0x22)
-                case '"':
-                {
-                    result[pos + 1] = '"';
-                    pos += 2;
-                    break;
-                }
-
+                buffer = acquire_buffer();
+                const size_t target = std::min(BUFFER_UPPER_LIMIT, bytes - processed);
+                n_read = this->read_chunk(buffer.get(), target);
+            }
 
-                // reverse solidus (0x5c)
-                case '\\':
-                {
-                    // nothing to change
-                    pos += 2;
-                    break;
-                }
+            CSV_TRACE_STOP(this->trace_data.read, read_start);
 
+            if (n_read == 0) break;
 
-                // backspace (0x08)
-                case '\b':
-                {
-                    result[pos + 1] = 'b';
-                    pos += 2;
-                    break;
-                }
+            processed += n_read;
+            this->metrics_data.bytes_read += n_read;
 
+            if (this->unicode_policy != UnicodePolicy::NONE
+                && !this->validate_chunk(buffer, n_read, BUFFER_UPPER_LIMIT, unicode_error))
+                break; // Shut the worker down cleanly before throwing
 
-                // formfeed (0x0c)
-                case '\f':
-                {
-                    result[pos + 1] = 'f';
-                    pos += 2;
-                    break;
-                }
+            // A chunk can validate to zero bytes, e.g. it held only a byte
+            // order mark, or UTF-16 output was queued by validate_chunk()
+            if (n_read == 0) continue;
 
+            this->feed_state->queued_bytes += n_read;
 
-                // newline (0x0a)
-                case '\n':
-                {
-                    result[pos + 1] = 'n';
-                    pos += 2;
-                    break;
-                }
+            WorkItem item = std::make_pair<>(std::move(buffer), n_read);
+            if (!this->feed_state->feed_buffer.try_push(std::move(item))) { // Queue full
+                CSV_TRACE_START(stall_start);
 
+                while (!this->feed_state->feed_buffer.try_push(std::move(item)))
+                    std::this_thread::yield();
 
-                // carriage return (0x0d)
-                case '\r':
-                {
-                    result[pos + 1] = 'r';
-                    pos += 2;
-                    break;
-                }
+                CSV_TRACE_STOP(this->trace_data.queue_full, stall_start);
+            }
+        }
 
+        WorkItem poison = std::make_pair<>(nullptr, 0); // Termination signal
+        while (!this->feed_state->feed_buffer.try_push(std::move(poison)))
+            std::this_thread::yield();
 
-                // horizontal tab (0x09)
-                case '\t':
-                {
-                    result[pos + 1] = 't';
-                    pos += 2;
-                    break;
-                }
+        worker.join();
 
+        if (!unicode_error.empty()) {
+            this->close();
+            throw std::runtime_error(unicode_error);
+        }
 
-                default:
-                {
-                    if (c >= 0x00 && c <= 0x1f)
-                    {
-                        // print character c as \uxxxx
-                        sprintf(&result[pos + 1], "u%04x", int(c));
-                        pos += 6;
-                        // overwrite trailing null character
-                        result[pos] = '\\';
-                    }
-                    else
-                    {
-                        // all other characters are added as-is
-                        result[pos++] = c;
-                    }
-                    break;
-                }
-                }
+        const bool exhausted = this->async_ctx
+            ? this->async_done
+            : (this->compression == Compression::NONE
+                ? std::feof(this->infile) != 0
+                : this->decompress_done);
+
+        if (exhausted) {
+            // In follow mode, EOF on a plain file only means the producer
+            // has not appended yet: clear the EOF latch so the next round's
+            // fread() sees new bytes, and keep the parser's partial state
+            // (quote_escape and any incomplete trailing line) untouched
+            if (this->follow_mode && this->infile && !this->async_ctx
+                && this->compression == Compression::NONE) {
+                std::clearerr(this->infile);
+                return;
             }
 
-            return result;
+            this->end_feed();
+            this->close();
+
+            if (this->unicode_policy == UnicodePolicy::THROW
+                && (this->unicode_state.partial_len > 0
+                    || this->unicode_state.has_odd_byte
+                    || this->unicode_state.pending_high > 0))
+                throw std::runtime_error("Input ended in the middle of a Unicode sequence.");
         }
     }
 
-    /** Convert a CSV row to a JSON object, i.e.
-     *  `{"col1":"value1","col2":"value2"}`
+    /**
+     * Parse the next chunk of a memory-mapped file in place, i.e. without
+     * copying bytes into intermediate WorkItem buffers
      *
-     *  @note All strings are properly escaped. Numeric values are not quoted.
-     *  @param[in] subset A subset of columns to contain in the JSON.
-     *                    Leave empty for original columns.
+     * @pre CSVReader::mmap_base points to a valid mapping, i.e. CSVReader::open_mmap was called
+     *
+     * @param[in] bytes Number of bytes to parse.
+     * @see CSVReader::read_csv()
      */
-    CSV_INLINE std::string CSVRow::to_json(const std::vector<std::string>& subset) const {
-        std::vector<std::string> col_names = subset;
-        if (subset.empty()) {
-            col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
-        }
-
-        const size_t _n_cols = col_names.size();
-        std::string ret = "{";
-        
-        for (size_t i = 0; i < _n_cols; i++) {
-            auto& col = col_names[i];
-            auto field = this->operator[](col);
-
-            // TODO: Possible performance enhancements by caching escaped column names
-            ret += '"' + internals::json_escape_string(col) + "\":";
+    CSV_INLINE void CSVReader::read_csv_mmap(const size_t& bytes) {
+        const size_t remaining = this->mmap_len - this->mmap_pos;
+        const size_t to_parse = std::min(bytes, remaining);
 
-            // Add quotes around strings but not numbers
-            if (field.is_num())
-                 ret += internals::json_escape_string(field.get<csv::string_view>());
-            else
-                ret += '"' + internals::json_escape_string(field.get<csv::string_view>()) + '"';
+        this->feed(csv::string_view(this->mmap_base + this->mmap_pos, to_parse));
+        this->mmap_pos += to_parse;
 
-            // Do not add comma after last string
-            if (i + 1 < _n_cols)
-                ret += ',';
+        if (this->mmap_pos >= this->mmap_len) {
+            this->end_feed();
+            this->close();
         }
-
-        ret += '}';
-        return ret;
     }
 
-    /** Convert a CSV row to a JSON array, i.e.
-     *  `["value1","value2",...]`
+    /**
+     * Validate or transcode one freshly read chunk before it is queued
+     * for parsing
      *
-     *  @note All strings are properly escaped. Numeric values are not quoted.
-     *  @param[in] subset A subset of columns to contain in the JSON.
-     *                    Leave empty for all columns.
+     * The first chunk is sniffed for a UTF-16 byte order mark; UTF-16
+     * input is transcoded into UTF-8 and queued here (possibly as several
+     * WorkItems, since transcoding can grow the byte count past one chunk),
+     * in which case n_read is set to zero and the caller queues nothing.
+     * UTF-8 input is validated in place and queued by the caller as usual.
+     *
+     * @return false when the policy is UnicodePolicy::THROW and the chunk
+     *         is malformed, with `error` describing the problem
      */
-    CSV_INLINE std::string CSVRow::to_json_array(const std::vector<std::string>& subset) const {
-        std::vector<std::string> col_names = subset;
-        if (subset.empty())
-            col_names = this->buffer ? this->buffer->col_names->get_col_names() : std::vector<std::string>();
+    CSV_INLINE bool CSVReader::validate_chunk(std::unique_ptr<char[]>& buffer,
+        size_t& n_read, size_t buffer_size, std::string& error)
+    {
+        using Encoding = internals::UnicodeValidator::Encoding;
+        const bool replace = this->unicode_policy == UnicodePolicy::REPLACE;
+        auto& state = this->unicode_state;
+        size_t offset = 0;
 
-        const size_t _n_cols = col_names.size();
-        std::string ret = "[";
+        if (state.encoding == Encoding::UNKNOWN) {
+            auto* bytes = (unsigned char*)buffer.get();
 
-        for (size_t i = 0; i < _n_cols; i++) {
-            auto field = this->operator[](col_names[i]);
+            if (n_read >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+                state.encoding = Encoding::UTF16_LE;
+                offset = 2;
+            }
+            else if (n_read >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF) {
+                state.encoding = Encoding::UTF16_BE;
+                offset = 2;
+            }
+            else {
+                // A UTF-8 byte order mark, if any, is stripped by feed()
+                state.encoding = Encoding::UTF8;
+            }
+        }
 
-            // Add quotes around strings but not numbers
-            if (field.is_num())
-                ret += internals::json_escape_string(field.get<csv::string_view>());
-            else
-                ret += '"' + internals::json_escape_string(field.get<csv::string_view>()) + '"';
+        if (state.encoding == Encoding::UTF8) {
+            const size_t bad = internals::validate_utf8_chunk(
+                state, buffer.get(), n_read, replace);
 
-            // Do not add comma after last string
-            if (i + 1 < _n_cols)
-                ret += ',';
+            if (bad != csv::string_view::npos) {
+                error = "Malformed UTF-8 at byte offset "
+                    + std::to_string(this->metrics_data.bytes_read - n_read + bad);
+                return false;
+            }
+
+            return true;
         }
 
-        ret += ']';
-        return ret;
+        std::string transcoded;
+        if (!internals::transcode_utf16_chunk(state,
+            buffer.get() + offset, n_read - offset, transcoded, replace)) {
+            error = "Malformed UTF-16 input (unpaired surrogate).";
+            return false;
+        }
+
+        // Transcoding can outgrow the original chunk, so its output is
+        // re-cut into buffer-sized pieces: every queued buffer must be the
+        // standard chunk size for recycling to stay safe
+        for (size_t pos = 0; pos < transcoded.size(); ) {
+            const size_t piece = std::min(buffer_size, transcoded.size() - pos);
+            auto piece_buf = buffer
+                ? std::move(buffer)
+                : std::unique_ptr<char[]>(new char[buffer_size]);
+
+            std::memcpy(piece_buf.get(), transcoded.data() + pos, piece);
+            pos += piece;
+
+            this->feed_state->queued_bytes += piece;
+            WorkItem item = std::make_pair<>(std::move(piece_buf), piece);
+            while (!this->feed_state->feed_buffer.try_push(std::move(item)))
+                std::this_thread::yield();
+        }
+
+        n_read = 0;
+        return true;
     }
-}
-/** @file
- *  Calculates statistics from CSV files
- */
 
-#include <string>
+    /** Close the open file handle.
+     *
+     *  @note Automatically called by ~CSVReader().
+     */
+    CSV_INLINE void CSVReader::close() {
+        if (this->infile) {
+            std::fclose(this->infile);
+            this->infile = nullptr;
+        }
 
-namespace csv {
-    CSV_INLINE CSVStat::CSVStat(csv::string_view filename, CSVFormat format) :
-        CSVReader(filename, format) {
-        /** Lazily calculate statistics for a potentially large file. Once this constructor
-         *  is called, CSVStat will process the entire file iteratively. Once finished,
-         *  methods like get_mean(), get_counts(), etc... can be used to retrieve statistics.
-         */
-        while (!this->eof()) {
-            this->read_csv(internals::ITERATION_CHUNK_SIZE);
-            this->calc();
+        if (this->decompress_ctx) {
+#if defined(CSV_HAS_ZLIB)
+            if (this->compression == Compression::GZIP)
+                gzclose((gzFile)this->decompress_ctx);
+#endif
+#if defined(CSV_HAS_ZSTD)
+            if (this->compression == Compression::ZSTD)
+                ZSTD_freeDStream((ZSTD_DStream*)this->decompress_ctx);
+#endif
+            this->decompress_ctx = nullptr;
+            this->decompress_done = true;
         }
 
-        if (!this->records.empty())
-            this->calc();
-    }
+        if (this->mmap_base) {
+#if defined(_WIN32)
+            UnmapViewOfFile((LPCVOID)this->mmap_base);
+#elif defined(__linux__) || defined(__APPLE__)
+            munmap((void*)this->mmap_base, this->mmap_len);
+#endif
+            this->mmap_base = nullptr;
+        }
 
-    CSV_INLINE void CSVStat::end_feed() {
-        CSVReader::end_feed();
-        this->calc();
+#ifdef CSV_HAS_IO_URING
+        if (this->async_ctx) {
+            delete static_cast<internals::UringReader*>(this->async_ctx);
+            this->async_ctx = nullptr;
+            this->async_done = true;
+        }
+#endif
     }
 
-    /** Return current means */
-    CSV_INLINE std::vector<long double> CSVStat::get_mean() const {
-        std::vector<long double> ret;        
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->rolling_means[i]);
+    /**
+     * Retrieve rows as CSVRow objects, returning true if more rows are available.
+     *
+     * **Performance Notes**:
+     *  - The number of rows read in at a time is determined by csv::ITERATION_CHUNK_SIZE
+     *  - For performance details, read the documentation for CSVRow and CSVField.
+     *
+     * @param[out] row The variable where the parsed row will be stored
+     * @see CSVRow, CSVField
+     *
+     * **Example:**
+     * \snippet tests/test_read_csv.cpp CSVField Example
+     *
+     */
+    CSV_INLINE void CSVReader::fill_records() {
+        if (!this->prefetch_enabled) {
+            if (this->records.empty() && !this->eof()) {
+                this->read_csv(this->iteration_chunk_size);
+            }
+
+            return;
         }
-        return ret;
-    }
 
-    /** Return current variances */
-    CSV_INLINE std::vector<long double> CSVStat::get_variance() const {
-        std::vector<long double> ret;        
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->rolling_vars[i]/(this->n[i] - 1));
+        // Ran dry: wait for the in-flight chunk and take its rows
+        if (this->records.empty() && this->prefetch_thread.joinable()) {
+            this->prefetch_thread.join();
+            this->use_staging = false;
+            std::swap(this->records, this->staging_records);
+            this->staging_records.clear();
         }
-        return ret;
-    }
 
-    /** Return current mins */
-    CSV_INLINE std::vector<long double> CSVStat::get_mins() const {
-        std::vector<long double> ret;        
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->mins[i]);
+        // Cold start: nothing has been prefetched yet
+        if (this->records.empty() && !this->eof()) {
+            this->read_csv(this->iteration_chunk_size);
         }
-        return ret;
-    }
 
-    /** Return current maxes */
-    CSV_INLINE std::vector<long double> CSVStat::get_maxes() const {
-        std::vector<long double> ret;        
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->maxes[i]);
+        /** Start refilling in the background before rows run out. While the
+         *  prefetch is in flight it owns staging_records and all file state
+         *  exclusively; this thread only drains records, and eof() is never
+         *  consulted until the prefetch has been joined.
+         */
+        if (!this->prefetch_thread.joinable()
+            && this->records.size() <= this->prefetch_low_water
+            && !this->records.empty()
+            && !this->eof()) {
+            this->use_staging = true;
+            this->prefetch_thread = std::thread([this] {
+                this->read_csv(this->iteration_chunk_size);
+            });
         }
-        return ret;
     }
 
-    /** Get counts for each column */
-    CSV_INLINE std::vector<CSVStat::FreqCount> CSVStat::get_counts() const {
-        std::vector<FreqCount> ret;
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->counts[i]);
+    CSV_INLINE bool CSVReader::read_row(CSVRow &row) {
+        this->fill_records();
+        if (this->records.empty())
+            return false; // Stop reading
+
+        while (!this->records.empty()) {
+            if (this->records.front().size() != this->n_cols) {
+                if (this->format.variable_column_policy == VariableColumnPolicy::THROW) {
+                    if (this->records.front().size() < this->n_cols) {
+                        throw std::runtime_error("Line too short " + internals::format_row(this->records.front()));
+                    }
+
+                    throw std::runtime_error("Line too long " + internals::format_row(this->records.front()));
+                }
+
+                if (this->bad_row_handler)
+                    this->bad_row_handler(this->records.front());
+
+                if (this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
+                    // Silently drop row (default)
+                    this->metrics_data.rows_dropped++;
+                    this->records.pop_front();
+                    continue;
+                }
+            }
+
+            row = std::move(this->records.front());
+            this->num_rows++;
+            this->records.pop_front();
+            return true;
         }
-        return ret;
+
+        return false;
     }
 
-    /** Get data type counts for each column */
-    CSV_INLINE std::vector<CSVStat::TypeCount> CSVStat::get_dtypes() const {
-        std::vector<TypeCount> ret;        
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            ret.push_back(this->dtypes[i]);
-        }
-        return ret;
+    /** Attempt one parsing round over newly appended bytes
+     *
+     *  @see CSVReader::set_follow
+     *  @return Whether at least one complete row is buffered
+     */
+    CSV_INLINE bool CSVReader::poll() {
+        this->fill_records();
+        return !this->records.empty();
     }
 
-    CSV_INLINE void CSVStat::calc() {
-        /** Go through all records and calculate specified statistics */
-        for (size_t i = 0; i < this->col_names->size(); i++) {
-            dtypes.push_back({});
-            counts.push_back({});
-            rolling_means.push_back(0);
-            rolling_vars.push_back(0);
-            mins.push_back(NAN);
-            maxes.push_back(NAN);
-            n.push_back(0);
+    /**
+     * Sample buffered rows and record a per-column expected DataType.
+     *
+     * After sampling, fields from columns whose type was consistent across
+     * the sample can skip full type inference, making typed extraction
+     * of homogeneous columns considerably faster. The hint is only an
+     * expectation: fields that do not match it still infer their actual
+     * type, so results never change, only speed.
+     *
+     * Null fields are ignored during sampling, and columns mixing numeric
+     * widths receive the widest observed numeric type. Columns mixing
+     * strings and numbers receive no hint.
+     *
+     * @param[in] sample_size Maximum number of rows to examine
+     */
+    CSV_INLINE void CSVReader::sample_types(size_t sample_size) {
+        if (this->records.empty() && !this->eof()) {
+            this->read_csv(this->iteration_chunk_size);
         }
 
-        std::vector<std::thread> pool;
+        const size_t _n_cols = this->col_names->size();
+        std::vector<DataType> hints(_n_cols, UNKNOWN);
+        std::vector<bool> conflicted(_n_cols, false);
+
+        size_t sampled = 0;
+        for (auto& row : this->records) {
+            if (sampled++ >= sample_size) break;
+            if (row.size() != _n_cols) continue;
+
+            for (size_t i = 0; i < _n_cols; i++) {
+                auto type = internals::data_type(row.get_string_view(i));
+                if (type == CSV_NULL) continue;
 
-        // Start threads
-        for (size_t i = 0; i < this->col_names->size(); i++)
-            pool.push_back(std::thread(&CSVStat::calc_worker, this, i));
+                if (hints[i] == UNKNOWN) {
+                    hints[i] = type;
+                }
+                else if (hints[i] != type) {
+                    // Differing numeric widths widen; anything else conflicts
+                    if (hints[i] >= CSV_INT8 && type >= CSV_INT8)
+                        hints[i] = std::max(hints[i], type);
+                    else
+                        conflicted[i] = true;
+                }
+            }
+        }
 
-        // Block until done
-        for (auto& th: pool)
-            th.join();
+        for (size_t i = 0; i < _n_cols; i++) {
+            if (conflicted[i]) hints[i] = UNKNOWN;
+        }
 
-        this->records.clear();
+        this->col_names->set_type_hints(hints);
     }
 
-    CSV_INLINE void CSVStat::calc_worker(const size_t &i) {
-        /** Worker thread for CSVStat::calc() which calculates statistics for one column.
-         * 
-         *  @param[in] i Column index
-         */
+    /**
+     * Retrieve up to n rows at once, appending them to out.
+     *
+     * Batching amortizes the per-call bookkeeping of read_row() over many rows,
+     * which helps tight ETL loops that process rows in cache-friendly blocks.
+     * Rows are subject to the same variable column policy as read_row().
+     *
+     * @param[out] out Vector the parsed rows are appended to
+     * @param[in]  n   Maximum number of rows to transfer
+     *
+     * @return Number of rows appended; 0 indicates end of file
+     * @see CSVReader::read_row()
+     */
+    CSV_INLINE size_t CSVReader::read_rows(std::vector<CSVRow>& out, size_t n) {
+        size_t transferred = 0;
 
-        auto current_record = this->records.begin();
-        for (size_t processed = 0; current_record != this->records.end(); processed++) {
-            if (current_record->size() == this->n_cols) {
-                auto current_field = (*current_record)[i];
+        // Callers may pass a huge n meaning "until EOF"; growth past the
+        // initial guess is handled by push_back as usual
+        out.reserve(out.size() + (std::min)(n, (size_t)65536));
 
-                // Optimization: Don't count() if there's too many distinct values in the first 1000 rows
-                if (processed < 1000 || this->counts[i].size() <= 500)
-                    this->count(current_field, i);
+        while (transferred < n) {
+            if (this->records.empty()) {
+                this->fill_records();
 
-                this->dtype(current_field, i);
+                // Nothing left to parse
+                if (this->records.empty()) break;
+            }
 
-                // Numeric Stuff
-                if (current_field.is_num()) {
-                    long double x_n = current_field.get<long double>();
+            // Drain the queue in one go
+            while (transferred < n && !this->records.empty()) {
+                bool keep = true;
 
-                    // This actually calculates mean AND variance
-                    this->variance(x_n, i);
-                    this->min_max(x_n, i);
-                }
-            }
-            else if (this->format.get_variable_column_policy() == VariableColumnPolicy::THROW) {
-                throw std::runtime_error("Line has different length than the others " + internals::format_row(*current_record));
-            }
+                if (this->records.front().size() != this->n_cols) {
+                    if (this->format.variable_column_policy == VariableColumnPolicy::THROW) {
+                        if (this->records.front().size() < this->n_cols) {
+                            throw std::runtime_error("Line too short " + internals::format_row(this->records.front()));
+                        }
 
-            ++current_record;
-        }
-    }
+                        throw std::runtime_error("Line too long " + internals::format_row(this->records.front()));
+                    }
 
-    CSV_INLINE void CSVStat::dtype(CSVField& data, const size_t &i) {
-        /** Given a record update the type counter
-         *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
-         */
-        
-        auto type = data.type();
-        if (this->dtypes[i].find(type) !=
-            this->dtypes[i].end()) {
-            // Increment count
-            this->dtypes[i][type]++;
-        } else {
-            // Initialize count
-            this->dtypes[i].insert(std::make_pair(type, 1));
-        }
-    }
+                    if (this->bad_row_handler)
+                        this->bad_row_handler(this->records.front());
 
-    CSV_INLINE void CSVStat::count(CSVField& data, const size_t &i) {
-        /** Given a record update the frequency counter
-         *  @param[in]  record Data observation
-         *  @param[out] i      The column index that should be updated
-         */
+                    if (this->format.variable_column_policy != VariableColumnPolicy::KEEP) {
+                        // Silently drop row (default)
+                        this->metrics_data.rows_dropped++;
+                        keep = false;
+                    }
+                }
 
-        auto item = data.get<std::string>();
+                if (keep) {
+                    out.push_back(std::move(this->records.front()));
+                    this->num_rows++;
+                    transferred++;
+                }
 
-        if (this->counts[i].find(item) !=
-            this->counts[i].end()) {
-            // Increment count
-            this->counts[i][item]++;
-        } else {
-            // Initialize count
-            this->counts[i].insert(std::make_pair(item, 1));
+                this->records.pop_front();
+            }
         }
+
+        return transferred;
     }
 
-    CSV_INLINE void CSVStat::min_max(const long double &x_n, const size_t &i) {
-        /** Update current minimum and maximum
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
+    namespace internals {
+        /** Retrieve one field for batching, treating columns missing from
+         *  a short row (VariableColumnPolicy::KEEP) as empty/null
          */
-        if (isnan(this->mins[i]))
-            this->mins[i] = x_n;
-        if (isnan(this->maxes[i]))
-            this->maxes[i] = x_n;
-        
-        if (x_n < this->mins[i])
-            this->mins[i] = x_n;
-        else if (x_n > this->maxes[i])
-            this->maxes[i] = x_n;
-    }
+        static csv::string_view batch_field(const CSVRow& row, size_t col) {
+            return col < row.size() ? row.get_string_view(col) : csv::string_view("");
+        }
 
-    CSV_INLINE void CSVStat::variance(const long double &x_n, const size_t &i) {
-        /** Given a record update rolling mean and variance for all columns
-         *  using Welford's Algorithm
-         *  @param[in]  x_n Data observation
-         *  @param[out] i   The column index that should be updated
+        /** Cheap cardinality heuristic deciding whether a string column is
+         *  worth dictionary encoding: sample up to 1024 values and encode
+         *  if at most 256 distinct values cover no more than a quarter of
+         *  the sample
          */
-        long double& current_rolling_mean = this->rolling_means[i];
-        long double& current_rolling_var = this->rolling_vars[i];
-        long double& current_n = this->n[i];
-        long double delta;
-        long double delta2;
+        static bool dict_worthwhile(const std::vector<CSVRow>& rows, size_t col) {
+            constexpr size_t SAMPLE = 1024;
+            constexpr size_t MAX_DISTINCT = 256;
 
-        current_n++;
-        
-        if (current_n == 1) {
-            current_rolling_mean = x_n;
-        } else {
-            delta = x_n - current_rolling_mean;
-            current_rolling_mean += delta/current_n;
-            delta2 = x_n - current_rolling_mean;
-            current_rolling_var += delta*delta2;
+            const size_t n = (std::min)(rows.size(), SAMPLE);
+            std::unordered_set<std::string> distinct;
+
+            for (size_t i = 0; i < n; i++) {
+                distinct.insert(std::string(batch_field(rows[i], col)));
+                if (distinct.size() > MAX_DISTINCT) return false;
+            }
+
+            return distinct.size() * 4 <= n;
         }
     }
 
-    /** Useful for uploading CSV files to SQL databases.
+    /**
+     * Retrieve up to n rows transposed into per-column contiguous arrays.
      *
-     *  Return a data type for each column such that every value in a column can be
-     *  converted to the corresponding data type without data loss.
-     *  @param[in]  filename The CSV file
+     * Analytics consumers that aggregate column-wise would otherwise
+     * transpose CSVRows themselves, chasing the shared row buffer once per
+     * field. This converts each field exactly once and lays the results out
+     * cache-linearly; see ColumnBatch for the storage and type promotion
+     * rules. The batch is cleared and rebuilt on every call, so its vectors'
+     * capacity is recycled across calls.
      *
-     *  \return A mapping of column names to csv::DataType enums
+     * Rows are subject to the same variable column policy as read_row().
+     *
+     * @param[out] batch Receives the columnar data
+     * @param[in]  n     Maximum number of rows to transfer
+     *
+     * @return Number of rows batched; 0 indicates end of file
+     * @see CSVReader::read_rows()
      */
-    CSV_INLINE std::unordered_map<std::string, DataType> csv_data_types(const std::string& filename) {
-        CSVStat stat(filename);
-        std::unordered_map<std::string, DataType> csv_dtypes;
+    CSV_INLINE size_t CSVReader::read_batch(ColumnBatch& batch, size_t n) {
+        std::vector<CSVRow> rows;
+        this->read_rows(rows, n);
+
+        batch.col_names = this->get_col_names();
+        batch.n_rows = rows.size();
+        batch.columns.resize(batch.col_names.size());
+
+        for (size_t i = 0; i < batch.columns.size(); i++) {
+            auto& col = batch.columns[i];
+            col.ints.clear();
+            col.doubles.clear();
+            col.chars.clear();
+            col.offsets.clear();
+            col.codes.clear();
+
+            // First pass: find the widest type this column needs
+            DataType widest = UNKNOWN;
+            for (auto& row : rows) {
+                switch (internals::data_type(internals::batch_field(row, i))) {
+                case CSV_STRING:
+                    widest = CSV_STRING;
+                    break;
+                case CSV_NULL:       // Empty fields become NaN
+                case CSV_DOUBLE:
+                    if (widest != CSV_STRING) widest = CSV_DOUBLE;
+                    break;
+                default:             // Some integer width
+                    if (widest == UNKNOWN) widest = CSV_INT64;
+                    break;
+                }
+            }
 
-        auto col_names = stat.get_col_names();
-        auto temp = stat.get_dtypes();
+            col.type = (widest == UNKNOWN) ? CSV_STRING : widest;
+
+            // Second pass: convert each field exactly once
+            switch (col.type) {
+            case CSV_INT64:
+                col.ints.reserve(rows.size());
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+
+                    // The fast parser rejects some inputs data_type()
+                    // accepts, e.g. whitespace padding, so a miss falls
+                    // back to the slow path's value rather than zero
+                    long long value = 0;
+                    if (!internals::fast_parse_int64(field, value)) {
+                        long double number = 0;
+                        internals::data_type(field, &number);
+                        value = (long long)number;
+                    }
 
-        for (size_t i = 0; i < stat.get_col_names().size(); i++) {
-            auto& col = temp[i];
-            auto& col_name = col_names[i];
+                    col.ints.push_back(value);
+                }
+                break;
+            case CSV_DOUBLE:
+                col.doubles.reserve(rows.size());
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+
+                    // Same fallback as above; empty fields keep their NaN
+                    double value = std::numeric_limits<double>::quiet_NaN();
+                    if (!internals::fast_parse_double(field, value)) {
+                        long double number = 0;
+                        if (internals::data_type(field, &number) != CSV_NULL)
+                            value = (double)number;
+                    }
 
-            if (col[CSV_STRING])
-                csv_dtypes[col_name] = CSV_STRING;
-            else if (col[CSV_INT64])
-                csv_dtypes[col_name] = CSV_INT64;
-            else if (col[CSV_INT32])
-                csv_dtypes[col_name] = CSV_INT32;
-            else if (col[CSV_INT16])
-                csv_dtypes[col_name] = CSV_INT16;
-            else if (col[CSV_INT8])
-                csv_dtypes[col_name] = CSV_INT8;
-            else
-                csv_dtypes[col_name] = CSV_DOUBLE;
+                    col.doubles.push_back(value);
+                }
+                break;
+            default:
+                if (this->dict_encoding && internals::dict_worthwhile(rows, i)) {
+                    // Store each distinct value once, plus a code per row
+                    std::unordered_map<std::string, int> dictionary;
+                    col.codes.reserve(rows.size());
+                    col.offsets.push_back(0);
+
+                    for (auto& row : rows) {
+                        auto field = internals::batch_field(row, i);
+                        auto entry = dictionary.emplace(
+                            std::string(field), (int)dictionary.size());
+
+                        if (entry.second) {
+                            col.chars.append(field.data(), field.size());
+                            col.offsets.push_back(col.chars.size());
+                        }
+
+                        col.codes.push_back(entry.first->second);
+                    }
+
+                    break;
+                }
+
+                col.offsets.reserve(rows.size() + 1);
+                col.offsets.push_back(0);
+                for (auto& row : rows) {
+                    auto field = internals::batch_field(row, i);
+                    col.chars.append(field.data(), field.size());
+                    col.offsets.push_back(col.chars.size());
+                }
+                break;
+            }
         }
 
-        return csv_dtypes;
+        return batch.n_rows;
     }
 }
-#include <vector>
+/** @file
+ *  Defines a multi-threaded reader which parses many CSV files at once
+ */
+
+#include <algorithm>
 
 
 namespace csv {
-    /** Shorthand function for parsing an in-memory CSV string,
-     *  a collection of CSVRow objects
-     *
-     *  @snippet tests/test_read_csv.cpp Parse Example
-     */
-    CSV_INLINE CSVReader parse(csv::string_view in, CSVFormat format) {
-        CSVReader parser(format);
-        parser.feed(in);
-        parser.end_feed();
-        return parser;
-    }
+    CSV_INLINE MultiReader::MultiReader(std::vector<std::string> _filenames,
+        CSVFormat _format, size_t _n_threads) :
+        filenames(std::move(_filenames)), format(std::move(_format)) {
+        size_t n_threads = _n_threads > 0
+            ? _n_threads
+            : (std::max)((size_t)1, (size_t)std::thread::hardware_concurrency());
 
-    /** Parse a RFC 4180 CSV string, returning a collection
-     *  of CSVRow objects
-     *
-     *  @par Example
-     *  @snippet tests/test_read_csv.cpp Escaped Comma
-     *
-     */
-    CSV_INLINE CSVReader operator ""_csv(const char* in, size_t n) {
-        return parse(csv::string_view(in, n));
+        // No point in more workers than files
+        n_threads = (std::min)(n_threads, this->filenames.size());
+        this->pool.reserve(n_threads);
+        this->active_workers = n_threads;
     }
 
-    /**
-     *  Find the position of a column in a CSV file or CSV_NOT_FOUND otherwise
-     *
-     *  @param[in] filename  Path to CSV file
-     *  @param[in] col_name  Column whose position we should resolve
-     *  @param[in] format    Format of the CSV file
-     */
-    CSV_INLINE int get_col_pos(
-        const std::string filename,
-        const std::string col_name,
-        const CSVFormat format) {
-        CSVReader reader(filename, format);
-        return reader.index_of(col_name);
-    }
+    CSV_INLINE MultiReader::~MultiReader() {
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->shutting_down = true;
+        }
 
-    /** Get basic information about a CSV file
-     *  @include programs/csv_info.cpp
-     */
-    CSV_INLINE CSVFileInfo get_file_info(const std::string& filename) {
-        CSVReader reader(filename);
-        CSVFormat format = reader.get_format();
-        for (auto it = reader.begin(); it != reader.end(); ++it);
+        // Unblock workers waiting for queue space, then let them drain
+        this->space_available.notify_all();
+        for (auto& worker : this->pool) {
+            worker.join();
+        }
+    }
 
-        CSVFileInfo info = {
-            filename,
-            reader.get_col_names(),
-            format.get_delim(),
-            reader.num_rows,
-            (int)reader.get_col_names().size()
-        };
+    CSV_INLINE void MultiReader::start() {
+        if (this->started) return;
+        this->started = true;
 
-        return info;
+        for (size_t i = 0; i < this->pool.capacity(); i++) {
+            this->pool.push_back(std::thread(&MultiReader::worker_main, this));
+        }
     }
-}
-/** @file
- *  Defines an object which can store CSV data in
- *  continuous regions of memory
- */
 
+    CSV_INLINE void MultiReader::worker_main() {
+        while (true) {
+            // Claim the next unclaimed file; finished workers pull more
+            // work instead of idling, balancing skewed shard sizes
+            const size_t idx = this->next_file.fetch_add(1);
+            if (idx >= this->filenames.size()) break;
+
+            try {
+                CSVReader reader(this->filenames[idx], this->format);
+                std::vector<CSVRow> batch;
+                RowCount file_rows = 0;
+
+                while (true) {
+                    batch.clear();
+                    if (reader.read_rows(batch, WORKER_BATCH) == 0) break;
+                    file_rows += (RowCount)batch.size();
+
+                    std::unique_lock<std::mutex> guard(this->lock);
+                    this->space_available.wait(guard, [this] {
+                        return this->merged.size() < QUEUE_CAPACITY || this->shutting_down;
+                    });
+
+                    if (this->shutting_down) {
+                        guard.unlock();
+                        this->finish_worker();
+                        return;
+                    }
 
-namespace csv {
-    namespace internals {
-        //////////////
-        // ColNames //
-        //////////////
-        CSV_INLINE std::vector<std::string> ColNames::get_col_names() const {
-            return this->col_names;
-        }
+                    for (auto& row : batch) {
+                        this->merged.push_back(std::move(row));
+                    }
 
-        CSV_INLINE void ColNames::set_col_names(const std::vector<std::string>& cnames) {
-            this->col_names = cnames;
+                    guard.unlock();
+                    this->rows_available.notify_one();
+                }
 
-            for (size_t i = 0; i < cnames.size(); i++) {
-                this->col_pos[cnames[i]] = i;
-            }
-        }
+                if (this->file_callback) {
+                    this->file_callback(this->filenames[idx], file_rows);
+                }
 
-        CSV_INLINE int ColNames::index_of(csv::string_view col_name) const {
-            auto pos = this->col_pos.find(col_name.data());
-            if (pos != this->col_pos.end())
-                return (int)pos->second;
+                this->n_complete++;
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> guard(this->lock);
+                if (!this->worker_error) {
+                    this->worker_error = std::current_exception();
+                }
 
-            return CSV_NOT_FOUND;
+                break;
+            }
         }
 
-        CSV_INLINE size_t ColNames::size() const {
-            return this->col_names.size();
-        }
+        this->finish_worker();
+    }
 
-        CSV_INLINE RowData RawRowBuffer::get_row() {
-            return {
-                this->get_row_string(),
-                this->get_splits()
-            };
+    CSV_INLINE void MultiReader::finish_worker() {
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->active_workers--;
         }
 
-        /** Get the current row in the buffer
-         *  @note Has the side effect of updating the current end pointer
-         */
-        CSV_INLINE std::pair<size_t, size_t> RawRowBuffer::get_row_string() {
-            auto ret = std::make_pair(
-                this->current_end, // Beginning of string
-                (this->buffer.size() - this->current_end) // Count
-            );
+        this->rows_available.notify_all();
+    }
 
-            this->current_end = this->buffer.size();
-            return ret;
-        }
+    CSV_INLINE bool MultiReader::read_row(CSVRow& row) {
+        this->start();
 
-        CSV_INLINE ColumnPositions RawRowBuffer::get_splits()
-        {
-            const size_t head_idx = this->current_split_idx,
-                new_split_idx = this->split_buffer.size();
-            StrBufferPos n_cols = (new_split_idx - head_idx > 0) ?
-                (StrBufferPos)(new_split_idx - head_idx + 1): 0;
+        std::unique_lock<std::mutex> guard(this->lock);
+        this->rows_available.wait(guard, [this] {
+            return !this->merged.empty() || this->active_workers == 0;
+        });
 
-            this->current_split_idx = new_split_idx;
-            return ColumnPositions(head_idx, n_cols);
-        }
+        if (this->merged.empty()) {
+            if (this->worker_error) {
+                std::rethrow_exception(this->worker_error);
+            }
 
-        CSV_INLINE size_t RawRowBuffer::size() const {
-            return this->buffer.size() - this->current_end;
+            return false;
         }
 
-        CSV_INLINE size_t RawRowBuffer::splits_size() const {
-            return this->split_buffer.size() - this->current_split_idx;
-        }
-        
-        HEDLEY_WARN_UNUSED_RESULT CSV_INLINE
-        BufferPtr RawRowBuffer::reset() const {
-            // Save current row in progress
-            auto new_buff = BufferPtr(new RawRowBuffer());
+        row = std::move(this->merged.front());
+        this->merged.pop_front();
+        guard.unlock();
 
-            // Save text
-            new_buff->buffer = this->buffer.substr(
-                this->current_end,   // Position
-                (this->buffer.size() - this->current_end) // Count
-            );
+        this->space_available.notify_one();
+        return true;
+    }
+}
 
-            // Save split buffer in progress
-            for (size_t i = this->current_split_idx; i < this->split_buffer.size(); i++) {
-                new_buff->split_buffer.push_back(this->split_buffer[i]);
-            }
+/** @file
+ *  Explicit instantiations of the library's most commonly used templates
+ *
+ *  When built as a static library, the csv CMake target defines
+ *  CSV_EXTERN_TEMPLATES for itself and its consumers: clients then link
+ *  the definitions emitted here instead of re-instantiating these
+ *  templates in every translation unit, which noticeably shortens their
+ *  compiles. Single-header users never define the macro, so this file
+ *  contributes nothing to single_include/csv.hpp.
+ */
 
-            new_buff->col_names = this->col_names;
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
-            // No need to remove unnecessary bits from this buffer
-            // (memory savings would be marginal anyways)
-            return new_buff;
-        }
-    }
+
+#ifdef CSV_EXTERN_TEMPLATES
+namespace csv {
+    template short CSVField::get<short>();
+    template unsigned short CSVField::get<unsigned short>();
+    template int CSVField::get<int>();
+    template unsigned int CSVField::get<unsigned int>();
+    template long CSVField::get<long>();
+    template unsigned long CSVField::get<unsigned long>();
+    template unsigned long long CSVField::get<unsigned long long>();
+    template float CSVField::get<float>();
+
+    template DelimWriter<std::ofstream, ',', '"'>::DelimWriter(std::ofstream&);
+    template void DelimWriter<std::ofstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::ofstream, ',', '"'>::flush();
+
+    template DelimWriter<std::ofstream, '\t', '"'>::DelimWriter(std::ofstream&);
+    template void DelimWriter<std::ofstream, '\t', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::ofstream, '\t', '"'>::flush();
+
+    template DelimWriter<std::stringstream, ',', '"'>::DelimWriter(std::stringstream&);
+    template void DelimWriter<std::stringstream, ',', '"'>::write_row(const std::vector<std::string>&, bool);
+    template void DelimWriter<std::stringstream, ',', '"'>::flush();
 }
+#endif
+
 
-#endif
\ No newline at end of file
@@ -81,4 +81,44 @@ TEST_CASE("GiantSplitBufferTest", "[test_giant_split_buffer]") {
         REQUIRE(split_at(buffer, pos, 2) == 3);
         REQUIRE(pos.n_cols == 4);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("RecordRing Test", "[test_record_ring]") {
+    // Interleave pushes and pops well past the initial capacity so the
+    // head wraps around and slots get reused
+    RecordRing ring;
+    REQUIRE(ring.empty());
+
+    auto col_names = std::make_shared<ColNames>(
+        std::vector<std::string>({ "A" }));
+
+    size_t pushed = 0, popped = 0;
+    const size_t total = RecordRing::DEFAULT_CAPACITY * 3;
+
+    while (popped < total) {
+        // Push two, pop one, until everything has flowed through
+        for (int k = 0; k < 2 && pushed < total; k++) {
+            std::string text = std::to_string(pushed);
+            ring.push_back(csv::CSVRow(text,
+                { (StrBufferPos)text.size() }, col_names));
+            pushed++;
+        }
+
+        REQUIRE(ring.front().get_string_view(0) == std::to_string(popped));
+        ring.pop_front();
+        popped++;
+    }
+
+    REQUIRE(ring.empty());
+
+    // Growth: fill past capacity without popping
+    for (size_t i = 0; i < RecordRing::DEFAULT_CAPACITY + 10; i++) {
+        std::string text = std::to_string(i);
+        ring.push_back(csv::CSVRow(text,
+            { (StrBufferPos)text.size() }, col_names));
+    }
+
+    REQUIRE(ring.size() == RecordRing::DEFAULT_CAPACITY + 10);
+    for (size_t i = 0; i < ring.size(); i++) {
+        REQUIRE(ring[i].get_string_view(0) == std::to_string(i));
+    }
+}
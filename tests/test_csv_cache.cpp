@@ -0,0 +1,112 @@
+/** @file
+ *  Tests for building, saving, and reloading binary columnar caches
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "catch.hpp"
+#include "csv.hpp"
+
+using namespace csv;
+
+TEST_CASE("Basic CSVCache Test", "[test_csv_cache]") {
+    const char * test_file = "./tests/temp_cache_basic.csv";
+    const auto cache_file = CSVCache::default_cache_path(test_file);
+
+    {
+        std::ofstream out(test_file);
+        out << "A,B,C" << std::endl;
+        for (int i = 0; i < 1000; i++) {
+            out << i << "," << i * 0.5 << ",name" << i << std::endl;
+        }
+    }
+
+    // First open parses and writes the sidecar
+    auto cache = CSVCache::open(test_file);
+    REQUIRE(cache.num_rows() == 1000);
+    REQUIRE(cache.get_col_names() == std::vector<std::string>({ "A", "B", "C" }));
+    REQUIRE(CSVCache::is_fresh(test_file, cache_file));
+
+    // Second open serves the sidecar; results must match exactly
+    auto reloaded = CSVCache::open(test_file);
+    REQUIRE(reloaded.num_rows() == 1000);
+
+    auto& batch = reloaded.data();
+    REQUIRE(batch.columns[0].type == CSV_INT64);
+    REQUIRE(batch.columns[1].type == CSV_DOUBLE);
+    REQUIRE(batch.columns[2].type == CSV_STRING);
+
+    for (size_t i = 0; i < 1000; i++) {
+        REQUIRE(batch.columns[0].ints[i] == (long long)i);
+        REQUIRE(batch.columns[1].doubles[i] == i * 0.5);
+        REQUIRE(batch.columns[2].str(i) == "name" + std::to_string(i));
+    }
+
+    REQUIRE(remove(test_file) == 0);
+    REQUIRE(remove(cache_file.c_str()) == 0);
+}
+
+TEST_CASE("CSVCache Dictionary Test", "[test_csv_cache_dict]") {
+    const char * test_file = "./tests/temp_cache_dict.csv";
+    const auto cache_file = CSVCache::default_cache_path(test_file);
+
+    {
+        std::ofstream out(test_file);
+        out << "Country,Value" << std::endl;
+        for (int i = 0; i < 500; i++) {
+            out << (i % 2 == 0 ? "US" : "CA") << "," << i << std::endl;
+        }
+    }
+
+    CSVCache::open(test_file);
+
+    // Dictionary columns must survive the sidecar round trip
+    auto reloaded = CSVCache::open(test_file);
+    auto& country = reloaded.data().columns[0];
+    REQUIRE(country.is_dictionary());
+    REQUIRE(country.dict_size() == 2);
+
+    for (size_t i = 0; i < 500; i++) {
+        REQUIRE(country.str(i) == (i % 2 == 0 ? "US" : "CA"));
+    }
+
+    REQUIRE(remove(test_file) == 0);
+    REQUIRE(remove(cache_file.c_str()) == 0);
+}
+
+TEST_CASE("CSVCache Staleness Test", "[test_csv_cache_stale]") {
+    const char * test_file = "./tests/temp_cache_stale.csv";
+    const auto cache_file = CSVCache::default_cache_path(test_file);
+
+    {
+        std::ofstream out(test_file);
+        out << "A,B" << std::endl << "1,2" << std::endl;
+    }
+
+    CSVCache::open(test_file);
+    REQUIRE(CSVCache::is_fresh(test_file, cache_file));
+
+    // Growing the source invalidates the sidecar
+    {
+        std::ofstream out(test_file, std::ios::app);
+        out << "3,4" << std::endl;
+    }
+
+    REQUIRE_FALSE(CSVCache::is_fresh(test_file, cache_file));
+
+    auto rebuilt = CSVCache::open(test_file);
+    REQUIRE(rebuilt.num_rows() == 2);
+    REQUIRE(CSVCache::is_fresh(test_file, cache_file));
+
+    // A garbage sidecar is treated as stale, not an error
+    {
+        std::ofstream out(cache_file, std::ios::binary);
+        out << "not a cache";
+    }
+
+    REQUIRE_FALSE(CSVCache::is_fresh(test_file, cache_file));
+
+    REQUIRE(remove(test_file) == 0);
+    REQUIRE(remove(cache_file.c_str()) == 0);
+}
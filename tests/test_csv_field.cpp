@@ -37,6 +37,30 @@ TEST_CASE("CSVField get<> - Error Messages", "[test_csv_field_get_error]") {
     REQUIRE(ex_caught);
 }
 
+TEST_CASE("CSVField get<> - Fast Parse Paths", "[test_csv_field_fast_parse]") {
+    // Exercised by the direct get<double>()/get<long long>() kernels
+    REQUIRE(CSVField("9223372036854775807").get<long long>() == 9223372036854775807LL);
+    REQUIRE(CSVField("-9223372036854775807").get<long long>() == -9223372036854775807LL);
+    REQUIRE(CSVField("3.14").get<double>() == 3.14);
+    REQUIRE(CSVField("-1.2e3").get<double>() == -1200.0);
+
+    // Hard cases fall back to the long double parser
+    REQUIRE(CSVField(" 42 ").get<long long>() == 42);
+    REQUIRE(CSVField("1e-300").get<double>() == Approx(1e-300));
+    REQUIRE(CSVField("12345678901234567890123").type() == CSV_DOUBLE);
+
+    bool ex_caught = false;
+    try {
+        CSVField("3.5").get<long long>();
+    }
+    catch (std::runtime_error& err) {
+        REQUIRE(err.what() == csv::internals::ERROR_FLOAT_TO_INT);
+        ex_caught = true;
+    }
+
+    REQUIRE(ex_caught);
+}
+
 TEST_CASE("CSVField get<>() - Integral Value", "[test_csv_field_get_int]") {
     CSVField this_year("2019");
     REQUIRE(this_year.get<>() == "2019");
@@ -0,0 +1,114 @@
+/** @file
+ *  Tests for building, saving, and querying row-offset indexes
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "catch.hpp"
+#include "csv.hpp"
+
+using namespace csv;
+
+TEST_CASE("Basic CSVIndex Test", "[test_csv_index]") {
+    const char * test_file = "./tests/temp_index_basic.csv";
+
+    std::ofstream out(test_file);
+    out << "A,B,C" << std::endl;
+    for (int i = 0; i < 1000; i++) {
+        out << i << "," << i + 1 << "," << i + 2 << std::endl;
+    }
+    out.close();
+
+    auto index = CSVIndex::build(test_file, CSVFormat(), 64);
+    REQUIRE(index.num_rows() == 1000);
+    REQUIRE(index.num_checkpoints() == 16); // ceil(1000/64)
+    REQUIRE(index.get_col_names() == std::vector<std::string>({ "A", "B", "C" }));
+
+    // Spot check rows far from and on checkpoint boundaries
+    for (RowCount n : { (RowCount)0, (RowCount)63, (RowCount)64, (RowCount)500, (RowCount)999 }) {
+        auto row = index.get_row(test_file, n);
+        REQUIRE(row["A"].get<int>() == (int)n);
+        REQUIRE(row["C"].get<int>() == (int)n + 2);
+    }
+
+    REQUIRE_THROWS_AS(index.get_row(test_file, 1000), std::runtime_error);
+
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("CSVIndex Quoted Fields Test", "[test_csv_index_quotes]") {
+    const char * test_file = "./tests/temp_index_quotes.csv";
+
+    // Embedded newlines inside quoted fields should not produce
+    // spurious row boundaries
+    std::ofstream out(test_file);
+    out << "A,B" << std::endl;
+    for (int i = 0; i < 100; i++) {
+        out << i << ",\"Line 1" << std::endl << "Line 2\"" << std::endl;
+    }
+    out.close();
+
+    auto index = CSVIndex::build(test_file, CSVFormat(), 10);
+    REQUIRE(index.num_rows() == 100);
+
+    auto row = index.get_row(test_file, 57);
+    REQUIRE(row["A"].get<int>() == 57);
+    REQUIRE(row["B"] == "Line 1\nLine 2");
+
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("CSVIndex Save and Load Test", "[test_csv_index_save]") {
+    const char * test_file = "./tests/temp_index_save.csv";
+    const char * index_file = "./tests/temp_index_save.csvidx";
+
+    std::ofstream out(test_file);
+    out << "A,B" << std::endl;
+    for (int i = 0; i < 500; i++) {
+        out << i << "," << i * 2 << std::endl;
+    }
+    out.close();
+
+    CSVIndex::build(test_file, CSVFormat(), 32).save(index_file);
+
+    auto index = CSVIndex::load(index_file);
+    REQUIRE(index.num_rows() == 500);
+    REQUIRE(index.get_col_names() == std::vector<std::string>({ "A", "B" }));
+
+    auto row = index.get_row(test_file, 499);
+    REQUIRE(row["B"].get<int>() == 998);
+
+    // Loading a non-index file should fail loudly
+    REQUIRE_THROWS_AS(CSVIndex::load(test_file), std::runtime_error);
+
+    REQUIRE(remove(test_file) == 0);
+    REQUIRE(remove(index_file) == 0);
+}
+
+TEST_CASE("CSVIndex Blank Lines Test", "[test_csv_index_blanks]") {
+    const char * test_file = "./tests/temp_index_blanks.csv";
+
+    // Blank CRLF lines parse into empty records; row numbering must skip
+    // them consistently in both build() and get_row()
+    std::ofstream out(test_file, std::ios::binary);
+    out << "A,B\r\n";
+    for (int i = 0; i < 100; i++) {
+        out << i << "," << i * 2 << "\r\n";
+        if (i % 10 == 0) out << "\r\n";
+    }
+    out.close();
+
+    auto index = CSVIndex::build(test_file, CSVFormat(), 16);
+    REQUIRE(index.num_rows() == 100);
+
+    for (RowCount n : { (RowCount)0, (RowCount)15, (RowCount)16, (RowCount)50, (RowCount)99 }) {
+        auto row = index.get_row(test_file, n);
+        REQUIRE(row["A"].get<int>() == (int)n);
+        REQUIRE(row["B"].get<int>() == (int)n * 2);
+    }
+
+    REQUIRE_THROWS_AS(index.get_row(test_file, 100), std::runtime_error);
+
+    REQUIRE(remove(test_file) == 0);
+}
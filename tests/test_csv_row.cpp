@@ -97,4 +97,66 @@ TEST_CASE("CSVField operator==", "[test_csv_field_equal]") {
     REQUIRE(row["B"] == 2);
     REQUIRE(row["C"] == 3);
     REQUIRE(internals::is_equal(row["D"].get<long double>(), 3.14L));
-}
\ No newline at end of file
+}
+TEST_CASE("CSVRow unpack() Test", "[test_csv_row_unpack]") {
+    auto col_names = std::make_shared<internals::ColNames>(
+        std::vector<std::string>({ "Station", "Temp", "Count" })
+        );
+
+    std::string str = "KSFO"
+        "13.5"
+        "42";
+
+    std::vector<internals::StrBufferPos> splits = { 4, 8 };
+    CSVRow row(str, splits, col_names);
+
+    SECTION("Unpack Into Struct Members") {
+        struct Reading {
+            std::string station;
+            double temp;
+            int count;
+        } r;
+
+        row.unpack(r.station, r.temp, r.count);
+
+        REQUIRE(r.station == "KSFO");
+        REQUIRE(internals::is_equal(r.temp, 13.5));
+        REQUIRE(r.count == 42);
+    }
+
+    SECTION("Unpack a Prefix of the Row") {
+        csv::string_view station;
+        row.unpack(station);
+        REQUIRE(station == "KSFO");
+    }
+
+    SECTION("Unpack Into a Tuple") {
+        std::tuple<std::string, double, int> values;
+        row.unpack(values);
+
+        REQUIRE(std::get<0>(values) == "KSFO");
+        REQUIRE(std::get<2>(values) == 42);
+    }
+
+    SECTION("Unpack Via std::tie") {
+        std::string station;
+        long long count;
+        double temp;
+
+        row.unpack(std::tie(station, temp, count));
+
+        REQUIRE(station == "KSFO");
+        REQUIRE(internals::is_equal(temp, 13.5));
+        REQUIRE(count == 42);
+    }
+
+    SECTION("Too Many Destinations") {
+        std::string a, b, c, d;
+        REQUIRE_THROWS_AS(row.unpack(a, b, c, d), std::runtime_error);
+    }
+
+    SECTION("Bad Numeric Conversion") {
+        int station;
+        REQUIRE_THROWS_AS(row.unpack(station), std::runtime_error);
+    }
+}
@@ -1,3 +1,4 @@
+#include <sstream>
 #include "catch.hpp"
 #include "csv.hpp"
 using namespace csv;
@@ -110,4 +111,48 @@ TEST_CASE("CSVRow to_json() with Wrong Columns", "[csv_json_wrong_cols]") {
     // to_json() method should then produce an empty object instead of segfaulting.
     REQUIRE(first_row.to_json() == "{}");
     REQUIRE(first_row.to_json_array() == "[]");
-}
\ No newline at end of file
+}
+TEST_CASE("json_escape_string() Long String Test", "[json_escape_long]") {
+    using internals::json_escape_string;
+
+    // Exercise the vectorized scan: runs much longer than one SIMD block,
+    // with the special character at various alignments
+    std::string padding(100, 'x');
+    REQUIRE(json_escape_string(padding) == padding);
+
+    for (size_t pos : { (size_t)0, (size_t)15, (size_t)16, (size_t)31,
+                        (size_t)32, (size_t)99 }) {
+        std::string in = padding, expected = padding;
+        in[pos] = '"';
+        expected.replace(pos, 1, "\\\"");
+        REQUIRE(json_escape_string(in) == expected);
+    }
+}
+
+TEST_CASE("CSVRow to_json_into() Test", "[csv_row_to_json_into]") {
+    CSVRow row = make_csv_row(
+        { "Col 1", "Col 2" },
+        { "A", "B" }
+    );
+
+    // The buffer is appended to, not replaced
+    std::string buffer = "prefix:";
+    row.to_json_into(buffer);
+    REQUIRE(buffer == "prefix:{\"A\":\"Col 1\",\"B\":\"Col 2\"}");
+
+    buffer.clear();
+    row.to_json_array_into(buffer);
+    REQUIRE(buffer == "[\"Col 1\",\"Col 2\"]");
+}
+
+TEST_CASE("to_jsonl() Test", "[csv_to_jsonl]") {
+    std::string csv_string("A,B\n1,two\n3,four\n");
+
+    auto reader = parse(csv_string);
+    std::stringstream out;
+
+    REQUIRE(to_jsonl(reader, out) == 2);
+    REQUIRE(out.str() ==
+        "{\"A\":1,\"B\":\"two\"}\n"
+        "{\"A\":3,\"B\":\"four\"}\n");
+}
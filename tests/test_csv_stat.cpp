@@ -37,6 +37,93 @@ TEST_CASE("Calculating Statistics from Direct Input", "[read_csv_stat_direct]" )
     REQUIRE( reader.get_dtypes()[0][CSV_INT8] == 100 );
 }
 
+TEST_CASE("Statistics - Sharded Calculation", "[read_csv_stat_sharded]") {
+    // Enough rows that calc() shards the work across several threads,
+    // exercising the parallel Welford merge
+    std::string int_list = "";
+    for (int i = 0; i < 5000; i++) {
+        int_list += std::to_string(i) + "," + std::to_string(i * 2) + "\r\n";
+    }
+
+    CSVFormat format;
+    format.column_names({ "A", "B" });
+
+    CSVStat reader(format);
+    reader.feed(int_list);
+    reader.end_feed();
+
+    REQUIRE(reader.get_mins() == std::vector<long double>({ 0, 0 }));
+    REQUIRE(reader.get_maxes() == std::vector<long double>({ 4999, 9998 }));
+    REQUIRE(reader.get_mean() == std::vector<long double>({ 2499.5, 4999 }));
+
+    // Sample variance of 0..4999 is 5000 * 5001 / 12 exactly
+    REQUIRE(reader.get_variance()[0] == Approx(2083750).epsilon(0.000001));
+
+    auto dtypes = reader.get_dtypes()[0];
+    RowCount total = 0;
+    for (auto& item : dtypes)
+        total += item.second;
+    REQUIRE(total == 5000);
+}
+
+TEST_CASE("Statistics - Batched Numeric Kernels", "[read_csv_stat_batched]") {
+    // Enough rows that each column buffers several full batches,
+    // exercising the vectorized flush and the batch-to-batch merge
+    std::string int_list = "";
+    for (int i = 0; i < 20000; i++) {
+        int_list += std::to_string(i) + "," + std::to_string(i % 7) + "\r\n";
+    }
+
+    CSVFormat format;
+    format.column_names({ "A", "B" });
+
+    CSVStat reader(format);
+    reader.feed(int_list);
+    reader.end_feed();
+
+    REQUIRE(reader.get_mins() == std::vector<long double>({ 0, 0 }));
+    REQUIRE(reader.get_maxes() == std::vector<long double>({ 19999, 6 }));
+    REQUIRE(reader.get_mean()[0] == Approx(9999.5).epsilon(0.000001));
+
+    // Sample variance of 0..19999 is 20000 * 20001 / 12 exactly
+    REQUIRE(reader.get_variance()[0] == Approx(33335000).epsilon(0.000001));
+}
+
+TEST_CASE("Statistics - Approximate Mode", "[read_csv_stat_approx]") {
+    std::string int_list = "";
+    for (int i = 0; i < 5000; i++) {
+        int_list += std::to_string(i) + "," + std::to_string(i % 10) + "\r\n";
+    }
+
+    CSVFormat format;
+    format.column_names({ "A", "B" });
+
+    CSVStat reader(format, StatsMode::APPROXIMATE);
+    reader.feed(int_list);
+    reader.end_feed();
+
+    // Exact moment statistics are still available
+    REQUIRE(reader.get_mean()[0] == 2499.5);
+
+    // Column A has 5000 distinct values, column B has ten
+    auto cardinality = reader.get_cardinality();
+    REQUIRE(cardinality[0] > 4500);
+    REQUIRE(cardinality[0] < 5500);
+    REQUIRE(cardinality[1] >= 9);
+    REQUIRE(cardinality[1] <= 11);
+
+    // Median of 0...4999
+    REQUIRE(reader.get_quantile(0.5)[0] == Approx(2499.5).epsilon(0.05));
+
+    // All ten values of column B are heavy hitters appearing 500 times
+    auto top = reader.get_top_values()[1];
+    for (int i = 0; i < 10; i++)
+        REQUIRE(top[std::to_string(i)] >= 500);
+
+    // Sketch accessors require opting in
+    REQUIRE_THROWS_AS(CSVStat(format).get_cardinality(), std::runtime_error);
+}
+
 TEST_CASE( "Statistics - Rows of Integers", "[read_csv_stat]" ) {
     // Header on first row
     auto file = GENERATE(as<std::string> {},
@@ -3,6 +3,7 @@
  */
 
 #include <stdio.h> // remove()
+#include <fstream>
 #include <sstream>
 #include "catch.hpp"
 #include "csv.hpp"
@@ -33,4 +34,69 @@ TEST_CASE("guess_delim() Test - CSV with Comments", "[test_guess_comment]") {
         "./tests/data/fake_data/ints_comments.csv");
     REQUIRE(format.delim == ',');
     REQUIRE(format.header_row == 5);
-}
\ No newline at end of file
+}
+
+//
+// _guess_format(): all candidate delimiters are scored in one pass
+//
+TEST_CASE("Single Pass Guesser - Quoted Delimiters", "[test_guess_single_pass]") {
+    // Quoted fields contain rival delimiters which should not count
+    std::string head =
+        "A;B;C\r\n"
+        "1;\"2,s;emi\";3\r\n"
+        "4;5;6\r\n"
+        "7;8;9\r\n";
+
+    CSVGuessResult format = internals::_guess_format(head);
+    REQUIRE(format.delim == ';');
+    REQUIRE(format.header_row == 0);
+}
+
+TEST_CASE("Quote-Free Detection Test", "[test_guess_no_quote]") {
+    std::string quote_free =
+        "A,B,C\n"
+        "1,2,3\n"
+        "4,5,6\n";
+
+    std::string quoted =
+        "A,B,C\n"
+        "1,\"2,two\",3\n"
+        "4,5,6\n";
+
+    REQUIRE(internals::_guess_format(quote_free).no_quote);
+    REQUIRE_FALSE(internals::_guess_format(quoted).no_quote);
+}
+
+TEST_CASE("Single Pass Guesser - Preamble", "[test_guess_single_pass_preamble]") {
+    std::string head =
+        "Report generated 2020-01-01\n"
+        "\n"
+        "A\tB\tC\n"
+        "1\t2\t3\n"
+        "4\t5\t6\n"
+        "7\t8\t9\n";
+
+    CSVGuessResult format = internals::_guess_format(head);
+    REQUIRE(format.delim == '\t');
+    REQUIRE(format.header_row == 1);
+}
+TEST_CASE("Head Cache Staleness Test", "[test_guess_head_cache]") {
+    const char* test_file = "./tests/head_cache.csv";
+
+    // Rewriting a file with same-length content must not serve the
+    // previous head from the cache
+    {
+        std::ofstream out(test_file, std::ios::binary);
+        out << "A,B\n1,2\n3,4\n";
+    }
+
+    REQUIRE(guess_format(test_file).delim == ',');
+
+    {
+        std::ofstream out(test_file, std::ios::binary);
+        out << "A;B\n1;2\n3;4\n";
+    }
+
+    REQUIRE(guess_format(test_file).delim == ';');
+    REQUIRE(remove(test_file) == 0);
+}
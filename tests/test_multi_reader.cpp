@@ -0,0 +1,69 @@
+/** @file
+ *  Tests for the multi-threaded shard directory reader
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include "catch.hpp"
+#include "csv.hpp"
+
+using namespace csv;
+
+TEST_CASE("Basic MultiReader Test", "[test_multi_reader]") {
+    // Skewed shard sizes, so some workers finish early and steal more work
+    const std::vector<size_t> shard_sizes = { 2000, 50, 50, 1000, 10, 500 };
+    std::vector<std::string> filenames;
+    size_t total_rows = 0;
+
+    for (size_t k = 0; k < shard_sizes.size(); k++) {
+        std::string filename = "./tests/temp_shard_" + std::to_string(k) + ".csv";
+        std::ofstream out(filename);
+        out << "Shard,N" << std::endl;
+
+        for (size_t i = 0; i < shard_sizes[k]; i++) {
+            out << k << "," << i << std::endl;
+        }
+
+        filenames.push_back(filename);
+        total_rows += shard_sizes[k];
+    }
+
+    MultiReader shards(filenames, CSVFormat(), 4);
+
+    std::atomic<size_t> callbacks = { 0 };
+    std::atomic<long long> callback_rows = { 0 };
+    shards.on_file_complete([&](const std::string&, RowCount n) {
+        callbacks++;
+        callback_rows += n;
+    });
+
+    // Rows interleave across shards, but each shard arrives in file order
+    std::vector<size_t> next_n(shard_sizes.size(), 0);
+    size_t rows_seen = 0;
+    CSVRow row;
+
+    while (shards.read_row(row)) {
+        size_t shard = row["Shard"].get<size_t>();
+        REQUIRE(row["N"].get<size_t>() == next_n[shard]);
+        next_n[shard]++;
+        rows_seen++;
+    }
+
+    REQUIRE(rows_seen == total_rows);
+    REQUIRE(shards.files_completed() == shard_sizes.size());
+    REQUIRE(callbacks.load() == shard_sizes.size());
+    REQUIRE(callback_rows.load() == (long long)total_rows);
+
+    for (auto& filename : filenames) {
+        REQUIRE(remove(filename.c_str()) == 0);
+    }
+}
+
+TEST_CASE("MultiReader Missing File Test", "[test_multi_reader_error]") {
+    MultiReader shards({ "./tests/does_not_exist.csv" }, CSVFormat(), 1);
+
+    CSVRow row;
+    REQUIRE_THROWS(shards.read_row(row));
+}
@@ -3,6 +3,7 @@
  */
 
 #include <stdio.h> // remove()
+#include <cmath>   // std::isnan()
 #include <sstream>
 #include "catch.hpp"
 #include "csv.hpp"
@@ -43,6 +44,440 @@ TEST_CASE("Assert UTF-8 Handling Works", "[read_utf8_direct]") {
     REQUIRE(vector<string>(row) == first_row);
 }
 
+TEST_CASE("Test BasicCSVReader Static Format", "[read_csv_static]") {
+    BasicCSVReader<> reader;
+    reader.feed(
+        "A,B,C\r\n"
+        "123,\"234,345\",456\r\n"
+        "1,2,3\r\n"
+        "1,2,3");
+    reader.end_feed();
+
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    reader.read_row(row);
+    REQUIRE(vector<string>(row) ==
+        vector<string>({ "123", "234,345", "456" }));
+
+    while (reader.read_row(row));
+    REQUIRE(reader.num_rows == 3);
+}
+
+TEST_CASE("Test read_rows() Batch Retrieval", "[read_rows_batch]") {
+    auto rows = "A,B,C\r\n" // Header row
+        "123,234,345\r\n"
+        "1,2,3\r\n"
+        "4,5,6\r\n"
+        "7,8,9"_csv;
+
+    std::vector<CSVRow> batch;
+    REQUIRE(rows.read_rows(batch, 3) == 3);
+    REQUIRE(vector<string>(batch[0]) == vector<string>({ "123", "234", "345" }));
+    REQUIRE(vector<string>(batch[2]) == vector<string>({ "4", "5", "6" }));
+
+    // Only one row left
+    REQUIRE(rows.read_rows(batch, 3) == 1);
+    REQUIRE(vector<string>(batch[3]) == vector<string>({ "7", "8", "9" }));
+
+    // End of input
+    REQUIRE(rows.read_rows(batch, 3) == 0);
+    REQUIRE(rows.num_rows == 4);
+}
+
+TEST_CASE("Test sample_types() Column Hints", "[read_csv_sample_types]") {
+    auto rows = "Num,Str,Mixed\r\n"
+        "1,apples,10\r\n"
+        "2,bananas,oranges\r\n"
+        "3,cherries,3.14\r\n"
+        "4,dates,"_csv;
+
+    rows.sample_types();
+
+    // Hints never change results, even on the un-hintable mixed column
+    std::vector<DataType> expected = { CSV_INT8, CSV_STRING, CSV_DOUBLE, CSV_NULL };
+
+    CSVRow row;
+    for (size_t i = 0; rows.read_row(row); i++) {
+        REQUIRE(row["Num"].is_int());
+        REQUIRE(row["Num"].get<int>() == (int)i + 1);
+        REQUIRE(row["Str"].is_str());
+        REQUIRE(row["Mixed"].type() == expected[i]);
+    }
+}
+
+TEST_CASE("Test Column Projection", "[read_csv_projection]") {
+    const char* temp_file = "./tests/projection_test.csv";
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B,C,D,E" << std::endl;
+        for (int i = 0; i < 100; i++)
+            out << i << "," << i * 2 << ",\"x,y\"," << i * 4 << "," << i * 5 << std::endl;
+    }
+
+    SECTION("Selected columns only") {
+        CSVFormat format;
+        format.select({ "D", "B" }); // Selection order doesn't matter
+
+        CSVReader reader(temp_file, format);
+        REQUIRE(reader.get_col_names() == vector<string>({ "B", "D" }));
+
+        CSVRow row;
+        int i = 0;
+        for (; reader.read_row(row); i++) {
+            REQUIRE(row.size() == 2);
+            REQUIRE(row["B"].get<int>() == i * 2);
+            REQUIRE(row["D"].get<int>() == i * 4);
+        }
+
+        REQUIRE(i == 100);
+    }
+
+    SECTION("Single selected column") {
+        // One projected field per row records no delimiter splits, so
+        // these rows lean on the single-field (not blank) representation
+        CSVFormat format;
+        format.select({ "C" });
+
+        CSVReader reader(temp_file, format);
+        REQUIRE(reader.get_col_names() == vector<string>({ "C" }));
+
+        CSVRow row;
+        int i = 0;
+        for (; reader.read_row(row); i++) {
+            REQUIRE(row.size() == 1);
+            REQUIRE(row["C"] == "x,y");
+        }
+
+        REQUIRE(i == 100);
+    }
+
+    SECTION("Unknown column") {
+        CSVFormat format;
+        format.select({ "Z" });
+
+        REQUIRE_THROWS_AS(CSVReader(temp_file, format), std::runtime_error);
+    }
+
+    REQUIRE(remove(temp_file) == 0);
+}
+
+#ifdef CSV_HAS_ZLIB
+#include <zlib.h>
+
+TEST_CASE("Test Gzipped CSV", "[read_csv_gzip]") {
+    const char* temp_file = "./tests/gzip_test.csv.gz";
+
+    {
+        std::string text = "A,B,C\n";
+        for (int i = 0; i < 1000; i++)
+            text += std::to_string(i) + "," + std::to_string(i * 2) + ","
+                + std::to_string(i * 3) + "\n";
+
+        gzFile out = gzopen(temp_file, "wb");
+        gzwrite(out, text.data(), (unsigned)text.size());
+        gzclose(out);
+    }
+
+    // Format guessing and parsing both run over the decompressed stream
+    CSVReader reader(temp_file);
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    int i = 0;
+    for (; reader.read_row(row); i++)
+        REQUIRE(row["B"].get<int>() == i * 2);
+
+    REQUIRE(i == 1000);
+    REQUIRE(remove(temp_file) == 0);
+}
+#endif
+
+TEST_CASE("Test Row Filter", "[read_csv_row_filter]") {
+    CSVReader reader{ CSVFormat() };
+    reader.set_row_filter([](const std::vector<csv::string_view>& fields) {
+        return fields[1] == "keep";
+    });
+
+    reader.feed("A,B,C\r\n"    // Header rows bypass the filter
+        "1,keep,2\r\n"
+        "3,drop,4\r\n"
+        "5,keep,6\r\n"
+        "7,drop,8");           // Unterminated row handled by end_feed()
+    reader.end_feed();
+
+    CSVRow row;
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["A"].get<int>() == 1);
+
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["A"].get<int>() == 5);
+
+    REQUIRE_FALSE(reader.read_row(row));
+}
+
+TEST_CASE("Test Memory Budget", "[read_csv_memory_budget]") {
+    const char* temp_file = "./tests/memory_budget_test.csv";
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B,C" << std::endl;
+        for (int i = 0; i < 1000; i++)
+            out << i << "," << i * 2 << "," << i * 3 << std::endl;
+    }
+
+    CSVReader reader(temp_file);
+    reader.set_chunk_size(256);
+    reader.set_max_buffered_rows(50);
+
+    REQUIRE(reader.get_chunk_size() == 256);
+
+    CSVRow row;
+    int i = 0;
+    for (; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+
+        // The cap may be overshot by at most one 256-byte chunk of rows
+        REQUIRE(reader.get_buffered_rows() <= 100);
+
+        // Chunks are fully parsed before read_csv() returns
+        REQUIRE(reader.get_buffered_bytes() == 0);
+    }
+
+    REQUIRE(i == 1000);
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Prefetch", "[read_csv_prefetch]") {
+    const char* temp_file = "./tests/prefetch_test.csv";
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B" << std::endl;
+        for (int i = 0; i < 5000; i++)
+            out << i << "," << i * 2 << std::endl;
+    }
+
+    CSVReader reader(temp_file);
+    reader.set_chunk_size(1024);
+    reader.set_prefetch(true, 20);
+
+    CSVRow row;
+    int i = 0;
+    for (; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i * 2);
+    }
+
+    REQUIRE(i == 5000);
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Columnar Batch", "[read_csv_batch]") {
+    const char* temp_file = "./tests/batch_test.csv";
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B,C" << std::endl;
+        for (int i = 0; i < 100; i++) {
+            // B is promoted to double by its empty field; C stays a string
+            out << i << "," << (i == 50 ? "" : std::to_string(i * 0.5))
+                << ",name" << i << std::endl;
+        }
+    }
+
+    CSVReader reader(temp_file);
+    ColumnBatch batch;
+
+    REQUIRE(reader.read_batch(batch, 1000) == 100);
+    REQUIRE(batch.n_rows == 100);
+    REQUIRE(batch.col_names == std::vector<std::string>({ "A", "B", "C" }));
+
+    REQUIRE(batch.columns[0].type == CSV_INT64);
+    REQUIRE(batch.columns[1].type == CSV_DOUBLE);
+    REQUIRE(batch.columns[2].type == CSV_STRING);
+
+    for (size_t i = 0; i < 100; i++) {
+        REQUIRE(batch.columns[0].ints[i] == (long long)i);
+
+        if (i == 50)
+            REQUIRE(std::isnan(batch.columns[1].doubles[i]));
+        else
+            REQUIRE(batch.columns[1].doubles[i] == i * 0.5);
+
+        REQUIRE(batch.columns[2].str(i) == "name" + std::to_string(i));
+    }
+
+    // End of file
+    REQUIRE(reader.read_batch(batch, 1000) == 0);
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Columnar Batch - Slow Numerics and Short Rows", "[read_csv_batch2]") {
+    const char* temp_file = "./tests/batch_test2.csv";
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B,C" << std::endl;
+
+        // Numerics data_type() accepts but the fast parsers reject:
+        // whitespace padding, 20-digit integers, exponents past +/- 22
+        out << " 42,1e30,x" << std::endl
+            << "7,99999999999999999999,y" << std::endl;
+
+        out << "8,2.5" << std::endl; // Short row, kept by policy below
+    }
+
+    CSVFormat format;
+    format.variable_columns(VariableColumnPolicy::KEEP);
+
+    CSVReader reader(temp_file, format);
+    ColumnBatch batch;
+
+    REQUIRE(reader.read_batch(batch, 1000) == 3);
+    REQUIRE(batch.columns[0].type == CSV_INT64);
+    REQUIRE(batch.columns[1].type == CSV_DOUBLE);
+    REQUIRE(batch.columns[2].type == CSV_STRING);
+
+    REQUIRE(batch.columns[0].ints == std::vector<long long>({ 42, 7, 8 }));
+    REQUIRE(batch.columns[1].doubles[0] == 1e30);
+    REQUIRE(batch.columns[1].doubles[1] == 1e20);
+    REQUIRE(batch.columns[1].doubles[2] == 2.5);
+
+    // The missing field in the short row batches as an empty string
+    REQUIRE(batch.columns[2].str(0) == "x");
+    REQUIRE(batch.columns[2].str(1) == "y");
+    REQUIRE(batch.columns[2].str(2) == "");
+
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Dictionary Encoding", "[read_csv_dict]") {
+    const char* temp_file = "./tests/dict_test.csv";
+    const char* states[] = { "NEW", "OPEN", "CLOSED" };
+
+    {
+        std::ofstream out(temp_file);
+        out << "State,Name" << std::endl;
+        for (int i = 0; i < 2000; i++)
+            out << states[i % 3] << ",name" << i << std::endl;
+    }
+
+    CSVReader reader(temp_file);
+    reader.set_dictionary_encoding(true);
+
+    ColumnBatch batch;
+    REQUIRE(reader.read_batch(batch, 10000) == 2000);
+
+    // Three repeated values intern; 2000 distinct names do not
+    auto& state_col = batch.columns[0];
+    REQUIRE(state_col.is_dictionary());
+    REQUIRE(state_col.dict_size() == 3);
+    REQUIRE_FALSE(batch.columns[1].is_dictionary());
+
+    for (size_t i = 0; i < 2000; i++) {
+        REQUIRE(state_col.str(i) == states[i % 3]);
+
+        // Equal rows share a code, so filters are integer compares
+        REQUIRE(state_col.codes[i] == state_col.codes[i % 3]);
+    }
+
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Column Handles", "[read_csv_column_handle]") {
+    auto rows = parse("A,B,C\r\n" "1,2,3\r\n" "4,5,6\r\n");
+
+    auto b = rows.column("B");
+    REQUIRE(b.index() == 1);
+    REQUIRE(b.name() == "B");
+    REQUIRE_THROWS_AS(rows.column("D"), std::runtime_error);
+
+    CSVRow row;
+    int expected = 2;
+    while (rows.read_row(row)) {
+        // Same field as the name-based lookup, without the hashing
+        REQUIRE(row[b].get<int>() == expected);
+        REQUIRE(row[b].get<int>() == row["B"].get<int>());
+        expected += 3;
+    }
+
+    // Handles from one reader cannot index rows from another
+    auto other = parse("A,B,C\r\n" "7,8,9\r\n");
+    CSVRow other_row;
+    other.read_row(other_row);
+    REQUIRE_THROWS_AS(other_row[b], std::runtime_error);
+}
+
+TEST_CASE("Test Reader Metrics", "[read_csv_metrics]") {
+    const char* temp_file = "./tests/metrics_test.csv";
+    size_t file_size;
+
+    {
+        std::ofstream out(temp_file);
+        out << "A,B" << std::endl;
+        for (int i = 0; i < 100; i++)
+            out << i << "," << i * 2 << std::endl;
+
+        out << "1,2,3" << std::endl; // Dropped: too many fields
+        file_size = (size_t)out.tellp();
+    }
+
+    CSVReader reader(temp_file);
+    CSVRow row;
+    int i = 0;
+    while (reader.read_row(row)) i++;
+    REQUIRE(i == 100);
+
+    auto metrics = reader.metrics();
+    REQUIRE(metrics.bytes_read == file_size);
+    REQUIRE(metrics.bytes_parsed == file_size);
+    REQUIRE(metrics.chunks_fed >= 1);
+    REQUIRE(metrics.rows_dropped == 1);
+    REQUIRE(metrics.peak_buffer_bytes > 0);
+
+    REQUIRE(remove(temp_file) == 0);
+}
+
+TEST_CASE("Test Latency Histograms", "[read_csv_trace]") {
+    LatencyHistogram hist;
+
+    // Empty histogram
+    REQUIRE(hist.count == 0);
+    REQUIRE(hist.percentile_ns(0.99) == 0);
+
+    hist.record(0);       // Bucket 0
+    hist.record(1);       // Bucket 0
+    hist.record(100);     // Bucket 6: [64, 128)
+    hist.record(1000000); // Bucket 19: [524288, 1048576)
+
+    REQUIRE(hist.count == 4);
+    REQUIRE(hist.total_ns == 1000101);
+    REQUIRE(hist.min_ns == 0);
+    REQUIRE(hist.max_ns == 1000000);
+    REQUIRE(hist.buckets[0] == 2);
+    REQUIRE(hist.buckets[6] == 1);
+    REQUIRE(hist.buckets[19] == 1);
+
+    // Percentiles report the upper bound of the sample's bucket
+    REQUIRE(hist.percentile_ns(0.5) == 127);
+    REQUIRE(hist.percentile_ns(0.99) == 1048575);
+
+    CSVReaderTrace trace;
+    trace.parse.record(100);
+
+    auto json = trace.to_json();
+    REQUIRE(json.find("\"read\":") != std::string::npos);
+    REQUIRE(json.find("\"parse\":{\"count\":1") != std::string::npos);
+    REQUIRE(json.find("\"queue_full\":") != std::string::npos);
+    REQUIRE(json.find("\"queue_empty\":") != std::string::npos);
+
+    // Histograms hang off every reader; they only fill in under CSV_TRACE
+    auto rows = "A,B\r\n1,2\r\n"_csv;
+    REQUIRE(rows.trace().to_json().find("\"read\":") != std::string::npos);
+}
+
 //! [Escaped Comma]
 TEST_CASE( "Test Escaped Comma", "[read_csv_comma]" ) {
     auto rows = "A,B,C\r\n" // Header row
@@ -297,6 +732,36 @@ TEST_CASE("Test Variable Row Length Handling", "[read_csv_var_len]") {
         // Should be able to index extra columns via numeric index
         REQUIRE(rows[3][2] == 7);
         REQUIRE(rows[3][3] == 10);
+
+        // Columns a short row lacks read as null fields by name
+        auto missing = rows[2]["C"];
+        REQUIRE(missing.is_null());
+        REQUIRE(missing.get<>() == "");
+
+        // ...while present columns resolve normally
+        REQUIRE(rows[2]["B"] == 9);
+    }
+
+    SECTION("Bad Row Handler") {
+        CSVFormat format;
+        format.variable_columns(false);
+
+        CSVReader reader(format);
+        std::vector<size_t> ragged_sizes;
+        reader.set_bad_row_handler([&ragged_sizes](const CSVRow& row) {
+            ragged_sizes.push_back(row.size());
+        });
+
+        reader.feed(csv_string);
+        reader.end_feed();
+
+        CSVRow row;
+        size_t n_rows = 0;
+        while (reader.read_row(row)) n_rows++;
+
+        // Dropped rows are still observed, in order
+        REQUIRE(n_rows == 3);
+        REQUIRE(ragged_sizes == std::vector<size_t>({ 2, 4 }));
     }
 }
 
@@ -3,6 +3,7 @@
  */
 
 #include <stdio.h> // remove()
+#include <fstream>
 #include <sstream>
 #include "catch.hpp"
 #include "csv.hpp"
@@ -53,6 +54,340 @@ TEST_CASE("get_file_info() Test", "[test_file_info]") {
     REQUIRE(info.col_names == vector<string>({"ReportDt", "Unit", "Power"}));
 }
 
+TEST_CASE("count_rows() Test", "[test_count_rows]") {
+    const char * test_file = "./tests/count_rows_test.csv";
+    const int N_ROWS = 20000;
+
+    std::ofstream test_out(test_file);
+    test_out << "A,B" << std::endl;
+    for (int i = 0; i < N_ROWS; i++) {
+        // Every tenth row embeds a newline in a quoted field, which must
+        // not be counted as a record terminator
+        if (i % 10 == 0)
+            test_out << i << ",\"x\ny\"" << std::endl;
+        else
+            test_out << i << ",plain" << std::endl;
+    }
+
+    // The final row has no trailing newline but still counts
+    test_out << N_ROWS << ",last";
+    test_out.close();
+
+    // Header + data rows + unterminated final row
+    REQUIRE(count_rows(test_file) == N_ROWS + 2);
+
+    CSVFileInfo info = get_file_info(test_file);
+    REQUIRE(info.n_rows == N_ROWS + 1);
+    REQUIRE(info.col_names == vector<string>({ "A", "B" }));
+
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("profile_csv() Test", "[test_profile_csv]") {
+    const char * test_file = "./tests/profile_test.csv";
+    const int N_ROWS = 50000;
+
+    std::ofstream test_out(test_file);
+    test_out << "Id,Value,Name" << std::endl;
+    for (int i = 0; i < N_ROWS; i++)
+        test_out << i << "," << i + 0.5 << ",\"row, " << i << "\"" << std::endl;
+    test_out.close();
+
+    CSVFileProfile profile = profile_csv(test_file);
+
+    REQUIRE(profile.delim == ',');
+    REQUIRE(profile.n_cols == 3);
+    REQUIRE(profile.col_names == vector<string>({ "Id", "Value", "Name" }));
+
+    REQUIRE(profile.n_rows_sampled > 0);
+    REQUIRE(profile.types[0] == CSV_INT32);
+    REQUIRE(profile.types[1] == CSV_DOUBLE);
+    REQUIRE(profile.types[2] == CSV_STRING);
+
+    // Every sampled Value field should have been tallied as a double
+    REQUIRE(profile.type_counts[1][CSV_DOUBLE] == (size_t)profile.n_rows_sampled);
+
+    // Extrapolated count should land within a few percent of the truth
+    REQUIRE(profile.n_rows_estimate > N_ROWS * 95 / 100);
+    REQUIRE(profile.n_rows_estimate < N_ROWS * 105 / 100);
+
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("Memory-Mapped Read Test", "[read_csv_mmap]") {
+    const char * test_file = "./tests/mmap_test.csv";
+
+    std::ofstream test_out(test_file);
+    test_out << "A,B,C" << std::endl;
+    for (int i = 0; i < 10000; i++)
+        test_out << i << "," << i + 1 << "," << i + 2 << std::endl;
+    test_out.close();
+
+    CSVReader reader(test_file, CSVFormat(), IOMode::MMAP);
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    for (int i = 0; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i + 1);
+        REQUIRE(row["C"].get<int>() == i + 2);
+    }
+
+    REQUIRE(reader.num_rows == 10000);
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("Quote-Free Fast Lane Test", "[read_csv_no_quote]") {
+    const char * test_file = "./tests/no_quote_test.csv";
+
+    std::ofstream test_out(test_file);
+    test_out << "A,B,C" << std::endl;
+    for (int i = 0; i < 10000; i++)
+        test_out << i << "," << i + 1 << "," << i + 2 << std::endl;
+    test_out.close();
+
+    // Format guessing should detect the absence of quotes and engage
+    // the two-symbol parsing lane automatically
+    CSVReader reader(test_file);
+    REQUIRE_FALSE(reader.get_format().is_quoting_enabled());
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    for (int i = 0; i < 10000; i++) {
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i + 1);
+        REQUIRE(row["C"].get<int>() == i + 2);
+    }
+
+    REQUIRE_FALSE(reader.read_row(row));
+    REQUIRE(remove(test_file) == 0);
+
+    // A quote mid-field is ordinary data once quoting is off
+    CSVFormat no_quote_format;
+    no_quote_format.quote(false).column_names({ "A", "B" });
+
+    auto rows = parse("1,say \"hi\"\r\n2,\"quoted\"\r\n", no_quote_format);
+    auto it = rows.begin();
+    REQUIRE((*it)["B"].get<>() == "say \"hi\"");
+    REQUIRE((*++it)["B"].get<>() == "\"quoted\"");
+}
+
+TEST_CASE("Asynchronous Read Test", "[read_csv_async]") {
+    const char * test_file = "./tests/async_test.csv";
+
+    std::ofstream test_out(test_file);
+    test_out << "A,B,C" << std::endl;
+    for (int i = 0; i < 10000; i++)
+        test_out << i << "," << i + 1 << "," << i + 2 << std::endl;
+    test_out.close();
+
+    // Uses io_uring where available; otherwise quietly falls back to
+    // buffered stdio reads, so the results are identical either way
+    CSVReader reader(test_file, CSVFormat(), IOMode::ASYNC);
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    for (int i = 0; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i + 1);
+        REQUIRE(row["C"].get<int>() == i + 2);
+    }
+
+    REQUIRE(reader.num_rows == 10000);
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("Parser Session Test", "[read_csv_session]") {
+    // Several small files, two sharing a header and one with its own
+    const char * file_a = "./tests/session_a.csv";
+    const char * file_b = "./tests/session_b.csv";
+    const char * file_c = "./tests/session_c.csv";
+
+    for (auto& item : { std::make_pair(file_a, 0), std::make_pair(file_b, 100) }) {
+        std::ofstream test_out(item.first);
+        test_out << "A,B" << std::endl;
+        for (int i = 0; i < 50; i++)
+            test_out << item.second + i << "," << item.second + i * 2 << std::endl;
+    }
+
+    {
+        std::ofstream test_out(file_c);
+        test_out << "X,Y,Z" << std::endl;
+        test_out << "1,2,3" << std::endl;
+    }
+
+    ParserSession session;
+    CSVRow row;
+
+    // Column names come from each file's own header
+    for (auto& item : { std::make_pair(file_a, 0), std::make_pair(file_b, 100) }) {
+        CSVReader& reader = session.open(item.first);
+        REQUIRE(reader.get_col_names() == vector<string>({ "A", "B" }));
+
+        for (int i = 0; reader.read_row(row); i++) {
+            REQUIRE(row["A"].get<int>() == item.second + i);
+            REQUIRE(row["B"].get<int>() == item.second + i * 2);
+        }
+
+        REQUIRE(reader.num_rows == 50);
+    }
+
+    CSVReader& reader = session.open(file_c);
+    REQUIRE(reader.get_col_names() == vector<string>({ "X", "Y", "Z" }));
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["Z"].get<int>() == 3);
+    REQUIRE_FALSE(reader.read_row(row));
+
+    // Guessed formats cannot be reused: each file would need its own guess
+    REQUIRE_THROWS_AS(ParserSession(CSVFormat::guess_csv()), std::runtime_error);
+
+    for (auto* f : { file_a, file_b, file_c })
+        REQUIRE(remove(f) == 0);
+}
+
+TEST_CASE("Multi-Threaded Parse Test", "[read_csv_parallel]") {
+    const char * test_file = "./tests/parallel_test.csv";
+
+    std::ofstream test_out(test_file);
+    test_out << "A,B,C" << std::endl;
+    for (int i = 0; i < 50000; i++)
+        test_out << i << "," << i + 1 << "," << i + 2 << std::endl;
+    test_out.close();
+
+    CSVFormat format;
+    format.threads(4);
+
+    CSVReader reader(test_file, format);
+
+    // Assert rows come back in their original order
+    CSVRow row;
+    for (int i = 0; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["C"].get<int>() == i + 2);
+    }
+
+    REQUIRE(reader.num_rows == 50000);
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("concat() Test", "[test_concat]") {
+    const char * shard_1 = "./tests/concat_shard1.csv";
+    const char * shard_2 = "./tests/concat_shard2.csv";
+    const char * shard_3 = "./tests/concat_shard3.tsv";
+    const char * merged = "./tests/concat_merged.csv";
+
+    {
+        std::ofstream test_out(shard_1);
+        test_out << "A,B" << std::endl;
+        for (int i = 0; i < 1000; i++)
+            test_out << i << "," << i * 2 << std::endl;
+    }
+
+    {
+        // No trailing newline: concat() must still keep rows separated
+        std::ofstream test_out(shard_2);
+        test_out << "A,B" << std::endl;
+        for (int i = 1000; i < 1999; i++)
+            test_out << i << "," << i * 2 << std::endl;
+        test_out << 1999 << "," << 1999 * 2;
+    }
+
+    {
+        // Same columns but tab-delimited: this shard is re-quoted, and its
+        // embedded comma must come out quoted in the merged file
+        std::ofstream test_out(shard_3);
+        test_out << "A\tB" << std::endl;
+        test_out << "2000\tx,y" << std::endl;
+    }
+
+    size_t n_bytes = concat(merged, { shard_1, shard_2, shard_3 });
+    REQUIRE(n_bytes > 0);
+
+    CSVReader reader(merged);
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B" }));
+
+    CSVRow row;
+    for (int i = 0; i < 2000; i++) {
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i * 2);
+    }
+
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["A"].get<int>() == 2000);
+    REQUIRE(row["B"].get<>() == "x,y");
+    REQUIRE_FALSE(reader.read_row(row));
+
+    // Shards with different column names are rejected
+    const char * bad_shard = "./tests/concat_bad.csv";
+    {
+        std::ofstream test_out(bad_shard);
+        test_out << "A,C" << std::endl << "1,2" << std::endl;
+    }
+
+    REQUIRE_THROWS_AS(concat(merged, { shard_1, bad_shard }), std::runtime_error);
+
+    for (auto* f : { shard_1, shard_2, shard_3, merged, bad_shard })
+        REQUIRE(remove(f) == 0);
+}
+
+TEST_CASE("Follow Mode Test", "[read_csv_follow]") {
+    const char * test_file = "./tests/follow_test.csv";
+
+    {
+        std::ofstream test_out(test_file);
+        test_out << "A,B" << std::endl;
+        for (int i = 0; i < 100; i++)
+            test_out << i << "," << i * 2 << std::endl;
+    }
+
+    CSVReader reader(test_file, CSVFormat());
+    reader.set_follow(true);
+
+    CSVRow row;
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"].get<int>() == i);
+    }
+
+    // Caught up: no complete row yet, but the reader is still live
+    REQUIRE_FALSE(reader.read_row(row));
+
+    // A producer appends a complete row plus the start of another
+    {
+        std::ofstream test_out(test_file, std::ios::app);
+        test_out << "100,200" << std::endl;
+        test_out << "101,";
+    }
+
+    REQUIRE(reader.poll());
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["A"].get<int>() == 100);
+
+    // The incomplete line is withheld until its newline arrives
+    REQUIRE_FALSE(reader.read_row(row));
+
+    {
+        std::ofstream test_out(test_file, std::ios::app);
+        test_out << "202" << std::endl;
+    }
+
+    REQUIRE(reader.read_row(row));
+    REQUIRE(row["A"].get<int>() == 101);
+    REQUIRE(row["B"].get<int>() == 202);
+
+    // Appends straddling the parser's partial state never re-scan:
+    // only new bytes were read to assemble the split row
+    REQUIRE(reader.num_rows == 102);
+
+    // Leaving follow mode lets the reader finish normally
+    reader.set_follow(false);
+    REQUIRE_FALSE(reader.read_row(row));
+
+    REQUIRE(remove(test_file) == 0);
+}
+
 TEST_CASE("Non-Existent CSV", "[read_ghost_csv]") {
     // Make sure attempting to parse a non-existent CSV throws an error
     bool error_caught = false;
@@ -147,4 +482,105 @@ TEST_CASE("Test read_row() CSVField - Power Status", "[read_row_csvf3]") {
             REQUIRE(row[unit].get<std::string>() == "Beaver Valley 1");
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Unicode Policy Test", "[unicode_policy]") {
+    const char* test_file = "./tests/unicode_policy.csv";
+
+    SECTION("Valid UTF-8 Passes Under THROW") {
+        {
+            std::ofstream out(test_file, std::ios::binary);
+            out << "A,B" << std::endl
+                << "caf\xC3\xA9,\xE2\x82\xAC" << std::endl
+                << "\xF0\x9F\x98\x80,x" << std::endl;
+        }
+
+        CSVReader reader(test_file);
+        reader.set_unicode_policy(UnicodePolicy::THROW);
+
+        CSVRow row;
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "caf\xC3\xA9");
+        REQUIRE(row["B"] == "\xE2\x82\xAC");
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "\xF0\x9F\x98\x80");
+        REQUIRE_FALSE(reader.read_row(row));
+    }
+
+    SECTION("Malformed UTF-8 Throws") {
+        {
+            std::ofstream out(test_file, std::ios::binary);
+            out << "A,B" << std::endl << "bad\xFF" "byte,1" << std::endl;
+        }
+
+        CSVReader reader(test_file);
+        reader.set_unicode_policy(UnicodePolicy::THROW);
+
+        CSVRow row;
+        REQUIRE_THROWS_AS(reader.read_row(row), std::runtime_error);
+    }
+
+    SECTION("Malformed UTF-8 Replaced") {
+        {
+            std::ofstream out(test_file, std::ios::binary);
+            out << "A,B" << std::endl << "bad\xFF" "byte,1" << std::endl;
+        }
+
+        CSVReader reader(test_file);
+        reader.set_unicode_policy(UnicodePolicy::REPLACE);
+
+        CSVRow row;
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "bad?byte");
+        REQUIRE(row["B"] == 1);
+    }
+
+    SECTION("UTF-16LE Transcode") {
+        // Data rows only: format guessing and header parsing read raw
+        // bytes, so UTF-16 input needs an explicit format
+        std::u16string content = u"1,café\r\n\U0001F600,x\r\n";
+
+        {
+            std::ofstream out(test_file, std::ios::binary);
+            out.put('\xFF'); // Byte order mark
+            out.put('\xFE');
+
+            for (char16_t unit : content) {
+                out.put((char)(unit & 0xFF));
+                out.put((char)(unit >> 8));
+            }
+        }
+
+        CSVFormat format;
+        format.delimiter(',').column_names({ "A", "B" });
+
+        CSVReader reader(test_file, format);
+        reader.set_unicode_policy(UnicodePolicy::THROW);
+
+        CSVRow row;
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "1");
+        REQUIRE(row["B"] == "caf\xC3\xA9");
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "\xF0\x9F\x98\x80"); // Surrogate pair for U+1F600
+        REQUIRE(row["B"] == "x");
+        REQUIRE_FALSE(reader.read_row(row));
+
+        // The detected encoding is per-file state: reopening onto a UTF-8
+        // file must not keep transcoding as UTF-16
+        const char* utf8_file = "./tests/unicode_policy2.csv";
+        {
+            std::ofstream out(utf8_file, std::ios::binary);
+            out << "caf\xC3\xA9,plain" << std::endl;
+        }
+
+        reader.open(utf8_file);
+        REQUIRE(reader.read_row(row));
+        REQUIRE(row["A"] == "caf\xC3\xA9");
+        REQUIRE(row["B"] == "plain");
+        REQUIRE_FALSE(reader.read_row(row));
+
+        REQUIRE(remove(utf8_file) == 0);
+    }
+
+    REQUIRE(remove(test_file) == 0);
+}
@@ -49,6 +49,10 @@ TEST_CASE("CSV to Stringstream", "[test_csv_sstream1]") {
     for (; !q.empty(); q.pop())
         writer.write_row(q.front());
 
+    // Rows stay in the writer's buffer until flushed
+    REQUIRE(out.str().empty());
+    writer.flush();
+
     REQUIRE(out.str() == correct.str());
 }
 
@@ -66,21 +70,101 @@ TEMPLATE_TEST_CASE("CSV/TSV Writer - operator <<", "[test_csv_operator<<]",
         test_row_2 = TestType({ "1,1", "2", "3" });
 
     SECTION("CSV Writer") {
-        auto csv_writer = make_csv_writer(output);
-        csv_writer << test_row_1 << test_row_2;
+        {
+            auto csv_writer = make_csv_writer(output);
+            csv_writer << test_row_1 << test_row_2;
+        } // Destruction flushes the writer
 
         REQUIRE(output.str() == correct_comma.str());
     }
 
     SECTION("TSV Writer") {
-        auto tsv_writer = make_tsv_writer(output);
-        tsv_writer << test_row_1 << test_row_2;
+        {
+            auto tsv_writer = make_tsv_writer(output);
+            tsv_writer << test_row_1 << test_row_2;
+        }
 
         REQUIRE(output.str() == correct_tab.str());
     }
 }
 //! [CSV Writer Example]
 
+TEST_CASE("CSV Writer - CSVRow Passthrough", "[test_csv_write_row]") {
+    auto rows = "A,B,C\r\n"
+        "123,\"234,345\",456\r\n"
+        "1,2,3"_csv;
+
+    std::stringstream output;
+
+    {
+        auto writer = make_csv_writer(output);
+        writer << rows.get_col_names();
+
+        CSVRow row;
+        while (rows.read_row(row))
+            writer << row;
+    }
+
+    REQUIRE(output.str() == "A,B,C\n123,\"234,345\",456\n1,2,3\n");
+}
+
+TEST_CASE("CSV Writer - Numeric Rows", "[test_csv_write_numeric]") {
+    std::stringstream output;
+
+    {
+        auto writer = make_csv_writer(output);
+        writer << std::make_tuple("label", 42, -17, 3.25, true);
+
+        std::vector<double> doubles = { 0.1, 2.5, -1e-9 };
+        writer.write_row(doubles);
+    }
+
+    REQUIRE(output.str() == "label,42,-17,3.25,1\n0.1,2.5,-1e-09\n");
+}
+
+#ifdef CSV_HAS_ZLIB
+TEST_CASE("CSV Writer - Compressed Output", "[test_csv_write_compressed]") {
+    const char * test_file = "./tests/compressed_write_test.csv.gz";
+    const int N_ROWS = 10000;
+
+    {
+        // Codec deduced from the .gz extension
+        CompressedOutput out(test_file);
+        auto writer = make_csv_writer(out);
+
+        writer << vector<string>({ "A", "B", "C" });
+
+        for (int i = 0; i < N_ROWS; i++) {
+            writer << std::make_tuple(i, i * 2, i + 1);
+
+            // Periodic flushes end the current frame, so the file is
+            // written as several independent gzip members
+            if (i % 2500 == 0)
+                writer.flush();
+        }
+    } // Destruction flushes the writer, then drains the compressor
+
+    // CSVReader decompresses transparently, detecting gzip by magic bytes
+    CSVReader reader(test_file);
+    REQUIRE(reader.get_col_names() == vector<string>({ "A", "B", "C" }));
+
+    CSVRow row;
+    for (int i = 0; reader.read_row(row); i++) {
+        REQUIRE(row["A"].get<int>() == i);
+        REQUIRE(row["B"].get<int>() == i * 2);
+        REQUIRE(row["C"].get<int>() == i + 1);
+    }
+
+    REQUIRE(reader.num_rows == N_ROWS);
+    REQUIRE(remove(test_file) == 0);
+}
+
+TEST_CASE("Compressed Output - Bad Codec", "[test_csv_write_compressed_bad]") {
+    // No recognized extension to deduce a codec from
+    REQUIRE_THROWS_AS(CompressedOutput("./tests/temp.csv"), std::runtime_error);
+}
+#endif
+
 /*
 TEST_CASE("CSV Round Trip", "[test_csv_roundtrip]") {
     const char * test_file = "./tests/temp/round_trip.csv";